@@ -124,7 +124,10 @@ namespace algorithms
 
         // ==================== BFS phase ====================
         GRB_BC_LOG("======= START BFS phase ======");
-        std::vector<GraphBLAS::Matrix<bool>* > Sigmas;
+        // The Sigmas are only used as masks and hold only true (positive
+        // path counts cast to bool): store their pattern only
+        typedef GraphBLAS::Matrix<bool, GraphBLAS::PatternStorageTag> SigmaType;
+        std::vector<SigmaType* > Sigmas;
         int32_t d = 0;
 
         // For testing purpose we only allow 10 iterations so it doesn't
@@ -134,7 +137,7 @@ namespace algorithms
             GRB_BC_LOG("------- BFS iteration " << d << " --------");
 
             // Sigma[d] = (bool)Frontier
-            Sigmas.push_back(new GraphBLAS::Matrix<bool>(nsver, n));
+            Sigmas.push_back(new SigmaType(nsver, n));
             GraphBLAS::apply(*(Sigmas[d]),
                              GraphBLAS::NoMask(),
                              GraphBLAS::NoAccumulate(),
@@ -325,12 +328,15 @@ namespace algorithms
         NumSP.build(GrB_ALL_nsver, s, std::vector<int32_t>(nsver, 1));
 
         // ==================== BFS phase ====================
-        std::vector<GraphBLAS::Matrix<bool>* > Sigmas;
+        // The Sigmas are only used as masks and hold only true (positive
+        // path counts cast to bool): store their pattern only
+        typedef GraphBLAS::Matrix<bool, GraphBLAS::PatternStorageTag> SigmaType;
+        std::vector<SigmaType* > Sigmas;
         int32_t d = 0;
         while (Frontier.nvals() > 0)
         {
             // Sigma[d] = (bool)Frontier
-            Sigmas.push_back(new GraphBLAS::Matrix<bool>(nsver, n));
+            Sigmas.push_back(new SigmaType(nsver, n));
             GraphBLAS::apply(*(Sigmas[d]),
                              GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
                              GraphBLAS::Identity<int32_t, bool>(),
@@ -499,11 +505,14 @@ namespace algorithms
         NumSP.build(s, GrB_ALL_nsver, std::vector<int32_t>(nsver, 1));
 
         // ==================== BFS phase ====================
-        std::vector<GraphBLAS::Matrix<bool>* > Sigmas;
+        // The Sigmas are only used as masks and hold only true (positive
+        // path counts cast to bool): store their pattern only
+        typedef GraphBLAS::Matrix<bool, GraphBLAS::PatternStorageTag> SigmaType;
+        std::vector<SigmaType* > Sigmas;
         int32_t d = 0;
         while (Frontier.nvals() > 0)
         {
-            Sigmas.push_back(new GraphBLAS::Matrix<bool>(n, nsver));
+            Sigmas.push_back(new SigmaType(n, nsver));
             GraphBLAS::apply(*(Sigmas[d]),
                              GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
                              GraphBLAS::Identity<int32_t, bool>(),
@@ -672,7 +681,10 @@ namespace algorithms
         GraphBLAS::Matrix<int32_t> NumSP(Frontier);
 
         // ==================== BFS phase ====================
-        std::vector<GraphBLAS::Matrix<bool>* > Sigmas;
+        // The Sigmas are only used as masks and hold only true (positive
+        // path counts cast to bool): store their pattern only
+        typedef GraphBLAS::Matrix<bool, GraphBLAS::PatternStorageTag> SigmaType;
+        std::vector<SigmaType* > Sigmas;
         int32_t d = 0;
         while (Frontier.nvals() > 0)
         {
@@ -686,7 +698,7 @@ namespace algorithms
                            true);
 
             // Sigma[d] = (bool)F
-            Sigmas.push_back(new GraphBLAS::Matrix<bool>(n, nsver));
+            Sigmas.push_back(new SigmaType(n, nsver));
             GraphBLAS::apply(*(Sigmas[d]),
                              GraphBLAS::NoMask(),
                              GraphBLAS::NoAccumulate(),
@@ -36,8 +36,12 @@
  * readable error code conversion.</p>
  */
 
+#ifndef ALGORITHMS_BFS_HPP
+#define ALGORITHMS_BFS_HPP
+
 #include <limits>
 #include <tuple>
+#include <algorithm>
 
 #include <graphblas/graphblas.hpp>
 
@@ -51,47 +55,23 @@ namespace
     {
         using T = typename MatrixT::ScalarType;
 
-        GraphBLAS::IndexArrayType i, j, v;
-        for (GraphBLAS::IndexType ix = 0; ix < mat.ncols(); ++ix)
-        {
-            i.push_back(ix);
-            j.push_back(ix);
-            v.push_back(ix + 1);
-        }
-
-        MatrixT identity_ramp(mat.ncols(), mat.ncols());
-
-        identity_ramp.build(i,j,v);
-
-        GraphBLAS::mxm(mat,
-                       GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
-                       GraphBLAS::MinSelect2ndSemiring<T>(),
-                       mat, identity_ramp, true);
+        GraphBLAS::apply(mat,
+                         GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
+                         GraphBLAS::ColIndex<T, T>(1),
+                         mat, true);
     }
 
     //************************************************************************
-    //convert each stored entry of a vector to its 1-based index
+    //convert each stored entry of a vector to its 0-based index
     template <typename VectorT>
     void index_of_0based(VectorT &vec)
     {
         using T = typename VectorT::ScalarType;
 
-        GraphBLAS::IndexArrayType i, j, v;
-        for (GraphBLAS::IndexType ix = 0; ix < vec.size(); ++ix)
-        {
-            i.push_back(ix);
-            j.push_back(ix);
-            v.push_back(ix);
-        }
-
-        GraphBLAS::Matrix<T> identity_ramp(vec.size(), vec.size());
-
-        identity_ramp.build(i,j,v);
-
-        GraphBLAS::vxm(vec,
-                       GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
-                       GraphBLAS::MinSelect2ndSemiring<T>(),
-                       vec, identity_ramp, true);
+        GraphBLAS::apply(vec,
+                         GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
+                         GraphBLAS::RowIndex<T, T>(0),
+                         vec, true);
     }
 
     //************************************************************************
@@ -101,24 +81,86 @@ namespace
     {
         using T = typename VectorT::ScalarType;
 
-        GraphBLAS::IndexArrayType i, j, v;
-        for (GraphBLAS::IndexType ix = 0; ix < vec.size(); ++ix)
+        GraphBLAS::apply(vec,
+                         GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
+                         GraphBLAS::RowIndex<T, T>(1),
+                         vec, true);
+    }
+
+    //************************************************************************
+    // Direction-optimizing BFS support: tracks the frontier's out-edge
+    // count (m_f) and the out-edges of unvisited vertices (m_u), and
+    // decides whether the next level should push or pull (Beamer et al.,
+    // "Direction-Optimizing Breadth-First Search", SC'12).
+    class DirectionSelector
+    {
+    public:
+        template <typename MatrixT>
+        DirectionSelector(MatrixT const &graph, double alpha, double beta)
+            : m_out_degree(graph.nrows()),
+              m_frontier_degree(graph.nrows()),
+              m_num_vertices(graph.nrows()),
+              m_unexplored_edges(graph.nvals()),
+              m_alpha(alpha),
+              m_beta(beta),
+              m_pull(false)
         {
-            i.push_back(ix);
-            j.push_back(ix);
-            v.push_back(ix + 1);
+            using T = typename MatrixT::ScalarType;
+
+            // out_degree = number of stored values in each row of graph
+            GraphBLAS::BinaryOp_Bind2nd<T, GraphBLAS::Second<T,
+                                                             GraphBLAS::IndexType,
+                                                             GraphBLAS::IndexType> >
+                to_one(1);
+            GraphBLAS::Matrix<GraphBLAS::IndexType> edges(graph.nrows(),
+                                                          graph.ncols());
+            GraphBLAS::apply(edges,
+                             GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
+                             to_one, graph);
+            GraphBLAS::reduce(m_out_degree,
+                              GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
+                              GraphBLAS::PlusMonoid<GraphBLAS::IndexType>(),
+                              edges);
         }
 
-        GraphBLAS::Matrix<T> identity_ramp(vec.size(), vec.size());
-
-        identity_ramp.build(i,j,v);
-
-        GraphBLAS::vxm(vec,
-                       GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
-                       GraphBLAS::MinSelect2ndSemiring<T>(),
-                       vec, identity_ramp, true);
-    }
+        /// Decide the direction for expanding wavefront; call once per level.
+        template <typename WavefrontT>
+        bool pull(WavefrontT const &wavefront)
+        {
+            GraphBLAS::eWiseMult(m_frontier_degree,
+                                 GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
+                                 GraphBLAS::Second<GraphBLAS::IndexType>(),
+                                 wavefront, m_out_degree, true);
+            GraphBLAS::IndexType frontier_edges(0);
+            GraphBLAS::reduce(frontier_edges, GraphBLAS::NoAccumulate(),
+                              GraphBLAS::PlusMonoid<GraphBLAS::IndexType>(),
+                              m_frontier_degree);
+
+            if (!m_pull &&
+                (double(frontier_edges) > double(m_unexplored_edges)/m_alpha))
+            {
+                m_pull = true;
+            }
+            else if (m_pull &&
+                     (double(wavefront.nvals()) <
+                      double(m_num_vertices)/m_beta))
+            {
+                m_pull = false;
+            }
+
+            m_unexplored_edges -= std::min(frontier_edges, m_unexplored_edges);
+            return m_pull;
+        }
 
+    private:
+        GraphBLAS::Vector<GraphBLAS::IndexType> m_out_degree;
+        GraphBLAS::Vector<GraphBLAS::IndexType> m_frontier_degree;
+        GraphBLAS::IndexType                    m_num_vertices;
+        GraphBLAS::IndexType                    m_unexplored_edges;
+        double                                  m_alpha;
+        double                                  m_beta;
+        bool                                    m_pull;
+    };
 }
 
 //****************************************************************************
@@ -143,7 +185,7 @@ namespace algorithms
               typename WavefrontVectorT,
               typename ParentListVectorT>
     void bfs(MatrixT const          &graph,
-             WavefrontVectorT        wavefront,   // copy is intentional
+             WavefrontVectorT        wavefront,   // working copy; move in to avoid it
              ParentListVectorT      &parent_list)
     {
         using T = typename MatrixT::ScalarType;
@@ -159,6 +201,7 @@ namespace algorithms
             index_of_1based(wavefront);
 
             // Select1st because we are left multiplying wavefront rows
+            // (Min rather than Any keeps the chosen parent deterministic).
             // Masking out the parent list ensures wavefront values do not
             // overlap values already stored in the parent list
             GraphBLAS::vxm(wavefront,
@@ -211,7 +254,7 @@ namespace algorithms
               typename WavefrontMatrixT,
               typename ParentListMatrixT>
     void bfs_batch(MatrixT const          &graph,
-                   WavefrontMatrixT        wavefronts,   // copy is intentional
+                   WavefrontMatrixT        wavefronts,   // working copy; move in to avoid it
                    ParentListMatrixT      &parent_list)
     {
         using T = typename MatrixT::ScalarType;
@@ -308,7 +351,7 @@ namespace algorithms
             GraphBLAS::mxm(wavefront,
                            GraphBLAS::NoMask(),
                            GraphBLAS::NoAccumulate(),
-                           GraphBLAS::LogicalSemiring<unsigned int>(),
+                           GraphBLAS::AnyPairSemiring<unsigned int>(),
                            wavefront, graph,
                            true);
 
@@ -387,7 +430,7 @@ namespace algorithms
                 wavefront,
                 GraphBLAS::complement(levels),
                 GraphBLAS::NoAccumulate(),
-                GraphBLAS::LogicalSemiring<GraphBLAS::IndexType>(),
+                GraphBLAS::AnyPairSemiring<GraphBLAS::IndexType>(),
                 wavefront, graph,
                 true);
         }
@@ -453,7 +496,7 @@ namespace algorithms
                 wavefronts,
                 GraphBLAS::complement(levels),
                 GraphBLAS::NoAccumulate(),
-                GraphBLAS::LogicalSemiring<GraphBLAS::IndexType>(),
+                GraphBLAS::AnyPairSemiring<GraphBLAS::IndexType>(),
                 wavefronts, graph,
                 true);
         }
@@ -514,10 +557,260 @@ namespace algorithms
                 wavefront,
                 GraphBLAS::complement(levels),
                 GraphBLAS::NoAccumulate(),
-                GraphBLAS::LogicalSemiring<GraphBLAS::IndexType>(),
+                GraphBLAS::AnyPairSemiring<GraphBLAS::IndexType>(),
                 wavefront, graph,
                 true);
         }
     }
 
+    //************************************************************************
+    /**
+     * @brief Direction-optimizing (push/pull) breadth first search that
+     *        produces the same parent list as bfs().
+     *
+     * Small frontiers push along the out-edges of the frontier vertices
+     * (vxm with graph); large frontiers pull, with every unvisited vertex
+     * scanning its in-edges (mxv with graph_t).  The direction switches to
+     * pull when the frontier's out-edges exceed 1/alpha of the edges left
+     * to explore, and back to push when the frontier has fewer than
+     * N/beta vertices.
+     *
+     * By default each vertex takes the smallest-index parent available, so
+     * the result is deterministic; the pull step's Min reduction then has
+     * no terminal value and scans every in-edge of each unvisited vertex.
+     * Passing min_parent = false pulls with AnySelect2ndSemiring instead,
+     * which stops at the first in-neighbor on the frontier (any valid BFS
+     * parent, not necessarily the smallest).
+     *
+     * @param[in]  graph        N x N adjacency matrix (NOT the transpose).
+     * @param[in]  graph_t      The transpose of graph (e.g., from
+     *                          GraphBLAS::transpose); pass it in to reuse it
+     *                          across traversals.
+     * @param[in]  wavefront    N-vector with the root(s) set to '1'.
+     * @param[out] parent_list  The parent of each reached vertex (roots are
+     *                          their own parents).
+     * @param[in]  alpha        Push to pull threshold (Beamer: 14).
+     * @param[in]  beta         Pull to push threshold (Beamer: 24).
+     * @param[in]  min_parent   Pick the smallest-index parent (default)
+     *                          rather than the first one pulled.
+     */
+    template <typename MatrixT,
+              typename WavefrontVectorT,
+              typename ParentListVectorT>
+    void bfs_direction_optimizing(MatrixT const          &graph,
+                                  MatrixT const          &graph_t,
+                                  WavefrontVectorT        wavefront, // copy
+                                  ParentListVectorT      &parent_list,
+                                  double                  alpha = 14.0,
+                                  double                  beta = 24.0,
+                                  bool                    min_parent = true)
+    {
+        using T = typename MatrixT::ScalarType;
+
+        GraphBLAS::IndexType num_vertices(graph.nrows());
+        if ((graph.ncols() != num_vertices) ||
+            (graph_t.nrows() != num_vertices) ||
+            (graph_t.ncols() != num_vertices) ||
+            (wavefront.size() != num_vertices))
+        {
+            throw GraphBLAS::DimensionException();
+        }
+
+        // Replaces frontier values with their 1-based indices (parent ids)
+        GraphBLAS::RowIndex<T, T> index_of_1based_op(1);
+
+        DirectionSelector direction(graph, alpha, beta);
+
+        // Set the roots parents to themselves using one-based indices because
+        // the mask is sensitive to stored zeros.
+        GraphBLAS::apply(parent_list,
+                         GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
+                         index_of_1based_op,
+                         wavefront, true);
+
+        while (wavefront.nvals() > 0)
+        {
+            bool pull(direction.pull(wavefront));
+
+            // convert all stored values to their 1-based column index
+            GraphBLAS::apply(wavefront,
+                             GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
+                             index_of_1based_op,
+                             wavefront, true);
+
+            if (pull && !min_parent)
+            {
+                // Each unvisited vertex takes the first frontier in-neighbor
+                GraphBLAS::mxv(wavefront,
+                               GraphBLAS::complement(parent_list),
+                               GraphBLAS::NoAccumulate(),
+                               GraphBLAS::AnySelect2ndSemiring<T>(),
+                               graph_t, wavefront, true);
+            }
+            else if (pull)
+            {
+                // Each unvisited vertex takes the smallest frontier
+                // in-neighbor (Min has no terminal, so no early exit)
+                GraphBLAS::mxv(wavefront,
+                               GraphBLAS::complement(parent_list),
+                               GraphBLAS::NoAccumulate(),
+                               GraphBLAS::MinSelect2ndSemiring<T>(),
+                               graph_t, wavefront, true);
+            }
+            else
+            {
+                // Each frontier vertex offers itself along its out-edges
+                GraphBLAS::vxm(wavefront,
+                               GraphBLAS::complement(parent_list),
+                               GraphBLAS::NoAccumulate(),
+                               GraphBLAS::MinSelect1stSemiring<T>(),
+                               wavefront, graph, true);
+            }
+
+            // Merges new parents in current wavefront with existing parents
+            GraphBLAS::apply(parent_list,
+                             GraphBLAS::NoMask(),
+                             GraphBLAS::Plus<T>(),
+                             GraphBLAS::Identity<T>(),
+                             wavefront,
+                             false);
+        }
+
+        // Restore zero-based indices by subtracting 1 from all stored values
+        GraphBLAS::BinaryOp_Bind2nd<T, GraphBLAS::Minus<T> > subtract_1(1);
+
+        GraphBLAS::apply(parent_list,
+                         GraphBLAS::NoMask(),
+                         GraphBLAS::NoAccumulate(),
+                         subtract_1,
+                         parent_list,
+                         true);
+    }
+
+    //************************************************************************
+    /**
+     * @brief Direction-optimizing parent BFS that computes the transpose of
+     *        graph itself (see the overload taking graph_t).
+     */
+    template <typename MatrixT,
+              typename WavefrontVectorT,
+              typename ParentListVectorT>
+    void bfs_direction_optimizing(MatrixT const          &graph,
+                                  WavefrontVectorT const &wavefront,
+                                  ParentListVectorT      &parent_list,
+                                  double                  alpha = 14.0,
+                                  double                  beta = 24.0,
+                                  bool                    min_parent = true)
+    {
+        MatrixT graph_t(graph.ncols(), graph.nrows());
+        GraphBLAS::transpose(graph_t,
+                             GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
+                             graph);
+        bfs_direction_optimizing(graph, graph_t, wavefront, parent_list,
+                                 alpha, beta, min_parent);
+    }
+
+    //************************************************************************
+    /**
+     * @brief Direction-optimizing (push/pull) breadth first search that
+     *        produces the same levels as bfs_level_masked().
+     *
+     * Both directions use AnyPairSemiring; its Any monoid is terminal from
+     * the first value, so a pulling vertex stops scanning its in-edges at
+     * the first one from the frontier.  See bfs_direction_optimizing() for
+     * the switching heuristic.
+     *
+     * @param[in]  graph      NxN adjacency matrix (not the transpose).
+     * @param[in]  graph_t    The transpose of graph.
+     * @param[in]  wavefront  N-vector with the root(s) set to 1.
+     * @param[out] levels     The level of each reached vertex (roots are
+     *                        assigned 1).
+     */
+    template <typename MatrixT,
+              typename WavefrontT,
+              typename LevelListT>
+    void bfs_level_direction_optimizing(MatrixT const  &graph,
+                                        MatrixT const  &graph_t,
+                                        WavefrontT      wavefront, // copy
+                                        LevelListT     &levels,
+                                        double          alpha = 14.0,
+                                        double          beta = 24.0)
+    {
+        GraphBLAS::IndexType num_vertices(graph.nrows());
+        if ((graph.ncols() != num_vertices) ||
+            (graph_t.nrows() != num_vertices) ||
+            (graph_t.ncols() != num_vertices) ||
+            (wavefront.size() != num_vertices))
+        {
+            throw GraphBLAS::DimensionException();
+        }
+
+        DirectionSelector direction(graph, alpha, beta);
+
+        GraphBLAS::IndexType depth = 0;
+        while (wavefront.nvals() > 0)
+        {
+            // Increment the level
+            ++depth;
+
+            // Apply the level to all newly visited nodes
+            GraphBLAS::BinaryOp_Bind2nd<GraphBLAS::IndexType,
+                                        GraphBLAS::Times<GraphBLAS::IndexType> >
+                    apply_depth(depth);
+
+            GraphBLAS::apply(levels,
+                             GraphBLAS::NoMask(),
+                             GraphBLAS::Plus<GraphBLAS::IndexType>(),
+                             apply_depth,
+                             wavefront,
+                             true);
+
+            // Advance the wavefront and mask out nodes already assigned levels
+            if (direction.pull(wavefront))
+            {
+                GraphBLAS::mxv(
+                    wavefront,
+                    GraphBLAS::complement(levels),
+                    GraphBLAS::NoAccumulate(),
+                    GraphBLAS::AnyPairSemiring<GraphBLAS::IndexType>(),
+                    graph_t, wavefront,
+                    true);
+            }
+            else
+            {
+                GraphBLAS::vxm(
+                    wavefront,
+                    GraphBLAS::complement(levels),
+                    GraphBLAS::NoAccumulate(),
+                    GraphBLAS::AnyPairSemiring<GraphBLAS::IndexType>(),
+                    wavefront, graph,
+                    true);
+            }
+        }
+    }
+
+    //************************************************************************
+    /**
+     * @brief Direction-optimizing level BFS that computes the transpose of
+     *        graph itself (see the overload taking graph_t).
+     */
+    template <typename MatrixT,
+              typename WavefrontT,
+              typename LevelListT>
+    void bfs_level_direction_optimizing(MatrixT const    &graph,
+                                        WavefrontT const &wavefront,
+                                        LevelListT       &levels,
+                                        double            alpha = 14.0,
+                                        double            beta = 24.0)
+    {
+        MatrixT graph_t(graph.ncols(), graph.nrows());
+        GraphBLAS::transpose(graph_t,
+                             GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
+                             graph);
+        bfs_level_direction_optimizing(graph, graph_t, wavefront, levels,
+                                       alpha, beta);
+    }
+
 }
+
+#endif // ALGORITHMS_BFS_HPP
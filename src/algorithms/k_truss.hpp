@@ -31,7 +31,7 @@
 #define ALGORITHMS_K_TRUSS_HPP
 
 #include <iostream>
-#include <memory>
+#include <utility>
 
 #include <graphblas/graphblas.hpp>
 
@@ -102,8 +102,9 @@ namespace algorithms
         GraphBLAS::IndexType num_vertices(Ein.ncols());
         GraphBLAS::IndexType num_edges(Ein.nrows());
 
-        // Build a mask for the diagonal of A
-        GraphBLAS::Matrix<bool> DiagMask(num_vertices, num_vertices);
+        // Build a mask for the diagonal of A (structure only)
+        GraphBLAS::Matrix<bool, GraphBLAS::PatternStorageTag>
+            DiagMask(num_vertices, num_vertices);
         GraphBLAS::IndexArrayType I_n;
         std::vector<bool> v_n(num_vertices, true);
         I_n.reserve(num_vertices);
@@ -136,44 +137,47 @@ namespace algorithms
         // R = E*A
         // s = (R==2)*1
         //GraphBLAS::Matrix<EdgeType> R(num_edges, num_vertices);
-        auto E = std::make_shared<EMatrixT>(Ein);
-        auto R = std::make_shared<EMatrixT>(num_edges, num_vertices);
-        GraphBLAS::mxm(*R, GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
+        // The edges left are read from Ein until the first ones are removed;
+        // from then on E owns them (results are moved in, not copied).
+        EMatrixT const *Ecur = &Ein;
+        EMatrixT E(0, 0);
+        EMatrixT R(num_edges, num_vertices);
+        GraphBLAS::mxm(R, GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
                        GraphBLAS::ArithmeticSemiring<EdgeType>(),
-                       *E, A);
-        //GraphBLAS::print_matrix(std::cout, *R, "R");
+                       Ein, A);
+        //GraphBLAS::print_matrix(std::cout, R, "R");
 
         GraphBLAS::Vector<EdgeType> OnesN(num_vertices);
         GraphBLAS::assign(OnesN,
                           GraphBLAS::NoMask(),
                           GraphBLAS::NoAccumulate(),
                           static_cast<EdgeType>(1), I_n, true);
-        auto s = std::make_shared<GraphBLAS::Vector<EdgeType>>(num_edges);
-        GraphBLAS::mxv(*s, GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
+        GraphBLAS::Vector<EdgeType> s(num_edges);
+        GraphBLAS::mxv(s, GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
                        Support2Semiring<EdgeType>(),
-                       *R, OnesN, true);
-        //GraphBLAS::print_vector(std::cout, *s, "edge support");
+                       R, OnesN, true);
+        //GraphBLAS::print_vector(std::cout, s, "edge support");
 
         // 4. Determine edges which lack enough support for k-truss
         // x = find(s < k-2)
-        auto x = std::make_shared<GraphBLAS::Vector<bool>>(num_edges);
-        GraphBLAS::apply(*x, GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
+        GraphBLAS::Vector<bool> x(num_edges);
+        GraphBLAS::apply(x, GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
                          SupportTest<EdgeType>(k_size - 2),
-                         *s, true);
-        GraphBLAS::apply(*x, *x, GraphBLAS::NoAccumulate(),
+                         s, true);
+        GraphBLAS::apply(x, x, GraphBLAS::NoAccumulate(),
                          GraphBLAS::Identity<EdgeType>(),
-                         *x, true);
-        //GraphBLAS::print_vector(std::cout, *x, "edges lacking support");
+                         x, true);
+        //GraphBLAS::print_vector(std::cout, x, "edges lacking support");
 
-        while (x->nvals() > 0)
+        while (x.nvals() > 0)
         {
             //std::cout << "============= Iteration: |x| = " << x->nvals()
             //          << std::endl;
 
             // Step 0a: Get the indices of 'falses' in x
-            GraphBLAS::IndexArrayType x_indices(x->nvals());
-            GraphBLAS::IndexArrayType x_vals(x->nvals());
-            x->extractTuples(x_indices.begin(), x_vals.begin());
+            GraphBLAS::IndexArrayType x_indices(x.nvals());
+            GraphBLAS::IndexArrayType x_vals(x.nvals());
+            x.extractTuples(x_indices.begin(), x_vals.begin());
 
             //std::cout << "x_indices: ";
             //for (auto ix : x_indices) std::cout << " " << ix;
@@ -184,7 +188,7 @@ namespace algorithms
             GraphBLAS::apply(
                 xc, GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
                 SupportTest<EdgeType, std::greater_equal<EdgeType>>(k_size - 2),
-                *s, true);
+                s, true);
             // masked no-op to get rid of stored falses.
             GraphBLAS::apply(xc, xc, GraphBLAS::NoAccumulate(),
                              GraphBLAS::Identity<EdgeType>(),
@@ -205,7 +209,7 @@ namespace algorithms
             GraphBLAS::extract(Ex,
                                GraphBLAS::NoMask(),
                                GraphBLAS::NoAccumulate(),
-                               *E,
+                               *Ecur,
                                x_indices,
                                GraphBLAS::AllIndices(),
                                true);
@@ -214,32 +218,33 @@ namespace algorithms
             // Step 1b: extract the edges that are left
             // E := E(xc,:)
             num_edges = xc_indices.size();
-            auto Enew = std::make_shared<EMatrixT>(num_edges, num_vertices);
-            GraphBLAS::extract(*Enew,
+            EMatrixT Enew(num_edges, num_vertices);
+            GraphBLAS::extract(Enew,
                                GraphBLAS::NoMask(),
                                GraphBLAS::NoAccumulate(),
-                               *E,
+                               *Ecur,
                                xc_indices,
                                GraphBLAS::AllIndices(),
                                true);
-            //GraphBLAS::print_matrix(std::cout, *Enew, "Enew");
-            E = Enew;
+            //GraphBLAS::print_matrix(std::cout, Enew, "Enew");
+            E = std::move(Enew);
+            Ecur = &E;
             if (num_edges == 0)
             {
                 break;
             }
 
             // R := R(xc,:)
-            auto Rnew = std::make_shared<EMatrixT>(num_edges, num_vertices);
-            GraphBLAS::extract(*Rnew,
+            EMatrixT Rnew(num_edges, num_vertices);
+            GraphBLAS::extract(Rnew,
                                GraphBLAS::NoMask(),
                                GraphBLAS::NoAccumulate(),
-                               *R,
+                               R,
                                xc_indices,
                                GraphBLAS::AllIndices(),
                                true);
-            //GraphBLAS::print_matrix(std::cout, *Rnew, "Rnew");
-            R = Rnew;
+            //GraphBLAS::print_matrix(std::cout, Rnew, "Rnew");
+            R = std::move(Rnew);
 
             // R := R - E[Ex'*Ex - diag(dx)]
             //
@@ -254,34 +259,38 @@ namespace algorithms
             //GraphBLAS::print_matrix(std::cout, ExT_Ex, "Ex'*Ex - diag");
 
             // R -= E(Ex'*Ex)
-            GraphBLAS::mxm(*R,
+            GraphBLAS::mxm(R,
                            GraphBLAS::NoMask(),
                            GraphBLAS::Minus<EdgeType>(),
                            GraphBLAS::ArithmeticSemiring<EdgeType>(),
-                           *Enew, ExT_Ex, true);
-            //GraphBLAS::print_matrix(std::cout, *R, "R -= E*[Ex'*Ex - diag]");
+                           E, ExT_Ex, true);
+            //GraphBLAS::print_matrix(std::cout, R, "R -= E*[Ex'*Ex - diag]");
 
-            s = std::make_shared<GraphBLAS::Vector<EdgeType>>(num_edges);
-            GraphBLAS::mxv(*s, GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
+            s = GraphBLAS::Vector<EdgeType>(num_edges);
+            GraphBLAS::mxv(s, GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
                            Support2Semiring<EdgeType>(),
-                           *Rnew, OnesN, true);
-            //GraphBLAS::print_vector(std::cout, *s, "support");
+                           R, OnesN, true);
+            //GraphBLAS::print_vector(std::cout, s, "support");
 
             // 4. Determine edges which lack enough support for k-truss
-            x = std::make_shared<GraphBLAS::Vector<bool>>(num_edges);
-            GraphBLAS::apply(*x,
+            x = GraphBLAS::Vector<bool>(num_edges);
+            GraphBLAS::apply(x,
                              GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
                              SupportTest<EdgeType>(k_size - 2),
-                             *s, true);
-            //GraphBLAS::print_vector(std::cout, *x, "new x");
-            GraphBLAS::apply(*x, *x, GraphBLAS::NoAccumulate(),
+                             s, true);
+            //GraphBLAS::print_vector(std::cout, x, "new x");
+            GraphBLAS::apply(x, x, GraphBLAS::NoAccumulate(),
                              GraphBLAS::Identity<EdgeType>(),
-                             *x, true);
-            //GraphBLAS::print_vector(std::cout, *x, "new x (masked noop)");
+                             x, true);
+            //GraphBLAS::print_vector(std::cout, x, "new x (masked noop)");
         }
 
         // return incidence matrix containing all edges in k-trusses
-        return *E;
+        if (Ecur == &Ein)
+        {
+            return Ein;
+        }
+        return E;
     }
 
     //************************************************************************
@@ -0,0 +1,200 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+#include <bench/bench_harness.hpp>
+
+#include <algorithms/algorithms.hpp>
+#include <algorithms/apsp.hpp>
+#include <algorithms/k_truss.hpp>
+
+//****************************************************************************
+// Per-algorithm benchmarks on random undirected graphs of several sizes
+// and densities.  The cubic (or setElement bound) algorithms only run on
+// the smaller graphs.
+//****************************************************************************
+int main(int argc, char **argv)
+{
+    using GraphBLAS::IndexType;
+    typedef GraphBLAS::Matrix<double>    MatrixT;
+    typedef GraphBLAS::Matrix<IndexType> IndexMatrixT;
+
+    bench::Options opts(bench::parse_options(argc, argv));
+    bench::Harness harness("algorithms", opts);
+
+    for (IndexType base_n : {256UL, 1024UL, 4096UL})
+    {
+        for (IndexType degree : {4UL, 16UL})
+        {
+            IndexType n(bench::scaled(opts, base_n));
+            bench::Params params = {{"n", bench::to_string(n)},
+                                    {"degree", bench::to_string(degree)}};
+
+            // The same pattern, weighted and unweighted
+            MatrixT G(bench::random_matrix<MatrixT>(n, degree, 7, true));
+            IndexMatrixT Gi(bench::random_matrix<IndexMatrixT>(n, degree, 7,
+                                                               true));
+
+            // bfs.hpp
+            {
+                GraphBLAS::Vector<IndexType> wavefront(n), result(n);
+                auto reset = [&]() {
+                    wavefront.clear();
+                    wavefront.setElement(0, 1);
+                    result.clear();
+                };
+                harness.run("bfs", params, reset, [&]() {
+                        algorithms::bfs(Gi, wavefront, result);
+                    });
+                harness.run("bfs_level_masked", params, reset, [&]() {
+                        algorithms::bfs_level_masked(Gi, wavefront, result);
+                    });
+                harness.run("bfs_direction_optimizing", params, reset,
+                            [&]() {
+                                algorithms::bfs_direction_optimizing(
+                                    Gi, wavefront, result);
+                            });
+            }
+
+            // sssp.hpp and metrics.hpp
+            {
+                GraphBLAS::Vector<double> dist(n);
+                auto reset = [&]() {
+                    dist.clear();
+                    dist.setElement(0, 0.0);
+                };
+                harness.run("sssp", params, reset, [&]() {
+                        algorithms::sssp(G, dist);
+                    });
+                harness.run("sssp_delta_step", params, [&]() {
+                        GraphBLAS::Vector<double> paths(n);
+                        algorithms::sssp_delta_step(G, 4.0, 0, paths);
+                    });
+                harness.run("vertex_eccentricity", params, [&]() {
+                        algorithms::vertex_eccentricity(G, 0);
+                    });
+            }
+
+            // page_rank.hpp
+            {
+                GraphBLAS::Vector<double> rank(n);
+                harness.run("page_rank", params, [&]() {
+                        algorithms::page_rank(G, rank, 0.85, 1.e-5, 100);
+                    });
+            }
+
+            // triangle_count.hpp
+            {
+                IndexMatrixT L(n, n), U(n, n);
+                GraphBLAS::split(Gi, L, U);
+                harness.run("triangle_count_masked", params, [&]() {
+                        algorithms::triangle_count_masked(L);
+                    });
+            }
+
+            // mis.hpp and mst.hpp
+            {
+                GraphBLAS::Vector<bool> independent_set(n);
+                harness.run("mis", params,
+                            [&]() { independent_set.clear(); },
+                            [&]() {
+                                algorithms::mis(G, independent_set, 1.0);
+                            });
+
+                GraphBLAS::Vector<IndexType> parents(n);
+                harness.run("mst", params,
+                            [&]() { parents.clear(); },
+                            [&]() { algorithms::mst(G, parents); });
+            }
+
+            // bc.hpp
+            {
+                GraphBLAS::IndexArrayType sources;
+                for (IndexType ix = 0; ix < std::min<IndexType>(8, n); ++ix)
+                {
+                    sources.push_back(ix);
+                }
+                harness.run("vertex_betweenness_centrality_batch", params,
+                            [&]() {
+                                algorithms::vertex_betweenness_centrality_batch(
+                                    G, sources);
+                            });
+            }
+
+            // cluster.hpp
+            harness.run("peer_pressure_cluster", params, [&]() {
+                    algorithms::peer_pressure_cluster(G, 10);
+                });
+            if (base_n <= 1024)
+            {
+                harness.run("markov_cluster", params, [&]() {
+                        algorithms::markov_cluster(G, 2, 2, 5);
+                    });
+            }
+
+            // k_truss.hpp (edge x vertex incidence matrix)
+            if (base_n <= 1024)
+            {
+                GraphBLAS::IndexArrayType rows(G.nvals()), cols(G.nvals());
+                GraphBLAS::IndexArrayType edge_num, node_num;
+                std::vector<double> vals(G.nvals());
+                G.extractTuples(rows, cols, vals);
+                for (IndexType ix = 0; ix < rows.size(); ++ix)
+                {
+                    if (rows[ix] < cols[ix])
+                    {
+                        IndexType edge(edge_num.size()/2);
+                        edge_num.push_back(edge);
+                        node_num.push_back(rows[ix]);
+                        edge_num.push_back(edge);
+                        node_num.push_back(cols[ix]);
+                    }
+                }
+                IndexMatrixT E(edge_num.size()/2, n);
+                E.build(edge_num, node_num,
+                        std::vector<IndexType>(edge_num.size(), 1));
+                harness.run("k_truss", params, [&]() {
+                        algorithms::k_truss(E, 3);
+                    });
+            }
+
+            // maxflow.hpp and apsp.hpp
+            if (base_n <= 256)
+            {
+                harness.run("maxflow", params, [&]() {
+                        algorithms::maxflow(G, 0, n - 1);
+                    });
+                harness.run("apsp", params, [&]() {
+                        algorithms::apsp(G);
+                    });
+            }
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,375 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+#ifndef GB_BENCH_HARNESS_HPP
+#define GB_BENCH_HARNESS_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <graphblas/graphblas.hpp>
+
+//****************************************************************************
+/**
+ * Minimal, dependency free benchmark harness.  Every case is run
+ * 'warmup' times untimed and 'reps' times timed; the report lists the
+ * median, p95, min and mean (in milliseconds) of each case as JSON.
+ *
+ * Command line (shared by all bench_* executables):
+ *   --reps N       timed repetitions per case (default 5)
+ *   --warmup N     untimed runs per case (default 1)
+ *   --scale X      multiplies every problem size (default 1.0)
+ *   --filter S     only run cases whose name contains S
+ *   --json FILE    write the JSON report to FILE (default: bench_<suite>.json,
+ *                  "-" for stdout)
+ */
+namespace bench
+{
+    typedef std::vector<std::pair<std::string, std::string> > Params;
+
+    //************************************************************************
+    struct Options
+    {
+        Options() : reps(5), warmup(1), scale(1.0) {}
+
+        unsigned int reps;
+        unsigned int warmup;
+        double       scale;
+        std::string  filter;
+        std::string  json_path;
+    };
+
+    inline Options parse_options(int argc, char **argv)
+    {
+        Options opts;
+        for (int ix = 1; ix < argc; ++ix)
+        {
+            std::string arg(argv[ix]);
+            bool has_value(ix + 1 < argc);
+
+            if ((arg == "--reps") && has_value)
+                opts.reps = std::max(1, std::atoi(argv[++ix]));
+            else if ((arg == "--warmup") && has_value)
+                opts.warmup = std::max(0, std::atoi(argv[++ix]));
+            else if ((arg == "--scale") && has_value)
+                opts.scale = std::atof(argv[++ix]);
+            else if ((arg == "--filter") && has_value)
+                opts.filter = argv[++ix];
+            else if ((arg == "--json") && has_value)
+                opts.json_path = argv[++ix];
+            else
+            {
+                std::cerr << "Usage: " << argv[0]
+                          << " [--reps N] [--warmup N] [--scale X]"
+                          << " [--filter S] [--json FILE]" << std::endl;
+                std::exit(arg == "--help" ? 0 : 1);
+            }
+        }
+        return opts;
+    }
+
+    /// Problem size n scaled by the --scale option (at least 1).
+    inline GraphBLAS::IndexType scaled(Options const        &opts,
+                                       GraphBLAS::IndexType  n)
+    {
+        return std::max<GraphBLAS::IndexType>(
+            1, static_cast<GraphBLAS::IndexType>(n*opts.scale));
+    }
+
+    template <typename T>
+    std::string to_string(T const &val)
+    {
+        std::ostringstream oss;
+        oss << val;
+        return oss.str();
+    }
+
+    //************************************************************************
+    /// Nearest-rank percentile of an ascending sequence.
+    inline double percentile(std::vector<double> const &sorted, double pct)
+    {
+        if (sorted.empty()) return 0.0;
+        std::size_t rank = static_cast<std::size_t>(
+            pct/100.0*static_cast<double>(sorted.size()) + 0.999999);
+        rank = std::min(std::max<std::size_t>(rank, 1), sorted.size());
+        return sorted[rank - 1];
+    }
+
+    inline std::string json_escape(std::string const &str)
+    {
+        std::string out;
+        for (char c : str)
+        {
+            if ((c == '"') || (c == '\\')) out += '\\';
+            if (static_cast<unsigned char>(c) >= 0x20) out += c;
+        }
+        return out;
+    }
+
+    //************************************************************************
+    struct Result
+    {
+        std::string         name;
+        Params              params;
+        std::vector<double> times_ms;   // ascending
+    };
+
+    //************************************************************************
+    class Harness
+    {
+    public:
+        Harness(std::string const &suite, Options const &opts)
+            : m_suite(suite), m_opts(opts)
+        {
+            if (m_opts.json_path.empty())
+            {
+                m_opts.json_path = "bench_" + suite + ".json";
+            }
+        }
+
+        ~Harness() { report(); }
+
+        Options const &options() const { return m_opts; }
+
+        bool enabled(std::string const &name) const
+        {
+            return (m_opts.filter.empty() ||
+                    (name.find(m_opts.filter) != std::string::npos));
+        }
+
+        /**
+         * Time run() after an untimed setup() on every repetition (setup
+         * restores any state that run() consumes, e.g. an output matrix).
+         */
+        template <typename SetupT, typename RunT>
+        void run(std::string const &name, Params const &params,
+                 SetupT setup, RunT run)
+        {
+            if (!enabled(name)) return;
+
+            for (unsigned int ix = 0; ix < m_opts.warmup; ++ix)
+            {
+                setup();
+                run();
+            }
+
+            Result result;
+            result.name = name;
+            result.params = params;
+            for (unsigned int ix = 0; ix < m_opts.reps; ++ix)
+            {
+                setup();
+                auto start = std::chrono::steady_clock::now();
+                run();
+                auto stop = std::chrono::steady_clock::now();
+                result.times_ms.push_back(
+                    std::chrono::duration<double, std::milli>(
+                        stop - start).count());
+            }
+            std::sort(result.times_ms.begin(), result.times_ms.end());
+
+            std::cerr << std::left << std::setw(32) << name;
+            for (auto const &param : params)
+            {
+                std::cerr << " " << param.first << "=" << param.second;
+            }
+            std::cerr << "  median " << percentile(result.times_ms, 50)
+                      << " ms, p95 " << percentile(result.times_ms, 95)
+                      << " ms" << std::endl;
+
+            m_results.push_back(result);
+        }
+
+        template <typename RunT>
+        void run(std::string const &name, Params const &params, RunT run)
+        {
+            this->run(name, params, []() {}, run);
+        }
+
+        void report()
+        {
+            if (m_reported) return;
+            m_reported = true;
+
+            if (m_opts.json_path == "-")
+            {
+                write_json(std::cout);
+            }
+            else
+            {
+                std::ofstream ofs(m_opts.json_path);
+                write_json(ofs);
+            }
+        }
+
+        void write_json(std::ostream &os) const
+        {
+            os << "{\n  \"suite\": \"" << json_escape(m_suite) << "\",\n"
+#if defined(GB_USE_OPENMP)
+               << "  \"platform\": \"openmp\",\n"
+#else
+               << "  \"platform\": \"sequential\",\n"
+#endif
+               << "  \"warmup\": " << m_opts.warmup << ",\n"
+               << "  \"repetitions\": " << m_opts.reps << ",\n"
+               << "  \"scale\": " << m_opts.scale << ",\n"
+               << "  \"results\": [";
+
+            for (std::size_t ix = 0; ix < m_results.size(); ++ix)
+            {
+                Result const &res(m_results[ix]);
+                double sum(0.0);
+                for (double t : res.times_ms) sum += t;
+
+                os << (ix ? ",\n" : "\n") << "    {\"name\": \""
+                   << json_escape(res.name) << "\", \"params\": {";
+                for (std::size_t p = 0; p < res.params.size(); ++p)
+                {
+                    os << (p ? ", " : "") << "\""
+                       << json_escape(res.params[p].first) << "\": \""
+                       << json_escape(res.params[p].second) << "\"";
+                }
+                os << "},\n     \"median_ms\": "
+                   << percentile(res.times_ms, 50)
+                   << ", \"p95_ms\": " << percentile(res.times_ms, 95)
+                   << ", \"min_ms\": " << res.times_ms.front()
+                   << ", \"mean_ms\": " << sum/res.times_ms.size()
+                   << ",\n     \"times_ms\": [";
+                for (std::size_t t = 0; t < res.times_ms.size(); ++t)
+                {
+                    os << (t ? ", " : "") << res.times_ms[t];
+                }
+                os << "]}";
+            }
+            os << "\n  ]\n}" << std::endl;
+        }
+
+    private:
+        std::string          m_suite;
+        Options              m_opts;
+        std::vector<Result>  m_results;
+        bool                 m_reported = false;
+    };
+
+    //************************************************************************
+    /// splitmix64: small, fast and identical on every platform.
+    class Random
+    {
+    public:
+        Random(uint64_t seed) : m_state(seed) {}
+
+        uint64_t next()
+        {
+            uint64_t z = (m_state += 0x9E3779B97F4A7C15ULL);
+            z = (z ^ (z >> 30))*0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27))*0x94D049BB133111EBULL;
+            return z ^ (z >> 31);
+        }
+
+        GraphBLAS::IndexType below(GraphBLAS::IndexType bound)
+        {
+            return static_cast<GraphBLAS::IndexType>(next() % bound);
+        }
+
+    private:
+        uint64_t m_state;
+    };
+
+    //************************************************************************
+    /**
+     * Uniform random (Erdos-Renyi style) n x n matrix with about 'degree'
+     * stored values per row, values in [1, 9].  With 'symmetric' set, every
+     * edge is stored in both directions, there are no self loops and a ring
+     * (i, i+1) keeps the graph connected.
+     */
+    template <typename MatrixT>
+    MatrixT random_matrix(GraphBLAS::IndexType n,
+                          GraphBLAS::IndexType degree,
+                          uint64_t             seed,
+                          bool                 symmetric = false)
+    {
+        typedef typename MatrixT::ScalarType T;
+        Random rng(seed);
+        GraphBLAS::IndexArrayType rows, cols;
+        std::vector<T> vals;
+
+        GraphBLAS::IndexType num_edges(symmetric ? n*degree/2 : n*degree);
+        for (GraphBLAS::IndexType ix = 0; ix < num_edges; ++ix)
+        {
+            GraphBLAS::IndexType i(rng.below(n)), j(rng.below(n));
+            T val(static_cast<T>(1 + rng.below(9)));
+            if (symmetric)
+            {
+                if (i == j) continue;
+                rows.push_back(j); cols.push_back(i); vals.push_back(val);
+            }
+            rows.push_back(i); cols.push_back(j); vals.push_back(val);
+        }
+
+        for (GraphBLAS::IndexType i = 0; symmetric && (i + 1 < n); ++i)
+        {
+            T val(static_cast<T>(1 + rng.below(9)));
+            rows.push_back(i);     cols.push_back(i + 1); vals.push_back(val);
+            rows.push_back(i + 1); cols.push_back(i);     vals.push_back(val);
+        }
+
+        MatrixT A(n, n);
+        A.build(rows, cols, vals);
+        return A;
+    }
+
+    /// Dense n-vector filled with 'val' at every 'stride'-th index.
+    template <typename VectorT>
+    VectorT strided_vector(GraphBLAS::IndexType            n,
+                           GraphBLAS::IndexType            stride,
+                           typename VectorT::ScalarType    val)
+    {
+        GraphBLAS::IndexArrayType idx;
+        std::vector<typename VectorT::ScalarType> vals;
+        for (GraphBLAS::IndexType ix = 0; ix < n; ix += stride)
+        {
+            idx.push_back(ix);
+            vals.push_back(val);
+        }
+        VectorT v(n);
+        v.build(idx, vals);
+        return v;
+    }
+}
+
+#endif // GB_BENCH_HARNESS_HPP
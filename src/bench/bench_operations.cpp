@@ -0,0 +1,251 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+#include <cstdio>
+
+#include <bench/bench_harness.hpp>
+
+//****************************************************************************
+// Per-operation microbenchmarks: the graph generators, then one case per
+// backend primitive over several sizes and densities (average stored
+// values per row).
+//****************************************************************************
+int main(int argc, char **argv)
+{
+    using GraphBLAS::IndexType;
+    typedef GraphBLAS::Matrix<double> MatrixT;
+    typedef GraphBLAS::Vector<double> VectorT;
+
+    bench::Options opts(bench::parse_options(argc, argv));
+    bench::Harness harness("operations", opts);
+
+    // Graph generators (graph_generators.hpp)
+    for (unsigned int base_scale : {14U, 16U, 18U})
+    {
+        unsigned int scale(base_scale);
+        while ((scale > 1) &&
+               (bench::scaled(opts, 1UL << base_scale) < (1UL << scale)))
+        {
+            --scale;
+        }
+        IndexType side(IndexType(1) << (scale/2));
+        bench::Params params = {{"scale", bench::to_string(scale)}};
+
+        harness.run("generate_rmat", params, [&]() {
+                GraphBLAS::rmat<GraphBLAS::Matrix<bool> >(scale, 16, 1);
+            });
+        harness.run("generate_uniform", params, [&]() {
+                GraphBLAS::uniform_random_graph<GraphBLAS::Matrix<bool> >(
+                    IndexType(1) << scale, 16*(IndexType(1) << scale), 1);
+            });
+        harness.run("generate_grid_2d", params, [&]() {
+                GraphBLAS::grid_2d<GraphBLAS::Matrix<bool> >(side, side);
+            });
+
+        // Graph files (matrix_io.hpp, binary_csr.hpp)
+        {
+            typedef GraphBLAS::Matrix<double, GraphBLAS::CsrStorageTag> CsrT;
+            MatrixT G(GraphBLAS::rmat<MatrixT>(scale, 16, 1));
+            std::string const mtx("bench_operations_io.mtx");
+            std::string const tsv("bench_operations_io.tsv");
+            std::string const bin("bench_operations_io.gbcsr");
+
+            GraphBLAS::write_matrix_market(mtx, G);
+            GraphBLAS::write_edge_list(tsv, G, '\t', false);
+            GraphBLAS::write_binary_csr(bin, G);
+
+            harness.run("write_matrix_market", params, [&]() {
+                    GraphBLAS::write_matrix_market(mtx, G);
+                });
+            harness.run("read_matrix_market", params, [&]() {
+                    GraphBLAS::read_matrix_market<MatrixT>(mtx);
+                });
+            harness.run("read_edge_list", params, [&]() {
+                    GraphBLAS::read_edge_list<MatrixT>(tsv, G.nrows());
+                });
+            harness.run("read_binary_csr", params, [&]() {
+                    GraphBLAS::read_binary_csr<CsrT>(bin);
+                });
+
+            std::remove(mtx.c_str());
+            std::remove(tsv.c_str());
+            std::remove(bin.c_str());
+        }
+    }
+
+    for (IndexType base_n : {1024UL, 4096UL, 16384UL})
+    {
+        for (IndexType degree : {4UL, 16UL})
+        {
+            IndexType n(bench::scaled(opts, base_n));
+            bench::Params params = {{"n", bench::to_string(n)},
+                                    {"degree", bench::to_string(degree)}};
+
+            MatrixT A(bench::random_matrix<MatrixT>(n, degree, 1));
+            MatrixT B(bench::random_matrix<MatrixT>(n, degree, 2));
+            VectorT u_dense(bench::strided_vector<VectorT>(n, 1, 1.0));
+            VectorT u_sparse(bench::strided_vector<VectorT>(n, 97, 1.0));
+
+            // build (from unsorted tuples with duplicates)
+            {
+                bench::Random rng(3);
+                GraphBLAS::IndexArrayType rows, cols;
+                std::vector<double> vals;
+                for (IndexType ix = 0; ix < n*degree; ++ix)
+                {
+                    rows.push_back(rng.below(n));
+                    cols.push_back(rng.below(n));
+                    vals.push_back(1.0);
+                }
+                harness.run("build", params, [&]() {
+                        MatrixT C(n, n);
+                        C.build(rows, cols, vals, GraphBLAS::Plus<double>());
+                    });
+            }
+
+            // mxm: plain and masked by the pattern of A
+            if (base_n <= 4096)
+            {
+                MatrixT C(n, n);
+                harness.run("mxm", params, [&]() {
+                        GraphBLAS::mxm(C, GraphBLAS::NoMask(),
+                                       GraphBLAS::NoAccumulate(),
+                                       GraphBLAS::ArithmeticSemiring<double>(),
+                                       A, B);
+                    });
+            }
+            {
+                MatrixT C(n, n);
+                harness.run("mxm_masked", params, [&]() {
+                        GraphBLAS::mxm(C, A, GraphBLAS::NoAccumulate(),
+                                       GraphBLAS::ArithmeticSemiring<double>(),
+                                       A, B, true);
+                    });
+            }
+
+            // mxv / vxm with dense and sparse inputs
+            {
+                VectorT w(n);
+                harness.run("mxv_dense", params, [&]() {
+                        GraphBLAS::mxv(w, GraphBLAS::NoMask(),
+                                       GraphBLAS::NoAccumulate(),
+                                       GraphBLAS::ArithmeticSemiring<double>(),
+                                       A, u_dense);
+                    });
+                harness.run("vxm_dense", params, [&]() {
+                        GraphBLAS::vxm(w, GraphBLAS::NoMask(),
+                                       GraphBLAS::NoAccumulate(),
+                                       GraphBLAS::ArithmeticSemiring<double>(),
+                                       u_dense, A);
+                    });
+                harness.run("vxm_sparse", params, [&]() {
+                        GraphBLAS::vxm(w, GraphBLAS::NoMask(),
+                                       GraphBLAS::NoAccumulate(),
+                                       GraphBLAS::ArithmeticSemiring<double>(),
+                                       u_sparse, A);
+                    });
+                harness.run("vxm_sparse_complement_mask", params, [&]() {
+                        GraphBLAS::vxm(w, GraphBLAS::complement(u_sparse),
+                                       GraphBLAS::NoAccumulate(),
+                                       GraphBLAS::ArithmeticSemiring<double>(),
+                                       u_sparse, A, true);
+                    });
+            }
+
+            // element-wise
+            {
+                MatrixT C(n, n);
+                harness.run("eWiseAdd", params, [&]() {
+                        GraphBLAS::eWiseAdd(C, GraphBLAS::NoMask(),
+                                            GraphBLAS::NoAccumulate(),
+                                            GraphBLAS::Plus<double>(), A, B);
+                    });
+                harness.run("eWiseMult", params, [&]() {
+                        GraphBLAS::eWiseMult(C, GraphBLAS::NoMask(),
+                                             GraphBLAS::NoAccumulate(),
+                                             GraphBLAS::Times<double>(), A, B);
+                    });
+            }
+
+            // extract and assign every other row/column
+            {
+                GraphBLAS::IndexArrayType half;
+                for (IndexType ix = 0; ix < n; ix += 2) half.push_back(ix);
+                IndexType h(half.size());
+
+                MatrixT S(h, h);
+                harness.run("extract", params, [&]() {
+                        GraphBLAS::extract(S, GraphBLAS::NoMask(),
+                                           GraphBLAS::NoAccumulate(),
+                                           A, half, half);
+                    });
+
+                MatrixT C(n, n);
+                harness.run("assign", params,
+                            [&]() { C = A; },
+                            [&]() {
+                                GraphBLAS::assign(C, GraphBLAS::NoMask(),
+                                                  GraphBLAS::NoAccumulate(),
+                                                  S, half, half);
+                            });
+            }
+
+            // apply, reduce and transpose
+            {
+                MatrixT C(n, n);
+                harness.run("apply", params, [&]() {
+                        GraphBLAS::apply(C, GraphBLAS::NoMask(),
+                                         GraphBLAS::NoAccumulate(),
+                                         GraphBLAS::AdditiveInverse<double>(),
+                                         A);
+                    });
+
+                VectorT w(n);
+                harness.run("reduce_rows", params, [&]() {
+                        GraphBLAS::reduce(w, GraphBLAS::NoMask(),
+                                          GraphBLAS::NoAccumulate(),
+                                          GraphBLAS::PlusMonoid<double>(), A);
+                    });
+
+                double sum(0.0);
+                harness.run("reduce_scalar", params, [&]() {
+                        GraphBLAS::reduce(sum, GraphBLAS::NoAccumulate(),
+                                          GraphBLAS::PlusMonoid<double>(), A);
+                    });
+
+                harness.run("transpose", params, [&]() {
+                        GraphBLAS::transpose(C, GraphBLAS::NoMask(),
+                                             GraphBLAS::NoAccumulate(), A);
+                    });
+            }
+        }
+    }
+
+    return 0;
+}
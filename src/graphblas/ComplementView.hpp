@@ -267,6 +267,20 @@ namespace GraphBLAS
             AMatrixT                                  const  &A,
             bool                                              replace_flag);
 
+        template<typename CScalarT,
+                 typename MaskT,
+                 typename AccumT,
+                 typename IndexUnaryOpT,
+                 typename AMatrixT,
+                 typename ...ATagsT>
+        friend inline void select(
+            GraphBLAS::Matrix<CScalarT, ATagsT...>           &C,
+            MaskT                                     const  &Mask,
+            AccumT                                            accum,
+            IndexUnaryOpT                                     op,
+            AMatrixT                                  const  &A,
+            bool                                              replace_flag);
+
         //--------------------------------------------------------------------
 
         // 4.3.10
@@ -557,6 +571,19 @@ namespace GraphBLAS
                                  UVectorT                         const &u,
                                  bool                                    replace_flag);
 
+        template<typename WScalarT,
+                 typename MaskT,
+                 typename AccumT,
+                 typename IndexUnaryOpT,
+                 typename UVectorT,
+                 typename ...WTagsT>
+        friend inline void select(GraphBLAS::Vector<WScalarT, WTagsT...> &w,
+                                  MaskT                            const &mask,
+                                  AccumT                                  accum,
+                                  IndexUnaryOpT                           op,
+                                  UVectorT                         const &u,
+                                  bool                                    replace_flag);
+
         //--------------------------------------------------------------------
 
         // 4.3.9.1
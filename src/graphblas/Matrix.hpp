@@ -31,6 +31,7 @@
 
 #include <cstddef>
 #include <type_traits>
+#include <utility>
 #include <graphblas/detail/config.hpp>
 #include <graphblas/detail/param_unpack.hpp>
 
@@ -78,6 +79,8 @@ namespace GraphBLAS
             ScalarT,
             detail::SparsenessCategoryTag,
             detail::DirectednessCategoryTag,
+            detail::StorageCategoryTag,
+            detail::ColumnIndexCategoryTag,
             TagsT... ,
             detail::NullTag,
             detail::NullTag >::type BackendType;
@@ -106,6 +109,17 @@ namespace GraphBLAS
         {
         }
 
+        /**
+         * @brief Move constructor: takes over the contents of rhs in O(1).
+         *
+         * @param[in] rhs   The matrix to move from; it is left empty with
+         *                  no rows or columns (assign to it before reuse).
+         */
+        Matrix(Matrix<ScalarT, TagsT...> &&rhs)
+            : m_mat(std::move(rhs.m_mat))
+        {
+        }
+
         /**
          * @brief Construct a dense matrix from dense data
          *
@@ -148,6 +162,27 @@ namespace GraphBLAS
             return *this;
         }
 
+        /**
+         * @brief Move assignment: takes over the contents and the shape of
+         *        rhs in O(1), so a result computed elsewhere can replace
+         *        this matrix.  rhs is left empty.
+         */
+        Matrix<ScalarT, TagsT...> &
+        operator=(Matrix<ScalarT, TagsT...> &&rhs)
+        {
+            if (this != &rhs)
+            {
+                m_mat = std::move(rhs.m_mat);
+            }
+            return *this;
+        }
+
+        /// Exchange contents and shape with rhs in O(1).
+        void swap(Matrix<ScalarT, TagsT...> &rhs)
+        {
+            m_mat.swap(rhs.m_mat);
+        }
+
 
         /// @todo need to change to mix and match internal types
         bool operator==(Matrix<ScalarT, TagsT...> const &rhs) const
@@ -479,6 +514,20 @@ namespace GraphBLAS
                 AMatrixT                                const   &A,
                 bool                                             replace_flag);
 
+        template<typename CScalarT,
+                 typename MaskT,
+                 typename AccumT,
+                 typename IndexUnaryOpT,
+                 typename AMatrixT,
+                 typename... ATagsT>
+        friend inline void select(
+                GraphBLAS::Matrix<CScalarT, ATagsT...>          &C,
+                MaskT                                   const   &Mask,
+                AccumT                                           accum,
+                IndexUnaryOpT                                    op,
+                AMatrixT                                const   &A,
+                bool                                             replace_flag);
+
         //--------------------------------------------------------------------
 
         // 4.3.9.1
@@ -535,6 +584,14 @@ namespace GraphBLAS
 
         // .... ADD OTHER OPERATIONS AS FRIENDS AS THEY ARE IMPLEMENTED .....
 
+        template<typename MatrixT>
+        friend void write_binary_csr(std::string const &path,
+                                     MatrixT const     &A);
+
+        template<typename MatrixT>
+        friend MatrixT read_binary_csr(std::string const &path,
+                                       bool               trust_file);
+
         template <typename MatrixT>
         friend void print_matrix(std::ostream      &ostr,
                                  MatrixT const     &mat,
@@ -593,4 +650,11 @@ namespace GraphBLAS
         return os;
     }
 
+    /// Exchange the contents of two matrices in O(1).
+    template<typename ScalarT, typename... TagsT>
+    void swap(Matrix<ScalarT, TagsT...> &lhs, Matrix<ScalarT, TagsT...> &rhs)
+    {
+        lhs.swap(rhs);
+    }
+
 } // end namespace GraphBLAS
@@ -322,6 +322,19 @@ namespace GraphBLAS
                                  AMatrixT              const &A,
                                  bool                         replace_flag);
 
+        template<typename CScalarT,
+                 typename MaskT,
+                 typename AccumT,
+                 typename IndexUnaryOpT,
+                 typename AMatrixT,
+                 typename ...ATagsT>
+        friend inline void select(Matrix<CScalarT, ATagsT...> &C,
+                                  MaskT                 const &Mask,
+                                  AccumT                       accum,
+                                  IndexUnaryOpT                op,
+                                  AMatrixT              const &A,
+                                  bool                         replace_flag);
+
         //--------------------------------------------------------------------
 
         template<typename WVectorT,
@@ -31,6 +31,7 @@
 
 #include <cstddef>
 #include <type_traits>
+#include <utility>
 #include <graphblas/detail/config.hpp>
 #include <graphblas/detail/param_unpack.hpp>
 
@@ -103,6 +104,21 @@ namespace GraphBLAS
             : m_vec(values, zero)
         {
         }
+
+        /// Copy constructor.
+        Vector(Vector<ScalarT, TagsT...> const &rhs)
+            : m_vec(rhs.m_vec)
+        {
+        }
+
+        /**
+         * @brief Move constructor: takes over the contents of rhs in O(1).
+         *        rhs is left with size 0 (assign to it before reuse).
+         */
+        Vector(Vector<ScalarT, TagsT...> &&rhs)
+            : m_vec(std::move(rhs.m_vec))
+        {
+        }
         /// Destructor
         ~Vector() { }
 
@@ -114,7 +130,7 @@ namespace GraphBLAS
          * @todo Should assignment work only if dimensions are same?
          * @note This clears any previous information
          */
-        Vector<ScalarT, TagsT...>
+        Vector<ScalarT, TagsT...> &
         operator=(Vector<ScalarT, TagsT...> const &rhs)
         {
             if (this != &rhs)
@@ -124,6 +140,26 @@ namespace GraphBLAS
             return *this;
         }
 
+        /**
+         * @brief Move assignment: takes over the contents and the size of
+         *        rhs in O(1).  rhs is left empty.
+         */
+        Vector<ScalarT, TagsT...> &
+        operator=(Vector<ScalarT, TagsT...> &&rhs)
+        {
+            if (this != &rhs)
+            {
+                m_vec = std::move(rhs.m_vec);
+            }
+            return *this;
+        }
+
+        /// Exchange contents and size with rhs in O(1).
+        void swap(Vector<ScalarT, TagsT...> &rhs)
+        {
+            m_vec.swap(rhs.m_vec);
+        }
+
         /**
          * @brief Assignment from dense data
          *
@@ -432,6 +468,20 @@ namespace GraphBLAS
             UVectorT                         const &u,
             bool                                    replace_flag);
 
+        template<typename WScalarT,
+                 typename MaskT,
+                 typename AccumT,
+                 typename IndexUnaryOpT,
+                 typename UVectorT,
+                 typename ...WTagsT>
+        friend inline void select(
+            GraphBLAS::Vector<WScalarT, WTagsT...> &w,
+            MaskT                            const &mask,
+            AccumT                                  accum,
+            IndexUnaryOpT                           op,
+            UVectorT                         const &u,
+            bool                                    replace_flag);
+
         // 4.3.9.1
         template<typename WVectorT,
                  typename MaskT,
@@ -499,4 +549,11 @@ namespace GraphBLAS
         return os;
     }
 
+    /// Exchange the contents of two vectors in O(1).
+    template<typename ScalarT, typename... TagsT>
+    void swap(Vector<ScalarT, TagsT...> &lhs, Vector<ScalarT, TagsT...> &rhs)
+    {
+        lhs.swap(rhs);
+    }
+
 } // end namespace GraphBLAS
@@ -34,7 +34,9 @@
 #include <algorithm>
 #include <functional>
 #include <limits>
+#include <type_traits>
 #include <utility>
+#include <graphblas/types.hpp>
 
 namespace GraphBLAS
 {
@@ -98,6 +100,127 @@ namespace GraphBLAS
     };
 }
 
+namespace GraphBLAS
+{
+    //************************************************************************
+    // The Index Unary Operators
+    //************************************************************************
+
+    /**
+     * Operators called as op(value, i, j) with the position of the stored
+     * value: row and column for a matrix, (index, 0) for a vector.  apply()
+     * stores the result; select() keeps the entries for which it is true.
+     * Any bound constant (offset, diagonal) is held by the operator.
+     */
+    struct IndexUnaryOp
+    {
+    };
+
+    /// True for operators derived from IndexUnaryOp
+    template <typename OpT>
+    struct is_index_unary_op
+        : std::integral_constant<bool,
+                                 std::is_base_of<IndexUnaryOp, OpT>::value>
+    {
+    };
+
+    /// i + offset (e.g., a 1-based vertex id with offset 1)
+    template <typename D1, typename D3 = IndexType>
+    struct RowIndex : IndexUnaryOp
+    {
+        typedef D1 ValueType;
+        typedef D3 result_type;
+        D3 offset;
+
+        RowIndex(D3 const &offset = D3(0)) : offset(offset) {}
+
+        inline D3 operator()(D1 const &, IndexType i, IndexType) const
+        {
+            return static_cast<D3>(i) + offset;
+        }
+    };
+
+    /// j + offset
+    template <typename D1, typename D3 = IndexType>
+    struct ColIndex : IndexUnaryOp
+    {
+        typedef D1 ValueType;
+        typedef D3 result_type;
+        D3 offset;
+
+        ColIndex(D3 const &offset = D3(0)) : offset(offset) {}
+
+        inline D3 operator()(D1 const &, IndexType, IndexType j) const
+        {
+            return static_cast<D3>(j) + offset;
+        }
+    };
+
+    /// On or below diagonal k (j <= i + k)
+    template <typename D1>
+    struct TriL : IndexUnaryOp
+    {
+        typedef D1 ValueType;
+        typedef bool result_type;
+        int64_t k;
+
+        TriL(int64_t k = 0) : k(k) {}
+
+        inline bool operator()(D1 const &, IndexType i, IndexType j) const
+        {
+            return static_cast<int64_t>(j) <= static_cast<int64_t>(i) + k;
+        }
+    };
+
+    /// On or above diagonal k (j >= i + k)
+    template <typename D1>
+    struct TriU : IndexUnaryOp
+    {
+        typedef D1 ValueType;
+        typedef bool result_type;
+        int64_t k;
+
+        TriU(int64_t k = 0) : k(k) {}
+
+        inline bool operator()(D1 const &, IndexType i, IndexType j) const
+        {
+            return static_cast<int64_t>(j) >= static_cast<int64_t>(i) + k;
+        }
+    };
+
+    /// On diagonal k (j == i + k)
+    template <typename D1>
+    struct Diag : IndexUnaryOp
+    {
+        typedef D1 ValueType;
+        typedef bool result_type;
+        int64_t k;
+
+        Diag(int64_t k = 0) : k(k) {}
+
+        inline bool operator()(D1 const &, IndexType i, IndexType j) const
+        {
+            return static_cast<int64_t>(j) == static_cast<int64_t>(i) + k;
+        }
+    };
+
+    /// Off diagonal k (j != i + k)
+    template <typename D1>
+    struct OffDiag : IndexUnaryOp
+    {
+        typedef D1 ValueType;
+        typedef bool result_type;
+        int64_t k;
+
+        OffDiag(int64_t k = 0) : k(k) {}
+
+        inline bool operator()(D1 const &, IndexType i, IndexType j) const
+        {
+            return static_cast<int64_t>(j) != static_cast<int64_t>(i) + k;
+        }
+    };
+}
+
 namespace GraphBLAS
 {
     //************************************************************************
@@ -208,6 +331,18 @@ namespace GraphBLAS
         inline D3 operator()(D1 lhs, D2 rhs) { return rhs; }
     };
 
+    /// Returns one without reading either operand (ONEB); for semirings
+    /// that only depend on the structure of their inputs.
+    template<typename D1, typename D2 = D1, typename D3 = D1>
+    struct Pair
+    {
+        typedef D1 lhs_type;
+        typedef D2 rhs_type;
+        typedef D3 result_type;
+        inline D3 operator()(D1 const &, D2 const &)
+        { return static_cast<D3>(1); }
+    };
+
     template<typename D1, typename D2 = D1, typename D3 = D1>
     struct Min
     {
@@ -289,38 +424,75 @@ typedef GraphBLAS::LogicalXor<bool>   GrB_LXOR;
 // Monoids
 //****************************************************************************
 
-#define GEN_GRAPHBLAS_MONOID(M_NAME, BINARYOP, IDENTITY)        \
-    template <typename ScalarT>                                 \
-    struct M_NAME                                               \
-    {                                                           \
-    public:                                                     \
-        typedef ScalarT lhs_type;                               \
-        typedef ScalarT rhs_type;                               \
-        typedef ScalarT ScalarType;                             \
-        typedef ScalarT result_type;                            \
-                                                                \
-        ScalarT identity() const                                \
-        {                                                       \
-            return static_cast<ScalarT>(IDENTITY);              \
-        }                                                       \
-                                                                \
-        ScalarT operator()(ScalarT lhs, ScalarT rhs) const      \
-        {                                                       \
-            return BINARYOP<ScalarT>()(lhs, rhs);               \
-        }                                                       \
+/**
+ * The macro for building monoid objects with a terminal value
+ *
+ * A terminal (annihilator) value t satisfies op(t, x) == t for every x, so
+ * a reduction that reaches it can stop.  HAS_TERMINAL may depend on
+ * ScalarT; TERMINAL is ignored when it is false.
+ */
+#define GEN_GRAPHBLAS_MONOID_TERMINAL(M_NAME, BINARYOP, IDENTITY,       \
+                                      HAS_TERMINAL, TERMINAL)           \
+    template <typename ScalarT>                                         \
+    struct M_NAME                                                       \
+    {                                                                   \
+    public:                                                             \
+        typedef ScalarT lhs_type;                                       \
+        typedef ScalarT rhs_type;                                       \
+        typedef ScalarT ScalarType;                                     \
+        typedef ScalarT result_type;                                    \
+                                                                        \
+        static const bool has_terminal = HAS_TERMINAL;                  \
+                                                                        \
+        ScalarT identity() const                                        \
+        {                                                               \
+            return static_cast<ScalarT>(IDENTITY);                      \
+        }                                                               \
+                                                                        \
+        ScalarT terminal() const                                        \
+        {                                                               \
+            return static_cast<ScalarT>(TERMINAL);                      \
+        }                                                               \
+                                                                        \
+        ScalarT operator()(ScalarT lhs, ScalarT rhs) const              \
+        {                                                               \
+            return BINARYOP<ScalarT>()(lhs, rhs);                       \
+        }                                                               \
     };
 
+/// Monoid without a terminal value
+#define GEN_GRAPHBLAS_MONOID(M_NAME, BINARYOP, IDENTITY)                \
+    GEN_GRAPHBLAS_MONOID_TERMINAL(M_NAME, BINARYOP, IDENTITY, false, IDENTITY)
+
 namespace GraphBLAS
 {
     GEN_GRAPHBLAS_MONOID(PlusMonoid, Plus, 0)
-    GEN_GRAPHBLAS_MONOID(TimesMonoid, Times, 1)
-    GEN_GRAPHBLAS_MONOID(MinMonoid, Min, std::numeric_limits<ScalarT>::max())
+
+    /// 0 only annihilates integers (0 * inf is NaN)
+    GEN_GRAPHBLAS_MONOID_TERMINAL(TimesMonoid, Times, 1,
+                                  std::is_integral<ScalarT>::value, 0)
+
+    /// The lowest value is only reachable (not -inf or NaN) for integers
+    GEN_GRAPHBLAS_MONOID_TERMINAL(MinMonoid, Min,
+                                  std::numeric_limits<ScalarT>::max(),
+                                  std::is_integral<ScalarT>::value,
+                                  std::numeric_limits<ScalarT>::lowest())
 
     /// @todo The following identity only works for unsigned domains
     /// std::numerical_limits<>::min() does not work for floating point types
-    GEN_GRAPHBLAS_MONOID(MaxMonoid, Max, 0)
-
-    GEN_GRAPHBLAS_MONOID(LogicalOrMonoid, LogicalOr, false)
+    GEN_GRAPHBLAS_MONOID_TERMINAL(MaxMonoid, Max, 0,
+                                  std::is_integral<ScalarT>::value,
+                                  std::numeric_limits<ScalarT>::max())
+
+    GEN_GRAPHBLAS_MONOID_TERMINAL(LogicalOrMonoid, LogicalOr, false,
+                                  true, true)
+    GEN_GRAPHBLAS_MONOID_TERMINAL(LogicalAndMonoid, LogicalAnd, true,
+                                  true, false)
+
+    /// Any of its operands is a valid result, so a reduction may stop at
+    /// the first value it sees (see is_any_monoid).  Keeps the latest
+    /// operand so that identity() (+) x == x.
+    GEN_GRAPHBLAS_MONOID(AnyMonoid, Second, 0)
 } // GraphBLAS
 
 //****************************************************************************
@@ -343,6 +515,8 @@ namespace GraphBLAS
         typedef D2 rhs_type;                                            \
         typedef D3 ScalarType;                                          \
         typedef D3 result_type;                                         \
+        typedef ADD_MONOID<D3> add_monoid_type;                         \
+        typedef MULT_BINARYOP<D1,D2,D3> mult_op_type;                   \
                                                                         \
         D3 add(D3 a, D3 b) const                                        \
         { return ADD_MONOID<D3>()(a, b); }                              \
@@ -352,6 +526,11 @@ namespace GraphBLAS
                                                                         \
         ScalarType zero() const                                         \
         { return ADD_MONOID<D3>().identity(); }                         \
+                                                                        \
+        static const bool has_terminal = ADD_MONOID<D3>::has_terminal;  \
+                                                                        \
+        ScalarType terminal() const                                     \
+        { return ADD_MONOID<D3>().terminal(); }                         \
     };
 
 
@@ -373,6 +552,83 @@ namespace GraphBLAS
 
     GEN_GRAPHBLAS_SEMIRING(MinSelect1stSemiring, MinMonoid, First)
     GEN_GRAPHBLAS_SEMIRING(MaxSelect1stSemiring, MaxMonoid, First)
+
+    /// Structure-only semirings: the product of two stored values is 1.
+    /// AnyPair is reachability (one hit per output suffices), PlusPair
+    /// counts the common entries (e.g., triangles, common neighbors).
+    GEN_GRAPHBLAS_SEMIRING(AnyPairSemiring, AnyMonoid, Pair)
+    GEN_GRAPHBLAS_SEMIRING(PlusPairSemiring, PlusMonoid, Pair)
+
+    /// Pick any one of the candidate values (e.g., any parent in a BFS)
+    GEN_GRAPHBLAS_SEMIRING(AnySelect1stSemiring, AnyMonoid, First)
+    GEN_GRAPHBLAS_SEMIRING(AnySelect2ndSemiring, AnyMonoid, Second)
+} // namespace GraphBLAS
+
+//****************************************************************************
+// Terminal values
+//****************************************************************************
+
+namespace GraphBLAS
+{
+    namespace detail
+    {
+        template <typename T>
+        struct void_type
+        {
+            typedef void type;
+        };
+    }
+
+    /// True when a monoid or semiring declares a terminal value for its
+    /// addition; operators without a has_terminal member have none.
+    template <typename OpT, typename EnableT = void>
+    struct has_terminal_value : std::false_type
+    {
+    };
+
+    template <typename OpT>
+    struct has_terminal_value<
+        OpT, typename detail::void_type<decltype(OpT::has_terminal)>::type>
+        : std::integral_constant<bool, OpT::has_terminal>
+    {
+    };
+
+    /// True for the Any monoid, and for semirings whose addition is Any.
+    template <typename OpT, typename EnableT = void>
+    struct is_any_monoid : std::false_type
+    {
+    };
+
+    template <typename ScalarT>
+    struct is_any_monoid<AnyMonoid<ScalarT>, void> : std::true_type
+    {
+    };
+
+    template <typename OpT>
+    struct is_any_monoid<
+        OpT, typename detail::void_type<typename OpT::add_monoid_type>::type>
+        : is_any_monoid<typename OpT::add_monoid_type>
+    {
+    };
+
+    /// True for the Pair operator, and for semirings that multiply with it:
+    /// the product does not depend on the operand values.
+    template <typename OpT, typename EnableT = void>
+    struct is_pair_op : std::false_type
+    {
+    };
+
+    template <typename D1, typename D2, typename D3>
+    struct is_pair_op<Pair<D1, D2, D3>, void> : std::true_type
+    {
+    };
+
+    template <typename OpT>
+    struct is_pair_op<
+        OpT, typename detail::void_type<typename OpT::mult_op_type>::type>
+        : is_pair_op<typename OpT::mult_op_type>
+    {
+    };
 } // namespace GraphBLAS
 
 //****************************************************************************
@@ -419,6 +675,13 @@ namespace GraphBLAS
             return sr.zero();
         }
 
+        static const bool has_terminal = has_terminal_value<SemiringT>::value;
+
+        ScalarType terminal() const
+        {
+            return sr.terminal();
+        }
+
         ScalarType operator() (ScalarType lhs, ScalarType rhs) const
         {
             return sr.add(lhs, rhs);
@@ -428,6 +691,18 @@ namespace GraphBLAS
         SemiringT sr;
     };
 
+    template <typename SemiringT>
+    struct is_pair_op<MultiplicativeOpFromSemiring<SemiringT>, void>
+        : is_pair_op<SemiringT>
+    {
+    };
+
+    template <typename SemiringT>
+    struct is_any_monoid<AdditiveMonoidFromSemiring<SemiringT>, void>
+        : is_any_monoid<SemiringT>
+    {
+    };
+
     //************************************************************************
     template <typename SemiringT>
     MultiplicativeOpFromSemiring<SemiringT>
@@ -0,0 +1,91 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+#ifndef GB_BINARY_CSR_HPP
+#define GB_BINARY_CSR_HPP
+
+#include <string>
+
+#include <graphblas/Matrix.hpp>
+#include <graphblas/operations.hpp>
+
+//****************************************************************************
+// Binary CSR graph files (see platforms/sequential/binary_csr.hpp for the
+// layout).  A file written once can be loaded many times at the cost of a
+// mmap: a matrix tagged CsrStorageTag reads its arrays straight out of the
+// mapping, which stays alive as long as the matrix (or a copy) uses it.
+// Modifying such a matrix replaces the touched arrays with private copies;
+// the file itself is never written through.
+//****************************************************************************
+namespace GraphBLAS
+{
+    /**
+     * @brief Write a matrix to a binary CSR file.
+     *
+     * @param[in] path  The file to create (overwritten if it exists)
+     * @param[in] A     The matrix to write
+     *
+     * @throw IOException  If the file cannot be written
+     */
+    template<typename MatrixT>
+    void write_binary_csr(std::string const &path, MatrixT const &A)
+    {
+        backend::write_binary_csr(path, A.m_mat);
+    }
+
+    /**
+     * @brief Load a matrix from a binary CSR file.
+     *
+     * With CsrStorageTag the matrix is backed by the mapped file (zero
+     * copy); with any other storage the file is copied into the matrix.
+     *
+     * @tparam MatrixT  The matrix type; its ScalarType must match the file.
+     * @param[in] path  The file to load
+     * @param[in] trust_file  Skip the scan of the column indices when
+     *                        mapping into CsrStorageTag (copies into other
+     *                        storage always check them).  Only for files
+     *                        known to be well formed: a bad index is used
+     *                        unchecked by the kernels.
+     *
+     * @throw IOException  If the file is missing, malformed or holds a
+     *                     different value type
+     */
+    template<typename MatrixT>
+    MatrixT read_binary_csr(std::string const &path,
+                            bool               trust_file = false)
+    {
+        backend::BinaryCsrFile file(path, trust_file);
+        MatrixT A(file.nrows(), file.ncols());
+        file.load(A.m_mat);
+        return A;
+    }
+
+} // GraphBLAS
+
+#endif // GB_BINARY_CSR_HPP
@@ -39,11 +39,26 @@ namespace GraphBLAS
     struct DenseTag {};
     struct SparseTag {};
 
+    // Matrix storage engines: list-of-lists (default), compressed sparse row,
+    // hypersparse (doubly compressed, only non-empty rows are stored; the
+    // operations still take O(nrows) time and temporary memory), or
+    // pattern-only (no values; every stored element has the same value)
+    struct LilStorageTag {};
+    struct CsrStorageTag {};
+    struct HypersparseStorageTag {};
+    struct PatternStorageTag {};
+
+    // Optional cached column-major index for O(column) column access
+    struct NoColumnIndexTag {};
+    struct ColumnIndexTag {};
+
     namespace detail
     {
         // add category tags in the detail namespace
         struct SparsenessCategoryTag {};
         struct DirectednessCategoryTag {};
+        struct StorageCategoryTag {};
+        struct ColumnIndexCategoryTag {};
         struct NullTag {};
     } //end detail
 }//end GraphBLAS
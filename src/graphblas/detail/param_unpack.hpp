@@ -80,6 +80,36 @@ namespace GraphBLAS
             using type = DirectedMatrixTag;
         };
 
+        template<>
+        struct substitute<detail::StorageCategoryTag, LilStorageTag> {
+            using type = LilStorageTag;
+        };
+
+        template<>
+        struct substitute<detail::StorageCategoryTag, CsrStorageTag> {
+            using type = CsrStorageTag;
+        };
+
+        template<>
+        struct substitute<detail::StorageCategoryTag, HypersparseStorageTag> {
+            using type = HypersparseStorageTag;
+        };
+
+        template<>
+        struct substitute<detail::StorageCategoryTag, PatternStorageTag> {
+            using type = PatternStorageTag;
+        };
+
+        template<>
+        struct substitute<detail::ColumnIndexCategoryTag, NoColumnIndexTag> {
+            using type = NoColumnIndexTag;
+        };
+
+        template<>
+        struct substitute<detail::ColumnIndexCategoryTag, ColumnIndexTag> {
+            using type = ColumnIndexTag;
+        };
+
         template<>
         struct substitute<detail::DirectednessCategoryTag, detail::NullTag> {
             //default values
@@ -91,6 +121,16 @@ namespace GraphBLAS
             using type = SparseTag; // default sparseness
         };
 
+        template<>
+        struct substitute<detail::StorageCategoryTag, detail::NullTag> {
+            using type = LilStorageTag; // default storage
+        };
+
+        template<>
+        struct substitute<detail::ColumnIndexCategoryTag, detail::NullTag> {
+            using type = NoColumnIndexTag; // default: no column index
+        };
+
 
         // hidden part in the frontend (detail namespace somewhere) to unroll
         // template parameter pack
@@ -99,30 +139,41 @@ namespace GraphBLAS
             // recursive call: shaves off one of the tags and puts it in the right
             // place (no error checking yet)
             template<typename ScalarT, typename Sparseness, typename Directedness,
-                typename InputTag, typename... Tags>
+                typename Storage, typename ColumnIndex, typename InputTag,
+                typename... Tags>
             struct result {
                 using type = typename result<ScalarT,
                       typename detail::substitute<Sparseness, InputTag >::type,
                       typename detail::substitute<Directedness, InputTag >::type,
+                      typename detail::substitute<Storage, InputTag >::type,
+                      typename detail::substitute<ColumnIndex, InputTag >::type,
                       Tags... >::type;
             };
 
             //null tag shortcut:
-            template<typename ScalarT, typename Sparseness, typename Directedness>
-            struct result<ScalarT, Sparseness, Directedness, detail::NullTag, detail::NullTag>
+            template<typename ScalarT, typename Sparseness, typename Directedness,
+                typename Storage, typename ColumnIndex>
+            struct result<ScalarT, Sparseness, Directedness, Storage,
+                          ColumnIndex, detail::NullTag, detail::NullTag>
             {
                 using type = typename backend::Matrix<ScalarT,
                       typename detail::substitute<Sparseness, detail::NullTag >::type,
-                      typename detail::substitute<Directedness, detail::NullTag >::type >;
+                      typename detail::substitute<Directedness, detail::NullTag >::type,
+                      typename detail::substitute<Storage, detail::NullTag >::type,
+                      typename detail::substitute<ColumnIndex, detail::NullTag >::type >;
             };
 
             // base case returns the matrix from the backend
-            template<typename ScalarT, typename Sparseness, typename Directedness, typename InputTag>
-            struct result<ScalarT, Sparseness, Directedness, InputTag>
+            template<typename ScalarT, typename Sparseness, typename Directedness,
+                typename Storage, typename ColumnIndex, typename InputTag>
+            struct result<ScalarT, Sparseness, Directedness, Storage,
+                          ColumnIndex, InputTag>
             {
                 using type = typename backend::Matrix<ScalarT,
                       typename detail::substitute<Sparseness, InputTag >::type,
-                      typename detail::substitute<Directedness, InputTag >::type > ;
+                      typename detail::substitute<Directedness, InputTag >::type,
+                      typename detail::substitute<Storage, InputTag >::type,
+                      typename detail::substitute<ColumnIndex, InputTag >::type > ;
             };
         };
 
@@ -138,12 +189,13 @@ namespace GraphBLAS
                       Tags... >::type;
             };
 
-            //null tag shortcut:
+            //null tag shortcut: unlike matrices, a vector without a
+            //sparseness tag keeps the category tag, which leaves the
+            //backend free to pick its storage form.
             template<typename ScalarT, typename Sparseness>
             struct result<ScalarT, Sparseness, detail::NullTag>
             {
-                using type = typename backend::Vector<ScalarT,
-                      typename detail::substitute<Sparseness, detail::NullTag >::type >;
+                using type = typename backend::Vector<ScalarT, Sparseness>;
             };
 
             // base case returns the vector from the backend
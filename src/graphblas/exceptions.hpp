@@ -180,6 +180,30 @@ namespace GraphBLAS
 
         std::string m_message;
     };
+
+    //************************************************************************
+    // Library extensions
+    //************************************************************************
+
+    //************************************************************************
+    /// Reading or writing a graph file failed (bad file, bad format).
+    class IOException : public std::exception
+    {
+    public:
+        IOException(std::string const &msg)
+            : m_message("IOException: " + msg) {}
+
+        IOException() : m_message("IOException") {}
+
+    private:
+        // Prefixed once here so what() does not point into a temporary
+        const char* what() const throw()
+        {
+            return m_message.c_str();
+        }
+
+        std::string m_message;
+    };
 }
 
 #endif // GB_EXCEPTIONS_HPP
@@ -0,0 +1,342 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+#ifndef GB_GRAPH_GENERATORS_HPP
+#define GB_GRAPH_GENERATORS_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include <graphblas/graphblas.hpp>
+
+//****************************************************************************
+// Synthetic graph generators for scaling studies.
+//
+// Every generator fills (row, col) tuple arrays and hands them to one
+// sort-based Matrix::build (duplicate edges are merged with Second, so
+// every stored value is 'val').  The random generators draw each edge from
+// its own counter-based stream (seed, edge number), so the result depends
+// only on the arguments: not on the platform or the number of threads.
+//****************************************************************************
+namespace GraphBLAS
+{
+    namespace detail
+    {
+        //********************************************************************
+        /// splitmix64 step; also used to hash (seed, counter) into a stream.
+        inline uint64_t splitmix64(uint64_t &state)
+        {
+            uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+            z = (z ^ (z >> 30))*0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27))*0x94D049BB133111EBULL;
+            return z ^ (z >> 31);
+        }
+
+        /// Independent random stream for edge number 'counter'.
+        class EdgeRandom
+        {
+        public:
+            EdgeRandom(uint64_t seed, uint64_t counter)
+                : m_state(seed ^ (counter*0xD1B54A32D192ED03ULL))
+            {
+                splitmix64(m_state);
+            }
+
+            uint64_t next() { return splitmix64(m_state); }
+
+            /// Uniform in [0, 1) with 53 random bits.
+            double uniform() { return (next() >> 11)*(1.0/9007199254740992.0); }
+
+            IndexType below(IndexType bound)
+            {
+                return static_cast<IndexType>(next() % bound);
+            }
+
+        private:
+            uint64_t m_state;
+        };
+
+        //********************************************************************
+        /// Fill rows[e], cols[e] for e in [0, num_edges) with edge_fn(e, i, j)
+        /// (in parallel with the openmp platform).
+        template <typename EdgeFnT>
+        void generate_edges(IndexArrayType &rows,
+                            IndexArrayType &cols,
+                            IndexType       num_edges,
+                            EdgeFnT         edge_fn)
+        {
+            rows.resize(num_edges);
+            cols.resize(num_edges);
+
+#if defined(GB_USE_OPENMP)
+            #pragma omp parallel for schedule(static)
+#endif
+            for (int64_t e = 0; e < static_cast<int64_t>(num_edges); ++e)
+            {
+                edge_fn(static_cast<IndexType>(e), rows[e], cols[e]);
+            }
+        }
+
+        //********************************************************************
+        /// Build an n x n matrix from the tuples, optionally mirrored and
+        /// without self loops.
+        template <typename MatrixT>
+        MatrixT build_graph(IndexType                     n,
+                            IndexArrayType               &rows,
+                            IndexArrayType               &cols,
+                            bool                          symmetric,
+                            bool                          self_loops,
+                            typename MatrixT::ScalarType  val)
+        {
+            IndexType num_edges(0);
+            for (IndexType e = 0; e < rows.size(); ++e)
+            {
+                if (self_loops || (rows[e] != cols[e]))
+                {
+                    rows[num_edges] = rows[e];
+                    cols[num_edges] = cols[e];
+                    ++num_edges;
+                }
+            }
+            rows.resize(num_edges);
+            cols.resize(num_edges);
+
+            if (symmetric)
+            {
+                rows.reserve(2*num_edges);
+                cols.reserve(2*num_edges);
+                for (IndexType e = 0; e < num_edges; ++e)
+                {
+                    if (rows[e] != cols[e])
+                    {
+                        rows.push_back(cols[e]);
+                        cols.push_back(rows[e]);
+                    }
+                }
+            }
+
+            std::vector<typename MatrixT::ScalarType> vals(rows.size(), val);
+            MatrixT graph(n, n);
+            graph.build(rows.begin(), cols.begin(), vals.begin(), vals.size());
+            return graph;
+        }
+    }
+
+    //************************************************************************
+    /**
+     * @brief R-MAT / Graph500 Kronecker graph with 2^scale vertices and
+     *        edge_factor*2^scale generated edges.
+     *
+     * Each edge descends 'scale' levels of the adjacency matrix, picking
+     * the quadrant with probabilities a, b, c and 1-a-b-c.  The defaults are
+     * the Graph500 initiator.  Duplicate edges are merged, so nvals() is
+     * below the number of generated edges.
+     *
+     * @param[in] scale        log2 of the number of vertices
+     * @param[in] edge_factor  generated edges per vertex
+     * @param[in] seed         the same seed always gives the same graph
+     * @param[in] symmetric    store every edge in both directions
+     * @param[in] permute      randomly relabel the vertices (as Graph500
+     *                         does) so degree does not follow vertex id
+     * @param[in] self_loops   keep generated edges (i, i)
+     * @param[in] val          value stored for every edge
+     */
+    template<typename MatrixT>
+    MatrixT rmat(unsigned int                  scale,
+                 IndexType                     edge_factor = 16,
+                 uint64_t                      seed = 1,
+                 bool                          symmetric = false,
+                 bool                          permute = true,
+                 bool                          self_loops = true,
+                 typename MatrixT::ScalarType  val = 1,
+                 double                        a = 0.57,
+                 double                        b = 0.19,
+                 double                        c = 0.19)
+    {
+        if ((scale >= 8*sizeof(IndexType)) ||
+            (a < 0.) || (b < 0.) || (c < 0.) || (a + b + c > 1.))
+        {
+            throw InvalidValueException("rmat: bad scale or probabilities");
+        }
+
+        IndexType n(static_cast<IndexType>(1) << scale);
+
+        // Relabelling permutation (Fisher-Yates on a stream of its own)
+        IndexArrayType label;
+        if (permute)
+        {
+            label.resize(n);
+            for (IndexType ix = 0; ix < n; ++ix) label[ix] = ix;
+            detail::EdgeRandom rng(seed, ~static_cast<uint64_t>(0));
+            for (IndexType ix = n - 1; ix > 0; --ix)
+            {
+                std::swap(label[ix], label[rng.below(ix + 1)]);
+            }
+        }
+
+        // Quadrant thresholds in 32-bit fixed point: each 64-bit draw
+        // decides two levels.
+        double const one(4294967296.0);
+        uint64_t const t_a(static_cast<uint64_t>(a*one));
+        uint64_t const t_ab(static_cast<uint64_t>((a + b)*one));
+        uint64_t const t_abc(static_cast<uint64_t>((a + b + c)*one));
+
+        IndexArrayType rows, cols;
+        detail::generate_edges(
+            rows, cols, edge_factor*n,
+            [&](IndexType e, IndexType &i, IndexType &j)
+            {
+                detail::EdgeRandom rng(seed, e);
+                i = 0;
+                j = 0;
+                uint64_t bits(0);
+                for (unsigned int level = 0; level < scale; ++level)
+                {
+                    if ((level & 1) == 0) bits = rng.next();
+                    uint64_t r(bits & 0xFFFFFFFFULL);
+                    bits >>= 32;
+
+                    // Branch free: quadrants b and d set the column bit,
+                    // c and d the row bit.
+                    IndexType ge_a(r >= t_a), ge_ab(r >= t_ab);
+                    IndexType ge_abc(r >= t_abc);
+                    i = (i << 1) | ge_ab;
+                    j = (j << 1) | (ge_a ^ ge_ab ^ ge_abc);
+                }
+                if (permute)
+                {
+                    i = label[i];
+                    j = label[j];
+                }
+            });
+
+        return detail::build_graph<MatrixT>(n, rows, cols, symmetric,
+                                            self_loops, val);
+    }
+
+    //************************************************************************
+    /**
+     * @brief Uniform random (Erdos-Renyi G(n, m)) graph: num_edges edges
+     *        with endpoints drawn uniformly from [0, n); duplicates are
+     *        merged and self loops dropped.
+     */
+    template<typename MatrixT>
+    MatrixT uniform_random_graph(
+        IndexType                     n,
+        IndexType                     num_edges,
+        uint64_t                      seed = 1,
+        bool                          symmetric = false,
+        typename MatrixT::ScalarType  val = 1)
+    {
+        if (n == 0)
+        {
+            throw InvalidValueException("uniform_random_graph: n == 0");
+        }
+
+        IndexArrayType rows, cols;
+        detail::generate_edges(
+            rows, cols, num_edges,
+            [&](IndexType e, IndexType &i, IndexType &j)
+            {
+                detail::EdgeRandom rng(seed, e);
+                i = rng.below(n);
+                j = rng.below(n);
+            });
+
+        return detail::build_graph<MatrixT>(n, rows, cols, symmetric,
+                                            false, val);
+    }
+
+    //************************************************************************
+    /**
+     * @brief 2D grid graph (5-point stencil without the centre) on an
+     *        nx x ny lattice; vertex (x, y) is x + nx*y.  Edges are stored
+     *        in both directions.
+     */
+    template<typename MatrixT>
+    MatrixT grid_2d(IndexType                     nx,
+                    IndexType                     ny,
+                    typename MatrixT::ScalarType  val = 1)
+    {
+        IndexArrayType rows, cols;
+        rows.reserve(2*nx*ny);
+        cols.reserve(2*nx*ny);
+        for (IndexType y = 0; y < ny; ++y)
+        {
+            for (IndexType x = 0; x < nx; ++x)
+            {
+                IndexType v(x + nx*y);
+                if (x + 1 < nx) { rows.push_back(v); cols.push_back(v + 1); }
+                if (y + 1 < ny) { rows.push_back(v); cols.push_back(v + nx); }
+            }
+        }
+
+        return detail::build_graph<MatrixT>(nx*ny, rows, cols, true,
+                                            false, val);
+    }
+
+    //************************************************************************
+    /**
+     * @brief 3D grid graph (7-point stencil without the centre) on an
+     *        nx x ny x nz lattice; vertex (x, y, z) is x + nx*(y + ny*z).
+     *        Edges are stored in both directions.
+     */
+    template<typename MatrixT>
+    MatrixT grid_3d(IndexType                     nx,
+                    IndexType                     ny,
+                    IndexType                     nz,
+                    typename MatrixT::ScalarType  val = 1)
+    {
+        IndexType plane(nx*ny);
+        IndexArrayType rows, cols;
+        rows.reserve(3*plane*nz);
+        cols.reserve(3*plane*nz);
+        for (IndexType z = 0; z < nz; ++z)
+        {
+            for (IndexType y = 0; y < ny; ++y)
+            {
+                for (IndexType x = 0; x < nx; ++x)
+                {
+                    IndexType v(x + nx*(y + ny*z));
+                    if (x + 1 < nx)
+                    { rows.push_back(v); cols.push_back(v + 1); }
+                    if (y + 1 < ny)
+                    { rows.push_back(v); cols.push_back(v + nx); }
+                    if (z + 1 < nz)
+                    { rows.push_back(v); cols.push_back(v + plane); }
+                }
+            }
+        }
+
+        return detail::build_graph<MatrixT>(plane*nz, rows, cols, true,
+                                            false, val);
+    }
+}
+
+#endif // GB_GRAPH_GENERATORS_HPP
@@ -46,6 +46,9 @@
 
 #include <graphblas/operations.hpp>
 #include <graphblas/matrix_utils.hpp>
+#include <graphblas/graph_generators.hpp>
+#include <graphblas/binary_csr.hpp>
+#include <graphblas/matrix_io.hpp>
 
 #define GB_INCLUDE_BACKEND_ALL 1
 #include <backend_include.hpp>
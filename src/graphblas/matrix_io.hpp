@@ -0,0 +1,864 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+#ifndef GB_MATRIX_IO_HPP
+#define GB_MATRIX_IO_HPP
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <graphblas/graphblas.hpp>
+
+#if defined(GB_USE_OPENMP)
+#include <omp.h>
+#endif
+
+//****************************************************************************
+// Text graph files: Matrix Market coordinate files and TSV/CSV edge lists.
+//
+// The reader loads the whole file, splits it into chunks at line breaks and
+// parses the chunks independently (in parallel with the openmp platform)
+// with a hand-written number parser.  The tuples of all chunks are then
+// handed to one sort-based Matrix::build.  The writers format chunks of
+// tuples the same way and write them in order.
+//****************************************************************************
+namespace GraphBLAS
+{
+    namespace detail
+    {
+        //********************************************************************
+        // Number parsing: p points into the buffer, end is one past the last
+        // character that may be consumed.  Each returns the position after
+        // the number, or nullptr if there is no number at p.
+        //********************************************************************
+
+        inline bool is_digit(char c) { return (c >= '0') && (c <= '9'); }
+
+        /// Field separators: blanks and commas (CR tolerates DOS files).
+        inline bool is_separator(char c)
+        {
+            return (c == ' ') || (c == '\t') || (c == ',') || (c == '\r');
+        }
+
+        inline char const *skip_separators(char const *p, char const *end)
+        {
+            while ((p != end) && is_separator(*p)) ++p;
+            return p;
+        }
+
+        inline char const *parse_index(char const *p, char const *end,
+                                       uint64_t &val)
+        {
+            char const *start = p;
+            uint64_t v = 0;
+            while ((p != end) && is_digit(*p) && (p - start < 19))
+            {
+                v = v*10 + static_cast<uint64_t>(*p - '0');
+                ++p;
+            }
+            if ((p == start) || ((p != end) && is_digit(*p)))
+            {
+                return nullptr;
+            }
+            val = v;
+            return p;
+        }
+
+        /**
+         * Decimal to double.  Mantissas of up to 15 significant digits with
+         * a decimal exponent within +/-22 are converted exactly with one
+         * multiplication or division (both operands are exact doubles);
+         * anything else (longer mantissas, inf, nan, ...) goes to strtod.
+         *
+         * @note strtod may look past 'end'; the buffers handed in here are
+         *       std::strings, so the data is always NUL terminated.
+         */
+        inline char const *parse_real(char const *p, char const *end,
+                                      double &val)
+        {
+            static double const pow10[] = {
+                1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+            char const *start = p;
+            bool negative = false;
+            if ((p != end) && ((*p == '-') || (*p == '+')))
+            {
+                negative = (*p == '-');
+                ++p;
+            }
+
+            uint64_t mantissa = 0;
+            int      num_digits = 0;    // significant digits
+            int      exp10 = 0;
+            bool     any_digit = false;
+
+            for (; (p != end) && is_digit(*p); ++p)
+            {
+                any_digit = true;
+                if ((mantissa != 0) || (*p != '0'))
+                {
+                    if (++num_digits <= 19)
+                        mantissa = mantissa*10 + static_cast<uint64_t>(*p - '0');
+                    else
+                        ++exp10;
+                }
+            }
+            if ((p != end) && (*p == '.'))
+            {
+                for (++p; (p != end) && is_digit(*p); ++p)
+                {
+                    any_digit = true;
+                    if ((mantissa != 0) || (*p != '0'))
+                    {
+                        if (++num_digits <= 19)
+                        {
+                            mantissa = mantissa*10 + static_cast<uint64_t>(*p - '0');
+                            --exp10;
+                        }
+                    }
+                    else
+                    {
+                        --exp10;
+                    }
+                }
+            }
+            if (any_digit && (p != end) && ((*p == 'e') || (*p == 'E')))
+            {
+                char const *q = p + 1;
+                bool exp_negative = false;
+                if ((q != end) && ((*q == '-') || (*q == '+')))
+                {
+                    exp_negative = (*q == '-');
+                    ++q;
+                }
+                if ((q != end) && is_digit(*q))
+                {
+                    int e = 0;
+                    for (; (q != end) && is_digit(*q); ++q)
+                    {
+                        if (e < 100000) e = e*10 + (*q - '0');
+                    }
+                    exp10 += (exp_negative ? -e : e);
+                    p = q;
+                }
+            }
+
+            if (any_digit && (num_digits <= 15) &&
+                (exp10 >= -22) && (exp10 <= 22))
+            {
+                double v = static_cast<double>(mantissa);
+                v = (exp10 < 0) ? v/pow10[-exp10] : v*pow10[exp10];
+                val = negative ? -v : v;
+                return p;
+            }
+
+            char *stop = nullptr;
+            double v = std::strtod(start, &stop);
+            if ((stop == start) || (stop > end))
+            {
+                return nullptr;
+            }
+            val = v;
+            return stop;
+        }
+
+        /// Parse a value of the matrix's scalar type.
+        template <typename ScalarT>
+        inline char const *parse_value(char const *p, char const *end,
+                                       ScalarT &val,
+                                       std::true_type /* integral */)
+        {
+            // Exact for the full integer range; real-valued text is cast.
+            char const *q = p;
+            bool negative = ((q != end) && (*q == '-'));
+            if ((q != end) && ((*q == '-') || (*q == '+'))) ++q;
+
+            uint64_t v;
+            q = parse_index(q, end, v);
+            if ((q != nullptr) &&
+                ((q == end) || ((*q != '.') && (*q != 'e') && (*q != 'E'))))
+            {
+                val = negative ? static_cast<ScalarT>(-static_cast<int64_t>(v))
+                               : static_cast<ScalarT>(v);
+                return q;
+            }
+
+            double d;
+            q = parse_real(p, end, d);
+            if (q != nullptr)
+            {
+                val = static_cast<ScalarT>(d);
+            }
+            return q;
+        }
+
+        template <typename ScalarT>
+        inline char const *parse_value(char const *p, char const *end,
+                                       ScalarT &val,
+                                       std::false_type /* floating point */)
+        {
+            double d;
+            p = parse_real(p, end, d);
+            if (p != nullptr)
+            {
+                val = static_cast<ScalarT>(d);
+            }
+            return p;
+        }
+
+        inline char const *parse_value(char const *p, char const *end,
+                                       bool &val,
+                                       std::true_type)
+        {
+            double d;
+            p = parse_real(p, end, d);
+            if (p != nullptr)
+            {
+                val = (d != 0.0);
+            }
+            return p;
+        }
+
+        //********************************************************************
+        /// How the entry lines of a text graph file are laid out.
+        struct TextGraphFormat
+        {
+            bool        one_based;
+            bool        values;         // a value column follows (i, j)
+            bool        values_optional;
+            int         symmetry;       // 0 general, 1 symmetric, -1 skew
+            IndexType   nrows;          // index bounds (max() if unknown)
+            IndexType   ncols;
+        };
+
+        /// The tuples parsed from one chunk of a text graph file.
+        template <typename ScalarT>
+        struct TextGraphChunk
+        {
+            TextGraphChunk() : num_entries(0), max_index(0), error() {}
+
+            IndexArrayType        rows;
+            IndexArrayType        cols;
+            std::vector<ScalarT>  vals;
+            IndexType             num_entries;  // lines, before mirroring
+            IndexType             max_index;
+            std::string           error;
+        };
+
+        template <typename ScalarT>
+        ScalarT negate(ScalarT const &val) { return -val; }
+
+        inline bool negate(bool const &val) { return val; }
+
+        /**
+         * Parse the entry lines in [begin, end).  Lines that are blank or
+         * start with '%' or '#' are skipped.  On error the chunk records the
+         * offending line and stops.
+         */
+        template <typename ScalarT>
+        void parse_text_chunk(char const               *begin,
+                              char const               *end,
+                              TextGraphFormat const    &fmt,
+                              ScalarT                   default_val,
+                              TextGraphChunk<ScalarT>  &chunk)
+        {
+            typedef std::integral_constant<
+                bool, std::is_integral<ScalarT>::value> IsIntegral;
+
+            std::size_t num_lines = std::count(begin, end, '\n') + 1;
+            std::size_t capacity = (fmt.symmetry != 0) ? 2*num_lines : num_lines;
+            chunk.rows.reserve(capacity);
+            chunk.cols.reserve(capacity);
+            chunk.vals.reserve(capacity);
+
+            char const *p = begin;
+            while (p != end)
+            {
+                char const *line = p;
+                char const *eol = static_cast<char const *>(
+                    std::memchr(p, '\n', end - p));
+                if (eol == nullptr) eol = end;
+
+                p = skip_separators(p, eol);
+                if ((p == eol) || (*p == '%') || (*p == '#'))
+                {
+                    p = (eol == end) ? end : eol + 1;
+                    continue;
+                }
+
+                uint64_t    i, j;
+                ScalarT     val(default_val);
+                char const *q = parse_index(p, eol, i);
+                if (q != nullptr)
+                {
+                    q = parse_index(skip_separators(q, eol), eol, j);
+                }
+                if (q != nullptr)
+                {
+                    q = skip_separators(q, eol);
+                    if (fmt.values && (q != eol || !fmt.values_optional))
+                    {
+                        q = parse_value(q, eol, val, IsIntegral());
+                        if (q != nullptr) q = skip_separators(q, eol);
+                    }
+                }
+                if ((q != nullptr) && fmt.one_based)
+                {
+                    if ((i == 0) || (j == 0))
+                        q = nullptr;
+                    else
+                    {
+                        --i; --j;
+                    }
+                }
+                if ((q == nullptr) || (i >= fmt.nrows) || (j >= fmt.ncols))
+                {
+                    chunk.error = std::string(line, eol);
+                    return;
+                }
+
+                chunk.rows.push_back(i);
+                chunk.cols.push_back(j);
+                chunk.vals.push_back(val);
+                ++chunk.num_entries;
+                chunk.max_index = std::max<IndexType>(chunk.max_index,
+                                                      std::max(i, j));
+                if ((fmt.symmetry != 0) && (i != j))
+                {
+                    chunk.rows.push_back(j);
+                    chunk.cols.push_back(i);
+                    chunk.vals.push_back((fmt.symmetry < 0) ? negate(val) : val);
+                }
+
+                p = (eol == end) ? end : eol + 1;
+            }
+        }
+
+        /// Number of chunks to split 'nbytes' of text into.
+        inline std::size_t num_text_chunks(std::size_t nbytes)
+        {
+#if defined(GB_USE_OPENMP)
+            std::size_t num_chunks = 4*static_cast<std::size_t>(omp_get_max_threads());
+#else
+            std::size_t num_chunks = 1;
+#endif
+            return std::max<std::size_t>(
+                1, std::min(num_chunks, nbytes/(64*1024)));
+        }
+
+        /**
+         * Parse [begin, end) in chunks split at line breaks and gather the
+         * tuples (in file order) into rows, cols and vals.  Also returns
+         * the number of entry lines and the largest index seen.
+         *
+         * @throw IOException (prefixed with 'context') naming the first bad
+         *        line.
+         */
+        template <typename ScalarT>
+        void parse_text_graph(std::string const      &context,
+                              char const             *begin,
+                              char const             *end,
+                              TextGraphFormat const  &fmt,
+                              ScalarT                 default_val,
+                              IndexArrayType         &rows,
+                              IndexArrayType         &cols,
+                              std::vector<ScalarT>   &vals,
+                              IndexType              &num_entries,
+                              IndexType              &max_index)
+        {
+            std::size_t num_chunks = num_text_chunks(end - begin);
+            std::vector<char const *> bounds(num_chunks + 1, end);
+            bounds[0] = begin;
+            for (std::size_t c = 1; c < num_chunks; ++c)
+            {
+                char const *p = std::max(bounds[c - 1],
+                                         begin + c*((end - begin)/num_chunks));
+                while ((p != end) && (*p != '\n')) ++p;
+                bounds[c] = (p == end) ? end : p + 1;
+            }
+
+            std::vector<TextGraphChunk<ScalarT> > chunks(num_chunks);
+#if defined(GB_USE_OPENMP)
+            #pragma omp parallel for schedule(dynamic, 1)
+#endif
+            for (int64_t c = 0; c < static_cast<int64_t>(num_chunks); ++c)
+            {
+                parse_text_chunk(bounds[c], bounds[c + 1], fmt, default_val,
+                                 chunks[c]);
+            }
+
+            std::vector<IndexType> offsets(num_chunks + 1, 0);
+            num_entries = 0;
+            max_index = 0;
+            for (std::size_t c = 0; c < num_chunks; ++c)
+            {
+                if (!chunks[c].error.empty())
+                {
+                    throw IOException(context + ": bad or out of range entry '" +
+                                      chunks[c].error + "'");
+                }
+                offsets[c + 1] = offsets[c] + chunks[c].rows.size();
+                num_entries += chunks[c].num_entries;
+                max_index = std::max(max_index, chunks[c].max_index);
+            }
+
+            rows.resize(offsets[num_chunks]);
+            cols.resize(offsets[num_chunks]);
+            vals.resize(offsets[num_chunks]);
+
+            // std::vector<bool> elements share words: copy those serially.
+#if defined(GB_USE_OPENMP)
+            #pragma omp parallel for schedule(dynamic, 1) \
+                if (!std::is_same<ScalarT, bool>::value)
+#endif
+            for (int64_t c = 0; c < static_cast<int64_t>(num_chunks); ++c)
+            {
+                std::copy(chunks[c].rows.begin(), chunks[c].rows.end(),
+                          rows.begin() + offsets[c]);
+                std::copy(chunks[c].cols.begin(), chunks[c].cols.end(),
+                          cols.begin() + offsets[c]);
+                std::copy(chunks[c].vals.begin(), chunks[c].vals.end(),
+                          vals.begin() + offsets[c]);
+                chunks[c] = TextGraphChunk<ScalarT>();
+            }
+        }
+
+        inline std::string read_text_file(std::string const &path)
+        {
+            std::ifstream ifs(path, std::ios::binary);
+            if (!ifs)
+            {
+                throw IOException("cannot open " + path);
+            }
+            ifs.seekg(0, std::ios::end);
+            std::streamoff nbytes = ifs.tellg();
+            ifs.seekg(0, std::ios::beg);
+
+            std::string buffer(static_cast<std::size_t>(nbytes), '\0');
+            if ((nbytes > 0) && !ifs.read(&buffer[0], nbytes))
+            {
+                throw IOException("cannot read " + path);
+            }
+            return buffer;
+        }
+
+        //********************************************************************
+        // Formatting
+        //********************************************************************
+
+        inline void append_index(std::string &out, uint64_t val)
+        {
+            char digits[20];
+            int n = 0;
+            do
+            {
+                digits[n++] = static_cast<char>('0' + val % 10);
+                val /= 10;
+            } while (val != 0);
+            while (n > 0) out.push_back(digits[--n]);
+        }
+
+        template <typename ScalarT>
+        inline void append_value(std::string &out, ScalarT val,
+                                 std::true_type /* integral */)
+        {
+            if (val < 0)
+            {
+                out.push_back('-');
+                append_index(out, 0 - static_cast<uint64_t>(val));
+            }
+            else
+            {
+                append_index(out, static_cast<uint64_t>(val));
+            }
+        }
+
+        inline void append_value(std::string &out, bool val, std::true_type)
+        {
+            out.push_back(val ? '1' : '0');
+        }
+
+        /// Shortest-safe round trip: max_digits10 significant digits.
+        template <typename ScalarT>
+        inline void append_value(std::string &out, ScalarT val,
+                                 std::false_type /* floating point */)
+        {
+            char buf[32];
+            int n = std::snprintf(buf, sizeof(buf), "%.*g",
+                                  std::numeric_limits<ScalarT>::max_digits10,
+                                  static_cast<double>(val));
+            out.append(buf, n);
+        }
+
+        /**
+         * Format the tuples as "i<sep>j[<sep>v]\n" lines and write them.
+         * Chunks of lines are formatted in parallel with the openmp
+         * platform and written in order.
+         */
+        template <typename ScalarT>
+        void write_text_tuples(std::ofstream                &ofs,
+                               IndexArrayType const         &rows,
+                               IndexArrayType const         &cols,
+                               std::vector<ScalarT> const   &vals,
+                               char                          sep,
+                               bool                          write_values,
+                               IndexType                     base)
+        {
+            typedef std::integral_constant<
+                bool, std::is_integral<ScalarT>::value> IsIntegral;
+
+            IndexType const chunk_size = 1 << 16;
+            IndexType const num_tuples = rows.size();
+            IndexType const num_chunks = (num_tuples + chunk_size - 1)/chunk_size;
+
+            // Formats at most 'batch' chunks at a time to bound the memory.
+#if defined(GB_USE_OPENMP)
+            IndexType const batch = 4*static_cast<IndexType>(omp_get_max_threads());
+#else
+            IndexType const batch = 1;
+#endif
+            std::vector<std::string> text(batch);
+            for (IndexType first = 0; first < num_chunks; first += batch)
+            {
+                IndexType last = std::min(num_chunks, first + batch);
+#if defined(GB_USE_OPENMP)
+                #pragma omp parallel for schedule(dynamic, 1)
+#endif
+                for (int64_t c = first; c < static_cast<int64_t>(last); ++c)
+                {
+                    std::string &out = text[c - first];
+                    out.clear();
+                    IndexType stop = std::min(num_tuples, (c + 1)*chunk_size);
+                    for (IndexType ix = c*chunk_size; ix < stop; ++ix)
+                    {
+                        append_index(out, rows[ix] + base);
+                        out.push_back(sep);
+                        append_index(out, cols[ix] + base);
+                        if (write_values)
+                        {
+                            out.push_back(sep);
+                            append_value(out, static_cast<ScalarT>(vals[ix]),
+                                         IsIntegral());
+                        }
+                        out.push_back('\n');
+                    }
+                }
+                for (IndexType c = first; c < last; ++c)
+                {
+                    ofs.write(text[c - first].data(), text[c - first].size());
+                }
+            }
+        }
+
+        template <typename ScalarT>
+        char const *matrix_market_field()
+        {
+            return (std::is_floating_point<ScalarT>::value ? "real" :
+                    "integer");
+        }
+
+        template <typename MatrixT>
+        void get_tuples(MatrixT const                              &A,
+                        IndexArrayType                             &rows,
+                        IndexArrayType                             &cols,
+                        std::vector<typename MatrixT::ScalarType>  &vals)
+        {
+            rows.resize(A.nvals());
+            cols.resize(A.nvals());
+            vals.resize(A.nvals());
+            A.extractTuples(rows, cols, vals);
+        }
+    } // namespace detail
+
+    //************************************************************************
+    /**
+     * @brief Read a Matrix Market coordinate file.
+     *
+     * Supports the real, integer and pattern fields and the general,
+     * symmetric and skew-symmetric symmetries (the stored triangle is
+     * mirrored).  Pattern entries get the value 1.  Duplicate entries are
+     * combined with 'dup'.
+     *
+     * @throw IOException  If the file cannot be read, the header is not a
+     *                     supported coordinate format, an entry is malformed
+     *                     or out of range, or the entry count is wrong.
+     */
+    template <typename MatrixT,
+              typename BinaryOpT = Second<typename MatrixT::ScalarType> >
+    MatrixT read_matrix_market(std::string const &path,
+                               BinaryOpT          dup = BinaryOpT())
+    {
+        typedef typename MatrixT::ScalarType ScalarT;
+
+        std::string buffer(detail::read_text_file(path));
+        char const *p = buffer.data();
+        char const *end = p + buffer.size();
+
+        // Banner: %%MatrixMarket matrix coordinate <field> <symmetry>
+        char const *eol = p;
+        while ((eol != end) && (*eol != '\n')) ++eol;
+        std::istringstream banner(std::string(p, eol));
+        std::string tag, object, format, field, symmetry;
+        banner >> tag >> object >> format >> field >> symmetry;
+        for (std::string *s : {&object, &format, &field, &symmetry})
+        {
+            for (auto &c : *s) c = static_cast<char>(std::tolower(c));
+        }
+        if ((tag != "%%MatrixMarket") || (object != "matrix"))
+        {
+            throw IOException("read_matrix_market: no Matrix Market banner in " + path);
+        }
+        if ((format != "coordinate") ||
+            ((field != "real") && (field != "integer") && (field != "pattern")) ||
+            ((symmetry != "general") && (symmetry != "symmetric") &&
+             (symmetry != "skew-symmetric")))
+        {
+            throw IOException("read_matrix_market: unsupported format '" +
+                              format + " " + field + " " + symmetry + "' in " + path);
+        }
+
+        // Skip comments to the size line: rows cols entries
+        uint64_t nrows = 0, ncols = 0, num_entries = 0;
+        bool have_size = false;
+        while (!have_size && (eol != end))
+        {
+            p = eol + 1;
+            eol = p;
+            while ((eol != end) && (*eol != '\n')) ++eol;
+            char const *q = detail::skip_separators(p, eol);
+            if ((q == eol) || (*q == '%'))
+            {
+                continue;
+            }
+            q = detail::parse_index(q, eol, nrows);
+            if (q) q = detail::parse_index(detail::skip_separators(q, eol), eol, ncols);
+            if (q) q = detail::parse_index(detail::skip_separators(q, eol), eol, num_entries);
+            if (!q || (detail::skip_separators(q, eol) != eol))
+            {
+                throw IOException("read_matrix_market: bad size line in " + path);
+            }
+            have_size = true;
+        }
+        if (!have_size)
+        {
+            throw IOException("read_matrix_market: missing size line in " + path);
+        }
+
+        detail::TextGraphFormat fmt;
+        fmt.one_based = true;
+        fmt.values = (field != "pattern");
+        fmt.values_optional = false;
+        fmt.symmetry = ((symmetry == "general") ? 0 :
+                        (symmetry == "symmetric") ? 1 : -1);
+        fmt.nrows = nrows;
+        fmt.ncols = ncols;
+
+        IndexArrayType rows, cols;
+        std::vector<ScalarT> vals;
+        IndexType num_read, max_index;
+        char const *body = (eol == end) ? end : eol + 1;
+        detail::parse_text_graph("read_matrix_market: " + path,
+                                 body, end, fmt, static_cast<ScalarT>(1),
+                                 rows, cols, vals, num_read, max_index);
+        if (num_read != num_entries)
+        {
+            throw IOException("read_matrix_market: wrong number of entries in " + path);
+        }
+
+        MatrixT A(nrows, ncols);
+        A.build(rows.begin(), cols.begin(), vals.begin(), rows.size(), dup);
+        return A;
+    }
+
+    //************************************************************************
+    /**
+     * @brief Write a matrix as a Matrix Market coordinate file.
+     *
+     * @param[in] symmetric  If true, only the lower triangle is written and
+     *                       the file is marked symmetric.  The caller
+     *                       vouches that A is symmetric.
+     *
+     * @throw IOException  If the file cannot be written
+     */
+    template <typename MatrixT>
+    void write_matrix_market(std::string const &path,
+                             MatrixT const     &A,
+                             bool               symmetric = false)
+    {
+        typedef typename MatrixT::ScalarType ScalarT;
+
+        if (symmetric && (A.nrows() != A.ncols()))
+        {
+            throw DimensionException("write_matrix_market: symmetric matrix must be square");
+        }
+
+        IndexArrayType rows, cols;
+        std::vector<ScalarT> vals;
+        detail::get_tuples(A, rows, cols, vals);
+        if (symmetric)
+        {
+            IndexType num_kept = 0;
+            for (IndexType ix = 0; ix < rows.size(); ++ix)
+            {
+                if (rows[ix] >= cols[ix])
+                {
+                    rows[num_kept] = rows[ix];
+                    cols[num_kept] = cols[ix];
+                    vals[num_kept] = vals[ix];
+                    ++num_kept;
+                }
+            }
+            rows.resize(num_kept);
+            cols.resize(num_kept);
+            vals.resize(num_kept);
+        }
+
+        std::ofstream ofs(path, std::ios::binary | std::ios::trunc);
+        if (!ofs)
+        {
+            throw IOException("write_matrix_market: cannot open " + path);
+        }
+        ofs << "%%MatrixMarket matrix coordinate "
+            << detail::matrix_market_field<ScalarT>() << " "
+            << (symmetric ? "symmetric" : "general") << "\n"
+            << A.nrows() << " " << A.ncols() << " " << rows.size() << "\n";
+        detail::write_text_tuples(ofs, rows, cols, vals, ' ', true, 1);
+
+        ofs.close();
+        if (!ofs)
+        {
+            throw IOException("write_matrix_market: error writing " + path);
+        }
+    }
+
+    //************************************************************************
+    /**
+     * @brief Read an edge list: one "src dst [value]" line per edge.
+     *
+     * Fields may be separated by blanks, tabs or commas (TSV and CSV).
+     * Lines that are blank or start with '#' or '%' are skipped.  Edges
+     * without a value get the value 1; duplicates are combined with 'dup'.
+     *
+     * @param[in] path       The file to read
+     * @param[in] num_nodes  The matrix is num_nodes x num_nodes; 0 means
+     *                       one more than the largest vertex id.
+     * @param[in] symmetric  Also store (dst, src) for every edge
+     * @param[in] one_based  Vertex ids start at 1
+     *
+     * @throw IOException  If the file cannot be read or a line is malformed
+     *                     or out of range.
+     */
+    template <typename MatrixT,
+              typename BinaryOpT = Second<typename MatrixT::ScalarType> >
+    MatrixT read_edge_list(std::string const &path,
+                           IndexType          num_nodes = 0,
+                           bool               symmetric = false,
+                           bool               one_based = false,
+                           BinaryOpT          dup = BinaryOpT())
+    {
+        typedef typename MatrixT::ScalarType ScalarT;
+
+        std::string buffer(detail::read_text_file(path));
+
+        detail::TextGraphFormat fmt;
+        fmt.one_based = one_based;
+        fmt.values = true;
+        fmt.values_optional = true;
+        fmt.symmetry = (symmetric ? 1 : 0);
+        fmt.nrows = fmt.ncols = ((num_nodes == 0) ?
+                                 std::numeric_limits<IndexType>::max() :
+                                 num_nodes);
+
+        IndexArrayType rows, cols;
+        std::vector<ScalarT> vals;
+        IndexType num_read, max_index;
+        detail::parse_text_graph("read_edge_list: " + path,
+                                 buffer.data(), buffer.data() + buffer.size(),
+                                 fmt, static_cast<ScalarT>(1),
+                                 rows, cols, vals, num_read, max_index);
+
+        if (num_nodes == 0)
+        {
+            num_nodes = (num_read == 0) ? 1 : max_index + 1;
+        }
+
+        MatrixT A(num_nodes, num_nodes);
+        A.build(rows.begin(), cols.begin(), vals.begin(), rows.size(), dup);
+        return A;
+    }
+
+    //************************************************************************
+    /**
+     * @brief Write a matrix as an edge list: one "src<sep>dst[<sep>value]"
+     *        line per stored value, in row-major order.
+     *
+     * @throw IOException  If the file cannot be written
+     */
+    template <typename MatrixT>
+    void write_edge_list(std::string const &path,
+                         MatrixT const     &A,
+                         char               sep = '\t',
+                         bool               write_values = true,
+                         bool               one_based = false)
+    {
+        typedef typename MatrixT::ScalarType ScalarT;
+
+        IndexArrayType rows, cols;
+        std::vector<ScalarT> vals;
+        detail::get_tuples(A, rows, cols, vals);
+
+        std::ofstream ofs(path, std::ios::binary | std::ios::trunc);
+        if (!ofs)
+        {
+            throw IOException("write_edge_list: cannot open " + path);
+        }
+        detail::write_text_tuples(ofs, rows, cols, vals, sep, write_values,
+                                  one_based ? 1 : 0);
+
+        ofs.close();
+        if (!ofs)
+        {
+            throw IOException("write_edge_list: error writing " + path);
+        }
+    }
+}
+
+#endif // GB_MATRIX_IO_HPP
@@ -32,6 +32,7 @@
 
 #include <functional>
 #include <vector>
+#include <utility>
 
 #include <graphblas/graphblas.hpp>
 
@@ -165,11 +166,13 @@ namespace GraphBLAS
         MatrixT Adiag(w.size(), w.size());
         Adiag.build(indices.begin(), indices.begin(), vals.begin(), vals.size());
 
-        //Perform matrix multiply to scale rows
-        GraphBLAS::mxm(A,
+        //Perform matrix multiply to scale rows, then take over the result
+        MatrixT Ascaled(A.nrows(), A.ncols());
+        GraphBLAS::mxm(Ascaled,
                        GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
                        GraphBLAS::ArithmeticSemiring<T>(),
                        Adiag, A);
+        A = std::move(Ascaled);
     }
 
 
@@ -203,11 +206,13 @@ namespace GraphBLAS
         MatrixT Adiag(w.size(), w.size());
         Adiag.build(indices.begin(), indices.begin(), vals.begin(), vals.size());
 
-        //Perform matrix multiply to scale rows
-        GraphBLAS::mxm(A,
+        //Perform matrix multiply to scale columns, then take over the result
+        MatrixT Ascaled(A.nrows(), A.ncols());
+        GraphBLAS::mxm(Ascaled,
                        GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
                        GraphBLAS::ArithmeticSemiring<T>(),
                        A, Adiag);
+        A = std::move(Ascaled);
     }
 }
 
@@ -47,6 +47,8 @@
 #include <graphblas/detail/config.hpp>
 #include <graphblas/detail/checks.hpp>
 
+#include <graphblas/profiling.hpp>
+
 #define GB_INCLUDE_BACKEND_TRANSPOSE_VIEW 1
 #define GB_INCLUDE_BACKEND_COMPLEMENT_VIEW 1
 #define GB_INCLUDE_BACKEND_OPERATIONS 1
@@ -92,8 +94,11 @@ namespace GraphBLAS
         check_ncols_ncols(C, B, "mxm: C.ncols != B.ncols");
         check_ncols_nrows(A, B, "mxm: A.ncols != B.nrows");
 
+        GRB_PROFILE_BEGIN("mxm", op, Mask, A.nvals() + B.nvals(),
+                          2.0*A.nvals()*profiling::density(B, B.nrows()));
         backend::mxm(C.m_mat, Mask.m_mat, accum, op, A.m_mat, B.m_mat,
                      replace_flag);
+        GRB_PROFILE_END(C.nvals());
 
         GRB_LOG_VERBOSE("C (Result): " << C.m_mat);
         GRB_LOG_FN_END("mxm - 4.3.1 - matrix-matrix multiply");
@@ -129,8 +134,11 @@ namespace GraphBLAS
         check_size_ncols(w, A, "vxm: w.size != A.ncols");
         check_size_nrows(u, A, "vxm: u.size != A.nrows");
 
+        GRB_PROFILE_BEGIN("vxm", op, mask, u.nvals() + A.nvals(),
+                          2.0*A.nvals()*profiling::density(u, u.size()));
         backend::vxm(w.m_vec, mask.m_vec, accum, op, u.m_vec, A.m_mat,
                      replace_flag);
+        GRB_PROFILE_END(w.nvals());
 
         GRB_LOG_VERBOSE("w out :" << w.m_vec);
         GRB_LOG_FN_END("mxm - 4.3.2 - vector-matrix multiply");
@@ -166,8 +174,11 @@ namespace GraphBLAS
         check_size_nrows(w, A, "mxv: w.size != A.nrows");
         check_size_ncols(u, A, "mxv: u.size != A.ncols");
 
+        GRB_PROFILE_BEGIN("mxv", op, mask, A.nvals() + u.nvals(),
+                          2.0*A.nvals()*profiling::density(u, u.size()));
         backend::mxv(w.m_vec, mask.m_vec, accum, op, A.m_mat, u.m_vec,
                      replace_flag);
+        GRB_PROFILE_END(w.nvals());
         GRB_LOG_VERBOSE("w out :" << w.m_vec);
         GRB_LOG_FN_END("mxv - 4.3.3 - matrix-vector multiply");
     }
@@ -210,8 +221,11 @@ namespace GraphBLAS
         check_size_size(w, u, "eWiseMult(vec): w.size != u.size");
         check_size_size(u, v, "eWiseMult(vec): u.size != v.size");
 
+        GRB_PROFILE_BEGIN("eWiseMult", op, mask, u.nvals() + v.nvals(),
+                          u.nvals() + v.nvals());
         backend::eWiseMult(w.m_vec, mask.m_vec, accum, op, u.m_vec, v.m_vec,
                            replace_flag);
+        GRB_PROFILE_END(w.nvals());
 
         GRB_LOG_VERBOSE("w out :" << w.m_vec);
         GRB_LOG_FN_END("eWiseMult - 4.3.4.1 - element-wise vector multiply");
@@ -249,8 +263,11 @@ namespace GraphBLAS
         check_ncols_ncols(A, B, "eWiseMult(mat): A.ncols != B.ncols");
         check_nrows_nrows(A, B, "eWiseMult(mat): A.nrows != B.nrows");
 
+        GRB_PROFILE_BEGIN("eWiseMult", op, Mask, A.nvals() + B.nvals(),
+                          A.nvals() + B.nvals());
         backend::eWiseMult(C.m_mat, Mask.m_mat, accum, op, A.m_mat, B.m_mat,
                            replace_flag);
+        GRB_PROFILE_END(C.nvals());
 
         GRB_LOG_VERBOSE("C out :" << C.m_mat);
         GRB_LOG_FN_END("eWiseMult - 4.3.4.2 - element-wise matrix multiply");
@@ -291,8 +308,11 @@ namespace GraphBLAS
         check_size_size(w, u, "eWiseAdd(vec): w.size != u.size");
         check_size_size(u, v, "eWiseAdd(vec): u.size != v.size");
 
+        GRB_PROFILE_BEGIN("eWiseAdd", op, mask, u.nvals() + v.nvals(),
+                          u.nvals() + v.nvals());
         backend::eWiseAdd(w.m_vec, mask.m_vec, accum, op, u.m_vec, v.m_vec,
                           replace_flag);
+        GRB_PROFILE_END(w.nvals());
 
         GRB_LOG_VERBOSE("w out :" << w.m_vec);
         GRB_LOG_FN_END("eWiseAdd - 4.3.5.1 - element-wise vector addition");
@@ -330,8 +350,11 @@ namespace GraphBLAS
         check_ncols_ncols(A, B, "eWiseAdd(mat): A.ncols != B.ncols");
         check_nrows_nrows(A, B, "eWiseAdd(mat): A.nrows != B.nrows");
 
+        GRB_PROFILE_BEGIN("eWiseAdd", op, Mask, A.nvals() + B.nvals(),
+                          A.nvals() + B.nvals());
         backend::eWiseAdd(C.m_mat, Mask.m_mat, accum, op, A.m_mat, B.m_mat,
                           replace_flag);
+        GRB_PROFILE_END(C.nvals());
 
         GRB_LOG_VERBOSE("C out :" << C.m_mat);
         GRB_LOG_FN_END("eWiseAdd - 4.3.5.2 - element-wise matrix addition");
@@ -367,8 +390,10 @@ namespace GraphBLAS
         check_size_nindices(w, indices,
                             "extract(std vec): w.size != indicies.size");
 
+        GRB_PROFILE_BEGIN("extract", accum, mask, u.nvals(), 0);
         backend::extract(w.m_vec, mask.m_vec, accum, u.m_vec,
                          indices, replace_flag);
+        GRB_PROFILE_END(w.nvals());
 
         GRB_LOG_FN_END("extract - 4.3.6.1 - standard vector variant");
     }
@@ -406,8 +431,10 @@ namespace GraphBLAS
         check_ncols_nindices(C, col_indices,
                              "extract(std mat): C.ncols != col_indices");
 
+        GRB_PROFILE_BEGIN("extract", accum, Mask, A.nvals(), 0);
         backend::extract(C.m_mat, Mask.m_mat, accum, A.m_mat,
                          row_indices, col_indices, replace_flag);
+        GRB_PROFILE_END(C.nvals());
 
         GRB_LOG_FN_END("SEQUENTIAL extract - 4.3.6.2 - standard matrix variant");
     }
@@ -444,8 +471,10 @@ namespace GraphBLAS
         check_index_within_ncols(col_index, A,
                                  "extract(col): col_index >= A.ncols");
 
+        GRB_PROFILE_BEGIN("extract", accum, mask, A.nvals(), 0);
         backend::extract(w.m_vec, mask.m_vec, accum, A.m_mat, row_indices,
                          col_index, replace_flag);
+        GRB_PROFILE_END(w.nvals());
         GRB_LOG_FN_END("extract - 4.3.6.3 - column (and row) variant");
     }
 
@@ -483,8 +512,10 @@ namespace GraphBLAS
         check_size_nindices(u, indices,
                             "assign(std vec): u.size != |indicies|");
 
+        GRB_PROFILE_BEGIN("assign", accum, mask, u.nvals(), 0);
         backend::assign(w.m_vec, mask.m_vec, accum, u.m_vec, indices,
                         replace_flag);
+        GRB_PROFILE_END(w.nvals());
 
         GRB_LOG_VERBOSE("w out: " << w.m_vec);
         GRB_LOG_FN_END("assign - 4.3.7.1 - standard vector variant");
@@ -526,8 +557,10 @@ namespace GraphBLAS
         check_ncols_nindices(A, col_indices,
                              "assign(std mat): A.ncols != |col_indices|");
 
+        GRB_PROFILE_BEGIN("assign", accum, Mask, A.nvals(), 0);
         backend::assign(C.m_mat, Mask.m_mat, accum, A.m_mat,
                         row_indices, col_indices, replace_flag);
+        GRB_PROFILE_END(C.nvals());
 
         GRB_LOG_VERBOSE("C out: " << C.m_mat);
         GRB_LOG_FN_END("assign - 4.3.7.2 - standard matrix variant");
@@ -564,8 +597,10 @@ namespace GraphBLAS
         check_index_within_ncols(col_index, C,
                                  "assign(col): col_index >= C.ncols");
 
+        GRB_PROFILE_BEGIN("assign", accum, mask, u.nvals(), 0);
         backend::assign(C.m_mat, mask.m_vec, accum, u.m_vec,
                         row_indices, col_index, replace_flag);
+        GRB_PROFILE_END(C.nvals());
 
         GRB_LOG_VERBOSE("C out: " << C.m_mat);
         GRB_LOG_FN_END("assign - 4.3.7.3 - column variant");
@@ -601,8 +636,10 @@ namespace GraphBLAS
         check_index_within_nrows(row_index, C,
                                  "assign(col): row_index >= C.nrows");
 
+        GRB_PROFILE_BEGIN("assign", accum, mask, u.nvals(), 0);
         backend::assign(C.m_mat, mask.m_vec, accum, u.m_vec,
                         row_index, col_indices, replace_flag);
+        GRB_PROFILE_END(C.nvals());
 
         GRB_LOG_VERBOSE("C out: " << C.m_mat);
         GRB_LOG_FN_END("assign - 4.3.7.4 - row variant");
@@ -637,8 +674,10 @@ namespace GraphBLAS
         check_nindices_within_size(indices, w,
                                    "assign(const vec): indicies.size !<= w.size");
 
+        GRB_PROFILE_BEGIN("assign", accum, mask, 0, 0);
         backend::assign_constant(w.m_vec, mask.m_vec, accum, val, indices,
                                  replace_flag);
+        GRB_PROFILE_END(w.nvals());
 
         GRB_LOG_VERBOSE("w out: " << w.m_vec);
         GRB_LOG_FN_END("assign - 4.3.7.5 - constant vector variant");
@@ -681,8 +720,10 @@ namespace GraphBLAS
         check_nindices_within_ncols(
             col_indices, C,
             "assign(const mat): indicies.size !<= C.ncols");
+        GRB_PROFILE_BEGIN("assign", accum, Mask, 0, 0);
         backend::assign_constant(C.m_mat, Mask.m_mat, accum, val,
                                  row_indices, col_indices, replace_flag);
+        GRB_PROFILE_END(C.nvals());
 
         GRB_LOG_VERBOSE("C out: " << C.m_mat);
         GRB_LOG_FN_END("assign - 4.3.7.6 - constant matrix variant");
@@ -692,6 +733,9 @@ namespace GraphBLAS
     // Apply
     //************************************************************************
 
+    // op may also be an index unary op (derived from IndexUnaryOp), called
+    // as op(value, i, j) with the position of each stored value.
+
     // 4.3.8.1: vector variant
     template<typename WScalarT,
              typename MaskT,
@@ -717,7 +761,9 @@ namespace GraphBLAS
         check_size_size(w, mask, "apply(vec): w.size != mask.size");
         check_size_size(w, u, "apply(vec): w.size != u.size");
 
+        GRB_PROFILE_BEGIN("apply", op, mask, u.nvals(), u.nvals());
         backend::apply(w.m_vec, mask.m_vec, accum, op, u.m_vec, replace_flag);
+        GRB_PROFILE_END(w.nvals());
 
         GRB_LOG_VERBOSE("w out: " << w.m_vec);
         GRB_LOG_FN_END("assign - 4.3.8.1 - vector variant");
@@ -751,12 +797,88 @@ namespace GraphBLAS
         check_ncols_ncols(C, A, "apply(mat): C.ncols != A.ncols");
         check_nrows_nrows(C, A, "apply(mat): C.nrows != A.nrows");
 
+        GRB_PROFILE_BEGIN("apply", op, Mask, A.nvals(), A.nvals());
         backend::apply(C.m_mat, Mask.m_mat, accum, op, A.m_mat, replace_flag);
+        GRB_PROFILE_END(C.nvals());
 
         GRB_LOG_VERBOSE("C out: " << C.m_mat);
         GRB_LOG_FN_END("apply - 4.3.8.2 - matrix variant");
     };
 
+    //************************************************************************
+    // Select: keep the stored values for which op(value, i, j) is true
+    //************************************************************************
+
+    // vector variant
+    template<typename WScalarT,
+             typename MaskT,
+             typename AccumT,
+             typename IndexUnaryOpT,
+             typename UVectorT,
+             typename ...WTagsT>
+    inline void select(Vector<WScalarT, WTagsT...> &w,
+                       MaskT                 const &mask,
+                       AccumT                       accum,
+                       IndexUnaryOpT                op,
+                       UVectorT              const &u,
+                       bool                         replace_flag = false)
+    {
+        GRB_LOG_FN_BEGIN("select - vector variant");
+        GRB_LOG_VERBOSE("w in: " << w.m_vec);
+        GRB_LOG_VERBOSE("mask in: " << mask.m_vec);
+        GRB_LOG_VERBOSE_ACCUM(accum);
+        GRB_LOG_VERBOSE_OP(op);
+        GRB_LOG_VERBOSE("u in: " << u.m_vec);
+        GRB_LOG_VERBOSE_REPLACE(replace_flag);
+
+        check_size_size(w, mask, "select(vec): w.size != mask.size");
+        check_size_size(w, u, "select(vec): w.size != u.size");
+
+        GRB_PROFILE_BEGIN("select", op, mask, u.nvals(), u.nvals());
+        backend::select(w.m_vec, mask.m_vec, accum, op, u.m_vec,
+                        replace_flag);
+        GRB_PROFILE_END(w.nvals());
+
+        GRB_LOG_VERBOSE("w out: " << w.m_vec);
+        GRB_LOG_FN_END("select - vector variant");
+    }
+
+    // matrix variant
+    template<typename CScalarT,
+             typename MaskT,
+             typename AccumT,
+             typename IndexUnaryOpT,
+             typename AMatrixT,
+             typename ...CTagsT>
+    inline void select(Matrix<CScalarT, CTagsT...> &C,
+                       MaskT                 const &Mask,
+                       AccumT                       accum,
+                       IndexUnaryOpT                op,
+                       AMatrixT              const &A,
+                       bool                         replace_flag = false)
+    {
+        GRB_LOG_FN_BEGIN("select - matrix variant");
+        GRB_LOG_VERBOSE("C in: " << C.m_mat);
+        GRB_LOG_VERBOSE("Mask in: " << Mask.m_mat);
+        GRB_LOG_VERBOSE_ACCUM(accum);
+        GRB_LOG_VERBOSE_OP(op);
+        GRB_LOG_VERBOSE("A in: " << A);
+        GRB_LOG_VERBOSE_REPLACE(replace_flag);
+
+        check_ncols_ncols(C, Mask, "select(mat): C.ncols != Mask.ncols");
+        check_nrows_nrows(C, Mask, "select(mat): C.nrows != Mask.nrows");
+        check_ncols_ncols(C, A, "select(mat): C.ncols != A.ncols");
+        check_nrows_nrows(C, A, "select(mat): C.nrows != A.nrows");
+
+        GRB_PROFILE_BEGIN("select", op, Mask, A.nvals(), A.nvals());
+        backend::select(C.m_mat, Mask.m_mat, accum, op, A.m_mat,
+                        replace_flag);
+        GRB_PROFILE_END(C.nvals());
+
+        GRB_LOG_VERBOSE("C out: " << C.m_mat);
+        GRB_LOG_FN_END("select - matrix variant");
+    }
+
     //************************************************************************
     // reduce
     //************************************************************************
@@ -786,7 +908,9 @@ namespace GraphBLAS
         check_size_size(w, mask, "reduce(mat2vec): w.size != mask.size");
         check_size_nrows(w, A, "reduce(mat2vec): w.size != A.nrows");
 
+        GRB_PROFILE_BEGIN("reduce", op, mask, A.nvals(), A.nvals());
         backend::reduce(w.m_vec, mask.m_vec, accum, op, A.m_mat, replace_flag);
+        GRB_PROFILE_END(w.nvals());
 
         GRB_LOG_VERBOSE("w out: " << w.m_vec);
         GRB_LOG_FN_END("reduce - 4.3.9.1 - matrix to vector variant");
@@ -810,7 +934,9 @@ namespace GraphBLAS
         GRB_LOG_VERBOSE_OP(op);
         GRB_LOG_VERBOSE("u in: " << u.m_vec);
 
+        GRB_PROFILE_BEGIN("reduce", op, NoMask(), u.nvals(), u.nvals());
         backend::reduce_vector_to_scalar(val, accum, op, u.m_vec);
+        GRB_PROFILE_END(1);
 
         GRB_LOG_VERBOSE("val out: " << val);
         GRB_LOG_FN_END("reduce - 4.3.9.2 - vector to scalar variant");
@@ -836,7 +962,9 @@ namespace GraphBLAS
         GRB_LOG_VERBOSE_OP(op);
         GRB_LOG_VERBOSE("A in: " << A.m_mat);
 
+        GRB_PROFILE_BEGIN("reduce", op, NoMask(), A.nvals(), A.nvals());
         backend::reduce_matrix_to_scalar(val, accum, op, A.m_mat);
+        GRB_PROFILE_END(1);
 
         GRB_LOG_VERBOSE("val out: " << val);
         GRB_LOG_FN_END("reduce - 4.3.9.3 - matrix to scalar variant");
@@ -869,7 +997,9 @@ namespace GraphBLAS
         check_ncols_nrows(C, A, "transpose: C.ncols != A.nrows");
         check_ncols_nrows(A, C, "transpose: A.ncols != C.nrows");
 
+        GRB_PROFILE_BEGIN("transpose", accum, Mask, A.nvals(), 0);
         backend::transpose(C.m_mat, Mask.m_mat, accum, A.m_mat, replace_flag);
+        GRB_PROFILE_END(C.nvals());
 
         GRB_LOG_VERBOSE("C out: " << C.m_mat);
         GRB_LOG_FN_END("transpose - 4.3.10");
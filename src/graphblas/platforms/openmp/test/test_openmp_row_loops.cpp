@@ -0,0 +1,249 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+
+// Use small blocks so that the buffered row commits are exercised
+#define GB_OPENMP_ROWS_PER_BLOCK 37
+
+#include <omp.h>
+#include <graphblas/graphblas.hpp>
+
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_MODULE openmp_row_loops_test_suite
+
+#include <boost/test/included/unit_test.hpp>
+
+using namespace GraphBLAS;
+
+BOOST_AUTO_TEST_SUITE(BOOST_TEST_MODULE)
+
+//****************************************************************************
+
+namespace
+{
+    IndexType const NROWS = 311;
+    IndexType const NCOLS = 257;
+
+    /// Deterministic sparse pattern with some empty rows and columns.
+    template<typename MatrixT>
+    void build_pattern(MatrixT &A, IndexType salt)
+    {
+        IndexArrayType i, j;
+        std::vector<double> v;
+        for (IndexType r = 0; r < A.nrows(); ++r)
+        {
+            if ((r % 13) == salt % 13) continue;
+            for (IndexType c = 0; c < A.ncols(); ++c)
+            {
+                if (((r*7 + c*3 + salt) % 17) == 0)
+                {
+                    i.push_back(r);
+                    j.push_back(c);
+                    v.push_back(double((r + 2*c + salt) % 9 + 1));
+                }
+            }
+        }
+        A.build(i, j, v);
+    }
+
+    /// Run op once with one thread and once with four, return both results.
+    template<typename ResultT, typename OpT>
+    void run_serial_and_parallel(ResultT &serial, ResultT &parallel, OpT op)
+    {
+        int saved(omp_get_max_threads());
+        omp_set_num_threads(1);
+        op(serial);
+        omp_set_num_threads(4);
+        op(parallel);
+        omp_set_num_threads(saved);
+    }
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_openmp_mxm)
+{
+    Matrix<double> A(NROWS, NCOLS), B(NCOLS, NROWS), M(NROWS, NROWS);
+    build_pattern(A, 1);
+    build_pattern(B, 2);
+    build_pattern(M, 3);
+
+    // Dense reference for the unmasked product
+    std::vector<std::vector<double> > dA(NROWS, std::vector<double>(NCOLS, 0));
+    std::vector<std::vector<double> > dB(NCOLS, std::vector<double>(NROWS, 0));
+    for (IndexType r = 0; r < NROWS; ++r)
+        for (IndexType c = 0; c < NCOLS; ++c)
+        {
+            if (A.hasElement(r, c)) dA[r][c] = A.extractElement(r, c);
+            if (B.hasElement(c, r)) dB[c][r] = B.extractElement(c, r);
+        }
+    std::vector<std::vector<double> > dC(NROWS, std::vector<double>(NROWS, 0));
+    for (IndexType r = 0; r < NROWS; ++r)
+        for (IndexType k = 0; k < NCOLS; ++k)
+            for (IndexType c = 0; c < NROWS; ++c)
+                dC[r][c] += dA[r][k]*dB[k][c];
+    Matrix<double> answer(dC, 0.0);
+
+    Matrix<double> serial(NROWS, NROWS), parallel(NROWS, NROWS);
+    run_serial_and_parallel(serial, parallel, [&](Matrix<double> &C)
+        {
+            mxm(C, NoMask(), NoAccumulate(),
+                ArithmeticSemiring<double>(), A, B);
+        });
+    BOOST_CHECK_EQUAL(serial, answer);
+    BOOST_CHECK_EQUAL(parallel, answer);
+
+    run_serial_and_parallel(serial, parallel, [&](Matrix<double> &C)
+        {
+            C.clear();
+            mxm(C, M, NoAccumulate(), ArithmeticSemiring<double>(), A, B);
+        });
+    BOOST_CHECK_EQUAL(serial, parallel);
+
+    run_serial_and_parallel(serial, parallel, [&](Matrix<double> &C)
+        {
+            C.clear();
+            mxm(C, complement(M), Plus<double>(),
+                ArithmeticSemiring<double>(), A, transpose(A), true);
+        });
+    BOOST_CHECK_EQUAL(serial, parallel);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_openmp_csr_mxm_with_column_index)
+{
+    Matrix<double, CsrStorageTag, ColumnIndexTag> A(NROWS, NCOLS);
+    Matrix<double, CsrStorageTag, ColumnIndexTag> B(NCOLS, NROWS);
+    Matrix<double, CsrStorageTag> M(NROWS, NROWS);
+    build_pattern(A, 4);
+    build_pattern(B, 5);
+    build_pattern(M, 6);
+
+    Matrix<double, CsrStorageTag> serial(NROWS, NROWS), parallel(NROWS, NROWS);
+    run_serial_and_parallel(
+        serial, parallel, [&](Matrix<double, CsrStorageTag> &C)
+        {
+            C.clear();
+            mxm(C, M, NoAccumulate(), ArithmeticSemiring<double>(), A, B);
+        });
+    BOOST_CHECK(serial.nvals() > 0);
+    BOOST_CHECK_EQUAL(serial, parallel);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_openmp_mxv_vxm_reduce)
+{
+    Matrix<double> A(NROWS, NCOLS);
+    build_pattern(A, 7);
+
+    Vector<double> u(NCOLS), v(NROWS);
+    for (IndexType c = 0; c < NCOLS; c += 3) u.setElement(c, double(c % 5));
+    for (IndexType r = 0; r < NROWS; r += 2) v.setElement(r, double(r % 7));
+
+    Vector<double> serial(NROWS), parallel(NROWS);
+    run_serial_and_parallel(serial, parallel, [&](Vector<double> &w)
+        {
+            mxv(w, NoMask(), NoAccumulate(),
+                ArithmeticSemiring<double>(), A, u);
+        });
+    BOOST_CHECK(serial.nvals() > 0);
+    BOOST_CHECK_EQUAL(serial, parallel);
+
+    Vector<double> serial_c(NCOLS), parallel_c(NCOLS);
+    run_serial_and_parallel(serial_c, parallel_c, [&](Vector<double> &w)
+        {
+            vxm(w, NoMask(), NoAccumulate(),
+                ArithmeticSemiring<double>(), v, A);
+        });
+    BOOST_CHECK(serial_c.nvals() > 0);
+    BOOST_CHECK_EQUAL(serial_c, parallel_c);
+
+    run_serial_and_parallel(serial, parallel, [&](Vector<double> &w)
+        {
+            reduce(w, NoMask(), NoAccumulate(), Plus<double>(), A);
+        });
+    BOOST_CHECK_EQUAL(serial, parallel);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_openmp_elementwise_and_structural)
+{
+    Matrix<double> A(NROWS, NCOLS), B(NROWS, NCOLS);
+    build_pattern(A, 8);
+    build_pattern(B, 9);
+
+    Matrix<double> serial(NROWS, NCOLS), parallel(NROWS, NCOLS);
+    run_serial_and_parallel(serial, parallel, [&](Matrix<double> &C)
+        {
+            eWiseAdd(C, NoMask(), NoAccumulate(), Plus<double>(), A, B);
+        });
+    BOOST_CHECK_EQUAL(serial, parallel);
+
+    run_serial_and_parallel(serial, parallel, [&](Matrix<double> &C)
+        {
+            eWiseMult(C, B, Plus<double>(), Times<double>(), A, B);
+        });
+    BOOST_CHECK_EQUAL(serial, parallel);
+
+    run_serial_and_parallel(serial, parallel, [&](Matrix<double> &C)
+        {
+            apply(C, NoMask(), NoAccumulate(), AdditiveInverse<double>(), A);
+        });
+    BOOST_CHECK_EQUAL(serial, parallel);
+
+    Matrix<double> serial_t(NCOLS, NROWS), parallel_t(NCOLS, NROWS);
+    run_serial_and_parallel(serial_t, parallel_t, [&](Matrix<double> &C)
+        {
+            GraphBLAS::transpose(C, NoMask(), NoAccumulate(), A);
+        });
+    BOOST_CHECK_EQUAL(serial_t, parallel_t);
+    for (IndexType r = 0; r < NROWS; ++r)
+        for (IndexType c = 0; c < NCOLS; ++c)
+            BOOST_CHECK_EQUAL(A.hasElement(r, c), parallel_t.hasElement(c, r));
+
+    IndexArrayType rows, cols;
+    for (IndexType k = 0; k < NROWS; k += 2) rows.push_back(NROWS - 1 - k);
+    for (IndexType c = 0; c < NCOLS; c += 3) cols.push_back(c);
+
+    Matrix<double> serial_e(rows.size(), cols.size());
+    Matrix<double> parallel_e(rows.size(), cols.size());
+    run_serial_and_parallel(serial_e, parallel_e, [&](Matrix<double> &C)
+        {
+            extract(C, NoMask(), NoAccumulate(), A, rows, cols);
+        });
+    BOOST_CHECK_EQUAL(serial_e, parallel_e);
+
+    run_serial_and_parallel(serial, parallel, [&](Matrix<double> &C)
+        {
+            C = B;
+            assign(C, NoMask(), Plus<double>(), serial_e, rows, cols);
+        });
+    BOOST_CHECK_EQUAL(serial, parallel);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,238 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+
+#ifndef GB_SEQUENTIAL_BITMAP_HPP
+#define GB_SEQUENTIAL_BITMAP_HPP
+
+#include <cstdint>
+#include <vector>
+#include <utility>
+
+#include <graphblas/types.hpp>
+
+//****************************************************************************
+
+namespace GraphBLAS
+{
+    namespace backend
+    {
+        /// Number of set bits in a word.
+        inline IndexType popcount_word(uint64_t word)
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            return static_cast<IndexType>(__builtin_popcountll(word));
+#else
+            IndexType count(0);
+            for (; word != 0; word &= word - 1)
+            {
+                ++count;
+            }
+            return count;
+#endif
+        }
+
+        /// Position of the lowest set bit of a non-zero word.
+        inline IndexType ctz_word(uint64_t word)
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            return static_cast<IndexType>(__builtin_ctzll(word));
+#else
+            IndexType pos(0);
+            for (; (word & 1ULL) == 0; word >>= 1)
+            {
+                ++pos;
+            }
+            return pos;
+#endif
+        }
+
+        /// Call f(base + i) for every set bit i of word, in increasing order.
+        template <typename FunctionT>
+        inline void for_each_bit(uint64_t word, IndexType base, FunctionT f)
+        {
+            for (; word != 0; word &= word - 1)
+            {
+                f(base + ctz_word(word));
+            }
+        }
+
+        /**
+         * @brief Fixed size set of bits packed 64 to a word.
+         *
+         * Replaces std::vector<bool> as the structure of BitmapSparseVector:
+         * counting uses popcount and the set bits are visited with a
+         * count-trailing-zeros loop, so scans skip 64 empty positions at a
+         * time.  The bits past size() in the last word are always zero,
+         * which lets whole-word operations ignore the tail.
+         *
+         * @note Writers of different bits in the same word race; parallel
+         *       writers must own whole words.
+         */
+        class Bitmap
+        {
+        public:
+            typedef uint64_t WordType;
+            static const IndexType WORD_BITS = 64;
+
+            Bitmap() : m_size(0) {}
+
+            Bitmap(IndexType nbits, bool value = false)
+            {
+                assign(nbits, value);
+            }
+
+            /// Resize to nbits, all of them set to value.
+            void assign(IndexType nbits, bool value)
+            {
+                m_size = nbits;
+                m_words.assign(num_words(nbits), value ? ~WordType(0) : 0);
+                clear_tail();
+            }
+
+            /// Reset every bit; the size does not change.
+            void clear()
+            {
+                m_words.assign(m_words.size(), 0);
+            }
+
+            IndexType size()   const { return m_size; }
+            IndexType nwords() const { return m_words.size(); }
+
+            bool operator[](IndexType idx) const
+            {
+                return ((m_words[idx / WORD_BITS] >> (idx % WORD_BITS)) & 1ULL)
+                    != 0;
+            }
+
+            void set(IndexType idx)
+            {
+                m_words[idx / WORD_BITS] |= (1ULL << (idx % WORD_BITS));
+            }
+
+            void reset(IndexType idx)
+            {
+                m_words[idx / WORD_BITS] &= ~(1ULL << (idx % WORD_BITS));
+            }
+
+            WordType word(IndexType widx) const { return m_words[widx]; }
+
+            /// Overwrite a whole word (bits past size() are dropped).
+            void set_word(IndexType widx, WordType bits)
+            {
+                m_words[widx] = bits & tail_mask(widx);
+            }
+
+            /// All bits of word widx that lie inside the bitmap.
+            WordType tail_mask(IndexType widx) const
+            {
+                IndexType rem(m_size % WORD_BITS);
+                return ((widx + 1 == m_words.size()) && (rem != 0)) ?
+                    ((1ULL << rem) - 1) : ~WordType(0);
+            }
+
+            /// Number of set bits.
+            IndexType count() const
+            {
+                IndexType total(0);
+                for (auto word : m_words)
+                {
+                    total += popcount_word(word);
+                }
+                return total;
+            }
+
+            /// First set bit at or after idx, or size() if there is none.
+            IndexType find_next(IndexType idx) const
+            {
+                if (idx >= m_size)
+                {
+                    return m_size;
+                }
+
+                IndexType widx(idx / WORD_BITS);
+                WordType word(m_words[widx] & (~WordType(0) << (idx % WORD_BITS)));
+                while (word == 0)
+                {
+                    if (++widx == m_words.size())
+                    {
+                        return m_size;
+                    }
+                    word = m_words[widx];
+                }
+                return widx * WORD_BITS + ctz_word(word);
+            }
+
+            /// Call f(idx) for every set bit, in increasing order.
+            template <typename FunctionT>
+            void for_each(FunctionT f) const
+            {
+                for (IndexType widx = 0; widx < m_words.size(); ++widx)
+                {
+                    for_each_bit(m_words[widx], widx * WORD_BITS, f);
+                }
+            }
+
+            void swap(Bitmap &rhs)
+            {
+                std::swap(m_size, rhs.m_size);
+                m_words.swap(rhs.m_words);
+            }
+
+            bool operator==(Bitmap const &rhs) const
+            {
+                return (m_size == rhs.m_size) && (m_words == rhs.m_words);
+            }
+
+            bool operator!=(Bitmap const &rhs) const
+            {
+                return !(*this == rhs);
+            }
+
+            static IndexType num_words(IndexType nbits)
+            {
+                return (nbits + WORD_BITS - 1) / WORD_BITS;
+            }
+
+        private:
+            void clear_tail()
+            {
+                if (!m_words.empty())
+                {
+                    m_words.back() &= tail_mask(m_words.size() - 1);
+                }
+            }
+
+            IndexType              m_size;
+            std::vector<WordType>  m_words;
+        };
+    } // backend
+} // GraphBLAS
+
+#endif // GB_SEQUENTIAL_BITMAP_HPP
@@ -32,14 +32,55 @@
 
 #include <iostream>
 #include <vector>
+#include <algorithm>
+#include <numeric>
+#include <utility>
 #include <typeinfo>
 
+#include <graphblas/platforms/sequential/Bitmap.hpp>
+#include <graphblas/platforms/sequential/dense_kernels.hpp>
+#include <graphblas/platforms/sequential/intersection.hpp>
+
 namespace GraphBLAS
 {
     namespace backend
     {
+        /// Storage forms of a BitmapSparseVector (DENSE_FORM is the bitmap
+        /// form with every element stored).
+        enum VectorForm { SPARSE_FORM, BITMAP_FORM, DENSE_FORM };
+
+        /// Which forms a vector may take: switch on fill, or pinned.
+        enum VectorFormPolicy
+        {
+            FORM_AUTO,
+            FORM_PINNED_SPARSE,
+            FORM_PINNED_DENSE
+        };
+
         /**
          * @brief Class representing a sparse vector by using a bitmap + dense vector
+         *
+         * Sparse vectors are kept instead as a sorted list of indices and
+         * values (the sparse form), so that a vector with a handful of
+         * stored elements costs O(nvals) to fill and scan.  Under FORM_AUTO
+         * a vector moves to the bitmap form when more than 1/SPARSE_RATIO of
+         * its elements are stored and back when fewer than half that are
+         * (checked by the bulk writers: build, setContents, clear and the
+         * element-wise members; setElement only grows into the bitmap).
+         * The element-wise members build their result as a list when their
+         * operands are lists, so they cost O(nvals) and not O(size).
+         *
+         * The bitmap is word packed (see Bitmap); where whole words of the
+         * operands are full, the element-wise members below run the dense
+         * value kernels of dense_kernels.hpp.
+         *
+         * get_bitmap() and get_vals() work in both forms: for a sparse form
+         * vector they fill a cached bitmap copy of the list (O(size) once
+         * per modification), so callers that only walk the stored elements
+         * should prefer getContents().
+         *
+         * @note Filling the cache modifies mutable state of a const vector;
+         *       concurrent readers must not race on the first access.
          */
         template<typename ScalarT>
         class BitmapSparseVector
@@ -47,6 +88,8 @@ namespace GraphBLAS
         public:
             typedef ScalarT ScalarType;
 
+            static const IndexType SPARSE_RATIO = 32;
+
             // Ambiguous with size constructor
             // template <typename OtherVectorT>
             // BitmapSparseVector(OtherVectorT const &rhs)
@@ -70,8 +113,9 @@ namespace GraphBLAS
             BitmapSparseVector(IndexType nsize)
                 : m_size(nsize),
                   m_nvals(0),
-                  m_vals(nsize),
-                  m_bitmap(nsize, false)
+                  m_sparse(true),
+                  m_cache_valid(false),
+                  m_policy(FORM_AUTO)
             {
                 if (nsize == 0)
                 {
@@ -81,9 +125,12 @@ namespace GraphBLAS
 
             BitmapSparseVector(IndexType const &nsize, ScalarT const &value)
                 : m_size(nsize),
-                  m_nvals(0),
+                  m_nvals(nsize),
                   m_vals(nsize, value),
-                  m_bitmap(nsize, true)
+                  m_bitmap(nsize, true),
+                  m_sparse(false),
+                  m_cache_valid(false),
+                  m_policy(FORM_AUTO)
             {
             }
 
@@ -98,7 +145,10 @@ namespace GraphBLAS
                 : m_size(rhs.size()),
                   m_nvals(rhs.size()),
                   m_vals(rhs),
-                  m_bitmap(rhs.size(), true)
+                  m_bitmap(rhs.size(), true),
+                  m_sparse(false),
+                  m_cache_valid(false),
+                  m_policy(FORM_AUTO)
             {
                 if (rhs.size() == 0)
                 {
@@ -120,7 +170,10 @@ namespace GraphBLAS
                 : m_size(rhs.size()),
                   m_nvals(0),
                   m_vals(rhs.size()),
-                  m_bitmap(rhs.size(), false)
+                  m_bitmap(rhs.size(), false),
+                  m_sparse(false),
+                  m_cache_valid(false),
+                  m_policy(FORM_AUTO)
             {
                 if (rhs.size() == 0)
                 {
@@ -132,10 +185,11 @@ namespace GraphBLAS
                     if (rhs[idx] != zero)
                     {
                         m_vals[idx] = rhs[idx];
-                        m_bitmap[idx] = true;
+                        m_bitmap.set(idx);
                         ++m_nvals;
                     }
                 }
+                update_form();
             }
 
             /**
@@ -149,7 +203,10 @@ namespace GraphBLAS
                 : m_size(nsize),
                   m_nvals(0),
                   m_vals(nsize),
-                  m_bitmap(nsize, false)
+                  m_bitmap(nsize, false),
+                  m_sparse(false),
+                  m_cache_valid(false),
+                  m_policy(FORM_AUTO)
             {
                 /// @todo check for same size indices and values
                 for (IndexType idx = 0; idx < indices.size(); ++idx)
@@ -161,9 +218,10 @@ namespace GraphBLAS
                     }
 
                     m_vals[i] = values[idx];
-                    m_bitmap[i] = true;
-                    ++m_nvals;
+                    m_bitmap.set(i);
                 }
+                m_nvals = m_bitmap.count();
+                update_form();
             }
 
             /**
@@ -175,11 +233,42 @@ namespace GraphBLAS
             BitmapSparseVector(BitmapSparseVector<ScalarT> const &rhs)
                 : m_size(rhs.m_size),
                   m_nvals(rhs.m_nvals),
-                  m_vals(rhs.m_vals),
-                  m_bitmap(rhs.m_bitmap)
+                  m_vals(rhs.m_sparse ? std::vector<ScalarT>() : rhs.m_vals),
+                  m_bitmap(rhs.m_sparse ? Bitmap() : rhs.m_bitmap),
+                  m_indices(rhs.m_indices),
+                  m_list_vals(rhs.m_list_vals),
+                  m_sparse(rhs.m_sparse),
+                  m_cache_valid(false),
+                  m_policy(rhs.m_policy)
             {
             }
 
+            /**
+             * @brief Move constructor: takes over the storage of rhs, which
+             *        is left with size 0 (it may only be assigned to or
+             *        destroyed).
+             */
+            BitmapSparseVector(BitmapSparseVector<ScalarT> &&rhs)
+                : m_size(rhs.m_size),
+                  m_nvals(rhs.m_nvals),
+                  m_vals(std::move(rhs.m_vals)),
+                  m_bitmap(std::move(rhs.m_bitmap)),
+                  m_indices(std::move(rhs.m_indices)),
+                  m_list_vals(std::move(rhs.m_list_vals)),
+                  m_sparse(rhs.m_sparse),
+                  m_cache_valid(rhs.m_cache_valid),
+                  m_policy(rhs.m_policy)
+            {
+                rhs.m_size = 0;
+                rhs.m_nvals = 0;
+                rhs.m_vals.clear();
+                rhs.m_bitmap = Bitmap();
+                rhs.m_indices.clear();
+                rhs.m_list_vals.clear();
+                rhs.m_sparse = true;
+                rhs.m_cache_valid = false;
+            }
+
             ~BitmapSparseVector() {}
 
             /**
@@ -200,12 +289,57 @@ namespace GraphBLAS
                     }
 
                     m_nvals = rhs.m_nvals;
-                    m_vals = rhs.m_vals;
-                    m_bitmap = rhs.m_bitmap;
+                    m_sparse = rhs.m_sparse;
+                    m_cache_valid = false;
+                    if (m_sparse)
+                    {
+                        m_indices = rhs.m_indices;
+                        m_list_vals = rhs.m_list_vals;
+                    }
+                    else
+                    {
+                        m_vals = rhs.m_vals;
+                        m_bitmap = rhs.m_bitmap;
+                        m_indices.clear();
+                        m_list_vals.clear();
+                    }
+                    update_form();
+                }
+                return *this;
+            }
+
+            /**
+             * @brief Move assignment: takes over the contents and the size of
+             *        rhs in O(1); rhs is left with size 0, as by the move
+             *        constructor, and the old contents of this are released.
+             */
+            BitmapSparseVector<ScalarT>& operator=(
+                BitmapSparseVector<ScalarT> &&rhs)
+            {
+                if (this != &rhs)
+                {
+                    BitmapSparseVector<ScalarT> tmp(std::move(rhs));
+                    swap(tmp);
                 }
                 return *this;
             }
 
+            /// Exchange contents and size with another vector in O(1).  Each
+            /// vector keeps its own form policy.
+            void swap(BitmapSparseVector<ScalarT> &rhs)
+            {
+                std::swap(m_size, rhs.m_size);
+                std::swap(m_nvals, rhs.m_nvals);
+                m_vals.swap(rhs.m_vals);
+                m_bitmap.swap(rhs.m_bitmap);
+                m_indices.swap(rhs.m_indices);
+                m_list_vals.swap(rhs.m_list_vals);
+                std::swap(m_sparse, rhs.m_sparse);
+                std::swap(m_cache_valid, rhs.m_cache_valid);
+                update_form();
+                rhs.update_form();
+            }
+
             /**
              * @brief Assignment from a dense vector.
              *
@@ -219,12 +353,11 @@ namespace GraphBLAS
                 {
                     throw DimensionException();
                 }
-                for (IndexType idx = 0; idx < rhs.size(); ++idx)
-                {
-                    m_vals[idx] = rhs[idx];
-                    m_bitmap[idx] = true;
-                }
+                m_vals = rhs;
+                m_bitmap.assign(m_size, true);
                 m_nvals = m_size;
+                drop_list();
+                update_form();
                 return *this;
             }
 
@@ -241,19 +374,23 @@ namespace GraphBLAS
                     return false;
                 }
 
-                for (IndexType i = 0; i < m_size; ++i)
+                if (m_sparse || rhs.m_sparse)
                 {
-                    if (m_bitmap[i] != rhs.m_bitmap[i])
+                    return getContents() == rhs.getContents();
+                }
+
+                if (m_bitmap != rhs.m_bitmap)
+                {
+                    return false;
+                }
+
+                for (IndexType i = m_bitmap.find_next(0); i < m_size;
+                     i = m_bitmap.find_next(i + 1))
+                {
+                    if (m_vals[i] != rhs.m_vals[i])
                     {
                         return false;
                     }
-                    if (m_bitmap[i])
-                    {
-                        if (m_vals[i] != rhs.m_vals[i])
-                        {
-                            return false;
-                        }
-                    }
                 }
 
                 return true;
@@ -272,7 +409,8 @@ namespace GraphBLAS
             // FUNCTIONS
 
             /**
-             *
+             * Few enough tuples for the sparse form are sorted (stably, so
+             * dup is applied in input order) instead of scattered.
              */
             template<typename RAIteratorIT,
                      typename RAIteratorVT,
@@ -282,8 +420,49 @@ namespace GraphBLAS
                        IndexType     nvals,
                        BinaryOpT     dup = BinaryOpT())
             {
+                if (prefer_sparse(nvals))
+                {
+                    std::vector<IndexType> order(nvals);
+                    std::iota(order.begin(), order.end(), 0);
+                    for (auto k : order)
+                    {
+                        if (i_it[k] >= m_size)
+                        {
+                            throw IndexOutOfBoundsException();
+                        }
+                    }
+                    std::stable_sort(order.begin(), order.end(),
+                                     [&i_it](IndexType a, IndexType b)
+                                     { return i_it[a] < i_it[b]; });
+
+                    std::vector<IndexType> indices;
+                    std::vector<ScalarType> vals;
+                    indices.reserve(nvals);
+                    vals.reserve(nvals);
+                    for (auto k : order)
+                    {
+                        if (!indices.empty() && (indices.back() == i_it[k]))
+                        {
+                            vals.back() = dup(vals.back(), v_it[k]);
+                        }
+                        else
+                        {
+                            indices.push_back(i_it[k]);
+                            vals.push_back(v_it[k]);
+                        }
+                    }
+
+                    m_indices.swap(indices);
+                    m_list_vals.swap(vals);
+                    m_nvals = m_indices.size();
+                    m_sparse = true;
+                    m_cache_valid = false;
+                    update_form();
+                    return;
+                }
+
                 std::vector<ScalarType> vals(m_size);
-                std::vector<bool> bitmap(m_size);
+                Bitmap bitmap(m_size);
 
                 /// @todo check for same size indices and values
                 for (IndexType idx = 0; idx < nvals; ++idx)
@@ -294,32 +473,62 @@ namespace GraphBLAS
                         throw IndexOutOfBoundsException();
                     }
 
-                    if (bitmap[i] == true)
+                    if (bitmap[i])
                     {
                         vals[i] = dup(vals[i], v_it[idx]);
                     }
                     else
                     {
                         vals[i] = v_it[idx];
-                        bitmap[i] = true;
+                        bitmap.set(i);
                     }
                 }
 
                 m_vals.swap(vals);
                 m_bitmap.swap(bitmap);
-                m_nvals = nvals;
+                m_nvals = m_bitmap.count();  // duplicates were merged
+                drop_list();
+                update_form();
             }
 
             void clear()
             {
                 m_nvals = 0;
-                //m_vals.clear();
-                m_bitmap.assign(m_size, false);
+                if (m_sparse)
+                {
+                    m_indices.clear();
+                    m_list_vals.clear();
+                    m_cache_valid = false;
+                }
+                else
+                {
+                    //m_vals.clear();
+                    m_bitmap.clear();
+                }
+                update_form();
             }
 
             IndexType size() const { return m_size; }
             IndexType nvals() const { return m_nvals; }
 
+            /// The current storage form.
+            VectorForm form() const
+            {
+                return (m_sparse ? SPARSE_FORM :
+                        ((m_nvals == m_size) ? DENSE_FORM : BITMAP_FORM));
+            }
+
+            bool isSparseForm() const { return m_sparse; }
+
+            VectorFormPolicy formPolicy() const { return m_policy; }
+
+            /// Choose (or pin) the storage form; converts if needed.
+            void setFormPolicy(VectorFormPolicy policy)
+            {
+                m_policy = policy;
+                update_form();
+            }
+
             bool hasElement(IndexType index) const
             {
                 if (index >= m_size)
@@ -327,6 +536,11 @@ namespace GraphBLAS
                     throw IndexOutOfBoundsException();
                 }
 
+                if (m_sparse)
+                {
+                    return std::binary_search(m_indices.begin(),
+                                              m_indices.end(), index);
+                }
                 return m_bitmap[index];
             }
 
@@ -348,6 +562,17 @@ namespace GraphBLAS
                     throw IndexOutOfBoundsException();
                 }
 
+                if (m_sparse)
+                {
+                    auto it = std::lower_bound(m_indices.begin(),
+                                               m_indices.end(), index);
+                    if ((it == m_indices.end()) || (*it != index))
+                    {
+                        throw NoValueException();
+                    }
+                    return m_list_vals[it - m_indices.begin()];
+                }
+
                 if (m_bitmap[index] == false)
                 {
                     throw NoValueException();
@@ -364,11 +589,41 @@ namespace GraphBLAS
                 {
                     throw IndexOutOfBoundsException();
                 }
+
+                if (m_sparse)
+                {
+                    auto it = std::lower_bound(m_indices.begin(),
+                                               m_indices.end(), index);
+                    auto pos(it - m_indices.begin());
+                    if ((it != m_indices.end()) && (*it == index))
+                    {
+                        m_list_vals[pos] = new_val;
+                    }
+                    else
+                    {
+                        m_indices.insert(it, index);
+                        m_list_vals.insert(m_list_vals.begin() + pos, new_val);
+                        ++m_nvals;
+                    }
+
+                    if (m_cache_valid)
+                    {
+                        m_vals[index] = new_val;
+                        m_bitmap.set(index);
+                    }
+                    if ((m_policy == FORM_AUTO) &&
+                        (m_nvals > m_size / SPARSE_RATIO))
+                    {
+                        to_bitmap_form();
+                    }
+                    return;
+                }
+
                 m_vals[index] = new_val;
-                if (m_bitmap[index] == false)
+                if (!m_bitmap[index])
                 {
                     ++m_nvals;
-                    m_bitmap[index] = true;
+                    m_bitmap.set(index);
                 }
             }
 
@@ -377,14 +632,19 @@ namespace GraphBLAS
             void extractTuples(RAIteratorIT        i_it,
                                RAIteratorVT        v_it) const
             {
-                for (IndexType idx = 0; idx < m_size; ++idx)
+                if (m_sparse)
                 {
-                    if (m_bitmap[idx])
+                    std::copy(m_indices.begin(), m_indices.end(), i_it);
+                    std::copy(m_list_vals.begin(), m_list_vals.end(), v_it);
+                    return;
+                }
+
+                m_bitmap.for_each(
+                    [&](IndexType idx)
                     {
                         *i_it = idx; ++i_it;
                         *v_it = m_vals[idx]; ++v_it;
-                    }
-                }
+                    });
             }
 
             void extractTuples(IndexArrayType        &indices,
@@ -400,11 +660,13 @@ namespace GraphBLAS
                 //os << "size  = " << m_size;
                 //os << ", nvals = " << m_nvals << std::endl;
                 //os << "contents: [";
+                auto const &bitmap(get_bitmap());
+                auto const &vals(get_vals());
                 os << "[";
-                if (m_bitmap[0]) os << m_vals[0]; else os << "-";
+                if (bitmap[0]) os << vals[0]; else os << "-";
                 for (IndexType idx = 1; idx < m_size; ++idx)
                 {
-                    if (m_bitmap[idx]) os << ", " << m_vals[idx]; else os << ", -";
+                    if (bitmap[idx]) os << ", " << vals[idx]; else os << ", -";
                 }
                 os << "]";
             }
@@ -416,41 +678,595 @@ namespace GraphBLAS
                 return os;
             }
 
-            std::vector<bool> const &get_bitmap() const { return m_bitmap; }
-            std::vector<ScalarT> const &get_vals() const { return m_vals; }
+            /// The bitmap and dense values (filled from the list first in the
+            /// sparse form).
+            Bitmap const &get_bitmap() const
+            {
+                fill_cache();
+                return m_bitmap;
+            }
+
+            std::vector<ScalarT> const &get_vals() const
+            {
+                fill_cache();
+                return m_vals;
+            }
+
+            /// The stored indices (in increasing order) and values of a
+            /// sparse form vector; empty in the bitmap form.
+            std::vector<IndexType> const &get_indices() const
+            {
+                return m_indices;
+            }
+
+            std::vector<ScalarT> const &get_list_vals() const
+            {
+                return m_list_vals;
+            }
 
             std::vector<std::tuple<IndexType,ScalarT> > getContents() const
             {
                 std::vector<std::tuple<IndexType,ScalarT> > contents;
                 contents.reserve(m_nvals);
-                for (IndexType idx = 0; idx < m_size; ++idx)
+                if (m_sparse)
                 {
-                    if (m_bitmap[idx])
+                    for (IndexType k = 0; k < m_indices.size(); ++k)
                     {
-                        contents.push_back(std::make_tuple(idx, m_vals[idx]));
+                        contents.push_back(std::make_tuple(m_indices[k],
+                                                           m_list_vals[k]));
                     }
+                    return contents;
                 }
+
+                m_bitmap.for_each(
+                    [&](IndexType idx)
+                    {
+                        contents.push_back(std::make_tuple(idx, m_vals[idx]));
+                    });
                 return contents;
             }
 
+            /// @param[in] contents  Stored elements, sorted by index.
             template <typename OtherScalarT>
             void setContents(
                 std::vector<std::tuple<IndexType,OtherScalarT> > const &contents)
             {
-                clear();
-                for (auto tupl : contents)
+                m_nvals = contents.size();
+                if (prefer_sparse(contents.size()))
                 {
-                    ++m_nvals;
-                    m_bitmap[std::get<0>(tupl)] = true;
+                    m_indices.resize(contents.size());
+                    m_list_vals.resize(contents.size());
+                    for (IndexType k = 0; k < contents.size(); ++k)
+                    {
+                        m_indices[k] = std::get<0>(contents[k]);
+                        m_list_vals[k] =
+                            static_cast<ScalarT>(std::get<1>(contents[k]));
+                    }
+                    m_sparse = true;
+                    m_cache_valid = false;
+                    return;
+                }
+
+                if (m_sparse)
+                {
+                    allocate_dense();
+                    drop_list();
+                }
+                else
+                {
+                    m_bitmap.clear();
+                }
+                for (auto const &tupl : contents)
+                {
+                    m_bitmap.set(std::get<0>(tupl));
                     m_vals[std::get<0>(tupl)] = static_cast<ScalarT>(std::get<1>(tupl));
                 }
             }
 
+            /**
+             * @brief this = u (union) v: op where both are stored, else
+             *        whichever is stored, cast to ScalarT.
+             *
+             * this may alias u or v (e.g. accumulating v into this).
+             */
+            template <typename UScalarT, typename VScalarT, typename BinaryOpT>
+            void ewise_or(BitmapSparseVector<UScalarT> const &u,
+                          BitmapSparseVector<VScalarT> const &v,
+                          BinaryOpT                           op)
+            {
+                check_size(u.size());
+                check_size(v.size());
+                if (u.isSparseForm() && v.isSparseForm())
+                {
+                    // merge the two lists
+                    auto const &u_idx(u.get_indices());
+                    auto const &v_idx(v.get_indices());
+                    auto const &u_vals(u.get_list_vals());
+                    auto const &v_vals(v.get_list_vals());
+
+                    std::vector<IndexType> indices;
+                    std::vector<ScalarT>   vals;
+                    indices.reserve(u_idx.size() + v_idx.size());
+                    vals.reserve(u_idx.size() + v_idx.size());
+                    IndexType ku(0), kv(0);
+                    while ((ku < u_idx.size()) || (kv < v_idx.size()))
+                    {
+                        if ((kv == v_idx.size()) ||
+                            ((ku < u_idx.size()) && (u_idx[ku] < v_idx[kv])))
+                        {
+                            indices.push_back(u_idx[ku]);
+                            vals.push_back(static_cast<ScalarT>(u_vals[ku]));
+                            ++ku;
+                        }
+                        else if ((ku == u_idx.size()) || (v_idx[kv] < u_idx[ku]))
+                        {
+                            indices.push_back(v_idx[kv]);
+                            vals.push_back(static_cast<ScalarT>(v_vals[kv]));
+                            ++kv;
+                        }
+                        else
+                        {
+                            indices.push_back(u_idx[ku]);
+                            vals.push_back(static_cast<ScalarT>(
+                                               op(u_vals[ku], v_vals[kv])));
+                            ++ku;
+                            ++kv;
+                        }
+                    }
+                    take_list(indices, vals);
+                    return;
+                }
+
+                to_bitmap_form();
+                auto const &u_bitmap(u.get_bitmap());
+                auto const &v_bitmap(v.get_bitmap());
+                auto const &u_vals(u.get_vals());
+                auto const &v_vals(v.get_vals());
+
+                m_nvals = 0;
+                IndexType widx(0);
+                while (widx < m_bitmap.nwords())
+                {
+                    IndexType run_end(widx);
+                    while ((run_end < m_bitmap.nwords()) &&
+                           ((u_bitmap.word(run_end) & v_bitmap.word(run_end)) ==
+                            ~Bitmap::WordType(0)))
+                    {
+                        ++run_end;
+                    }
+                    if (run_end > widx)
+                    {
+                        dense_binary(m_vals, u_vals, v_vals,
+                                     widx * Bitmap::WORD_BITS,
+                                     run_end * Bitmap::WORD_BITS, op);
+                        set_full_words(widx, run_end);
+                        widx = run_end;
+                        continue;
+                    }
+
+                    Bitmap::WordType u_word(u_bitmap.word(widx));
+                    Bitmap::WordType v_word(v_bitmap.word(widx));
+                    IndexType base(widx * Bitmap::WORD_BITS);
+                    for_each_bit(u_word & v_word, base, [&](IndexType idx)
+                        { m_vals[idx] = static_cast<ScalarT>(
+                                op(u_vals[idx], v_vals[idx])); });
+                    for_each_bit(u_word & ~v_word, base, [&](IndexType idx)
+                        { m_vals[idx] = static_cast<ScalarT>(u_vals[idx]); });
+                    for_each_bit(v_word & ~u_word, base, [&](IndexType idx)
+                        { m_vals[idx] = static_cast<ScalarT>(v_vals[idx]); });
+                    m_bitmap.set_word(widx, u_word | v_word);
+                    m_nvals += popcount_word(u_word | v_word);
+                    ++widx;
+                }
+                update_form();
+            }
+
+            /**
+             * @brief this = u (intersection) v: op where both are stored.
+             */
+            template <typename UScalarT, typename VScalarT, typename BinaryOpT>
+            void ewise_and(BitmapSparseVector<UScalarT> const &u,
+                           BitmapSparseVector<VScalarT> const &v,
+                           BinaryOpT                           op)
+            {
+                check_size(u.size());
+                check_size(v.size());
+                if (u.isSparseForm() || v.isSparseForm())
+                {
+                    std::vector<IndexType> indices;
+                    std::vector<ScalarT>   vals;
+                    if (u.isSparseForm() && v.isSparseForm())
+                    {
+                        // intersect the two lists
+                        auto const &u_idx(u.get_indices());
+                        auto const &v_idx(v.get_indices());
+                        auto const &u_vals(u.get_list_vals());
+                        auto const &v_vals(v.get_list_vals());
+                        intersect_sorted(
+                            u_idx.data(), u_idx.size(),
+                            v_idx.data(), v_idx.size(),
+                            [&](std::size_t ku, std::size_t kv)
+                            {
+                                indices.push_back(u_idx[ku]);
+                                vals.push_back(static_cast<ScalarT>(
+                                                   op(u_vals[ku], v_vals[kv])));
+                                return true;
+                            });
+                    }
+                    else if (u.isSparseForm())
+                    {
+                        // walk u's list, probing v's bitmap
+                        auto const &u_idx(u.get_indices());
+                        auto const &u_vals(u.get_list_vals());
+                        auto const &v_bitmap(v.get_bitmap());
+                        auto const &v_vals(v.get_vals());
+                        for (IndexType k = 0; k < u_idx.size(); ++k)
+                        {
+                            if (v_bitmap[u_idx[k]])
+                            {
+                                indices.push_back(u_idx[k]);
+                                vals.push_back(static_cast<ScalarT>(
+                                                   op(u_vals[k],
+                                                      v_vals[u_idx[k]])));
+                            }
+                        }
+                    }
+                    else
+                    {
+                        // walk v's list, probing u's bitmap
+                        auto const &v_idx(v.get_indices());
+                        auto const &v_vals(v.get_list_vals());
+                        auto const &u_bitmap(u.get_bitmap());
+                        auto const &u_vals(u.get_vals());
+                        for (IndexType k = 0; k < v_idx.size(); ++k)
+                        {
+                            if (u_bitmap[v_idx[k]])
+                            {
+                                indices.push_back(v_idx[k]);
+                                vals.push_back(static_cast<ScalarT>(
+                                                   op(u_vals[v_idx[k]],
+                                                      v_vals[k])));
+                            }
+                        }
+                    }
+                    take_list(indices, vals);
+                    return;
+                }
+
+                to_bitmap_form();
+                auto const &u_bitmap(u.get_bitmap());
+                auto const &v_bitmap(v.get_bitmap());
+                auto const &u_vals(u.get_vals());
+                auto const &v_vals(v.get_vals());
+
+                m_nvals = 0;
+                IndexType widx(0);
+                while (widx < m_bitmap.nwords())
+                {
+                    IndexType run_end(widx);
+                    while ((run_end < m_bitmap.nwords()) &&
+                           ((u_bitmap.word(run_end) & v_bitmap.word(run_end)) ==
+                            ~Bitmap::WordType(0)))
+                    {
+                        ++run_end;
+                    }
+                    if (run_end > widx)
+                    {
+                        dense_binary(m_vals, u_vals, v_vals,
+                                     widx * Bitmap::WORD_BITS,
+                                     run_end * Bitmap::WORD_BITS, op);
+                        set_full_words(widx, run_end);
+                        widx = run_end;
+                        continue;
+                    }
+
+                    Bitmap::WordType both(u_bitmap.word(widx) &
+                                          v_bitmap.word(widx));
+                    for_each_bit(both, widx * Bitmap::WORD_BITS,
+                                 [&](IndexType idx)
+                        { m_vals[idx] = static_cast<ScalarT>(
+                                op(u_vals[idx], v_vals[idx])); });
+                    m_bitmap.set_word(widx, both);
+                    m_nvals += popcount_word(both);
+                    ++widx;
+                }
+                update_form();
+            }
+
+            /**
+             * @brief this = op(u) at every element stored in u.
+             */
+            template <typename UScalarT, typename UnaryOpT>
+            void apply(BitmapSparseVector<UScalarT> const &u,
+                       UnaryOpT                            op)
+            {
+                check_size(u.size());
+                if (u.isSparseForm())
+                {
+                    auto const &u_vals(u.get_list_vals());
+                    std::vector<IndexType> indices(u.get_indices());
+                    std::vector<ScalarT>   vals;
+                    vals.reserve(u_vals.size());
+                    for (auto const &u_val : u_vals)
+                    {
+                        vals.push_back(static_cast<ScalarT>(op(u_val)));
+                    }
+                    take_list(indices, vals);
+                    return;
+                }
+
+                to_bitmap_form();
+                auto const &u_bitmap(u.get_bitmap());
+                auto const &u_vals(u.get_vals());
+
+                m_nvals = 0;
+                IndexType widx(0);
+                while (widx < m_bitmap.nwords())
+                {
+                    IndexType run_end(widx);
+                    while ((run_end < m_bitmap.nwords()) &&
+                           (u_bitmap.word(run_end) == ~Bitmap::WordType(0)))
+                    {
+                        ++run_end;
+                    }
+                    if (run_end > widx)
+                    {
+                        dense_unary(m_vals, u_vals,
+                                    widx * Bitmap::WORD_BITS,
+                                    run_end * Bitmap::WORD_BITS, op);
+                        set_full_words(widx, run_end);
+                        widx = run_end;
+                        continue;
+                    }
+
+                    Bitmap::WordType u_word(u_bitmap.word(widx));
+                    for_each_bit(u_word, widx * Bitmap::WORD_BITS,
+                                 [&](IndexType idx)
+                        { m_vals[idx] = static_cast<ScalarT>(
+                                op(u_vals[idx])); });
+                    m_bitmap.set_word(widx, u_word);
+                    m_nvals += popcount_word(u_word);
+                    ++widx;
+                }
+                update_form();
+            }
+
+            /**
+             * @brief this = op(u(i), i, 0) at every element stored in u
+             *        (index unary op).
+             */
+            template <typename UScalarT, typename IndexUnaryOpT>
+            void apply_index(BitmapSparseVector<UScalarT> const &u,
+                             IndexUnaryOpT                       op)
+            {
+                check_size(u.size());
+                if (u.isSparseForm())
+                {
+                    auto const &u_vals(u.get_list_vals());
+                    std::vector<IndexType> indices(u.get_indices());
+                    std::vector<ScalarT>   vals;
+                    vals.reserve(u_vals.size());
+                    for (IndexType k = 0; k < indices.size(); ++k)
+                    {
+                        vals.push_back(static_cast<ScalarT>(
+                                           op(u_vals[k], indices[k], 0)));
+                    }
+                    take_list(indices, vals);
+                    return;
+                }
+
+                to_bitmap_form();
+                auto const &u_bitmap(u.get_bitmap());
+                auto const &u_vals(u.get_vals());
+
+                m_nvals = 0;
+                for (IndexType widx = 0; widx < m_bitmap.nwords(); ++widx)
+                {
+                    Bitmap::WordType u_word(u_bitmap.word(widx));
+                    for_each_bit(u_word, widx * Bitmap::WORD_BITS,
+                                 [&](IndexType idx)
+                        { m_vals[idx] = static_cast<ScalarT>(
+                                op(u_vals[idx], idx, 0)); });
+                    m_bitmap.set_word(widx, u_word);
+                    m_nvals += popcount_word(u_word);
+                }
+                update_form();
+            }
+
+            /**
+             * @brief this = u(i) at every element stored in u for which
+             *        op(u(i), i, 0) is true.
+             */
+            template <typename UScalarT, typename IndexUnaryOpT>
+            void select(BitmapSparseVector<UScalarT> const &u,
+                        IndexUnaryOpT                       op)
+            {
+                check_size(u.size());
+                if (u.isSparseForm())
+                {
+                    auto const &u_idx(u.get_indices());
+                    auto const &u_vals(u.get_list_vals());
+                    std::vector<IndexType> indices;
+                    std::vector<ScalarT>   vals;
+                    for (IndexType k = 0; k < u_idx.size(); ++k)
+                    {
+                        if (op(u_vals[k], u_idx[k], 0))
+                        {
+                            indices.push_back(u_idx[k]);
+                            vals.push_back(static_cast<ScalarT>(u_vals[k]));
+                        }
+                    }
+                    take_list(indices, vals);
+                    return;
+                }
+
+                to_bitmap_form();
+                auto const &u_bitmap(u.get_bitmap());
+                auto const &u_vals(u.get_vals());
+
+                m_nvals = 0;
+                for (IndexType widx = 0; widx < m_bitmap.nwords(); ++widx)
+                {
+                    Bitmap::WordType kept(0);
+                    for_each_bit(u_bitmap.word(widx), widx * Bitmap::WORD_BITS,
+                                 [&](IndexType idx)
+                        {
+                            if (op(u_vals[idx], idx, 0))
+                            {
+                                m_vals[idx] = static_cast<ScalarT>(u_vals[idx]);
+                                kept |= Bitmap::WordType(1)
+                                    << (idx % Bitmap::WORD_BITS);
+                            }
+                        });
+                    m_bitmap.set_word(widx, kept);
+                    m_nvals += popcount_word(kept);
+                }
+                update_form();
+            }
+
         private:
-            IndexType const       m_size;   // immutable after construction
+            void check_size(IndexType operand_size) const
+            {
+                if (operand_size != m_size)
+                {
+                    throw DimensionException();
+                }
+            }
+
+            void set_full_words(IndexType widx, IndexType run_end)
+            {
+                m_nvals += (run_end - widx) * Bitmap::WORD_BITS;
+                for (; widx < run_end; ++widx)
+                {
+                    m_bitmap.set_word(widx, ~Bitmap::WordType(0));
+                }
+            }
+
+            /// Whether nvals stored elements belong in the sparse form.
+            bool prefer_sparse(IndexType nvals) const
+            {
+                if (m_policy != FORM_AUTO)
+                {
+                    return (m_policy == FORM_PINNED_SPARSE);
+                }
+                // stay in the current form between the two thresholds
+                return m_sparse ? (nvals <= m_size / SPARSE_RATIO)
+                                : (nvals < m_size / (2 * SPARSE_RATIO));
+            }
+
+            /// Make a sorted list the contents.  The element-wise members
+            /// build it apart, as this may alias an operand.
+            void take_list(std::vector<IndexType> &indices,
+                           std::vector<ScalarT>   &vals)
+            {
+                m_indices.swap(indices);
+                m_list_vals.swap(vals);
+                m_nvals = m_indices.size();
+                m_sparse = true;
+                m_cache_valid = false;
+                update_form();
+            }
+
+            void update_form()
+            {
+                if (m_sparse != prefer_sparse(m_nvals))
+                {
+                    if (m_sparse)
+                    {
+                        to_bitmap_form();
+                    }
+                    else
+                    {
+                        to_sparse_form();
+                    }
+                }
+            }
+
+            /// Size (and clear) the bitmap and values of a sparse form vector.
+            void allocate_dense() const
+            {
+                if (m_vals.size() != m_size)
+                {
+                    m_vals.resize(m_size);
+                }
+                if (m_bitmap.size() != m_size)
+                {
+                    m_bitmap.assign(m_size, false);
+                }
+                else
+                {
+                    m_bitmap.clear();
+                }
+            }
+
+            void fill_cache() const
+            {
+                if (!m_sparse || m_cache_valid)
+                {
+                    return;
+                }
+
+                allocate_dense();
+                for (IndexType k = 0; k < m_indices.size(); ++k)
+                {
+                    m_bitmap.set(m_indices[k]);
+                    m_vals[m_indices[k]] = m_list_vals[k];
+                }
+                m_cache_valid = true;
+            }
+
+            void drop_list()
+            {
+                m_indices.clear();
+                m_list_vals.clear();
+                m_sparse = false;
+                m_cache_valid = false;
+            }
+
+            void to_bitmap_form()
+            {
+                if (m_sparse)
+                {
+                    fill_cache();
+                    drop_list();
+                }
+            }
+
+            /// The dense arrays keep their memory for a later switch back.
+            void to_sparse_form()
+            {
+                if (!m_sparse)
+                {
+                    m_indices.clear();
+                    m_list_vals.clear();
+                    m_indices.reserve(m_nvals);
+                    m_list_vals.reserve(m_nvals);
+                    m_bitmap.for_each(
+                        [this](IndexType idx)
+                        {
+                            m_indices.push_back(idx);
+                            m_list_vals.push_back(m_vals[idx]);
+                        });
+                    m_sparse = true;
+                    m_cache_valid = true;
+                }
+            }
+
+            IndexType             m_size;   // changed only by swap and moves
             IndexType             m_nvals;
-            std::vector<ScalarT>  m_vals;
-            std::vector<bool>     m_bitmap;
+
+            // bitmap form; in the sparse form a cache of the list that is
+            // current only while m_cache_valid is set
+            mutable std::vector<ScalarT>  m_vals;
+            mutable Bitmap                m_bitmap;
+
+            // sparse form: stored indices in increasing order, and values
+            std::vector<IndexType>  m_indices;
+            std::vector<ScalarT>    m_list_vals;
+
+            bool                    m_sparse;
+            mutable bool            m_cache_valid;
+            VectorFormPolicy        m_policy;
         };
     } // backend
 } // GraphBLAS
@@ -0,0 +1,181 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+#ifndef GB_SEQUENTIAL_COLUMNINDEX_HPP
+#define GB_SEQUENTIAL_COLUMNINDEX_HPP
+
+#include <vector>
+#include <tuple>
+#include <utility>
+
+#include <graphblas/types.hpp>
+#include <graphblas/platforms/sequential/SparseRow.hpp>
+
+//****************************************************************************
+
+namespace GraphBLAS
+{
+    namespace backend
+    {
+        /**
+         * @brief Optional column-major (CSC) companion index for the row
+         *        oriented matrix storage classes.
+         *
+         * When enabled, the index is built on the first column access after
+         * a modification (one counting-sort pass over the rows) and cached
+         * until the owning matrix invalidates it, making column access
+         * O(column length) instead of a scan of every stored value.
+         *
+         * @note Building the index modifies mutable state of a const matrix;
+         *       concurrent readers must not race on the first column access.
+         */
+        template<typename ScalarT>
+        class ColumnIndex
+        {
+        public:
+            typedef std::vector<std::tuple<IndexType, ScalarT> > ColType;
+
+            ColumnIndex() : m_enabled(false), m_valid(false) {}
+
+            void enable(bool flag = true)
+            {
+                m_enabled = flag;
+                invalidate();
+            }
+
+            bool enabled() const { return m_enabled; }
+            bool valid()   const { return m_valid; }
+
+            void swap(ColumnIndex &rhs)
+            {
+                std::swap(m_enabled, rhs.m_enabled);
+                std::swap(m_valid, rhs.m_valid);
+                m_col_ptr.swap(rhs.m_col_ptr);
+                m_row_idx.swap(rhs.m_row_idx);
+                m_vals.swap(rhs.m_vals);
+            }
+
+            void invalidate()
+            {
+                if (m_valid)
+                {
+                    m_valid = false;
+                    m_col_ptr.clear();
+                    m_row_idx.clear();
+                    m_vals.clear();
+                }
+            }
+
+            /// Build (if stale) from any matrix providing getRow().
+            template<typename MatrixT>
+            void update(MatrixT const &mat)
+            {
+                if (m_valid)
+                {
+                    return;
+                }
+
+                IndexType num_rows(mat.nrows());
+                IndexType num_cols(mat.ncols());
+
+                // Count the entries of each column
+                m_col_ptr.assign(num_cols + 1, 0);
+                for (IndexType row_idx = 0; row_idx < num_rows; ++row_idx)
+                {
+                    for (auto const &tupl : mat.getRow(row_idx))
+                    {
+                        ++m_col_ptr[std::get<0>(tupl) + 1];
+                    }
+                }
+                for (IndexType col_idx = 0; col_idx < num_cols; ++col_idx)
+                {
+                    m_col_ptr[col_idx + 1] += m_col_ptr[col_idx];
+                }
+
+                // Scatter, walking the rows in order keeps each column sorted
+                m_row_idx.resize(m_col_ptr[num_cols]);
+                m_vals.resize(m_col_ptr[num_cols]);
+                std::vector<IndexType> next(m_col_ptr.begin(), m_col_ptr.end() - 1);
+                for (IndexType row_idx = 0; row_idx < num_rows; ++row_idx)
+                {
+                    for (auto const &tupl : mat.getRow(row_idx))
+                    {
+                        IndexType ix = next[std::get<0>(tupl)]++;
+                        m_row_idx[ix] = row_idx;
+                        m_vals[ix] = std::get<1>(tupl);
+                    }
+                }
+
+                m_valid = true;
+            }
+
+            ColType getCol(IndexType col_index) const
+            {
+                ColType data;
+                data.reserve(m_col_ptr[col_index + 1] - m_col_ptr[col_index]);
+                for (IndexType ix = m_col_ptr[col_index];
+                     ix < m_col_ptr[col_index + 1]; ++ix)
+                {
+                    data.push_back(std::make_tuple(m_row_idx[ix], m_vals[ix]));
+                }
+                return data;
+            }
+
+            void getCol(IndexType col_index, SparseRow<ScalarT> &col_data) const
+            {
+                col_data.assign(m_row_idx.begin() + m_col_ptr[col_index],
+                                m_row_idx.begin() + m_col_ptr[col_index + 1],
+                                m_vals.begin() + m_col_ptr[col_index]);
+            }
+
+            void getRowIndices(IndexType col_index, IndexArrayType &v) const
+            {
+                v.assign(m_row_idx.begin() + m_col_ptr[col_index],
+                         m_row_idx.begin() + m_col_ptr[col_index + 1]);
+            }
+
+            // Raw CSC arrays (valid only after update())
+            std::vector<IndexType> const &get_col_ptr() const { return m_col_ptr; }
+            std::vector<IndexType> const &get_row_idx() const { return m_row_idx; }
+            std::vector<ScalarT>   const &get_vals()    const { return m_vals; }
+
+        private:
+            bool m_enabled;
+            bool m_valid;
+
+            std::vector<IndexType> m_col_ptr;
+            std::vector<IndexType> m_row_idx;
+            std::vector<ScalarT>   m_vals;
+        };
+
+    } // namespace backend
+
+} // namespace GraphBLAS
+
+#endif // GB_SEQUENTIAL_COLUMNINDEX_HPP
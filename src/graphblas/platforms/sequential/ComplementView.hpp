@@ -80,17 +80,23 @@ namespace GraphBLAS
 
             IndexType nrows() const { return m_matrix.nrows(); }
             IndexType ncols() const { return m_matrix.ncols(); }
+
+            /// The matrix being complemented (lets kernels test the mask
+            /// without generating complemented rows).
+            MatrixT const &getMatrix() const { return m_matrix; }
+
+            void assemble() const { m_matrix.assemble(); }
             IndexType nvals() const
             {
                 IndexType num_vals = (m_matrix.nrows()*m_matrix.ncols() -
                                       m_matrix.nvals());
 
-                // THIS IS COSTLY
-                // Need to detect and deal with stored 'falses' in m_matrix.
-                // They count for stored values in the structural complement
+                // Stored 'falses' in m_matrix count for stored values in
+                // the structural complement; only the stored rows are
+                // visited.
                 for (IndexType ix = 0; ix < nrows(); ++ix)
                 {
-                    auto row = getRow(ix);
+                    auto const &row(m_matrix.getRow(ix));
                     for (auto &ix : row)
                     {
                         if (false == static_cast<bool>(std::get<1>(ix)))
@@ -204,6 +210,8 @@ namespace GraphBLAS
                 throw GraphBLAS::NoValueException();
             }
 
+            /// @note Generates every absent column, O(ncols).  The kernels
+            ///       test complemented masks through MaskRowFilter instead.
             std::vector<std::tuple<IndexType, bool> > getRow(
                 IndexType row) const
             {
@@ -370,12 +378,15 @@ namespace GraphBLAS
             }
 
             IndexType size() const  { return m_vector.size(); }
+
+            /// The vector being complemented.
+            VectorT const &getVector() const { return m_vector; }
             IndexType nvals() const
             {
                 // THIS IS COSTLY
                 IndexType num_vals(0);
-                auto bitmap(m_vector.get_bitmap());
-                auto vals(m_vector.get_vals());
+                auto const &bitmap(m_vector.get_bitmap());
+                auto const &vals(m_vector.get_vals());
 
                 for (IndexType idx = 0; idx < size(); ++idx)
                 {
@@ -462,10 +473,12 @@ namespace GraphBLAS
                 throw GraphBLAS::NoValueException();
             }
 
+            /// @note Generates every absent index, O(size).  The kernels
+            ///       test complemented masks through VectorMaskFilter instead.
             std::vector<std::tuple<IndexType, bool> > getContents() const
             {
-                auto bitmap(m_vector.get_bitmap());
-                auto vals(m_vector.get_vals());
+                auto const &bitmap(m_vector.get_bitmap());
+                auto const &vals(m_vector.get_vals());
 
                 std::vector<std::tuple<IndexType, bool> > contents;
                 //contents.reserve(nvals());
@@ -0,0 +1,218 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+
+#ifndef GB_SEQUENTIAL_CSRARRAY_HPP
+#define GB_SEQUENTIAL_CSRARRAY_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <graphblas/types.hpp>
+
+//****************************************************************************
+
+namespace GraphBLAS
+{
+    namespace backend
+    {
+        /**
+         * @brief One of the flat arrays behind CsrSparseMatrix.
+         *
+         * Reads like a const std::vector.  The elements either live in an
+         * owned std::vector or in read-only memory owned by someone else
+         * (e.g., a memory-mapped file, kept alive by a shared handle).
+         * Copies of a view share the memory.  The storage class only ever
+         * replaces an array as a whole (operator=, assign, clear), which
+         * drops the view, so a mapped matrix stays fully usable: it simply
+         * stops sharing the file once it is modified.
+         */
+        template<typename T>
+        class CsrArray
+        {
+        public:
+            typedef T         value_type;
+            typedef T const  *const_iterator;
+
+            CsrArray() { point_to_owned(); }
+
+            CsrArray(std::size_t n, T const &val) : m_owned(n, val)
+            {
+                point_to_owned();
+            }
+
+            /// View n elements at data; 'keep' (non-null) keeps the memory alive.
+            CsrArray(T const                      *data,
+                     std::size_t                   n,
+                     std::shared_ptr<void const>   keep)
+                : m_data(data), m_size(n), m_keep(keep)
+            {
+            }
+
+            CsrArray(CsrArray const &rhs)
+                : m_owned(rhs.m_owned), m_keep(rhs.m_keep)
+            {
+                share_or_own(rhs);
+            }
+
+            CsrArray &operator=(CsrArray const &rhs)
+            {
+                if (this != &rhs)
+                {
+                    m_owned = rhs.m_owned;
+                    m_keep = rhs.m_keep;
+                    share_or_own(rhs);
+                }
+                return *this;
+            }
+
+            CsrArray(CsrArray &&rhs)
+                : m_owned(std::move(rhs.m_owned)), m_keep(std::move(rhs.m_keep))
+            {
+                share_or_own(rhs);
+                rhs.point_to_owned();
+            }
+
+            CsrArray &operator=(CsrArray &&rhs)
+            {
+                if (this != &rhs)
+                {
+                    m_owned = std::move(rhs.m_owned);
+                    m_keep = std::move(rhs.m_keep);
+                    share_or_own(rhs);
+                    rhs.point_to_owned();
+                }
+                return *this;
+            }
+
+            /// Take over a freshly computed array.
+            CsrArray &operator=(std::vector<T> &&rhs)
+            {
+                m_owned = std::move(rhs);
+                m_keep.reset();
+                point_to_owned();
+                return *this;
+            }
+
+            void assign(std::size_t n, T const &val)
+            {
+                m_owned.assign(n, val);
+                m_keep.reset();
+                point_to_owned();
+            }
+
+            void clear()
+            {
+                m_owned.clear();
+                m_keep.reset();
+                point_to_owned();
+            }
+
+            std::size_t size() const  { return m_size; }
+            bool empty() const        { return (m_size == 0); }
+            T const *data() const     { return m_data; }
+
+            T const &operator[](std::size_t idx) const { return m_data[idx]; }
+            T const &back() const     { return m_data[m_size - 1]; }
+
+            const_iterator begin() const { return m_data; }
+            const_iterator end() const   { return m_data + m_size; }
+
+            /// True while the elements are a view of external memory.
+            bool is_view() const { return static_cast<bool>(m_keep); }
+
+            bool operator==(CsrArray const &rhs) const
+            {
+                return ((m_size == rhs.m_size) &&
+                        std::equal(begin(), end(), rhs.begin()));
+            }
+
+            bool operator!=(CsrArray const &rhs) const
+            {
+                return !(*this == rhs);
+            }
+
+        private:
+            void point_to_owned()
+            {
+                m_data = m_owned.data();
+                m_size = m_owned.size();
+            }
+
+            void share_or_own(CsrArray const &rhs)
+            {
+                if (m_keep)
+                {
+                    m_data = rhs.m_data;
+                    m_size = rhs.m_size;
+                }
+                else
+                {
+                    point_to_owned();
+                }
+            }
+
+            std::vector<T>               m_owned;
+            T const                     *m_data;
+            std::size_t                  m_size;
+            std::shared_ptr<void const>  m_keep;
+        };
+
+        /// The value array type: std::vector<bool> has no contiguous
+        /// storage to view, so bool values are always owned.
+        template<typename ScalarT>
+        struct csr_values
+        {
+            typedef CsrArray<ScalarT> type;
+        };
+
+        template<>
+        struct csr_values<bool>
+        {
+            typedef std::vector<bool> type;
+        };
+
+        template<typename T>
+        inline bool is_view_array(CsrArray<T> const &arr)
+        {
+            return arr.is_view();
+        }
+
+        inline bool is_view_array(std::vector<bool> const &)
+        {
+            return false;
+        }
+
+    } // namespace backend
+
+} // namespace GraphBLAS
+
+#endif // GB_SEQUENTIAL_CSRARRAY_HPP
@@ -0,0 +1,996 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+#ifndef GB_SEQUENTIAL_CSRSPARSEMATRIX_HPP
+#define GB_SEQUENTIAL_CSRSPARSEMATRIX_HPP
+
+#include <iostream>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <utility>
+#include <typeinfo>
+#include <stdexcept>
+
+#include <graphblas/graphblas.hpp>
+#include <graphblas/platforms/sequential/ColumnIndex.hpp>
+#include <graphblas/platforms/sequential/CsrArray.hpp>
+
+//****************************************************************************
+
+namespace GraphBLAS
+{
+    namespace backend
+    {
+        /**
+         * @brief Compressed sparse row (CSR) storage.
+         *
+         * Stored values live in three flat arrays: m_row_ptr (nrows + 1
+         * offsets), m_col_idx and m_vals.  Row-wise kernels can walk these
+         * arrays directly through get_row_ptr(), get_col_idx() and get_vals().
+         * The arrays may be read-only views of external memory (see
+         * adopt_arrays()); they are only ever replaced as a whole, so any
+         * modification leaves the view behind.
+         *
+         * Row replacements (setRow, setElement, setCol) are staged as pending
+         * rows and spliced into the arrays in a single O(nvals) pass the next
+         * time the arrays are needed.  This keeps the "rewrite every row in
+         * order" pattern used by the write stage of every operation linear
+         * instead of quadratic.
+         *
+         * @note Assembling pending rows modifies mutable state from const
+         *       methods; concurrent readers must call assemble() first.
+         */
+        template<typename ScalarT>
+        class CsrSparseMatrix
+        {
+        public:
+            typedef ScalarT ScalarType;
+            typedef typename csr_values<ScalarT>::type ValuesArrayType;
+
+            // Constructor
+            CsrSparseMatrix(IndexType num_rows,
+                            IndexType num_cols)
+                : m_num_rows(num_rows),
+                  m_num_cols(num_cols),
+                  m_nvals(0),
+                  m_row_ptr(num_rows + 1, 0)
+            {
+            }
+
+            // Constructor - copy
+            CsrSparseMatrix(CsrSparseMatrix<ScalarT> const &rhs)
+                : m_num_rows(rhs.m_num_rows),
+                  m_num_cols(rhs.m_num_cols),
+                  m_nvals(rhs.m_nvals),
+                  m_row_ptr(rhs.m_row_ptr),
+                  m_col_idx(rhs.m_col_idx),
+                  m_vals(rhs.m_vals),
+                  m_pending(rhs.m_pending),
+                  m_col_index(rhs.m_col_index)
+            {
+            }
+
+            // Constructor - move (rhs is left as an empty 0 x 0 matrix)
+            CsrSparseMatrix(CsrSparseMatrix<ScalarT> &&rhs)
+                : m_num_rows(0),
+                  m_num_cols(0),
+                  m_nvals(0),
+                  m_row_ptr(1, 0)
+            {
+                m_col_index.enable(rhs.m_col_index.enabled());
+                swap(rhs);
+            }
+
+            // Constructor - dense from dense matrix
+            CsrSparseMatrix(std::vector<std::vector<ScalarT>> const &val)
+                : m_num_rows(val.size()),
+                  m_num_cols(val[0].size()),
+                  m_nvals(0),
+                  m_row_ptr(val.size() + 1, 0)
+            {
+                std::vector<IndexType> row_ptr(m_num_rows + 1, 0);
+                std::vector<IndexType> col_idx;
+                std::vector<ScalarT>   vals;
+                col_idx.reserve(m_num_rows*m_num_cols);
+                vals.reserve(m_num_rows*m_num_cols);
+                for (IndexType ii = 0; ii < m_num_rows; ii++)
+                {
+                    if (val[ii].size() != m_num_cols)
+                    {
+                        throw DimensionException("CsrSparseMatrix(dense ctor)");
+                    }
+
+                    for (IndexType jj = 0; jj < m_num_cols; jj++)
+                    {
+                        col_idx.push_back(jj);
+                        vals.push_back(val[ii][jj]);
+                    }
+                    row_ptr[ii + 1] = col_idx.size();
+                }
+                m_nvals = col_idx.size();
+                m_row_ptr = std::move(row_ptr);
+                m_col_idx = std::move(col_idx);
+                m_vals = std::move(vals);
+            }
+
+            // Constructor - sparse from dense matrix, removing specifed implied zeros
+            CsrSparseMatrix(std::vector<std::vector<ScalarT>> const &val,
+                            ScalarT zero)
+                : m_num_rows(val.size()),
+                  m_num_cols(val[0].size()),
+                  m_nvals(0),
+                  m_row_ptr(val.size() + 1, 0)
+            {
+                std::vector<IndexType> row_ptr(m_num_rows + 1, 0);
+                std::vector<IndexType> col_idx;
+                std::vector<ScalarT>   vals;
+                for (IndexType ii = 0; ii < m_num_rows; ii++)
+                {
+                    if (val[ii].size() != m_num_cols)
+                    {
+                        throw DimensionException("CsrSparseMatrix(dense ctor)");
+                    }
+
+                    for (IndexType jj = 0; jj < m_num_cols; jj++)
+                    {
+                        if (val[ii][jj] != zero)
+                        {
+                            col_idx.push_back(jj);
+                            vals.push_back(val[ii][jj]);
+                        }
+                    }
+                    row_ptr[ii + 1] = col_idx.size();
+                }
+                m_nvals = col_idx.size();
+                m_row_ptr = std::move(row_ptr);
+                m_col_idx = std::move(col_idx);
+                m_vals = std::move(vals);
+            }
+
+            // Destructor
+            ~CsrSparseMatrix()
+            {}
+
+            // Assignment (currently restricted to same dimensions)
+            CsrSparseMatrix<ScalarT> &operator=(CsrSparseMatrix<ScalarT> const &rhs)
+            {
+                if (this != &rhs)
+                {
+                    // push this check to frontend
+                    if ((m_num_rows != rhs.m_num_rows) ||
+                        (m_num_cols != rhs.m_num_cols))
+                    {
+                        throw DimensionException();
+                    }
+
+                    m_nvals = rhs.m_nvals;
+                    m_row_ptr = rhs.m_row_ptr;
+                    m_col_idx = rhs.m_col_idx;
+                    m_vals = rhs.m_vals;
+                    m_pending = rhs.m_pending;
+                    m_col_index.invalidate();
+                }
+                return *this;
+            }
+
+            // Move assignment: takes over the contents and the shape of rhs,
+            // which is left as an empty 0 x 0 matrix (as by the move
+            // constructor); the old contents of this are released.
+            CsrSparseMatrix<ScalarT> &operator=(CsrSparseMatrix<ScalarT> &&rhs)
+            {
+                if (this != &rhs)
+                {
+                    CsrSparseMatrix<ScalarT> tmp(std::move(rhs));
+                    swap(tmp);
+                }
+                return *this;
+            }
+
+            /// Exchange contents and shape with another matrix in O(1).  A
+            /// cached column index goes along when both matrices keep one;
+            /// otherwise it is rebuilt on next use.
+            void swap(CsrSparseMatrix<ScalarT> &rhs)
+            {
+                std::swap(m_num_rows, rhs.m_num_rows);
+                std::swap(m_num_cols, rhs.m_num_cols);
+                std::swap(m_nvals, rhs.m_nvals);
+                std::swap(m_row_ptr, rhs.m_row_ptr);
+                std::swap(m_col_idx, rhs.m_col_idx);
+                std::swap(m_vals, rhs.m_vals);
+                m_pending.swap(rhs.m_pending);
+                if (m_col_index.enabled() == rhs.m_col_index.enabled())
+                {
+                    m_col_index.swap(rhs.m_col_index);
+                }
+                else
+                {
+                    m_col_index.invalidate();
+                    rhs.m_col_index.invalidate();
+                }
+            }
+
+            // EQUALITY OPERATORS
+            /**
+             * @brief Equality testing for CsrSparseMatrix.
+             * @param rhs The right hand side of the equality operation.
+             * @return If this CsrSparseMatrix and rhs are identical.
+             */
+            bool operator==(CsrSparseMatrix<ScalarT> const &rhs) const
+            {
+                if ((m_num_rows != rhs.m_num_rows) ||
+                    (m_num_cols != rhs.m_num_cols) ||
+                    (m_nvals != rhs.m_nvals))
+                {
+                    return false;
+                }
+
+                assemble_rows();
+                rhs.assemble_rows();
+                return ((m_row_ptr == rhs.m_row_ptr) &&
+                        (m_col_idx == rhs.m_col_idx) &&
+                        (m_vals == rhs.m_vals));
+            }
+
+            /**
+             * @brief Inequality testing for CsrSparseMatrix.
+             * @param rhs The right hand side of the inequality operation.
+             * @return If this CsrSparseMatrix and rhs are not identical.
+             */
+            bool operator!=(CsrSparseMatrix<ScalarT> const &rhs) const
+            {
+                return !(*this == rhs);
+            }
+
+            /**
+             * Bulk construction: the (row, col, val) triples are bucketed by
+             * row, each row is sorted by column (stable, so duplicates are
+             * combined with dup in input order), and the arrays are written
+             * in a single pass.  Existing values are kept and are treated as
+             * occurring before all of the new triples.
+             */
+            template<typename RAIteratorI,
+                     typename RAIteratorJ,
+                     typename RAIteratorV,
+                     typename DupT>
+            void build(RAIteratorI  i_it,
+                       RAIteratorJ  j_it,
+                       RAIteratorV  v_it,
+                       IndexType    n,
+                       DupT         dup)
+            {
+                assemble_rows();
+                m_col_index.invalidate();
+
+                IndexType num_tuples = m_nvals + n;
+                std::vector<IndexType> rows, cols;
+                std::vector<ScalarT>   vals;
+                rows.reserve(num_tuples);
+                cols.reserve(num_tuples);
+                vals.reserve(num_tuples);
+
+                for (IndexType row_idx = 0; row_idx < m_num_rows; ++row_idx)
+                {
+                    for (IndexType ix = m_row_ptr[row_idx];
+                         ix < m_row_ptr[row_idx + 1]; ++ix)
+                    {
+                        rows.push_back(row_idx);
+                        cols.push_back(m_col_idx[ix]);
+                        vals.push_back(m_vals[ix]);
+                    }
+                }
+
+                for (IndexType ix = 0; ix < n; ++ix)
+                {
+                    if (*i_it >= m_num_rows || *j_it >= m_num_cols)
+                    {
+                        throw IndexOutOfBoundsException(
+                            "build: index out of bounds");
+                    }
+                    rows.push_back(*i_it);
+                    cols.push_back(*j_it);
+                    vals.push_back(static_cast<ScalarT>(*v_it));
+                    ++i_it; ++j_it; ++v_it;
+                }
+
+                // Counting sort on the row index (stable)
+                std::vector<IndexType> offsets(m_num_rows + 1, 0);
+                for (auto row_idx : rows)
+                {
+                    ++offsets[row_idx + 1];
+                }
+                for (IndexType row_idx = 0; row_idx < m_num_rows; ++row_idx)
+                {
+                    offsets[row_idx + 1] += offsets[row_idx];
+                }
+
+                std::vector<IndexType> perm(num_tuples);
+                std::vector<IndexType> next(offsets.begin(), offsets.end() - 1);
+                for (IndexType ix = 0; ix < num_tuples; ++ix)
+                {
+                    perm[next[rows[ix]]++] = ix;
+                }
+
+                // Sort within each row and combine duplicates
+                std::vector<IndexType> row_ptr(m_num_rows + 1, 0);
+                std::vector<IndexType> col_idx;
+                std::vector<ScalarT>   new_vals;
+                col_idx.reserve(num_tuples);
+                new_vals.reserve(num_tuples);
+
+                for (IndexType row_idx = 0; row_idx < m_num_rows; ++row_idx)
+                {
+                    auto row_begin = perm.begin() + offsets[row_idx];
+                    auto row_end   = perm.begin() + offsets[row_idx + 1];
+                    std::stable_sort(row_begin, row_end,
+                                     [&cols](IndexType a, IndexType b)
+                                     { return cols[a] < cols[b]; });
+
+                    IndexType row_start = col_idx.size();
+                    for (auto it = row_begin; it != row_end; ++it)
+                    {
+                        if ((col_idx.size() > row_start) &&
+                            (col_idx.back() == cols[*it]))
+                        {
+                            new_vals.back() = dup(new_vals.back(), vals[*it]);
+                        }
+                        else
+                        {
+                            col_idx.push_back(cols[*it]);
+                            new_vals.push_back(vals[*it]);
+                        }
+                    }
+                    row_ptr[row_idx + 1] = col_idx.size();
+                }
+
+                m_row_ptr = std::move(row_ptr);
+                m_col_idx = std::move(col_idx);
+                m_vals = std::move(new_vals);
+                m_nvals = m_col_idx.size();
+            }
+
+            void clear()
+            {
+                m_col_index.invalidate();
+                m_nvals = 0;
+                m_row_ptr.assign(m_num_rows + 1, 0);
+                m_col_idx.clear();
+                m_vals.clear();
+                m_pending.clear();
+            }
+
+            IndexType nrows() const { return m_num_rows; }
+            IndexType ncols() const { return m_num_cols; }
+            IndexType nvals() const { return m_nvals; }
+
+            bool hasElement(IndexType irow, IndexType icol) const
+            {
+                if (irow >= m_num_rows || icol >= m_num_cols)
+                {
+                    throw IndexOutOfBoundsException(
+                        "get_value_at: index out of bounds");
+                }
+
+                auto pending_it = m_pending.find(irow);
+                if (pending_it != m_pending.end())
+                {
+                    for (auto const &tupl : pending_it->second)
+                    {
+                        if (std::get<0>(tupl) == icol)
+                        {
+                            return true;
+                        }
+                    }
+                    return false;
+                }
+
+                return (find_in_row(irow, icol) != m_row_ptr[irow + 1]);
+            }
+
+            // Get value at index
+            ScalarT extractElement(IndexType irow, IndexType icol) const
+            {
+                if (irow >= m_num_rows || icol >= m_num_cols)
+                {
+                    throw IndexOutOfBoundsException(
+                        "get_value_at: index out of bounds");
+                }
+
+                auto pending_it = m_pending.find(irow);
+                if (pending_it != m_pending.end())
+                {
+                    for (auto const &tupl : pending_it->second)
+                    {
+                        if (std::get<0>(tupl) == icol)
+                        {
+                            return std::get<1>(tupl);
+                        }
+                    }
+                    throw NoValueException("get_value_at: no entry at index");
+                }
+
+                IndexType ix = find_in_row(irow, icol);
+                if (ix == m_row_ptr[irow + 1])
+                {
+                    throw NoValueException("get_value_at: no entry at index");
+                }
+                return m_vals[ix];
+            }
+
+            // Set value at index
+            void setElement(IndexType irow, IndexType icol, ScalarT const &val)
+            {
+                if (irow >= m_num_rows || icol >= m_num_cols)
+                {
+                    throw IndexOutOfBoundsException("setElement: index out of bounds");
+                }
+
+                m_col_index.invalidate();
+                RowType &row(pending_row(irow));
+                auto it = std::lower_bound(row.begin(), row.end(), icol,
+                                           [](std::tuple<IndexType, ScalarT> const &tupl,
+                                              IndexType idx)
+                                           { return std::get<0>(tupl) < idx; });
+                if ((it != row.end()) && (std::get<0>(*it) == icol))
+                {
+                    std::get<1>(*it) = val;
+                }
+                else
+                {
+                    row.insert(it, std::make_tuple(icol, val));
+                    ++m_nvals;
+                }
+            }
+
+            // Set value at index + 'merge' with any existing value
+            // according to the BinaryOp passed.
+            template <typename BinaryOpT>
+            void setElement(IndexType irow, IndexType icol, ScalarT const &val,
+                            BinaryOpT merge)
+            {
+                if (irow >= m_num_rows || icol >= m_num_cols)
+                {
+                    throw IndexOutOfBoundsException(
+                        "setElement(merge): index out of bounds");
+                }
+
+                m_col_index.invalidate();
+                RowType &row(pending_row(irow));
+                auto it = std::lower_bound(row.begin(), row.end(), icol,
+                                           [](std::tuple<IndexType, ScalarT> const &tupl,
+                                              IndexType idx)
+                                           { return std::get<0>(tupl) < idx; });
+                if ((it != row.end()) && (std::get<0>(*it) == icol))
+                {
+                    // merge with existing stored value
+                    std::get<1>(*it) = merge(std::get<1>(*it), val);
+                }
+                else
+                {
+                    row.insert(it, std::make_tuple(icol, val));
+                    ++m_nvals;
+                }
+            }
+
+            /// Rows are not stored as tuples, so they are returned by value.
+            typedef std::vector<std::tuple<IndexType, ScalarT>> RowType;
+            RowType getRow(IndexType row_index) const
+            {
+                auto pending_it = m_pending.find(row_index);
+                if (pending_it != m_pending.end())
+                {
+                    return pending_it->second;
+                }
+
+                RowType data;
+                data.reserve(m_row_ptr[row_index + 1] - m_row_ptr[row_index]);
+                for (IndexType ix = m_row_ptr[row_index];
+                     ix < m_row_ptr[row_index + 1]; ++ix)
+                {
+                    data.push_back(std::make_tuple(m_col_idx[ix], m_vals[ix]));
+                }
+                return data;
+            }
+
+            /// Copy a row into a structure-of-arrays buffer (a slice of the
+            /// CSR arrays unless the row is pending).
+            void getRow(IndexType row_index, SparseRow<ScalarT> &row_data) const
+            {
+                auto pending_it = m_pending.find(row_index);
+                if (pending_it != m_pending.end())
+                {
+                    row_data.assign(pending_it->second);
+                    return;
+                }
+
+                row_data.assign(m_col_idx.begin() + m_row_ptr[row_index],
+                                m_col_idx.begin() + m_row_ptr[row_index + 1],
+                                m_vals.begin() + m_row_ptr[row_index]);
+            }
+
+            // Allow casting
+            template <typename OtherScalarT>
+            void setRow(
+                IndexType row_index,
+                std::vector<std::tuple<IndexType, OtherScalarT> > const &row_data)
+            {
+                RowType data;
+                data.reserve(row_data.size());
+                for (auto &tupl : row_data)
+                {
+                    data.push_back(
+                        std::make_tuple(std::get<0>(tupl),
+                                        static_cast<ScalarT>(std::get<1>(tupl))));
+                }
+                stage_row(row_index, data);
+            }
+
+            // When not casting vector assignment used
+            void setRow(
+                IndexType row_index,
+                std::vector<std::tuple<IndexType, ScalarT> > const &row_data)
+            {
+                RowType data(row_data);
+                stage_row(row_index, data);
+            }
+
+            // Take over the row's storage (no copy)
+            void setRow(
+                IndexType row_index,
+                std::vector<std::tuple<IndexType, ScalarT> > &&row_data)
+            {
+                RowType data(std::move(row_data));
+                stage_row(row_index, data);
+            }
+
+            typedef std::vector<std::tuple<IndexType, ScalarT> > const ColType;
+            ColType getCol(IndexType col_index) const
+            {
+                if (m_col_index.enabled())
+                {
+                    m_col_index.update(*this);
+                    return m_col_index.getCol(col_index);
+                }
+
+                assemble_rows();
+
+                std::vector<std::tuple<IndexType, ScalarT> > data;
+                for (IndexType ii = 0; ii < m_num_rows; ii++)
+                {
+                    IndexType ix = find_in_row(ii, col_index);
+                    if (ix != m_row_ptr[ii + 1])
+                    {
+                        data.push_back(std::make_tuple(ii, m_vals[ix]));
+                    }
+                }
+
+                return data;
+            }
+
+            /// Copy a column into a structure-of-arrays buffer.
+            void getCol(IndexType col_index, SparseRow<ScalarT> &col_data) const
+            {
+                if (m_col_index.enabled())
+                {
+                    m_col_index.update(*this);
+                    m_col_index.getCol(col_index, col_data);
+                }
+                else
+                {
+                    col_data.assign(getCol(col_index));
+                }
+            }
+
+            // col_data must be in increasing index order
+            template <typename OtherScalarT>
+            void setCol(
+                IndexType col_index,
+                std::vector<std::tuple<IndexType, OtherScalarT> > const &col_data)
+            {
+                assemble_rows();
+                m_col_index.invalidate();
+
+                // Only rows that currently store col_index or that receive a
+                // new value from col_data are touched.
+                auto it = col_data.begin();
+                for (IndexType row_index = 0; row_index < m_num_rows; row_index++)
+                {
+                    bool insert = ((it != col_data.end()) &&
+                                   (row_index == std::get<0>(*it)));
+                    bool stored = (find_in_row(row_index, col_index) !=
+                                   m_row_ptr[row_index + 1]);
+
+                    if (insert)
+                    {
+                        setElement(row_index, col_index,
+                                   static_cast<ScalarT>(std::get<1>(*it)));
+                        ++it;
+                    }
+                    else if (stored)
+                    {
+                        RowType &row(pending_row(row_index));
+                        for (auto row_it = row.begin(); row_it != row.end(); ++row_it)
+                        {
+                            if (std::get<0>(*row_it) == col_index)
+                            {
+                                row.erase(row_it);
+                                --m_nvals;
+                                break;
+                            }
+                        }
+                    }
+                    else if ((it != col_data.end()) &&
+                             (row_index > std::get<0>(*it)))
+                    {
+                        // This should not happen
+                        throw GraphBLAS::PanicException(
+                            "CsrSparseMatrix::setCol() INTERNAL ERROR");
+                    }
+                }
+            }
+
+            // Get column indices for a given row
+            void getColumnIndices(IndexType irow, IndexArrayType &v) const
+            {
+                if (irow >= m_num_rows)
+                {
+                    throw IndexOutOfBoundsException(
+                        "getColumnIndices: index out of bounds");
+                }
+
+                RowType row(getRow(irow));
+                if (!row.empty())
+                {
+                    v.resize(0);
+                    for (auto const &tupl : row)
+                    {
+                        v.push_back(std::get<0>(tupl));
+                    }
+                }
+            }
+
+            // Get row indices for a given column
+            void getRowIndices(IndexType icol, IndexArrayType &v) const
+            {
+                if (icol >= m_num_cols)
+                {
+                    throw IndexOutOfBoundsException(
+                        "getRowIndices: index out of bounds");
+                }
+
+                if (m_col_index.enabled())
+                {
+                    m_col_index.update(*this);
+                    m_col_index.getRowIndices(icol, v);
+                    return;
+                }
+
+                assemble_rows();
+                v.resize(0);
+                for (IndexType ii = 0; ii < m_num_rows; ii++)
+                {
+                    if (find_in_row(ii, icol) != m_row_ptr[ii + 1])
+                    {
+                        v.push_back(ii);
+                    }
+                }
+            }
+
+            template<typename RAIteratorIT,
+                     typename RAIteratorJT,
+                     typename RAIteratorVT>
+            void extractTuples(RAIteratorIT        row_it,
+                               RAIteratorJT        col_it,
+                               RAIteratorVT        values) const
+            {
+                assemble_rows();
+                for (IndexType row = 0; row < m_num_rows; ++row)
+                {
+                    for (IndexType ix = m_row_ptr[row]; ix < m_row_ptr[row + 1]; ++ix)
+                    {
+                        *row_it = row;           ++row_it;
+                        *col_it = m_col_idx[ix]; ++col_it;
+                        *values = m_vals[ix];    ++values;
+                    }
+                }
+            }
+
+            /// Bring all lazily maintained state (pending rows and, when
+            /// enabled, the column index) up to date.  Concurrent readers
+            /// must call this first.
+            void assemble() const
+            {
+                assemble_rows();
+                if (m_col_index.enabled())
+                {
+                    m_col_index.update(*this);
+                }
+            }
+
+            /// Splice any pending row updates into the CSR arrays.
+            void assemble_rows() const
+            {
+                if (m_pending.empty())
+                {
+                    return;
+                }
+
+                std::vector<IndexType> row_ptr(m_num_rows + 1, 0);
+                std::vector<IndexType> col_idx;
+                std::vector<ScalarT>   vals;
+                col_idx.reserve(m_nvals);
+                vals.reserve(m_nvals);
+
+                auto pending_it = m_pending.begin();
+                for (IndexType row_idx = 0; row_idx < m_num_rows; ++row_idx)
+                {
+                    if ((pending_it != m_pending.end()) &&
+                        (pending_it->first == row_idx))
+                    {
+                        for (auto const &tupl : pending_it->second)
+                        {
+                            col_idx.push_back(std::get<0>(tupl));
+                            vals.push_back(std::get<1>(tupl));
+                        }
+                        ++pending_it;
+                    }
+                    else
+                    {
+                        col_idx.insert(col_idx.end(),
+                                       m_col_idx.begin() + m_row_ptr[row_idx],
+                                       m_col_idx.begin() + m_row_ptr[row_idx + 1]);
+                        vals.insert(vals.end(),
+                                    m_vals.begin() + m_row_ptr[row_idx],
+                                    m_vals.begin() + m_row_ptr[row_idx + 1]);
+                    }
+                    row_ptr[row_idx + 1] = col_idx.size();
+                }
+
+                m_row_ptr = std::move(row_ptr);
+                m_col_idx = std::move(col_idx);
+                m_vals = std::move(vals);
+                m_pending.clear();
+            }
+
+            // Raw CSR arrays (pending updates are assembled first)
+            CsrArray<IndexType> const &get_row_ptr() const
+            {
+                assemble_rows();
+                return m_row_ptr;
+            }
+
+            CsrArray<IndexType> const &get_col_idx() const
+            {
+                assemble_rows();
+                return m_col_idx;
+            }
+
+            ValuesArrayType const &get_vals() const
+            {
+                assemble_rows();
+                return m_vals;
+            }
+
+            /**
+             * @brief Replace the contents with ready-made CSR arrays.
+             *
+             * The arrays may be views of external memory (e.g., a mapped
+             * file); they are used as-is without copying.  Column indices
+             * must be sorted within each row.
+             */
+            void adopt_arrays(CsrArray<IndexType> row_ptr,
+                              CsrArray<IndexType> col_idx,
+                              ValuesArrayType     vals)
+            {
+                if ((row_ptr.size() != m_num_rows + 1) ||
+                    (col_idx.size() != vals.size()) ||
+                    (row_ptr[0] != 0) ||
+                    (row_ptr.back() != col_idx.size()))
+                {
+                    throw DimensionException("adopt_arrays: inconsistent CSR arrays");
+                }
+
+                m_pending.clear();
+                m_row_ptr = std::move(row_ptr);
+                m_col_idx = std::move(col_idx);
+                m_vals = std::move(vals);
+                m_nvals = m_col_idx.size();
+                m_col_index.invalidate();
+            }
+
+            /// True while any of the CSR arrays is a view of external memory.
+            bool is_view() const
+            {
+                assemble_rows();
+                return (m_row_ptr.is_view() || m_col_idx.is_view() ||
+                        is_view_array(m_vals));
+            }
+
+            /// Maintain a cached column-major index so that getCol() and
+            /// getRowIndices() cost O(column length).
+            void enableColumnIndex(bool flag = true)
+            {
+                m_col_index.enable(flag);
+            }
+
+            bool hasColumnIndex() const { return m_col_index.enabled(); }
+
+            // output specific to the storage layout of this type of matrix
+            void printInfo(std::ostream &os) const
+            {
+                // Used to print data in storage format instead of like a matrix
+                #ifdef GRB_SEQUENTIAL_MATRIX_PRINT_STORAGE
+                    assemble_rows();
+                    os << "CsrSparseMatrix<" << typeid(ScalarT).name() << ">"
+                       << std::endl;
+                    os << "dimensions: " << m_num_rows << " x " << m_num_cols
+                       << std::endl;
+                    os << "num stored values = " << m_nvals << std::endl;
+                    os << "row_ptr:";
+                    for (auto ptr : m_row_ptr) os << " " << ptr;
+                    os << std::endl << "col_idx:";
+                    for (auto idx : m_col_idx) os << " " << idx;
+                    os << std::endl << "vals:   ";
+                    for (auto val : m_vals) os << " " << val;
+                    os << std::endl;
+                #else
+                    IndexType num_rows = nrows();
+                    IndexType num_cols = ncols();
+
+                    os << "(" << num_rows << "x" << num_cols << ")" << std::endl;
+
+                    for (IndexType row_idx = 0; row_idx < num_rows; ++row_idx)
+                    {
+                        // We like to start with a little whitespace indent
+                        os << ((row_idx == 0) ? "  [[" : "   [");
+
+                        RowType const &row(getRow(row_idx));
+                        IndexType curr_idx = 0;
+
+                        if (row.empty())
+                        {
+                            while (curr_idx < num_cols)
+                            {
+                                os << ((curr_idx == 0) ? " " : ",  " );
+                                ++curr_idx;
+                            }
+                        }
+                        else
+                        {
+                            IndexType col_idx;
+                            ScalarT cell_val;
+
+                            auto row_it = row.begin();
+                            while (row_it != row.end())
+                            {
+                                std::tie(col_idx, cell_val) = *row_it;
+                                while (curr_idx < col_idx)
+                                {
+                                    os << ((curr_idx == 0) ? " " : ",  " );
+                                    ++curr_idx;
+                                }
+
+                                if (curr_idx != 0)
+                                    os << ", ";
+                                os << cell_val;
+
+                                ++row_it;
+                                ++curr_idx;
+                            }
+
+                            // Fill in the rest to the end
+                            while (curr_idx < num_cols)
+                            {
+                                os << ",  ";
+                                ++curr_idx;
+                            }
+                        }
+                        os << ((row_idx == num_rows - 1 ) ? "]]" : "]\n");
+                    }
+                #endif
+            }
+
+            friend std::ostream &operator<<(std::ostream             &os,
+                                            CsrSparseMatrix<ScalarT> const &mat)
+            {
+                mat.printInfo(os);
+                return os;
+            }
+
+        private:
+            // Binary search of the assembled arrays; returns the end of the
+            // row if icol is not stored.
+            IndexType find_in_row(IndexType irow, IndexType icol) const
+            {
+                auto row_begin = m_col_idx.begin() + m_row_ptr[irow];
+                auto row_end   = m_col_idx.begin() + m_row_ptr[irow + 1];
+                auto it = std::lower_bound(row_begin, row_end, icol);
+                if ((it != row_end) && (*it == icol))
+                {
+                    return (it - m_col_idx.begin());
+                }
+                return m_row_ptr[irow + 1];
+            }
+
+            // Returns the staged copy of a row, creating it if necessary.
+            RowType &pending_row(IndexType irow)
+            {
+                auto pending_it = m_pending.find(irow);
+                if (pending_it == m_pending.end())
+                {
+                    pending_it = m_pending.insert(
+                        std::make_pair(irow, getRow(irow))).first;
+                }
+                return pending_it->second;
+            }
+
+            void stage_row(IndexType row_index, RowType &data)
+            {
+                m_col_index.invalidate();
+                IndexType old_nvals;
+                auto pending_it = m_pending.find(row_index);
+                if (pending_it != m_pending.end())
+                {
+                    old_nvals = pending_it->second.size();
+                    pending_it->second.swap(data);
+                }
+                else
+                {
+                    old_nvals = m_row_ptr[row_index + 1] - m_row_ptr[row_index];
+                    if ((old_nvals == 0) && data.empty())
+                    {
+                        return;  // clearing an already empty row
+                    }
+                    m_pending[row_index].swap(data);
+                }
+
+                m_nvals = m_nvals + m_pending[row_index].size() - old_nvals;
+            }
+
+            IndexType m_num_rows;
+            IndexType m_num_cols;
+            IndexType m_nvals;
+
+            // Compressed sparse row storage (CSR)
+            mutable CsrArray<IndexType>    m_row_ptr;
+            mutable CsrArray<IndexType>    m_col_idx;
+            mutable ValuesArrayType        m_vals;
+
+            // Rows replaced since the arrays were last assembled
+            mutable std::map<IndexType, RowType> m_pending;
+
+            // Optional column-major companion index
+            mutable ColumnIndex<ScalarT> m_col_index;
+        };
+
+    } // namespace backend
+
+} // namespace GraphBLAS
+
+#endif // GB_SEQUENTIAL_CSRSPARSEMATRIX_HPP
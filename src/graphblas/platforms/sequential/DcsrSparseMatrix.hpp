@@ -0,0 +1,1082 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+#ifndef GB_SEQUENTIAL_DCSRSPARSEMATRIX_HPP
+#define GB_SEQUENTIAL_DCSRSPARSEMATRIX_HPP
+
+#include <iostream>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <numeric>
+#include <utility>
+#include <typeinfo>
+#include <stdexcept>
+
+#include <graphblas/graphblas.hpp>
+#include <graphblas/platforms/sequential/ColumnIndex.hpp>
+#include <graphblas/platforms/sequential/CsrSparseMatrix.hpp>
+
+//****************************************************************************
+
+namespace GraphBLAS
+{
+    namespace backend
+    {
+        /**
+         * @brief Doubly compressed sparse row (DCSR, "hypersparse") storage.
+         *
+         * Only non-empty rows are stored: m_row_ids holds their indices in
+         * increasing order, m_row_ptr (one entry longer) their offsets into
+         * m_col_idx and m_vals.  The matrix itself takes O(nvals) memory no
+         * matter how large nrows() is (but see the note on operations
+         * below).  Locating a row is a binary search of m_row_ids.
+         *
+         * As in CsrSparseMatrix, row replacements are staged as pending rows
+         * and spliced into the arrays in a single pass when next needed.
+         *
+         * @note Only the storage and the element/row access of this class are
+         *       independent of nrows().  The operations (apply, mxm, eWise*,
+         *       extract, assign, transpose, ...) still visit every row index
+         *       and stage their result in a full-height LilSparseMatrix, so
+         *       with a DCSR operand or output they take O(nrows() + nvals)
+         *       time and temporary memory; e.g., apply on a 2^40 x 2^40
+         *       matrix cannot allocate its staging.  The cached column
+         *       index (enableColumnIndex) is rebuilt over every row too.
+         *       Keep such matrices to build/setElement/extractTuples/getRow,
+         *       or convert slices to a row space the operations can afford.
+         *
+         * @note Assembling pending rows modifies mutable state from const
+         *       methods; concurrent readers must call assemble() first.
+         */
+        template<typename ScalarT>
+        class DcsrSparseMatrix
+        {
+        public:
+            typedef ScalarT ScalarType;
+
+            /// Rows are not stored as tuples, so they are returned by value.
+            typedef std::vector<std::tuple<IndexType, ScalarT>> RowType;
+            typedef std::vector<std::tuple<IndexType, ScalarT> > const ColType;
+
+            // Constructor
+            DcsrSparseMatrix(IndexType num_rows,
+                             IndexType num_cols)
+                : m_num_rows(num_rows),
+                  m_num_cols(num_cols),
+                  m_nvals(0),
+                  m_row_ptr(1, 0)
+            {
+            }
+
+            // Constructor - copy
+            DcsrSparseMatrix(DcsrSparseMatrix<ScalarT> const &rhs)
+                : m_num_rows(rhs.m_num_rows),
+                  m_num_cols(rhs.m_num_cols),
+                  m_nvals(rhs.m_nvals),
+                  m_row_ids(rhs.m_row_ids),
+                  m_row_ptr(rhs.m_row_ptr),
+                  m_col_idx(rhs.m_col_idx),
+                  m_vals(rhs.m_vals),
+                  m_pending(rhs.m_pending),
+                  m_col_index(rhs.m_col_index)
+            {
+            }
+
+            // Constructor - move (rhs is left as an empty 0 x 0 matrix)
+            DcsrSparseMatrix(DcsrSparseMatrix<ScalarT> &&rhs)
+                : m_num_rows(0),
+                  m_num_cols(0),
+                  m_nvals(0),
+                  m_row_ptr(1, 0)
+            {
+                m_col_index.enable(rhs.m_col_index.enabled());
+                swap(rhs);
+            }
+
+            // Constructor - dense from dense matrix
+            DcsrSparseMatrix(std::vector<std::vector<ScalarT>> const &val)
+                : m_num_rows(val.size()),
+                  m_num_cols(val[0].size()),
+                  m_nvals(0),
+                  m_row_ptr(1, 0)
+            {
+                for (IndexType ii = 0; ii < m_num_rows; ii++)
+                {
+                    if (val[ii].size() != m_num_cols)
+                    {
+                        throw DimensionException("DcsrSparseMatrix(dense ctor)");
+                    }
+
+                    for (IndexType jj = 0; jj < m_num_cols; jj++)
+                    {
+                        m_col_idx.push_back(jj);
+                        m_vals.push_back(val[ii][jj]);
+                    }
+                    close_row(ii);
+                }
+                m_nvals = m_col_idx.size();
+            }
+
+            // Constructor - sparse from dense matrix, removing specifed implied zeros
+            DcsrSparseMatrix(std::vector<std::vector<ScalarT>> const &val,
+                             ScalarT zero)
+                : m_num_rows(val.size()),
+                  m_num_cols(val[0].size()),
+                  m_nvals(0),
+                  m_row_ptr(1, 0)
+            {
+                for (IndexType ii = 0; ii < m_num_rows; ii++)
+                {
+                    if (val[ii].size() != m_num_cols)
+                    {
+                        throw DimensionException("DcsrSparseMatrix(dense ctor)");
+                    }
+
+                    for (IndexType jj = 0; jj < m_num_cols; jj++)
+                    {
+                        if (val[ii][jj] != zero)
+                        {
+                            m_col_idx.push_back(jj);
+                            m_vals.push_back(val[ii][jj]);
+                        }
+                    }
+                    close_row(ii);
+                }
+                m_nvals = m_col_idx.size();
+            }
+
+            /// Convert from CSR, dropping the empty rows: O(nrows + nvals).
+            explicit DcsrSparseMatrix(CsrSparseMatrix<ScalarT> const &csr)
+                : m_num_rows(csr.nrows()),
+                  m_num_cols(csr.ncols()),
+                  m_nvals(0),
+                  m_row_ptr(1, 0)
+            {
+                auto const &row_ptr(csr.get_row_ptr());
+                auto const &col_idx(csr.get_col_idx());
+                auto const &vals(csr.get_vals());
+
+                m_col_idx.reserve(csr.nvals());
+                m_vals.reserve(csr.nvals());
+                for (IndexType row_idx = 0; row_idx < m_num_rows; ++row_idx)
+                {
+                    for (IndexType ix = row_ptr[row_idx];
+                         ix < row_ptr[row_idx + 1]; ++ix)
+                    {
+                        m_col_idx.push_back(col_idx[ix]);
+                        m_vals.push_back(vals[ix]);
+                    }
+                    close_row(row_idx);
+                }
+                m_nvals = m_col_idx.size();
+            }
+
+            // Destructor
+            ~DcsrSparseMatrix()
+            {}
+
+            // Assignment (currently restricted to same dimensions)
+            DcsrSparseMatrix<ScalarT> &operator=(DcsrSparseMatrix<ScalarT> const &rhs)
+            {
+                if (this != &rhs)
+                {
+                    // push this check to frontend
+                    if ((m_num_rows != rhs.m_num_rows) ||
+                        (m_num_cols != rhs.m_num_cols))
+                    {
+                        throw DimensionException();
+                    }
+
+                    m_nvals = rhs.m_nvals;
+                    m_row_ids = rhs.m_row_ids;
+                    m_row_ptr = rhs.m_row_ptr;
+                    m_col_idx = rhs.m_col_idx;
+                    m_vals = rhs.m_vals;
+                    m_pending = rhs.m_pending;
+                    m_col_index.invalidate();
+                }
+                return *this;
+            }
+
+            // Move assignment: takes over the contents and the shape of rhs,
+            // which is left as an empty 0 x 0 matrix (as by the move
+            // constructor); the old contents of this are released.
+            DcsrSparseMatrix<ScalarT> &operator=(DcsrSparseMatrix<ScalarT> &&rhs)
+            {
+                if (this != &rhs)
+                {
+                    DcsrSparseMatrix<ScalarT> tmp(std::move(rhs));
+                    swap(tmp);
+                }
+                return *this;
+            }
+
+            /// Exchange contents and shape with another matrix in O(1).  A
+            /// cached column index goes along when both matrices keep one;
+            /// otherwise it is rebuilt on next use.
+            void swap(DcsrSparseMatrix<ScalarT> &rhs)
+            {
+                std::swap(m_num_rows, rhs.m_num_rows);
+                std::swap(m_num_cols, rhs.m_num_cols);
+                std::swap(m_nvals, rhs.m_nvals);
+                m_row_ids.swap(rhs.m_row_ids);
+                m_row_ptr.swap(rhs.m_row_ptr);
+                m_col_idx.swap(rhs.m_col_idx);
+                m_vals.swap(rhs.m_vals);
+                m_pending.swap(rhs.m_pending);
+                if (m_col_index.enabled() == rhs.m_col_index.enabled())
+                {
+                    m_col_index.swap(rhs.m_col_index);
+                }
+                else
+                {
+                    m_col_index.invalidate();
+                    rhs.m_col_index.invalidate();
+                }
+            }
+
+            /// Convert to CSR; the result has nrows() + 1 row offsets.
+            CsrSparseMatrix<ScalarT> to_csr() const
+            {
+                assemble_rows();
+
+                std::vector<IndexType> row_ptr(m_num_rows + 1, 0);
+                for (IndexType k = 0; k < m_row_ids.size(); ++k)
+                {
+                    row_ptr[m_row_ids[k] + 1] = m_row_ptr[k + 1] - m_row_ptr[k];
+                }
+                std::partial_sum(row_ptr.begin(), row_ptr.end(), row_ptr.begin());
+
+                CsrArray<IndexType> row_ptr_array, col_idx_array;
+                typename CsrSparseMatrix<ScalarT>::ValuesArrayType vals_array;
+                row_ptr_array = std::move(row_ptr);
+                col_idx_array = std::vector<IndexType>(m_col_idx);
+                vals_array = std::vector<ScalarT>(m_vals);
+
+                CsrSparseMatrix<ScalarT> csr(m_num_rows, m_num_cols);
+                csr.adopt_arrays(std::move(row_ptr_array),
+                                 std::move(col_idx_array),
+                                 std::move(vals_array));
+                return csr;
+            }
+
+            // EQUALITY OPERATORS
+            /**
+             * @brief Equality testing for DcsrSparseMatrix.
+             * @param rhs The right hand side of the equality operation.
+             * @return If this DcsrSparseMatrix and rhs are identical.
+             */
+            bool operator==(DcsrSparseMatrix<ScalarT> const &rhs) const
+            {
+                if ((m_num_rows != rhs.m_num_rows) ||
+                    (m_num_cols != rhs.m_num_cols) ||
+                    (m_nvals != rhs.m_nvals))
+                {
+                    return false;
+                }
+
+                assemble_rows();
+                rhs.assemble_rows();
+                return ((m_row_ids == rhs.m_row_ids) &&
+                        (m_row_ptr == rhs.m_row_ptr) &&
+                        (m_col_idx == rhs.m_col_idx) &&
+                        (m_vals == rhs.m_vals));
+            }
+
+            /**
+             * @brief Inequality testing for DcsrSparseMatrix.
+             * @param rhs The right hand side of the inequality operation.
+             * @return If this DcsrSparseMatrix and rhs are not identical.
+             */
+            bool operator!=(DcsrSparseMatrix<ScalarT> const &rhs) const
+            {
+                return !(*this == rhs);
+            }
+
+            /**
+             * Bulk construction: the (row, col, val) triples are sorted by
+             * row and then column (stable, so duplicates are combined with
+             * dup in input order) and the arrays are written in a single
+             * pass.  Cost depends on the number of triples, not on nrows().
+             * Existing values are kept and are treated as occurring before
+             * all of the new triples.
+             */
+            template<typename RAIteratorI,
+                     typename RAIteratorJ,
+                     typename RAIteratorV,
+                     typename DupT>
+            void build(RAIteratorI  i_it,
+                       RAIteratorJ  j_it,
+                       RAIteratorV  v_it,
+                       IndexType    n,
+                       DupT         dup)
+            {
+                assemble_rows();
+                m_col_index.invalidate();
+
+                IndexType num_tuples = m_nvals + n;
+                std::vector<IndexType> rows, cols;
+                std::vector<ScalarT>   vals;
+                rows.reserve(num_tuples);
+                cols.reserve(num_tuples);
+                vals.reserve(num_tuples);
+
+                for (IndexType k = 0; k < m_row_ids.size(); ++k)
+                {
+                    for (IndexType ix = m_row_ptr[k]; ix < m_row_ptr[k + 1]; ++ix)
+                    {
+                        rows.push_back(m_row_ids[k]);
+                        cols.push_back(m_col_idx[ix]);
+                        vals.push_back(m_vals[ix]);
+                    }
+                }
+
+                for (IndexType ix = 0; ix < n; ++ix)
+                {
+                    if (*i_it >= m_num_rows || *j_it >= m_num_cols)
+                    {
+                        throw IndexOutOfBoundsException(
+                            "build: index out of bounds");
+                    }
+                    rows.push_back(*i_it);
+                    cols.push_back(*j_it);
+                    vals.push_back(static_cast<ScalarT>(*v_it));
+                    ++i_it; ++j_it; ++v_it;
+                }
+
+                std::vector<IndexType> perm(num_tuples);
+                std::iota(perm.begin(), perm.end(), 0);
+                std::stable_sort(perm.begin(), perm.end(),
+                                 [&rows, &cols](IndexType a, IndexType b)
+                                 {
+                                     return ((rows[a] < rows[b]) ||
+                                             ((rows[a] == rows[b]) &&
+                                              (cols[a] < cols[b])));
+                                 });
+
+                m_row_ids.clear();
+                m_row_ptr.assign(1, 0);
+                m_col_idx.clear();
+                m_vals.clear();
+                for (IndexType ix = 0; ix < num_tuples; ++ix)
+                {
+                    IndexType tidx = perm[ix];
+                    if ((ix > 0) && (rows[perm[ix - 1]] != rows[tidx]))
+                    {
+                        close_row(rows[perm[ix - 1]]);
+                    }
+
+                    if ((m_col_idx.size() > m_row_ptr.back()) &&
+                        (m_col_idx.back() == cols[tidx]))
+                    {
+                        m_vals.back() = dup(m_vals.back(), vals[tidx]);
+                    }
+                    else
+                    {
+                        m_col_idx.push_back(cols[tidx]);
+                        m_vals.push_back(vals[tidx]);
+                    }
+                }
+                if (num_tuples > 0)
+                {
+                    close_row(rows[perm[num_tuples - 1]]);
+                }
+                m_nvals = m_col_idx.size();
+            }
+
+            void clear()
+            {
+                m_col_index.invalidate();
+                m_nvals = 0;
+                m_row_ids.clear();
+                m_row_ptr.assign(1, 0);
+                m_col_idx.clear();
+                m_vals.clear();
+                m_pending.clear();
+            }
+
+            IndexType nrows() const { return m_num_rows; }
+            IndexType ncols() const { return m_num_cols; }
+            IndexType nvals() const { return m_nvals; }
+
+            /// Number of non-empty rows actually stored.
+            IndexType num_stored_rows() const
+            {
+                assemble_rows();
+                return m_row_ids.size();
+            }
+
+            bool hasElement(IndexType irow, IndexType icol) const
+            {
+                if (irow >= m_num_rows || icol >= m_num_cols)
+                {
+                    throw IndexOutOfBoundsException(
+                        "get_value_at: index out of bounds");
+                }
+
+                auto pending_it = m_pending.find(irow);
+                if (pending_it != m_pending.end())
+                {
+                    for (auto const &tupl : pending_it->second)
+                    {
+                        if (std::get<0>(tupl) == icol)
+                        {
+                            return true;
+                        }
+                    }
+                    return false;
+                }
+
+                return (find_element(irow, icol) != m_col_idx.size());
+            }
+
+            // Get value at index
+            ScalarT extractElement(IndexType irow, IndexType icol) const
+            {
+                if (irow >= m_num_rows || icol >= m_num_cols)
+                {
+                    throw IndexOutOfBoundsException(
+                        "get_value_at: index out of bounds");
+                }
+
+                auto pending_it = m_pending.find(irow);
+                if (pending_it != m_pending.end())
+                {
+                    for (auto const &tupl : pending_it->second)
+                    {
+                        if (std::get<0>(tupl) == icol)
+                        {
+                            return std::get<1>(tupl);
+                        }
+                    }
+                    throw NoValueException("get_value_at: no entry at index");
+                }
+
+                IndexType ix = find_element(irow, icol);
+                if (ix == m_col_idx.size())
+                {
+                    throw NoValueException("get_value_at: no entry at index");
+                }
+                return m_vals[ix];
+            }
+
+            // Set value at index
+            void setElement(IndexType irow, IndexType icol, ScalarT const &val)
+            {
+                if (irow >= m_num_rows || icol >= m_num_cols)
+                {
+                    throw IndexOutOfBoundsException("setElement: index out of bounds");
+                }
+
+                m_col_index.invalidate();
+                RowType &row(pending_row(irow));
+                auto it = std::lower_bound(row.begin(), row.end(), icol,
+                                           [](std::tuple<IndexType, ScalarT> const &tupl,
+                                              IndexType idx)
+                                           { return std::get<0>(tupl) < idx; });
+                if ((it != row.end()) && (std::get<0>(*it) == icol))
+                {
+                    std::get<1>(*it) = val;
+                }
+                else
+                {
+                    row.insert(it, std::make_tuple(icol, val));
+                    ++m_nvals;
+                }
+            }
+
+            // Set value at index + 'merge' with any existing value
+            // according to the BinaryOp passed.
+            template <typename BinaryOpT>
+            void setElement(IndexType irow, IndexType icol, ScalarT const &val,
+                            BinaryOpT merge)
+            {
+                if (irow >= m_num_rows || icol >= m_num_cols)
+                {
+                    throw IndexOutOfBoundsException(
+                        "setElement(merge): index out of bounds");
+                }
+
+                m_col_index.invalidate();
+                RowType &row(pending_row(irow));
+                auto it = std::lower_bound(row.begin(), row.end(), icol,
+                                           [](std::tuple<IndexType, ScalarT> const &tupl,
+                                              IndexType idx)
+                                           { return std::get<0>(tupl) < idx; });
+                if ((it != row.end()) && (std::get<0>(*it) == icol))
+                {
+                    // merge with existing stored value
+                    std::get<1>(*it) = merge(std::get<1>(*it), val);
+                }
+                else
+                {
+                    row.insert(it, std::make_tuple(icol, val));
+                    ++m_nvals;
+                }
+            }
+
+            RowType getRow(IndexType row_index) const
+            {
+                auto pending_it = m_pending.find(row_index);
+                if (pending_it != m_pending.end())
+                {
+                    return pending_it->second;
+                }
+
+                RowType data;
+                IndexType k = find_row(row_index);
+                if (k != m_row_ids.size())
+                {
+                    data.reserve(m_row_ptr[k + 1] - m_row_ptr[k]);
+                    for (IndexType ix = m_row_ptr[k]; ix < m_row_ptr[k + 1]; ++ix)
+                    {
+                        data.push_back(std::make_tuple(m_col_idx[ix], m_vals[ix]));
+                    }
+                }
+                return data;
+            }
+
+            /// Copy a row into a structure-of-arrays buffer (a slice of the
+            /// DCSR arrays unless the row is pending).
+            void getRow(IndexType row_index, SparseRow<ScalarT> &row_data) const
+            {
+                auto pending_it = m_pending.find(row_index);
+                if (pending_it != m_pending.end())
+                {
+                    row_data.assign(pending_it->second);
+                    return;
+                }
+
+                IndexType k = find_row(row_index);
+                if (k == m_row_ids.size())
+                {
+                    row_data.clear();
+                    return;
+                }
+
+                row_data.assign(m_col_idx.begin() + m_row_ptr[k],
+                                m_col_idx.begin() + m_row_ptr[k + 1],
+                                m_vals.begin() + m_row_ptr[k]);
+            }
+
+            // Allow casting
+            template <typename OtherScalarT>
+            void setRow(
+                IndexType row_index,
+                std::vector<std::tuple<IndexType, OtherScalarT> > const &row_data)
+            {
+                RowType data;
+                data.reserve(row_data.size());
+                for (auto &tupl : row_data)
+                {
+                    data.push_back(
+                        std::make_tuple(std::get<0>(tupl),
+                                        static_cast<ScalarT>(std::get<1>(tupl))));
+                }
+                stage_row(row_index, data);
+            }
+
+            // When not casting vector assignment used
+            void setRow(
+                IndexType row_index,
+                std::vector<std::tuple<IndexType, ScalarT> > const &row_data)
+            {
+                RowType data(row_data);
+                stage_row(row_index, data);
+            }
+
+            // Take over the row's storage (no copy)
+            void setRow(
+                IndexType row_index,
+                std::vector<std::tuple<IndexType, ScalarT> > &&row_data)
+            {
+                RowType data(std::move(row_data));
+                stage_row(row_index, data);
+            }
+
+            ColType getCol(IndexType col_index) const
+            {
+                if (m_col_index.enabled())
+                {
+                    m_col_index.update(*this);
+                    return m_col_index.getCol(col_index);
+                }
+
+                assemble_rows();
+
+                std::vector<std::tuple<IndexType, ScalarT> > data;
+                for (IndexType k = 0; k < m_row_ids.size(); ++k)
+                {
+                    IndexType ix = find_in_stored_row(k, col_index);
+                    if (ix != m_row_ptr[k + 1])
+                    {
+                        data.push_back(std::make_tuple(m_row_ids[k], m_vals[ix]));
+                    }
+                }
+
+                return data;
+            }
+
+            /// Copy a column into a structure-of-arrays buffer.
+            void getCol(IndexType col_index, SparseRow<ScalarT> &col_data) const
+            {
+                if (m_col_index.enabled())
+                {
+                    m_col_index.update(*this);
+                    m_col_index.getCol(col_index, col_data);
+                }
+                else
+                {
+                    col_data.assign(getCol(col_index));
+                }
+            }
+
+            // col_data must be in increasing index order
+            template <typename OtherScalarT>
+            void setCol(
+                IndexType col_index,
+                std::vector<std::tuple<IndexType, OtherScalarT> > const &col_data)
+            {
+                assemble_rows();
+                m_col_index.invalidate();
+
+                // Only rows that currently store col_index or that receive a
+                // new value from col_data are touched: walk the stored rows
+                // and col_data together.
+                IndexType k = 0;
+                auto it = col_data.begin();
+                while ((k < m_row_ids.size()) || (it != col_data.end()))
+                {
+                    if ((it != col_data.end()) &&
+                        ((k == m_row_ids.size()) ||
+                         (std::get<0>(*it) <= m_row_ids[k])))
+                    {
+                        if ((k < m_row_ids.size()) &&
+                            (m_row_ids[k] == std::get<0>(*it)))
+                        {
+                            ++k;
+                        }
+                        setElement(std::get<0>(*it), col_index,
+                                   static_cast<ScalarT>(std::get<1>(*it)));
+                        ++it;
+                    }
+                    else
+                    {
+                        if (find_in_stored_row(k, col_index) != m_row_ptr[k + 1])
+                        {
+                            RowType &row(pending_row(m_row_ids[k]));
+                            for (auto row_it = row.begin(); row_it != row.end(); ++row_it)
+                            {
+                                if (std::get<0>(*row_it) == col_index)
+                                {
+                                    row.erase(row_it);
+                                    --m_nvals;
+                                    break;
+                                }
+                            }
+                        }
+                        ++k;
+                    }
+                }
+            }
+
+            // Get column indices for a given row
+            void getColumnIndices(IndexType irow, IndexArrayType &v) const
+            {
+                if (irow >= m_num_rows)
+                {
+                    throw IndexOutOfBoundsException(
+                        "getColumnIndices: index out of bounds");
+                }
+
+                RowType row(getRow(irow));
+                if (!row.empty())
+                {
+                    v.resize(0);
+                    for (auto const &tupl : row)
+                    {
+                        v.push_back(std::get<0>(tupl));
+                    }
+                }
+            }
+
+            // Get row indices for a given column
+            void getRowIndices(IndexType icol, IndexArrayType &v) const
+            {
+                if (icol >= m_num_cols)
+                {
+                    throw IndexOutOfBoundsException(
+                        "getRowIndices: index out of bounds");
+                }
+
+                if (m_col_index.enabled())
+                {
+                    m_col_index.update(*this);
+                    m_col_index.getRowIndices(icol, v);
+                    return;
+                }
+
+                assemble_rows();
+                v.resize(0);
+                for (IndexType k = 0; k < m_row_ids.size(); ++k)
+                {
+                    if (find_in_stored_row(k, icol) != m_row_ptr[k + 1])
+                    {
+                        v.push_back(m_row_ids[k]);
+                    }
+                }
+            }
+
+            template<typename RAIteratorIT,
+                     typename RAIteratorJT,
+                     typename RAIteratorVT>
+            void extractTuples(RAIteratorIT        row_it,
+                               RAIteratorJT        col_it,
+                               RAIteratorVT        values) const
+            {
+                assemble_rows();
+                for (IndexType k = 0; k < m_row_ids.size(); ++k)
+                {
+                    for (IndexType ix = m_row_ptr[k]; ix < m_row_ptr[k + 1]; ++ix)
+                    {
+                        *row_it = m_row_ids[k];  ++row_it;
+                        *col_it = m_col_idx[ix]; ++col_it;
+                        *values = m_vals[ix];    ++values;
+                    }
+                }
+            }
+
+            /// Bring all lazily maintained state (pending rows and, when
+            /// enabled, the column index) up to date.  Concurrent readers
+            /// must call this first.
+            void assemble() const
+            {
+                assemble_rows();
+                if (m_col_index.enabled())
+                {
+                    m_col_index.update(*this);
+                }
+            }
+
+            /// Splice any pending row updates into the arrays, merging the
+            /// pending rows with the stored rows by row index.
+            void assemble_rows() const
+            {
+                if (m_pending.empty())
+                {
+                    return;
+                }
+
+                std::vector<IndexType> row_ids;
+                std::vector<IndexType> row_ptr(1, 0);
+                std::vector<IndexType> col_idx;
+                std::vector<ScalarT>   vals;
+                row_ids.reserve(m_row_ids.size() + m_pending.size());
+                row_ptr.reserve(m_row_ids.size() + m_pending.size() + 1);
+                col_idx.reserve(m_nvals);
+                vals.reserve(m_nvals);
+
+                IndexType k = 0;
+                auto pending_it = m_pending.begin();
+                while ((k < m_row_ids.size()) || (pending_it != m_pending.end()))
+                {
+                    IndexType row_idx;
+                    if ((pending_it != m_pending.end()) &&
+                        ((k == m_row_ids.size()) ||
+                         (pending_it->first <= m_row_ids[k])))
+                    {
+                        row_idx = pending_it->first;
+                        if ((k < m_row_ids.size()) && (m_row_ids[k] == row_idx))
+                        {
+                            ++k;    // replaced by the pending row
+                        }
+                        for (auto const &tupl : pending_it->second)
+                        {
+                            col_idx.push_back(std::get<0>(tupl));
+                            vals.push_back(std::get<1>(tupl));
+                        }
+                        ++pending_it;
+                    }
+                    else
+                    {
+                        row_idx = m_row_ids[k];
+                        col_idx.insert(col_idx.end(),
+                                       m_col_idx.begin() + m_row_ptr[k],
+                                       m_col_idx.begin() + m_row_ptr[k + 1]);
+                        vals.insert(vals.end(),
+                                    m_vals.begin() + m_row_ptr[k],
+                                    m_vals.begin() + m_row_ptr[k + 1]);
+                        ++k;
+                    }
+
+                    if (col_idx.size() > row_ptr.back())
+                    {
+                        row_ids.push_back(row_idx);
+                        row_ptr.push_back(col_idx.size());
+                    }
+                }
+
+                m_row_ids = std::move(row_ids);
+                m_row_ptr = std::move(row_ptr);
+                m_col_idx = std::move(col_idx);
+                m_vals = std::move(vals);
+                m_pending.clear();
+            }
+
+            // Raw DCSR arrays (pending updates are assembled first)
+            std::vector<IndexType> const &get_row_ids() const
+            {
+                assemble_rows();
+                return m_row_ids;
+            }
+
+            std::vector<IndexType> const &get_row_ptr() const
+            {
+                assemble_rows();
+                return m_row_ptr;
+            }
+
+            std::vector<IndexType> const &get_col_idx() const
+            {
+                assemble_rows();
+                return m_col_idx;
+            }
+
+            std::vector<ScalarT> const &get_vals() const
+            {
+                assemble_rows();
+                return m_vals;
+            }
+
+            /// Maintain a cached column-major index so that getCol() and
+            /// getRowIndices() cost O(column length).
+            void enableColumnIndex(bool flag = true)
+            {
+                m_col_index.enable(flag);
+            }
+
+            bool hasColumnIndex() const { return m_col_index.enabled(); }
+
+            // output specific to the storage layout of this type of matrix
+            void printInfo(std::ostream &os) const
+            {
+                // Used to print data in storage format instead of like a matrix
+                #ifdef GRB_SEQUENTIAL_MATRIX_PRINT_STORAGE
+                    assemble_rows();
+                    os << "DcsrSparseMatrix<" << typeid(ScalarT).name() << ">"
+                       << std::endl;
+                    os << "dimensions: " << m_num_rows << " x " << m_num_cols
+                       << std::endl;
+                    os << "num stored values = " << m_nvals << std::endl;
+                    os << "row_ids:";
+                    for (auto idx : m_row_ids) os << " " << idx;
+                    os << std::endl << "row_ptr:";
+                    for (auto ptr : m_row_ptr) os << " " << ptr;
+                    os << std::endl << "col_idx:";
+                    for (auto idx : m_col_idx) os << " " << idx;
+                    os << std::endl << "vals:   ";
+                    for (auto val : m_vals) os << " " << val;
+                    os << std::endl;
+                #else
+                    IndexType num_rows = nrows();
+                    IndexType num_cols = ncols();
+
+                    os << "(" << num_rows << "x" << num_cols << ")" << std::endl;
+
+                    for (IndexType row_idx = 0; row_idx < num_rows; ++row_idx)
+                    {
+                        // We like to start with a little whitespace indent
+                        os << ((row_idx == 0) ? "  [[" : "   [");
+
+                        RowType const &row(getRow(row_idx));
+                        IndexType curr_idx = 0;
+
+                        if (row.empty())
+                        {
+                            while (curr_idx < num_cols)
+                            {
+                                os << ((curr_idx == 0) ? " " : ",  " );
+                                ++curr_idx;
+                            }
+                        }
+                        else
+                        {
+                            IndexType col_idx;
+                            ScalarT cell_val;
+
+                            auto row_it = row.begin();
+                            while (row_it != row.end())
+                            {
+                                std::tie(col_idx, cell_val) = *row_it;
+                                while (curr_idx < col_idx)
+                                {
+                                    os << ((curr_idx == 0) ? " " : ",  " );
+                                    ++curr_idx;
+                                }
+
+                                if (curr_idx != 0)
+                                    os << ", ";
+                                os << cell_val;
+
+                                ++row_it;
+                                ++curr_idx;
+                            }
+
+                            // Fill in the rest to the end
+                            while (curr_idx < num_cols)
+                            {
+                                os << ",  ";
+                                ++curr_idx;
+                            }
+                        }
+                        os << ((row_idx == num_rows - 1 ) ? "]]" : "]\n");
+                    }
+                #endif
+            }
+
+            friend std::ostream &operator<<(std::ostream                    &os,
+                                            DcsrSparseMatrix<ScalarT> const &mat)
+            {
+                mat.printInfo(os);
+                return os;
+            }
+
+        private:
+            // Position of irow in m_row_ids, or m_row_ids.size() if the row
+            // is empty.
+            IndexType find_row(IndexType irow) const
+            {
+                auto it = std::lower_bound(m_row_ids.begin(), m_row_ids.end(),
+                                           irow);
+                if ((it != m_row_ids.end()) && (*it == irow))
+                {
+                    return (it - m_row_ids.begin());
+                }
+                return m_row_ids.size();
+            }
+
+            // Binary search of the k-th stored row; returns the end of the
+            // row if icol is not stored.
+            IndexType find_in_stored_row(IndexType k, IndexType icol) const
+            {
+                auto row_begin = m_col_idx.begin() + m_row_ptr[k];
+                auto row_end   = m_col_idx.begin() + m_row_ptr[k + 1];
+                auto it = std::lower_bound(row_begin, row_end, icol);
+                if ((it != row_end) && (*it == icol))
+                {
+                    return (it - m_col_idx.begin());
+                }
+                return m_row_ptr[k + 1];
+            }
+
+            // Position of (irow, icol) in the assembled arrays, or
+            // m_col_idx.size() if it is not stored.
+            IndexType find_element(IndexType irow, IndexType icol) const
+            {
+                IndexType k = find_row(irow);
+                if (k == m_row_ids.size())
+                {
+                    return m_col_idx.size();
+                }
+                IndexType ix = find_in_stored_row(k, icol);
+                return ((ix == m_row_ptr[k + 1]) ? m_col_idx.size() : ix);
+            }
+
+            // Record row irow if anything was appended since the last
+            // recorded row.
+            void close_row(IndexType irow)
+            {
+                if (m_col_idx.size() > m_row_ptr.back())
+                {
+                    m_row_ids.push_back(irow);
+                    m_row_ptr.push_back(m_col_idx.size());
+                }
+            }
+
+            // Returns the staged copy of a row, creating it if necessary.
+            RowType &pending_row(IndexType irow)
+            {
+                auto pending_it = m_pending.find(irow);
+                if (pending_it == m_pending.end())
+                {
+                    pending_it = m_pending.insert(
+                        std::make_pair(irow, getRow(irow))).first;
+                }
+                return pending_it->second;
+            }
+
+            void stage_row(IndexType row_index, RowType &data)
+            {
+                m_col_index.invalidate();
+                IndexType old_nvals;
+                auto pending_it = m_pending.find(row_index);
+                if (pending_it != m_pending.end())
+                {
+                    old_nvals = pending_it->second.size();
+                    pending_it->second.swap(data);
+                }
+                else
+                {
+                    IndexType k = find_row(row_index);
+                    old_nvals = ((k == m_row_ids.size()) ? 0 :
+                                 m_row_ptr[k + 1] - m_row_ptr[k]);
+                    if ((old_nvals == 0) && data.empty())
+                    {
+                        return;  // clearing an already empty row
+                    }
+                    m_pending[row_index].swap(data);
+                }
+
+                m_nvals = m_nvals + m_pending[row_index].size() - old_nvals;
+            }
+
+            IndexType m_num_rows;
+            IndexType m_num_cols;
+            IndexType m_nvals;
+
+            // Doubly compressed sparse row storage (DCSR): only the
+            // non-empty rows have an entry in m_row_ids and m_row_ptr
+            mutable std::vector<IndexType> m_row_ids;
+            mutable std::vector<IndexType> m_row_ptr;
+            mutable std::vector<IndexType> m_col_idx;
+            mutable std::vector<ScalarT>   m_vals;
+
+            // Rows replaced since the arrays were last assembled
+            mutable std::map<IndexType, RowType> m_pending;
+
+            // Optional column-major companion index
+            mutable ColumnIndex<ScalarT> m_col_index;
+        };
+
+    } // namespace backend
+
+} // namespace GraphBLAS
+
+#endif // GB_SEQUENTIAL_DCSRSPARSEMATRIX_HPP
@@ -32,10 +32,14 @@
 
 #include <iostream>
 #include <vector>
+#include <algorithm>
+#include <utility>
 #include <typeinfo>
 #include <stdexcept>
 
 #include <graphblas/graphblas.hpp>
+#include <graphblas/platforms/sequential/ColumnIndex.hpp>
+#include <graphblas/platforms/sequential/row_loops.hpp>
 
 //****************************************************************************
 
@@ -65,10 +69,21 @@ namespace GraphBLAS
                 : m_num_rows(rhs.m_num_rows),
                   m_num_cols(rhs.m_num_cols),
                   m_nvals(rhs.m_nvals),
-                  m_data(rhs.m_data)
+                  m_data(rhs.m_data),
+                  m_col_index(rhs.m_col_index)
             {
             }
 
+            // Constructor - move (rhs is left as an empty 0 x 0 matrix)
+            LilSparseMatrix(LilSparseMatrix<ScalarT> &&rhs)
+                : m_num_rows(0),
+                  m_num_cols(0),
+                  m_nvals(0)
+            {
+                m_col_index.enable(rhs.m_col_index.enabled());
+                swap(rhs);
+            }
+
             // Constructor - dense from dense matrix
             LilSparseMatrix(std::vector<std::vector<ScalarT>> const &val)
                 : m_num_rows(val.size()),
@@ -135,6 +150,20 @@ namespace GraphBLAS
 
                     m_nvals = rhs.m_nvals;
                     m_data = rhs.m_data;
+                    m_col_index.invalidate();
+                }
+                return *this;
+            }
+
+            // Move assignment: takes over the contents and the shape of rhs,
+            // which is left as an empty 0 x 0 matrix (as by the move
+            // constructor); the old contents of this are released.
+            LilSparseMatrix<ScalarT> &operator=(LilSparseMatrix<ScalarT> &&rhs)
+            {
+                if (this != &rhs)
+                {
+                    LilSparseMatrix<ScalarT> tmp(std::move(rhs));
+                    swap(tmp);
                 }
                 return *this;
             }
@@ -163,6 +192,17 @@ namespace GraphBLAS
                 return !(*this == rhs);
             }
 
+            /**
+             * @brief Add the n (i, j, v) triples to the matrix.
+             *
+             * The triples are bucketed by row (counting sort), then each
+             * touched row is sorted by column and merged with its existing
+             * contents in one pass: O(n + sum of touched row lengths) rather
+             * than one insertion per triple.  Values landing on the same
+             * location are combined with dup in input order, existing values
+             * first (the same result as calling setElement(i, j, v, dup) for
+             * each triple).
+             */
             template<typename RAIteratorI,
                      typename RAIteratorJ,
                      typename RAIteratorV,
@@ -178,17 +218,101 @@ namespace GraphBLAS
                 /// @todo should this function call clear?
                 //clear();
 
-                /// @todo DOING SOMETHING REALLY STUPID RIGHT NOW
+                m_col_index.invalidate();
+
+                std::vector<IndexType> rows(n), cols(n);
+                std::vector<ScalarT>   vals(n);
                 for (IndexType ix = 0; ix < n; ++ix)
                 {
-                    setElement(*i_it, *j_it, *v_it, dup);
+                    if (*i_it >= m_num_rows || *j_it >= m_num_cols)
+                    {
+                        throw IndexOutOfBoundsException(
+                            "build: index out of bounds");
+                    }
+                    rows[ix] = *i_it;
+                    cols[ix] = *j_it;
+                    vals[ix] = static_cast<ScalarT>(*v_it);
                     ++i_it; ++j_it; ++v_it;
                 }
+
+                // Counting sort on the row index (stable)
+                std::vector<IndexType> offsets(m_num_rows + 1, 0);
+                for (auto row_idx : rows)
+                {
+                    ++offsets[row_idx + 1];
+                }
+
+                IndexArrayType touched_rows;
+                for (IndexType row_idx = 0; row_idx < m_num_rows; ++row_idx)
+                {
+                    if (offsets[row_idx + 1] > 0)
+                    {
+                        touched_rows.push_back(row_idx);
+                    }
+                    offsets[row_idx + 1] += offsets[row_idx];
+                }
+
+                std::vector<IndexType> perm(n);
+                std::vector<IndexType> next(offsets.begin(), offsets.end() - 1);
+                for (IndexType ix = 0; ix < n; ++ix)
+                {
+                    perm[next[rows[ix]]++] = ix;
+                }
+
+                // Sort each touched row by column and merge it with the
+                // stored row, combining duplicates in input order.
+                typedef std::vector<std::tuple<IndexType, ScalarT> > RowDataType;
+                compute_rows_mapped(
+                    *this, touched_rows,
+                    [this, &touched_rows, &offsets, &perm, &cols, &vals, dup]
+                    (IndexType k, RowDataType &row) mutable
+                    {
+                        IndexType row_idx(touched_rows[k]);
+                        auto new_it  = perm.begin() + offsets[row_idx];
+                        auto new_end = perm.begin() + offsets[row_idx + 1];
+                        std::stable_sort(new_it, new_end,
+                                         [&cols](IndexType a, IndexType b)
+                                         { return cols[a] < cols[b]; });
+
+                        RowDataType const &old_row(m_data[row_idx]);
+                        auto old_it = old_row.begin();
+                        row.reserve(old_row.size() + (new_end - new_it));
+
+                        while (new_it != new_end)
+                        {
+                            IndexType col_idx(cols[*new_it]);
+                            while ((old_it != old_row.end()) &&
+                                   (std::get<0>(*old_it) < col_idx))
+                            {
+                                row.push_back(*old_it++);
+                            }
+
+                            ScalarT val;
+                            if ((old_it != old_row.end()) &&
+                                (std::get<0>(*old_it) == col_idx))
+                            {
+                                val = std::get<1>(*old_it++);
+                            }
+                            else
+                            {
+                                val = vals[*new_it++];
+                            }
+
+                            while ((new_it != new_end) &&
+                                   (cols[*new_it] == col_idx))
+                            {
+                                val = dup(val, vals[*new_it++]);
+                            }
+                            row.push_back(std::make_tuple(col_idx, val));
+                        }
+                        row.insert(row.end(), old_it, old_row.end());
+                    });
             }
 
             void clear()
             {
                 /// @todo make atomic? transactional?
+                m_col_index.invalidate();
                 m_nvals = 0;
                 for (IndexType row = 0; row < m_data.size(); ++row)
                 {
@@ -196,6 +320,26 @@ namespace GraphBLAS
                 }
             }
 
+            /// Exchange contents and shape with another matrix in O(1).  A
+            /// cached column index goes along when both matrices keep one;
+            /// otherwise it is rebuilt on next use.
+            void swap(LilSparseMatrix &rhs)
+            {
+                std::swap(m_num_rows, rhs.m_num_rows);
+                std::swap(m_num_cols, rhs.m_num_cols);
+                std::swap(m_nvals, rhs.m_nvals);
+                m_data.swap(rhs.m_data);
+                if (m_col_index.enabled() == rhs.m_col_index.enabled())
+                {
+                    m_col_index.swap(rhs.m_col_index);
+                }
+                else
+                {
+                    m_col_index.invalidate();
+                    rhs.m_col_index.invalidate();
+                }
+            }
+
             IndexType nrows() const { return m_num_rows; }
             IndexType ncols() const { return m_num_cols; }
             IndexType nvals() const { return m_nvals; }
@@ -272,43 +416,21 @@ namespace GraphBLAS
             // Set value at index
             void setElement(IndexType irow, IndexType icol, ScalarT const &val)
             {
-                m_data[irow].reserve(m_data[irow].capacity() + 10);
                 if (irow >= m_num_rows || icol >= m_num_cols)
                 {
                     throw IndexOutOfBoundsException("setElement: index out of bounds");
                 }
+                m_col_index.invalidate();
 
-                if (m_data[irow].empty())
-                {
-                    m_data[irow].push_back(std::make_tuple(icol, val));
-                    ++m_nvals;
-                }
-                if (std::get<0>(*m_data[irow].begin()) > icol)
+                auto it = find_in_row(irow, icol);
+                if ((it != m_data[irow].end()) && (std::get<0>(*it) == icol))
                 {
-                    m_data[irow].insert(m_data[irow].begin(),
-                                        std::make_tuple(icol, val));
-                    ++m_nvals;
+                    std::get<1>(*it) = val;
                 }
                 else
                 {
-                    typename std::vector<std::tuple<IndexType, ScalarT>>::iterator it;
-                    for (it = m_data[irow].begin(); it != m_data[irow].end(); ++it)
-                    {
-                        if (std::get<0>(*it) == icol)
-                        {
-                            it = m_data[irow].erase(it);
-                            m_data[irow].insert(it, std::make_tuple(icol, val));
-                            return;
-                        }
-                        else if (std::get<0>(*it) > icol)
-                        {
-                            m_data[irow].insert(it, std::make_tuple(icol, val));
-                            ++m_nvals;
-                            return;
-                        }
-                    }
-                    m_data[irow].push_back(std::make_tuple(icol, val));
-                    m_nvals = m_nvals + 1;
+                    m_data[irow].insert(it, std::make_tuple(icol, val));
+                    ++m_nvals;
                 }
             }
 
@@ -323,34 +445,18 @@ namespace GraphBLAS
                     throw IndexOutOfBoundsException(
                         "setElement(merge): index out of bounds");
                 }
+                m_col_index.invalidate();
 
-                if (m_data[irow].empty())
+                auto it = find_in_row(irow, icol);
+                if ((it != m_data[irow].end()) && (std::get<0>(*it) == icol))
                 {
-                    m_data[irow].push_back(std::make_tuple(icol, val));
-                    m_nvals = m_nvals + 1;
+                    // merge with existing stored value
+                    std::get<1>(*it) = merge(std::get<1>(*it), val);
                 }
                 else
                 {
-                    typename std::vector<std::tuple<IndexType, ScalarT>>::iterator it;
-                    for (it = m_data[irow].begin(); it != m_data[irow].end(); it++)
-                    {
-                        if (std::get<0>(*it) == icol)
-                        {
-                            // merge with existing stored value
-                            std::get<1>(*it) = merge(std::get<1>(*it), val);
-                            //it = m_data[irow].erase(it);
-                            //m_data[irow].insert(it, std::make_tuple(icol, tmp));
-                            return;
-                        }
-                        else if (std::get<0>(*it) > icol)
-                        {
-                            m_data[irow].insert(it, std::make_tuple(icol, val));
-                            m_nvals = m_nvals + 1;
-                            return;
-                        }
-                    }
-                    m_data[irow].push_back(std::make_tuple(icol, val));
-                    m_nvals = m_nvals + 1;
+                    m_data[irow].insert(it, std::make_tuple(icol, val));
+                    ++m_nvals;
                 }
             }
 
@@ -360,12 +466,19 @@ namespace GraphBLAS
                 return m_data[row_index];
             }
 
+            /// Copy a row into a structure-of-arrays buffer.
+            void getRow(IndexType row_index, SparseRow<ScalarT> &row_data) const
+            {
+                row_data.assign(m_data[row_index]);
+            }
+
             // Allow casting
             template <typename OtherScalarT>
             void setRow(
                 IndexType row_index,
                 std::vector<std::tuple<IndexType, OtherScalarT> > const &row_data)
             {
+                m_col_index.invalidate();
                 IndexType old_nvals = m_data[row_index].size();
                 IndexType new_nvals = row_data.size();
 
@@ -385,6 +498,7 @@ namespace GraphBLAS
                 IndexType row_index,
                 std::vector<std::tuple<IndexType, ScalarT> > const &row_data)
             {
+                m_col_index.invalidate();
                 IndexType old_nvals = m_data[row_index].size();
                 IndexType new_nvals = row_data.size();
 
@@ -392,10 +506,29 @@ namespace GraphBLAS
                 m_data[row_index] = row_data;   // swap here?
             }
 
+            // Take over the row's storage (no copy)
+            void setRow(
+                IndexType row_index,
+                std::vector<std::tuple<IndexType, ScalarT> > &&row_data)
+            {
+                m_col_index.invalidate();
+                IndexType old_nvals = m_data[row_index].size();
+                IndexType new_nvals = row_data.size();
+
+                m_nvals = m_nvals + new_nvals - old_nvals;
+                m_data[row_index] = std::move(row_data);
+            }
+
             /// @todo need move semantics.
             typedef std::vector<std::tuple<IndexType, ScalarT> > const ColType;
             ColType getCol(IndexType col_index) const
             {
+                if (m_col_index.enabled())
+                {
+                    m_col_index.update(*this);
+                    return m_col_index.getCol(col_index);
+                }
+
                 std::vector<std::tuple<IndexType, ScalarT> > data;
 
                 for (IndexType ii = 0; ii < m_num_rows; ii++)
@@ -415,6 +548,20 @@ namespace GraphBLAS
                 return data;
             }
 
+            /// Copy a column into a structure-of-arrays buffer.
+            void getCol(IndexType col_index, SparseRow<ScalarT> &col_data) const
+            {
+                if (m_col_index.enabled())
+                {
+                    m_col_index.update(*this);
+                    m_col_index.getCol(col_index, col_data);
+                }
+                else
+                {
+                    col_data.assign(getCol(col_index));
+                }
+            }
+
             // col_data must be in increasing index order
             /// @todo this could be vastly improved.
             template <typename OtherScalarT>
@@ -422,6 +569,7 @@ namespace GraphBLAS
                 IndexType col_index,
                 std::vector<std::tuple<IndexType, OtherScalarT> > const &col_data)
             {
+                m_col_index.invalidate();
                 auto it = col_data.begin();
                 for (IndexType row_index = 0; row_index < m_num_rows; row_index++)
                 {
@@ -532,6 +680,13 @@ namespace GraphBLAS
                         "getRowIndices: index out of bounds");
                 }
 
+                if (m_col_index.enabled())
+                {
+                    m_col_index.update(*this);
+                    m_col_index.getRowIndices(icol, v);
+                    return;
+                }
+
                 IndexType ind;
                 ScalarT val;
                 v.resize(0);
@@ -560,9 +715,9 @@ namespace GraphBLAS
             template<typename RAIteratorIT,
                      typename RAIteratorJT,
                      typename RAIteratorVT>
-            ScalarT extractTuples(RAIteratorIT        row_it,
-                                  RAIteratorJT        col_it,
-                                  RAIteratorVT        values) const
+            void extractTuples(RAIteratorIT        row_it,
+                               RAIteratorJT        col_it,
+                               RAIteratorVT        values) const
             {
                 for (IndexType row = 0; row < m_data.size(); ++row)
                 {
@@ -577,6 +732,25 @@ namespace GraphBLAS
                 }
             }
 
+            /// Maintain a cached column-major index so that getCol() and
+            /// getRowIndices() cost O(column length).
+            void enableColumnIndex(bool flag = true)
+            {
+                m_col_index.enable(flag);
+            }
+
+            bool hasColumnIndex() const { return m_col_index.enabled(); }
+
+            /// Bring lazily maintained state (the column index) up to date.
+            /// Concurrent readers must call this first.
+            void assemble() const
+            {
+                if (m_col_index.enabled())
+                {
+                    m_col_index.update(*this);
+                }
+            }
+
             // output specific to the storage layout of this type of matrix
             void printInfo(std::ostream &os) const
             {
@@ -667,12 +841,26 @@ namespace GraphBLAS
             }
 
         private:
+            /// First element of row irow with column >= icol (binary search).
+            typename std::vector<std::tuple<IndexType, ScalarT> >::iterator
+            find_in_row(IndexType irow, IndexType icol)
+            {
+                return std::lower_bound(
+                    m_data[irow].begin(), m_data[irow].end(), icol,
+                    [](std::tuple<IndexType, ScalarT> const &elt,
+                       IndexType                             col)
+                    { return std::get<0>(elt) < col; });
+            }
+
             IndexType m_num_rows;
             IndexType m_num_cols;
             IndexType m_nvals;
 
             // List-of-lists storage (LIL)
             std::vector<std::vector<std::tuple<IndexType, ScalarT>>> m_data;
+
+            // Optional column-major companion index
+            mutable ColumnIndex<ScalarT> m_col_index;
         };
 
     } // namespace backend
@@ -30,7 +30,12 @@
 #pragma once
 
 #include <cstddef>
+#include <type_traits>
+#include <utility>
 #include <graphblas/platforms/sequential/LilSparseMatrix.hpp>
+#include <graphblas/platforms/sequential/CsrSparseMatrix.hpp>
+#include <graphblas/platforms/sequential/DcsrSparseMatrix.hpp>
+#include <graphblas/platforms/sequential/PatternSparseMatrix.hpp>
 
 //****************************************************************************
 
@@ -56,50 +61,135 @@ namespace GraphBLAS
         //********************************************************************
 
 
+        /// True when TagT appears among the (already unpacked) tags.
+        template<typename TagT, typename... TagsT>
+        struct has_tag : std::false_type
+        {
+        };
+
+        template<typename TagT, typename... TagsT>
+        struct has_tag<TagT, TagT, TagsT...> : std::true_type
+        {
+        };
+
+        template<typename TagT, typename OtherTagT, typename... TagsT>
+        struct has_tag<TagT, OtherTagT, TagsT...> : has_tag<TagT, TagsT...>
+        {
+        };
+
+        /// Selects the storage engine from the (already unpacked) tags;
+        /// LilStorageTag is the default.
+        template<typename ScalarT, typename... TagsT>
+        struct matrix_storage
+        {
+            typedef typename std::conditional<
+                has_tag<CsrStorageTag, TagsT...>::value,
+                CsrSparseMatrix<ScalarT>,
+                typename std::conditional<
+                    has_tag<HypersparseStorageTag, TagsT...>::value,
+                    DcsrSparseMatrix<ScalarT>,
+                    typename std::conditional<
+                        has_tag<PatternStorageTag, TagsT...>::value,
+                        PatternSparseMatrix<ScalarT>,
+                        LilSparseMatrix<ScalarT> >::type >::type >::type type;
+        };
+
+        /// True when a (backend) matrix type is stored as CSR arrays.
+        template<typename MatrixT>
+        struct is_csr_matrix
+            : std::is_base_of<CsrSparseMatrix<typename MatrixT::ScalarType>,
+                              MatrixT>
+        {
+        };
+
+        /// True when a (backend) matrix type stores only its pattern (every
+        /// stored value is the matrix's iso value).
+        template<typename MatrixT>
+        struct is_pattern_matrix
+            : std::is_base_of<
+                  PatternSparseMatrix<typename MatrixT::ScalarType>, MatrixT>
+        {
+        };
+
+        //********************************************************************
+
         template<typename ScalarT, typename... TagsT>
-        class Matrix : public LilSparseMatrix<ScalarT>
+        class Matrix : public matrix_storage<ScalarT, TagsT...>::type
         {
+        private:
+            typedef typename matrix_storage<ScalarT, TagsT...>::type
+                ParentMatrixType;
+
         public:
             typedef ScalarT ScalarType;
 
             // construct an empty matrix of fixed dimensions
             Matrix(IndexType   num_rows,
                    IndexType   num_cols)
-                : LilSparseMatrix<ScalarT>(num_rows, num_cols)
+                : ParentMatrixType(num_rows, num_cols)
             {
+                this->enableColumnIndex(
+                    has_tag<ColumnIndexTag, TagsT...>::value);
             }
 
             // copy construct
             Matrix(Matrix const &rhs)
-                : LilSparseMatrix<ScalarT>(rhs)
+                : ParentMatrixType(rhs)
+            {
+            }
+
+            // move construct
+            Matrix(Matrix &&rhs)
+                : ParentMatrixType(std::move(rhs))
             {
             }
 
             // construct a dense matrix from dense data.
             Matrix(std::vector<std::vector<ScalarT> > const &values)
-                : LilSparseMatrix<ScalarT>(values)
+                : ParentMatrixType(values)
             {
+                this->enableColumnIndex(
+                    has_tag<ColumnIndexTag, TagsT...>::value);
             }
 
             // construct a sparse matrix from dense data and a zero val.
             Matrix(std::vector<std::vector<ScalarT> > const &values,
                    ScalarT                                   zero)
-                : LilSparseMatrix<ScalarT>(values, zero)
+                : ParentMatrixType(values, zero)
             {
+                this->enableColumnIndex(
+                    has_tag<ColumnIndexTag, TagsT...>::value);
             }
 
             ~Matrix() {}  // virtual?
 
+            Matrix &operator=(Matrix const &rhs)
+            {
+                ParentMatrixType::operator=(rhs);
+                return *this;
+            }
+
+            Matrix &operator=(Matrix &&rhs)
+            {
+                ParentMatrixType::operator=(std::move(rhs));
+                return *this;
+            }
+
+            void swap(Matrix &rhs)
+            {
+                ParentMatrixType::swap(rhs);
+            }
+
             // necessary?
             bool operator==(Matrix const &rhs) const
             {
-                return LilSparseMatrix<ScalarT>::operator==(rhs);
+                return ParentMatrixType::operator==(rhs);
             }
 
             // necessary?
             bool operator!=(Matrix const &rhs) const
             {
-                return LilSparseMatrix<ScalarT>::operator!=(rhs);
+                return ParentMatrixType::operator!=(rhs);
             }
         };
     }
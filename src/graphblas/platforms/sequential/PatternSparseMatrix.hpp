@@ -0,0 +1,695 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+#ifndef GB_SEQUENTIAL_PATTERNSPARSEMATRIX_HPP
+#define GB_SEQUENTIAL_PATTERNSPARSEMATRIX_HPP
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <utility>
+#include <typeinfo>
+#include <stdexcept>
+
+#include <graphblas/graphblas.hpp>
+#include <graphblas/platforms/sequential/ColumnIndex.hpp>
+
+//****************************************************************************
+
+namespace GraphBLAS
+{
+    namespace backend
+    {
+        /**
+         * @brief Pattern-only (iso-valued) storage: a list of column index
+         *        lists and a single value shared by every stored element.
+         *
+         * Only the structure is kept, so an element costs one IndexType
+         * instead of a padded (index, value) tuple.  Every stored element
+         * reads back as isoValue() (1, i.e. true, unless changed); writing
+         * any other value (through the constructors, build, setElement,
+         * setRow or setCol) throws InvalidValueException rather than
+         * silently changing it.  As a mask such a matrix is structural.
+         *
+         * Rows are materialized as (index, value) tuples by getRow() for
+         * the generic kernels; getPattern() returns the stored indices
+         * directly so that value-free paths (mask tests) skip the values.
+         */
+        template<typename ScalarT>
+        class PatternSparseMatrix
+        {
+        public:
+            typedef ScalarT ScalarType;
+
+            /// Rows are not stored as tuples, so they are returned by value.
+            typedef std::vector<std::tuple<IndexType, ScalarT>> RowType;
+            typedef std::vector<std::tuple<IndexType, ScalarT> > const ColType;
+
+            // Constructor
+            PatternSparseMatrix(IndexType num_rows,
+                                IndexType num_cols)
+                : m_num_rows(num_rows),
+                  m_num_cols(num_cols),
+                  m_nvals(0),
+                  m_data(num_rows),
+                  m_iso_value(static_cast<ScalarT>(1))
+            {
+            }
+
+            // Constructor - copy
+            PatternSparseMatrix(PatternSparseMatrix<ScalarT> const &rhs)
+                : m_num_rows(rhs.m_num_rows),
+                  m_num_cols(rhs.m_num_cols),
+                  m_nvals(rhs.m_nvals),
+                  m_data(rhs.m_data),
+                  m_iso_value(rhs.m_iso_value),
+                  m_col_index(rhs.m_col_index)
+            {
+            }
+
+            // Constructor - move (rhs is left as an empty 0 x 0 matrix)
+            PatternSparseMatrix(PatternSparseMatrix<ScalarT> &&rhs)
+                : m_num_rows(0),
+                  m_num_cols(0),
+                  m_nvals(0),
+                  m_iso_value(rhs.m_iso_value)
+            {
+                m_col_index.enable(rhs.m_col_index.enabled());
+                swap(rhs);
+            }
+
+            // Constructor - dense from dense matrix (every element stored)
+            PatternSparseMatrix(std::vector<std::vector<ScalarT>> const &val)
+                : m_num_rows(val.size()),
+                  m_num_cols(val[0].size()),
+                  m_nvals(0),
+                  m_data(val.size()),
+                  m_iso_value(static_cast<ScalarT>(1))
+            {
+                for (IndexType ii = 0; ii < m_num_rows; ii++)
+                {
+                    if (val[ii].size() != m_num_cols)
+                    {
+                        throw DimensionException("PatternSparseMatrix(dense ctor)");
+                    }
+
+                    for (IndexType jj = 0; jj < m_num_cols; jj++)
+                    {
+                        check_iso(val[ii][jj], "PatternSparseMatrix(dense ctor)");
+                        m_data[ii].push_back(jj);
+                    }
+                    m_nvals += m_num_cols;
+                }
+            }
+
+            // Constructor - the pattern of the elements that are not zero
+            PatternSparseMatrix(std::vector<std::vector<ScalarT>> const &val,
+                                ScalarT zero)
+                : m_num_rows(val.size()),
+                  m_num_cols(val[0].size()),
+                  m_nvals(0),
+                  m_data(val.size()),
+                  m_iso_value(static_cast<ScalarT>(1))
+            {
+                for (IndexType ii = 0; ii < m_num_rows; ii++)
+                {
+                    if (val[ii].size() != m_num_cols)
+                    {
+                        throw DimensionException("PatternSparseMatrix(dense ctor)");
+                    }
+
+                    for (IndexType jj = 0; jj < m_num_cols; jj++)
+                    {
+                        if (val[ii][jj] != zero)
+                        {
+                            check_iso(val[ii][jj], "PatternSparseMatrix(dense ctor)");
+                            m_data[ii].push_back(jj);
+                            ++m_nvals;
+                        }
+                    }
+                }
+            }
+
+            // Destructor
+            ~PatternSparseMatrix()
+            {}
+
+            // Assignment (currently restricted to same dimensions)
+            PatternSparseMatrix<ScalarT> &operator=(PatternSparseMatrix<ScalarT> const &rhs)
+            {
+                if (this != &rhs)
+                {
+                    // push this check to frontend
+                    if ((m_num_rows != rhs.m_num_rows) ||
+                        (m_num_cols != rhs.m_num_cols))
+                    {
+                        throw DimensionException();
+                    }
+
+                    m_nvals = rhs.m_nvals;
+                    m_data = rhs.m_data;
+                    m_iso_value = rhs.m_iso_value;
+                    m_col_index.invalidate();
+                }
+                return *this;
+            }
+
+            // Move assignment: takes over the contents and the shape of rhs,
+            // which is left as an empty 0 x 0 matrix (as by the move
+            // constructor); the old contents of this are released.
+            PatternSparseMatrix<ScalarT> &operator=(PatternSparseMatrix<ScalarT> &&rhs)
+            {
+                if (this != &rhs)
+                {
+                    PatternSparseMatrix<ScalarT> tmp(std::move(rhs));
+                    swap(tmp);
+                }
+                return *this;
+            }
+
+            /// Exchange contents, shape and iso value with another matrix in
+            /// O(1).  A cached column index goes along when both matrices
+            /// keep one; otherwise it is rebuilt on next use.
+            void swap(PatternSparseMatrix<ScalarT> &rhs)
+            {
+                std::swap(m_num_rows, rhs.m_num_rows);
+                std::swap(m_num_cols, rhs.m_num_cols);
+                std::swap(m_nvals, rhs.m_nvals);
+                m_data.swap(rhs.m_data);
+                std::swap(m_iso_value, rhs.m_iso_value);
+                if (m_col_index.enabled() == rhs.m_col_index.enabled())
+                {
+                    m_col_index.swap(rhs.m_col_index);
+                }
+                else
+                {
+                    m_col_index.invalidate();
+                    rhs.m_col_index.invalidate();
+                }
+            }
+
+            // EQUALITY OPERATORS
+            /**
+             * @brief Equality testing for PatternSparseMatrix.
+             * @param rhs The right hand side of the equality operation.
+             * @return If this PatternSparseMatrix and rhs are identical.
+             */
+            bool operator==(PatternSparseMatrix<ScalarT> const &rhs) const
+            {
+                return ((m_num_rows == rhs.m_num_rows) &&
+                        (m_num_cols == rhs.m_num_cols) &&
+                        (m_nvals == rhs.m_nvals) &&
+                        ((m_nvals == 0) || (m_iso_value == rhs.m_iso_value)) &&
+                        (m_data == rhs.m_data));
+            }
+
+            /**
+             * @brief Inequality testing for PatternSparseMatrix.
+             * @param rhs The right hand side of the inequality operation.
+             * @return If this PatternSparseMatrix and rhs are not identical.
+             */
+            bool operator!=(PatternSparseMatrix<ScalarT> const &rhs) const
+            {
+                return !(*this == rhs);
+            }
+
+            /// The value shared by every stored element.
+            ScalarT isoValue() const { return m_iso_value; }
+
+            /// Change the value of every stored element at once (O(1)).
+            void setIsoValue(ScalarT const &val) { m_iso_value = val; }
+
+            /**
+             * @brief Add the n (i, j, v) triples.
+             *
+             * Every v must equal the iso value, and when a location is
+             * written more than once (or is already stored) dup(iso, iso)
+             * must too; otherwise InvalidValueException is thrown and the
+             * matrix is left unchanged.
+             */
+            template<typename RAIteratorI,
+                     typename RAIteratorJ,
+                     typename RAIteratorV,
+                     typename DupT>
+            void build(RAIteratorI  i_it,
+                       RAIteratorJ  j_it,
+                       RAIteratorV  v_it,
+                       IndexType    n,
+                       DupT         dup)
+            {
+                m_col_index.invalidate();
+
+                IndexArrayType rows(n), cols(n);
+                for (IndexType ix = 0; ix < n; ++ix)
+                {
+                    if (*i_it >= m_num_rows || *j_it >= m_num_cols)
+                    {
+                        throw IndexOutOfBoundsException(
+                            "build: index out of bounds");
+                    }
+                    check_iso(*v_it, "build: value differs from the iso value");
+                    rows[ix] = *i_it;
+                    cols[ix] = *j_it;
+                    ++i_it; ++j_it; ++v_it;
+                }
+
+                bool const dup_is_iso(
+                    static_cast<ScalarT>(dup(m_iso_value, m_iso_value)) ==
+                    m_iso_value);
+
+                IndexArrayType touched_rows(rows);
+                std::sort(touched_rows.begin(), touched_rows.end());
+                touched_rows.erase(
+                    std::unique(touched_rows.begin(), touched_rows.end()),
+                    touched_rows.end());
+
+                // Merge each touched row with its new columns; only commit
+                // once every row is known to be free of non-iso duplicates.
+                std::vector<IndexArrayType> new_rows(touched_rows.size());
+                {
+                    std::vector<IndexArrayType> added(touched_rows.size());
+                    for (IndexType ix = 0; ix < n; ++ix)
+                    {
+                        auto it = std::lower_bound(touched_rows.begin(),
+                                                   touched_rows.end(), rows[ix]);
+                        added[it - touched_rows.begin()].push_back(cols[ix]);
+                    }
+                    for (IndexType k = 0; k < touched_rows.size(); ++k)
+                    {
+                        IndexArrayType &row(new_rows[k]);
+                        IndexArrayType const &old_row(m_data[touched_rows[k]]);
+                        row.reserve(old_row.size() + added[k].size());
+                        row.assign(old_row.begin(), old_row.end());
+                        row.insert(row.end(), added[k].begin(), added[k].end());
+                        std::sort(row.begin(), row.end());
+                        row.erase(std::unique(row.begin(), row.end()),
+                                  row.end());
+                        if (!dup_is_iso &&
+                            (row.size() != old_row.size() + added[k].size()))
+                        {
+                            throw InvalidValueException(
+                                "build: dup of the iso value is not iso");
+                        }
+                    }
+                }
+
+                for (IndexType k = 0; k < touched_rows.size(); ++k)
+                {
+                    IndexArrayType &row(m_data[touched_rows[k]]);
+                    m_nvals = m_nvals + new_rows[k].size() - row.size();
+                    row.swap(new_rows[k]);
+                }
+            }
+
+            void clear()
+            {
+                m_col_index.invalidate();
+                m_nvals = 0;
+                for (auto &row : m_data)
+                {
+                    row.clear();
+                }
+            }
+
+            IndexType nrows() const { return m_num_rows; }
+            IndexType ncols() const { return m_num_cols; }
+            IndexType nvals() const { return m_nvals; }
+
+            bool hasElement(IndexType irow, IndexType icol) const
+            {
+                if (irow >= m_num_rows || icol >= m_num_cols)
+                {
+                    throw IndexOutOfBoundsException(
+                        "get_value_at: index out of bounds");
+                }
+
+                return std::binary_search(m_data[irow].begin(),
+                                          m_data[irow].end(), icol);
+            }
+
+            // Get value at index
+            ScalarT extractElement(IndexType irow, IndexType icol) const
+            {
+                if (!hasElement(irow, icol))
+                {
+                    throw NoValueException("get_value_at: no entry at index");
+                }
+                return m_iso_value;
+            }
+
+            // Set value at index (val must be the iso value)
+            void setElement(IndexType irow, IndexType icol, ScalarT const &val)
+            {
+                if (irow >= m_num_rows || icol >= m_num_cols)
+                {
+                    throw IndexOutOfBoundsException("setElement: index out of bounds");
+                }
+                check_iso(val, "setElement: value differs from the iso value");
+
+                m_col_index.invalidate();
+                IndexArrayType &row(m_data[irow]);
+                auto it = std::lower_bound(row.begin(), row.end(), icol);
+                if ((it == row.end()) || (*it != icol))
+                {
+                    row.insert(it, icol);
+                    ++m_nvals;
+                }
+            }
+
+            // Set value at index + 'merge' with any existing value; the
+            // merged value must be the iso value.
+            template <typename BinaryOpT>
+            void setElement(IndexType irow, IndexType icol, ScalarT const &val,
+                            BinaryOpT merge)
+            {
+                if (hasElement(irow, icol))
+                {
+                    check_iso(static_cast<ScalarT>(merge(m_iso_value, val)),
+                              "setElement: merged value differs from the iso value");
+                }
+                setElement(irow, icol, val);
+            }
+
+            RowType getRow(IndexType row_index) const
+            {
+                RowType data;
+                data.reserve(m_data[row_index].size());
+                for (auto col_idx : m_data[row_index])
+                {
+                    data.push_back(std::make_tuple(col_idx, m_iso_value));
+                }
+                return data;
+            }
+
+            /// Copy a row into a structure-of-arrays buffer.
+            void getRow(IndexType row_index, SparseRow<ScalarT> &row_data) const
+            {
+                row_data.clear();
+                row_data.reserve(m_data[row_index].size());
+                for (auto col_idx : m_data[row_index])
+                {
+                    row_data.push_back(col_idx, m_iso_value);
+                }
+            }
+
+            /// The stored column indices of a row, without values.
+            IndexArrayType const &getPattern(IndexType row_index) const
+            {
+                return m_data[row_index];
+            }
+
+            // Every value of row_data must be the iso value
+            template <typename OtherScalarT>
+            void setRow(
+                IndexType row_index,
+                std::vector<std::tuple<IndexType, OtherScalarT> > const &row_data)
+            {
+                for (auto const &tupl : row_data)
+                {
+                    check_iso(std::get<1>(tupl),
+                              "setRow: value differs from the iso value");
+                }
+
+                m_col_index.invalidate();
+                IndexArrayType &row(m_data[row_index]);
+                m_nvals = m_nvals + row_data.size() - row.size();
+                row.clear();
+                row.reserve(row_data.size());
+                for (auto const &tupl : row_data)
+                {
+                    row.push_back(std::get<0>(tupl));
+                }
+            }
+
+            ColType getCol(IndexType col_index) const
+            {
+                if (m_col_index.enabled())
+                {
+                    m_col_index.update(*this);
+                    return m_col_index.getCol(col_index);
+                }
+
+                std::vector<std::tuple<IndexType, ScalarT> > data;
+                for (IndexType ii = 0; ii < m_num_rows; ii++)
+                {
+                    if (std::binary_search(m_data[ii].begin(), m_data[ii].end(),
+                                           col_index))
+                    {
+                        data.push_back(std::make_tuple(ii, m_iso_value));
+                    }
+                }
+
+                return data;
+            }
+
+            /// Copy a column into a structure-of-arrays buffer.
+            void getCol(IndexType col_index, SparseRow<ScalarT> &col_data) const
+            {
+                if (m_col_index.enabled())
+                {
+                    m_col_index.update(*this);
+                    m_col_index.getCol(col_index, col_data);
+                }
+                else
+                {
+                    col_data.assign(getCol(col_index));
+                }
+            }
+
+            // col_data must be in increasing index order and hold only the
+            // iso value
+            template <typename OtherScalarT>
+            void setCol(
+                IndexType col_index,
+                std::vector<std::tuple<IndexType, OtherScalarT> > const &col_data)
+            {
+                for (auto const &tupl : col_data)
+                {
+                    check_iso(std::get<1>(tupl),
+                              "setCol: value differs from the iso value");
+                }
+
+                m_col_index.invalidate();
+                auto it = col_data.begin();
+                for (IndexType row_index = 0; row_index < m_num_rows; row_index++)
+                {
+                    IndexArrayType &row(m_data[row_index]);
+                    auto row_it = std::lower_bound(row.begin(), row.end(),
+                                                   col_index);
+                    bool stored = ((row_it != row.end()) && (*row_it == col_index));
+
+                    if ((it != col_data.end()) && (row_index == std::get<0>(*it)))
+                    {
+                        if (!stored)
+                        {
+                            row.insert(row_it, col_index);
+                            ++m_nvals;
+                        }
+                        ++it;
+                    }
+                    else if (stored)
+                    {
+                        row.erase(row_it);
+                        --m_nvals;
+                    }
+                }
+            }
+
+            // Get column indices for a given row
+            void getColumnIndices(IndexType irow, IndexArrayType &v) const
+            {
+                if (irow >= m_num_rows)
+                {
+                    throw IndexOutOfBoundsException(
+                        "getColumnIndices: index out of bounds");
+                }
+
+                if (!m_data[irow].empty())
+                {
+                    v = m_data[irow];
+                }
+            }
+
+            // Get row indices for a given column
+            void getRowIndices(IndexType icol, IndexArrayType &v) const
+            {
+                if (icol >= m_num_cols)
+                {
+                    throw IndexOutOfBoundsException(
+                        "getRowIndices: index out of bounds");
+                }
+
+                if (m_col_index.enabled())
+                {
+                    m_col_index.update(*this);
+                    m_col_index.getRowIndices(icol, v);
+                    return;
+                }
+
+                v.resize(0);
+                for (IndexType ii = 0; ii < m_num_rows; ii++)
+                {
+                    if (std::binary_search(m_data[ii].begin(), m_data[ii].end(),
+                                           icol))
+                    {
+                        v.push_back(ii);
+                    }
+                }
+            }
+
+            template<typename RAIteratorIT,
+                     typename RAIteratorJT,
+                     typename RAIteratorVT>
+            void extractTuples(RAIteratorIT        row_it,
+                               RAIteratorJT        col_it,
+                               RAIteratorVT        values) const
+            {
+                for (IndexType row = 0; row < m_num_rows; ++row)
+                {
+                    for (auto col_idx : m_data[row])
+                    {
+                        *row_it = row;         ++row_it;
+                        *col_it = col_idx;     ++col_it;
+                        *values = m_iso_value; ++values;
+                    }
+                }
+            }
+
+            /// Maintain a cached column-major index so that getCol() and
+            /// getRowIndices() cost O(column length).
+            void enableColumnIndex(bool flag = true)
+            {
+                m_col_index.enable(flag);
+            }
+
+            bool hasColumnIndex() const { return m_col_index.enabled(); }
+
+            /// Bring lazily maintained state (the column index) up to date.
+            /// Concurrent readers must call this first.
+            void assemble() const
+            {
+                if (m_col_index.enabled())
+                {
+                    m_col_index.update(*this);
+                }
+            }
+
+            // output specific to the storage layout of this type of matrix
+            void printInfo(std::ostream &os) const
+            {
+                // Used to print data in storage format instead of like a matrix
+                #ifdef GRB_SEQUENTIAL_MATRIX_PRINT_STORAGE
+                    os << "PatternSparseMatrix<" << typeid(ScalarT).name() << ">"
+                       << std::endl;
+                    os << "dimensions: " << m_num_rows << " x " << m_num_cols
+                       << std::endl;
+                    os << "num stored values = " << m_nvals
+                       << ", all equal to " << m_iso_value << std::endl;
+                    for (IndexType row = 0; row < m_data.size(); ++row)
+                    {
+                        os << row << " :";
+                        for (auto col_idx : m_data[row])
+                        {
+                            os << " " << col_idx;
+                        }
+                        os << std::endl;
+                    }
+                #else
+                    IndexType num_rows = nrows();
+                    IndexType num_cols = ncols();
+
+                    os << "(" << num_rows << "x" << num_cols << ")" << std::endl;
+
+                    for (IndexType row_idx = 0; row_idx < num_rows; ++row_idx)
+                    {
+                        // We like to start with a little whitespace indent
+                        os << ((row_idx == 0) ? "  [[" : "   [");
+
+                        IndexArrayType const &row(m_data[row_idx]);
+                        IndexType curr_idx = 0;
+
+                        for (auto col_idx : row)
+                        {
+                            while (curr_idx < col_idx)
+                            {
+                                os << ((curr_idx == 0) ? " " : ",  " );
+                                ++curr_idx;
+                            }
+
+                            if (curr_idx != 0)
+                                os << ", ";
+                            os << m_iso_value;
+                            ++curr_idx;
+                        }
+
+                        // Fill in the rest to the end
+                        while (curr_idx < num_cols)
+                        {
+                            os << ((curr_idx == 0) ? " " : ",  " );
+                            ++curr_idx;
+                        }
+                        os << ((row_idx == num_rows - 1 ) ? "]]" : "]\n");
+                    }
+                #endif
+            }
+
+            friend std::ostream &operator<<(std::ostream                       &os,
+                                            PatternSparseMatrix<ScalarT> const &mat)
+            {
+                mat.printInfo(os);
+                return os;
+            }
+
+        private:
+            template <typename OtherScalarT>
+            void check_iso(OtherScalarT const &val, char const *msg) const
+            {
+                if (static_cast<ScalarT>(val) != m_iso_value)
+                {
+                    throw InvalidValueException(msg);
+                }
+            }
+
+            IndexType m_num_rows;
+            IndexType m_num_cols;
+            IndexType m_nvals;
+
+            // One sorted list of column indices per row; no values
+            std::vector<IndexArrayType> m_data;
+            ScalarT                     m_iso_value;
+
+            // Optional column-major companion index
+            mutable ColumnIndex<ScalarT> m_col_index;
+        };
+
+    } // namespace backend
+
+} // namespace GraphBLAS
+
+#endif // GB_SEQUENTIAL_PATTERNSPARSEMATRIX_HPP
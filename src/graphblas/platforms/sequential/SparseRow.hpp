@@ -0,0 +1,128 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+#ifndef GB_SEQUENTIAL_SPARSEROW_HPP
+#define GB_SEQUENTIAL_SPARSEROW_HPP
+
+#include <vector>
+#include <tuple>
+#include <cstddef>
+
+#include <graphblas/types.hpp>
+
+//****************************************************************************
+
+namespace GraphBLAS
+{
+    namespace backend
+    {
+        /**
+         * @brief A sparse row (or column) held as two parallel arrays: the
+         *        sorted indices and their values.
+         *
+         * Used by the kernels as a reusable buffer in place of
+         * std::vector<std::tuple<IndexType, ScalarT>>: index-only loops
+         * (intersections, merges, mask probes) then read a dense IndexType
+         * array instead of striding over padded (index, value) pairs, and a
+         * value is only loaded once its index matched.
+         */
+        template<typename ScalarT>
+        class SparseRow
+        {
+        public:
+            typedef ScalarT ScalarType;
+
+            std::size_t size() const { return m_indices.size(); }
+            bool empty() const       { return m_indices.empty(); }
+
+            void clear()
+            {
+                m_indices.clear();
+                m_values.clear();
+            }
+
+            void reserve(std::size_t n)
+            {
+                m_indices.reserve(n);
+                m_values.reserve(n);
+            }
+
+            void push_back(IndexType idx, ScalarT const &val)
+            {
+                m_indices.push_back(idx);
+                m_values.push_back(val);
+            }
+
+            IndexType index(std::size_t k) const { return m_indices[k]; }
+            ScalarT   value(std::size_t k) const { return m_values[k]; }
+
+            std::vector<IndexType> const &indices() const { return m_indices; }
+            std::vector<ScalarT>   const &values()  const { return m_values; }
+
+            /// Replace the contents with [idx_first, idx_last) and the values
+            /// starting at val_first (e.g., a slice of CSR arrays).
+            template<typename IndexIteratorT, typename ValueIteratorT>
+            void assign(IndexIteratorT  idx_first,
+                        IndexIteratorT  idx_last,
+                        ValueIteratorT  val_first)
+            {
+                m_indices.assign(idx_first, idx_last);
+                m_values.assign(val_first, val_first + m_indices.size());
+            }
+
+            /// Replace the contents with a row of (index, value) tuples.
+            template<typename OtherScalarT>
+            void assign(
+                std::vector<std::tuple<IndexType, OtherScalarT> > const &tuples)
+            {
+                clear();
+                reserve(tuples.size());
+                for (auto const &tupl : tuples)
+                {
+                    m_indices.push_back(std::get<0>(tupl));
+                    m_values.push_back(static_cast<ScalarT>(std::get<1>(tupl)));
+                }
+            }
+
+            void swap(SparseRow<ScalarT> &rhs)
+            {
+                m_indices.swap(rhs.m_indices);
+                m_values.swap(rhs.m_values);
+            }
+
+        private:
+            std::vector<IndexType> m_indices;
+            std::vector<ScalarT>   m_values;
+        };
+
+    } // namespace backend
+
+} // namespace GraphBLAS
+
+#endif // GB_SEQUENTIAL_SPARSEROW_HPP
@@ -151,6 +151,8 @@ namespace GraphBLAS
             IndexType ncols() const { return m_matrix.nrows(); }
             IndexType nvals() const { return m_matrix.nvals(); }
 
+            void assemble() const { m_matrix.assemble(); }
+
             bool hasElement(IndexType irow, IndexType icol) const
             {
                 return m_matrix.hasElement(icol, irow);
@@ -197,6 +199,12 @@ namespace GraphBLAS
                 return m_matrix.getCol(row_index);
             }
 
+            template<typename RowScalarT>
+            void getRow(IndexType row_index, SparseRow<RowScalarT> &row_data) const
+            {
+                m_matrix.getCol(row_index, row_data);
+            }
+
             // Not implemented
             //void setRow(IndexType row_index,
             //           std::vector<std::tuple<IndexType, ScalarType> > &row_data)
@@ -207,6 +215,12 @@ namespace GraphBLAS
                 return m_matrix.getRow(col_index);
             }
 
+            template<typename ColScalarT>
+            void getCol(IndexType col_index, SparseRow<ColScalarT> &col_data) const
+            {
+                m_matrix.getRow(col_index, col_data);
+            }
+
             // Not implemented
             //void setCol(IndexType col_index,
             //            std::vector<std::tuple<IndexType, ScalarType> > &col_data)
@@ -34,6 +34,7 @@
 
 #include <graphblas/detail/config.hpp>
 #include <vector>
+#include <utility>
 #include <graphblas/platforms/sequential/BitmapSparseVector.hpp>
 
 namespace GraphBLAS
@@ -41,8 +42,27 @@ namespace GraphBLAS
     namespace backend
     {
         //**********************************************************************
-        /// @note ignoring all tags here, there is currently only one
-        ///       implementation of vector: dense+bitmap.
+        /// SparseTag pins the sorted list form, DenseTag the bitmap form;
+        /// without either the vector switches between them by fill.
+        template<typename... TagsT>
+        struct vector_form_policy
+        {
+            static const VectorFormPolicy value = FORM_AUTO;
+        };
+
+        template<typename... TagsT>
+        struct vector_form_policy<SparseTag, TagsT...>
+        {
+            static const VectorFormPolicy value = FORM_PINNED_SPARSE;
+        };
+
+        template<typename... TagsT>
+        struct vector_form_policy<DenseTag, TagsT...>
+        {
+            static const VectorFormPolicy value = FORM_PINNED_DENSE;
+        };
+
+        //**********************************************************************
         template<typename ScalarT, typename... TagsT>
         class Vector : public BitmapSparseVector<ScalarT>
         {
@@ -54,19 +74,52 @@ namespace GraphBLAS
 
             Vector() = delete;
 
-            Vector(IndexType nsize) : ParentVectorType(nsize) {}
+            Vector(IndexType nsize) : ParentVectorType(nsize)
+            {
+                pin_form();
+            }
 
             Vector(IndexType const &nsize, ScalarT const &value)
-                : ParentVectorType(nsize, value) {}
+                : ParentVectorType(nsize, value)
+            {
+                pin_form();
+            }
 
             Vector(std::vector<ScalarT> const &values)
-                : ParentVectorType(values) {}
+                : ParentVectorType(values)
+            {
+                pin_form();
+            }
 
             Vector(std::vector<ScalarT> const &values, ScalarT const &zero)
-                : ParentVectorType(values, zero) {}
+                : ParentVectorType(values, zero)
+            {
+                pin_form();
+            }
+
+            Vector(Vector const &rhs) : ParentVectorType(rhs) {}
+
+            Vector(Vector &&rhs) : ParentVectorType(std::move(rhs)) {}
 
             ~Vector() {}  // virtual?
 
+            Vector &operator=(Vector const &rhs)
+            {
+                ParentVectorType::operator=(rhs);
+                return *this;
+            }
+
+            Vector &operator=(Vector &&rhs)
+            {
+                ParentVectorType::operator=(std::move(rhs));
+                return *this;
+            }
+
+            void swap(Vector &rhs)
+            {
+                ParentVectorType::swap(rhs);
+            }
+
             // necessary?
             bool operator==(Vector const &rhs) const
             {
@@ -84,6 +137,13 @@ namespace GraphBLAS
                 os << "Sequential Backend:" << std::endl;
                 BitmapSparseVector<ScalarT>::printInfo(os);
             }
+
+        private:
+            void pin_form()
+            {
+                ParentVectorType::setFormPolicy(
+                    vector_form_policy<TagsT...>::value);
+            }
         };
     }
 }
@@ -0,0 +1,558 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+
+/**
+ * A binary CSR file format that can be memory-mapped and used in place.
+ *
+ * Layout (all integers in the writer's byte order):
+ *
+ *   offset 0    BinaryCsrHeader (64 bytes)
+ *   offset 64   row_ptr  (num_rows + 1 entries of index_bytes)
+ *   aligned 64  col_idx  (num_vals entries of index_bytes)
+ *   aligned 64  vals     (num_vals entries of value_bytes; bool as 1 byte)
+ *
+ * Loading into a CSR-stored matrix maps the file and points the matrix at
+ * the mapped arrays without copying; a list-of-lists matrix is filled row
+ * by row instead.
+ */
+
+#ifndef GB_SEQUENTIAL_BINARY_CSR_HPP
+#define GB_SEQUENTIAL_BINARY_CSR_HPP
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <graphblas/types.hpp>
+#include <graphblas/exceptions.hpp>
+#include <graphblas/platforms/sequential/Matrix.hpp>
+
+//****************************************************************************
+
+namespace GraphBLAS
+{
+    namespace backend
+    {
+        //********************************************************************
+        struct BinaryCsrHeader
+        {
+            char     magic[8];      // "GBTLCSR\0"
+            uint32_t version;
+            uint32_t byte_order;    // 0x01020304 as seen by the writer
+            uint64_t num_rows;
+            uint64_t num_cols;
+            uint64_t num_vals;
+            uint32_t index_bytes;
+            uint32_t value_bytes;
+            uint32_t value_kind;    // see binary_csr_value_kind
+            uint32_t reserved[3];
+        };
+
+        static_assert(sizeof(BinaryCsrHeader) == 64,
+                      "BinaryCsrHeader must be 64 bytes");
+
+        static char const     BINARY_CSR_MAGIC[8] = "GBTLCSR";
+        static uint32_t const BINARY_CSR_VERSION = 1;
+        static uint32_t const BINARY_CSR_BYTE_ORDER = 0x01020304;
+        static uint64_t const BINARY_CSR_ALIGN = 64;
+
+        enum BinaryCsrValueKind
+        {
+            BINARY_CSR_BOOL     = 0,
+            BINARY_CSR_SIGNED   = 1,
+            BINARY_CSR_UNSIGNED = 2,
+            BINARY_CSR_FLOAT    = 3
+        };
+
+        /// How values of type ScalarT are tagged in the header.
+        template<typename ScalarT>
+        inline uint32_t binary_csr_value_kind()
+        {
+            static_assert(std::is_arithmetic<ScalarT>::value,
+                          "binary CSR files hold arithmetic values only");
+            return (std::is_same<ScalarT, bool>::value ? BINARY_CSR_BOOL :
+                    std::is_floating_point<ScalarT>::value ? BINARY_CSR_FLOAT :
+                    std::is_signed<ScalarT>::value ? BINARY_CSR_SIGNED :
+                    BINARY_CSR_UNSIGNED);
+        }
+
+        inline uint64_t binary_csr_align(uint64_t offset)
+        {
+            return (offset + BINARY_CSR_ALIGN - 1) & ~(BINARY_CSR_ALIGN - 1);
+        }
+
+        namespace detail
+        {
+            // a + b*c, throwing instead of wrapping around.
+            inline uint64_t checked_mul_add(uint64_t a, uint64_t b, uint64_t c)
+            {
+                uint64_t const max_val(std::numeric_limits<uint64_t>::max());
+                if ((c != 0) && (b > (max_val - a)/c))
+                {
+                    throw IOException("binary CSR: array sizes overflow");
+                }
+                return a + b*c;
+            }
+
+            inline uint64_t checked_align(uint64_t offset)
+            {
+                if (offset > std::numeric_limits<uint64_t>::max() -
+                             (BINARY_CSR_ALIGN - 1))
+                {
+                    throw IOException("binary CSR: array sizes overflow");
+                }
+                return binary_csr_align(offset);
+            }
+        }
+
+        /// Byte offsets of the three arrays for the given header.
+        ///
+        /// @throw IOException  If the sizes do not fit in 64 bits
+        inline void binary_csr_offsets(BinaryCsrHeader const &hdr,
+                                       uint64_t &row_ptr_off,
+                                       uint64_t &col_idx_off,
+                                       uint64_t &vals_off,
+                                       uint64_t &file_bytes)
+        {
+            row_ptr_off = sizeof(BinaryCsrHeader);
+            col_idx_off = detail::checked_align(
+                detail::checked_mul_add(
+                    row_ptr_off, detail::checked_mul_add(1, hdr.num_rows, 1),
+                    hdr.index_bytes));
+            vals_off    = detail::checked_align(
+                detail::checked_mul_add(col_idx_off, hdr.num_vals,
+                                        hdr.index_bytes));
+            file_bytes  = detail::checked_mul_add(vals_off, hdr.num_vals,
+                                                  hdr.value_bytes);
+        }
+
+        //********************************************************************
+        namespace detail
+        {
+            inline void write_bytes(std::ofstream     &ofs,
+                                    void const        *data,
+                                    uint64_t           nbytes)
+            {
+                ofs.write(static_cast<char const *>(data),
+                          static_cast<std::streamsize>(nbytes));
+            }
+
+            inline void pad_to(std::ofstream &ofs, uint64_t offset)
+            {
+                static char const zeros[BINARY_CSR_ALIGN] = {0};
+                uint64_t pos = static_cast<uint64_t>(ofs.tellp());
+                if (pos < offset)
+                {
+                    write_bytes(ofs, zeros, offset - pos);
+                }
+            }
+
+            template<typename ScalarT, typename ValuesT>
+            inline void write_values(std::ofstream &ofs, ValuesT const &vals)
+            {
+                write_bytes(ofs, vals.data(), vals.size()*sizeof(ScalarT));
+            }
+
+            // std::vector<bool> is packed: write one byte per value.
+            template<>
+            inline void write_values<bool, std::vector<bool>>(
+                std::ofstream &ofs, std::vector<bool> const &vals)
+            {
+                std::vector<uint8_t> bytes(vals.begin(), vals.end());
+                write_bytes(ofs, bytes.data(), bytes.size());
+            }
+
+            template<typename ScalarT,
+                     typename RowPtrT, typename ColIdxT, typename ValuesT>
+            inline void write_csr_arrays(std::string const &path,
+                                         IndexType          num_rows,
+                                         IndexType          num_cols,
+                                         RowPtrT const     &row_ptr,
+                                         ColIdxT const     &col_idx,
+                                         ValuesT const     &vals)
+            {
+                BinaryCsrHeader hdr;
+                std::memset(&hdr, 0, sizeof(hdr));
+                std::memcpy(hdr.magic, BINARY_CSR_MAGIC, sizeof(hdr.magic));
+                hdr.version     = BINARY_CSR_VERSION;
+                hdr.byte_order  = BINARY_CSR_BYTE_ORDER;
+                hdr.num_rows    = num_rows;
+                hdr.num_cols    = num_cols;
+                hdr.num_vals    = col_idx.size();
+                hdr.index_bytes = sizeof(IndexType);
+                hdr.value_bytes = sizeof(ScalarT);
+                hdr.value_kind  = binary_csr_value_kind<ScalarT>();
+
+                uint64_t row_ptr_off, col_idx_off, vals_off, file_bytes;
+                binary_csr_offsets(hdr, row_ptr_off, col_idx_off, vals_off,
+                                   file_bytes);
+
+                std::ofstream ofs(path, std::ios::binary | std::ios::trunc);
+                if (!ofs)
+                {
+                    throw IOException("write_binary_csr: cannot open " + path);
+                }
+
+                write_bytes(ofs, &hdr, sizeof(hdr));
+                write_bytes(ofs, row_ptr.data(),
+                            row_ptr.size()*sizeof(IndexType));
+                pad_to(ofs, col_idx_off);
+                write_bytes(ofs, col_idx.data(),
+                            col_idx.size()*sizeof(IndexType));
+                pad_to(ofs, vals_off);
+                write_values<ScalarT>(ofs, vals);
+
+                ofs.close();
+                if (!ofs)
+                {
+                    throw IOException("write_binary_csr: error writing " + path);
+                }
+            }
+
+            // CSR storage: write the arrays as they are.
+            template<typename MatrixT>
+            inline void write_binary_csr(std::string const &path,
+                                         MatrixT const     &A,
+                                         std::true_type)
+            {
+                typedef typename MatrixT::ScalarType ScalarT;
+                write_csr_arrays<ScalarT>(path, A.nrows(), A.ncols(),
+                                          A.get_row_ptr(), A.get_col_idx(),
+                                          A.get_vals());
+            }
+
+            // Any other storage: gather the arrays from the rows.
+            template<typename MatrixT>
+            inline void write_binary_csr(std::string const &path,
+                                         MatrixT const     &A,
+                                         std::false_type)
+            {
+                typedef typename MatrixT::ScalarType ScalarT;
+                std::vector<IndexType> row_ptr(A.nrows() + 1, 0);
+                std::vector<IndexType> col_idx;
+                std::vector<ScalarT>   vals;
+                col_idx.reserve(A.nvals());
+                vals.reserve(A.nvals());
+
+                for (IndexType row_idx = 0; row_idx < A.nrows(); ++row_idx)
+                {
+                    for (auto const &tupl : A.getRow(row_idx))
+                    {
+                        col_idx.push_back(std::get<0>(tupl));
+                        vals.push_back(std::get<1>(tupl));
+                    }
+                    row_ptr[row_idx + 1] = col_idx.size();
+                }
+
+                write_csr_arrays<ScalarT>(path, A.nrows(), A.ncols(),
+                                          row_ptr, col_idx, vals);
+            }
+        } // namespace detail
+
+        /// Write a backend matrix in the binary CSR format.
+        template<typename MatrixT>
+        inline void write_binary_csr(std::string const &path,
+                                     MatrixT const     &A)
+        {
+            detail::write_binary_csr(path, A, is_csr_matrix<MatrixT>());
+        }
+
+        //********************************************************************
+        /// A read-only, private mapping of a whole file (POSIX mmap).
+        class MappedFile
+        {
+        public:
+            explicit MappedFile(std::string const &path)
+                : m_data(nullptr), m_size(0)
+            {
+                int fd = ::open(path.c_str(), O_RDONLY);
+                if (fd < 0)
+                {
+                    throw IOException("MappedFile: cannot open " + path);
+                }
+
+                struct stat st;
+                if ((::fstat(fd, &st) != 0) || (st.st_size <= 0))
+                {
+                    ::close(fd);
+                    throw IOException("MappedFile: cannot map empty file " + path);
+                }
+                m_size = static_cast<std::size_t>(st.st_size);
+
+                void *addr = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE,
+                                    fd, 0);
+                ::close(fd);  // the mapping holds its own reference
+                if (addr == MAP_FAILED)
+                {
+                    throw IOException("MappedFile: mmap failed for " + path);
+                }
+                m_data = static_cast<char const *>(addr);
+            }
+
+            ~MappedFile()
+            {
+                ::munmap(const_cast<char *>(m_data), m_size);
+            }
+
+            MappedFile(MappedFile const &) = delete;
+            MappedFile &operator=(MappedFile const &) = delete;
+
+            char const *data() const  { return m_data; }
+            std::size_t size() const  { return m_size; }
+
+        private:
+            char const   *m_data;
+            std::size_t   m_size;
+        };
+
+        //********************************************************************
+        /**
+         * @brief An opened (mapped and validated) binary CSR file.
+         *
+         * The mapping is shared with every matrix loaded from it and is
+         * released when the last of them lets go of the mapped arrays.
+         *
+         * Opening checks the header and the row offsets (O(nrows)).  The
+         * column indices are checked when loading: always while copying into
+         * non-CSR storage, and by a separate scan of the mapped array for
+         * CSR storage unless trust_file is set.  Out of range indices would
+         * otherwise be used to index the kernels' dense accumulators, so only
+         * skip the scan for files this program wrote itself.
+         */
+        class BinaryCsrFile
+        {
+        public:
+            explicit BinaryCsrFile(std::string const &path,
+                                   bool               trust_file = false)
+                : m_path(path),
+                  m_trust_file(trust_file),
+                  m_file(std::make_shared<MappedFile>(path))
+            {
+                if (m_file->size() < sizeof(BinaryCsrHeader))
+                {
+                    throw IOException("read_binary_csr: truncated header in " + path);
+                }
+                std::memcpy(&m_hdr, m_file->data(), sizeof(m_hdr));
+
+                if (std::memcmp(m_hdr.magic, BINARY_CSR_MAGIC,
+                                sizeof(m_hdr.magic)) != 0)
+                {
+                    throw IOException("read_binary_csr: not a binary CSR file: " + path);
+                }
+                if (m_hdr.version != BINARY_CSR_VERSION)
+                {
+                    throw IOException("read_binary_csr: unsupported version in " + path);
+                }
+                if (m_hdr.byte_order != BINARY_CSR_BYTE_ORDER)
+                {
+                    throw IOException("read_binary_csr: byte order mismatch in " + path);
+                }
+                if (m_hdr.index_bytes != sizeof(IndexType))
+                {
+                    throw IOException("read_binary_csr: index size mismatch in " + path);
+                }
+
+                // Each array fits in the file: bounds the counts before
+                // any offset arithmetic.
+                uint64_t const max_entries(m_file->size()/m_hdr.index_bytes);
+                if ((m_hdr.num_rows >= max_entries) ||
+                    (m_hdr.num_vals >= max_entries) ||
+                    ((m_hdr.value_bytes != 0) &&
+                     (m_hdr.num_vals > m_file->size()/m_hdr.value_bytes)))
+                {
+                    throw IOException("read_binary_csr: truncated file " + path);
+                }
+
+                uint64_t row_ptr_off, col_idx_off, vals_off, file_bytes;
+                binary_csr_offsets(m_hdr, row_ptr_off, col_idx_off, vals_off,
+                                   file_bytes);
+                if (m_file->size() < file_bytes)
+                {
+                    throw IOException("read_binary_csr: truncated file " + path);
+                }
+
+                m_row_ptr = reinterpret_cast<IndexType const *>(
+                    m_file->data() + row_ptr_off);
+                m_col_idx = reinterpret_cast<IndexType const *>(
+                    m_file->data() + col_idx_off);
+                m_vals = m_file->data() + vals_off;
+
+                check_row_offsets();
+            }
+
+            IndexType nrows() const { return m_hdr.num_rows; }
+            IndexType ncols() const { return m_hdr.num_cols; }
+            IndexType nvals() const { return m_hdr.num_vals; }
+
+            /// Load into A (which must have the file's shape).
+            template<typename MatrixT>
+            void load(MatrixT &A) const
+            {
+                typedef typename MatrixT::ScalarType ScalarT;
+                if ((m_hdr.value_kind != binary_csr_value_kind<ScalarT>()) ||
+                    (m_hdr.value_bytes != sizeof(ScalarT)))
+                {
+                    throw IOException("read_binary_csr: value type mismatch in " + m_path);
+                }
+                if ((A.nrows() != nrows()) || (A.ncols() != ncols()))
+                {
+                    throw DimensionException("read_binary_csr: shape mismatch");
+                }
+                load(A, is_csr_matrix<MatrixT>());
+            }
+
+        private:
+            // Row offsets must run from 0 to nvals without decreasing.
+            void check_row_offsets() const
+            {
+                if ((m_row_ptr[0] != 0) || (m_row_ptr[nrows()] != nvals()))
+                {
+                    throw IOException("read_binary_csr: bad row offsets in " + m_path);
+                }
+                for (IndexType row_idx = 0; row_idx < nrows(); ++row_idx)
+                {
+                    if (m_row_ptr[row_idx + 1] < m_row_ptr[row_idx])
+                    {
+                        throw IOException("read_binary_csr: bad row offsets in " + m_path);
+                    }
+                }
+            }
+
+            // Column indices must be sorted and in range within each row.
+            void check_col_indices() const
+            {
+                for (IndexType row_idx = 0; row_idx < nrows(); ++row_idx)
+                {
+                    IndexType start = m_row_ptr[row_idx];
+                    IndexType stop  = m_row_ptr[row_idx + 1];
+                    for (IndexType ix = start; ix < stop; ++ix)
+                    {
+                        if ((m_col_idx[ix] >= ncols()) ||
+                            ((ix > start) && (m_col_idx[ix] <= m_col_idx[ix - 1])))
+                        {
+                            throw IOException("read_binary_csr: bad column indices in " + m_path);
+                        }
+                    }
+                }
+            }
+
+            template<typename ScalarT>
+            CsrArray<ScalarT> values_array(ScalarT const *) const
+            {
+                return CsrArray<ScalarT>(
+                    reinterpret_cast<ScalarT const *>(m_vals), nvals(), m_file);
+            }
+
+            std::vector<bool> values_array(bool const *) const
+            {
+                uint8_t const *bytes = reinterpret_cast<uint8_t const *>(m_vals);
+                return std::vector<bool>(bytes, bytes + nvals());
+            }
+
+            // CSR storage: point the matrix at the mapped arrays.
+            template<typename MatrixT>
+            void load(MatrixT &A, std::true_type) const
+            {
+                typedef typename MatrixT::ScalarType ScalarT;
+                if (!m_trust_file)
+                {
+                    check_col_indices();
+                }
+                A.adopt_arrays(
+                    CsrArray<IndexType>(m_row_ptr, nrows() + 1, m_file),
+                    CsrArray<IndexType>(m_col_idx, nvals(), m_file),
+                    values_array(static_cast<ScalarT const *>(nullptr)));
+            }
+
+            // Any other storage: copy row by row, checking the column
+            // indices on the way (every entry is read anyway).
+            template<typename MatrixT>
+            void load(MatrixT &A, std::false_type) const
+            {
+                typedef typename MatrixT::ScalarType ScalarT;
+                ScalarT const *vals = reinterpret_cast<ScalarT const *>(m_vals);
+                uint8_t const *bool_vals = reinterpret_cast<uint8_t const *>(m_vals);
+
+                A.clear();
+                std::vector<std::tuple<IndexType, ScalarT> > row;
+                for (IndexType row_idx = 0; row_idx < nrows(); ++row_idx)
+                {
+                    IndexType start = m_row_ptr[row_idx];
+                    IndexType stop  = m_row_ptr[row_idx + 1];
+                    if (start == stop)
+                    {
+                        continue;
+                    }
+
+                    row.clear();
+                    for (IndexType ix = start; ix < stop; ++ix)
+                    {
+                        if ((m_col_idx[ix] >= ncols()) ||
+                            ((ix > start) && (m_col_idx[ix] <= m_col_idx[ix - 1])))
+                        {
+                            A.clear();
+                            throw IOException("read_binary_csr: bad column indices in " + m_path);
+                        }
+                        ScalarT val = (std::is_same<ScalarT, bool>::value ?
+                                       static_cast<ScalarT>(bool_vals[ix] != 0) :
+                                       vals[ix]);
+                        row.push_back(std::make_tuple(m_col_idx[ix], val));
+                    }
+                    A.setRow(row_idx, row);
+                }
+            }
+
+            std::string                  m_path;
+            bool                         m_trust_file;
+            std::shared_ptr<MappedFile>  m_file;
+            BinaryCsrHeader              m_hdr;
+            IndexType const             *m_row_ptr;
+            IndexType const             *m_col_idx;
+            char const                  *m_vals;
+        };
+
+    } // namespace backend
+
+} // namespace GraphBLAS
+
+#endif // GB_SEQUENTIAL_BINARY_CSR_HPP
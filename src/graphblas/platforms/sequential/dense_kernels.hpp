@@ -0,0 +1,261 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+
+#ifndef GB_SEQUENTIAL_DENSE_KERNELS_HPP
+#define GB_SEQUENTIAL_DENSE_KERNELS_HPP
+
+#include <vector>
+#include <algorithm>
+#include <type_traits>
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#include <graphblas/types.hpp>
+#include <graphblas/algebra.hpp>
+
+//****************************************************************************
+// Element-wise loops over runs of contiguous stored values (the fully
+// populated words of a bitmap vector).  Plus, Minus, Times, Div, Min and
+// Max on float or double (also bound to a constant with BinaryOp_Bind2nd)
+// use AVX-512 or AVX2 when the compiler targets them (e.g. -march=native);
+// everything else, and every build without them, runs the scalar loop.
+// Each lane computes exactly what the scalar operator would.
+//****************************************************************************
+
+namespace GraphBLAS
+{
+    namespace backend
+    {
+        /// Register type and width of the widest enabled vector unit.
+        template <typename ScalarT>
+        struct SimdPack
+        {
+            static const bool enabled = false;
+        };
+
+        /// Vector form of the supported binary operators (void if none).
+        template <typename BinaryOpT>
+        struct SimdBinaryOp
+        {
+            typedef void scalar_type;
+        };
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+
+#define GB_SIMD_PACK(PREFIX, SUFFIX, REG, SCALAR, WIDTH)                \
+        template <> struct SimdPack<SCALAR>                             \
+        {                                                               \
+            static const bool enabled = true;                           \
+            static const IndexType width = WIDTH;                       \
+            typedef REG type;                                           \
+        };                                                              \
+        inline REG simd_load(SCALAR const *p) { return PREFIX##_loadu_##SUFFIX(p); } \
+        inline void simd_store(SCALAR *p, REG a) { PREFIX##_storeu_##SUFFIX(p, a); } \
+        inline REG simd_set1(SCALAR x) { return PREFIX##_set1_##SUFFIX(x); } \
+        inline REG simd_add(REG a, REG b) { return PREFIX##_add_##SUFFIX(a, b); } \
+        inline REG simd_sub(REG a, REG b) { return PREFIX##_sub_##SUFFIX(a, b); } \
+        inline REG simd_mul(REG a, REG b) { return PREFIX##_mul_##SUFFIX(a, b); } \
+        inline REG simd_div(REG a, REG b) { return PREFIX##_div_##SUFFIX(a, b); } \
+        inline REG simd_min(REG a, REG b) { return PREFIX##_min_##SUFFIX(a, b); } \
+        inline REG simd_max(REG a, REG b) { return PREFIX##_max_##SUFFIX(a, b); }
+
+#if defined(__AVX512F__)
+        GB_SIMD_PACK(_mm512, pd, __m512d, double, 8)
+        GB_SIMD_PACK(_mm512, ps, __m512,  float, 16)
+#else
+        GB_SIMD_PACK(_mm256, pd, __m256d, double, 4)
+        GB_SIMD_PACK(_mm256, ps, __m256,  float,  8)
+#endif
+#undef GB_SIMD_PACK
+
+        // min(a, b) returns b unless a < b, like Min; max(b, a) returns a
+        // unless a < b, like Max (this matters for NaN and signed zeros).
+#define GB_SIMD_BINARY_OP(OP, EXPR)                                     \
+        template <typename T>                                           \
+        struct SimdBinaryOp<OP<T, T, T> >                               \
+        {                                                               \
+            typedef T scalar_type;                                      \
+            template <typename RegT>                                    \
+            static RegT apply(RegT a, RegT b) { return EXPR; }          \
+        };
+
+        GB_SIMD_BINARY_OP(Plus,  simd_add(a, b))
+        GB_SIMD_BINARY_OP(Minus, simd_sub(a, b))
+        GB_SIMD_BINARY_OP(Times, simd_mul(a, b))
+        GB_SIMD_BINARY_OP(Div,   simd_div(a, b))
+        GB_SIMD_BINARY_OP(Min,   simd_min(a, b))
+        GB_SIMD_BINARY_OP(Max,   simd_max(b, a))
+#undef GB_SIMD_BINARY_OP
+
+#endif
+
+        /// True when op on these value types has a vector implementation.
+        template <typename D3, typename D1, typename D2, typename BinaryOpT>
+        struct use_simd_binary
+            : std::integral_constant<
+                bool,
+                SimdPack<D3>::enabled &&
+                std::is_same<typename SimdBinaryOp<BinaryOpT>::scalar_type,
+                             D3>::value &&
+                std::is_same<D1, D3>::value && std::is_same<D2, D3>::value>
+        {
+        };
+
+        //**********************************************************************
+        /// out[k] = op(a[k], b[k]) for k in [begin, end)
+        template <typename D3, typename D1, typename D2, typename BinaryOpT>
+        inline void dense_binary(std::vector<D3>       &out,
+                                 std::vector<D1> const &a,
+                                 std::vector<D2> const &b,
+                                 IndexType              begin,
+                                 IndexType              end,
+                                 BinaryOpT             &op,
+                                 std::false_type)
+        {
+            for (IndexType k = begin; k < end; ++k)
+            {
+                out[k] = static_cast<D3>(op(a[k], b[k]));
+            }
+        }
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+        template <typename T, typename BinaryOpT>
+        inline void dense_binary(std::vector<T>       &out,
+                                 std::vector<T> const &a,
+                                 std::vector<T> const &b,
+                                 IndexType             begin,
+                                 IndexType             end,
+                                 BinaryOpT            &op,
+                                 std::true_type)
+        {
+            IndexType const width(SimdPack<T>::width);
+            IndexType k(begin);
+            for (; k + width <= end; k += width)
+            {
+                simd_store(out.data() + k,
+                           SimdBinaryOp<BinaryOpT>::apply(
+                               simd_load(a.data() + k),
+                               simd_load(b.data() + k)));
+            }
+            dense_binary(out, a, b, k, end, op, std::false_type());
+        }
+#endif
+
+        template <typename D3, typename D1, typename D2, typename BinaryOpT>
+        inline void dense_binary(std::vector<D3>       &out,
+                                 std::vector<D1> const &a,
+                                 std::vector<D2> const &b,
+                                 IndexType              begin,
+                                 IndexType              end,
+                                 BinaryOpT             &op)
+        {
+            dense_binary(out, a, b, begin, end, op,
+                         use_simd_binary<D3, D1, D2, BinaryOpT>());
+        }
+
+        //**********************************************************************
+        /// How a unary operator maps onto the vector unit.
+        template <typename D2, typename D1, typename UnaryOpT>
+        struct use_simd_unary : std::false_type
+        {
+        };
+
+        /// op(x, n) with a supported op: broadcast n.
+        template <typename T, typename ConstT, typename BinaryOpT>
+        struct use_simd_unary<T, T, BinaryOp_Bind2nd<ConstT, BinaryOpT> >
+            : use_simd_binary<T, T, T, BinaryOpT>
+        {
+        };
+
+        /// out[k] = op(a[k]) for k in [begin, end)
+        template <typename D2, typename D1, typename UnaryOpT>
+        inline void dense_unary(std::vector<D2>       &out,
+                                std::vector<D1> const &a,
+                                IndexType              begin,
+                                IndexType              end,
+                                UnaryOpT              &op,
+                                std::false_type)
+        {
+            for (IndexType k = begin; k < end; ++k)
+            {
+                out[k] = static_cast<D2>(op(a[k]));
+            }
+        }
+
+        /// Identity without a type change is a copy.
+        template <typename T>
+        inline void dense_unary(std::vector<T>       &out,
+                                std::vector<T> const &a,
+                                IndexType             begin,
+                                IndexType             end,
+                                Identity<T, T>       &,
+                                std::false_type)
+        {
+            std::copy(a.begin() + begin, a.begin() + end, out.begin() + begin);
+        }
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+        template <typename T, typename ConstT, typename BinaryOpT>
+        inline void dense_unary(std::vector<T>                         &out,
+                                std::vector<T>                   const &a,
+                                IndexType                               begin,
+                                IndexType                               end,
+                                BinaryOp_Bind2nd<ConstT, BinaryOpT>    &op,
+                                std::true_type)
+        {
+            IndexType const width(SimdPack<T>::width);
+            auto const n(simd_set1(static_cast<T>(op.n)));
+            IndexType k(begin);
+            for (; k + width <= end; k += width)
+            {
+                simd_store(out.data() + k,
+                           SimdBinaryOp<BinaryOpT>::apply(
+                               simd_load(a.data() + k), n));
+            }
+            dense_unary(out, a, k, end, op, std::false_type());
+        }
+#endif
+
+        template <typename D2, typename D1, typename UnaryOpT>
+        inline void dense_unary(std::vector<D2>       &out,
+                                std::vector<D1> const &a,
+                                IndexType              begin,
+                                IndexType              end,
+                                UnaryOpT              &op)
+        {
+            dense_unary(out, a, begin, end, op,
+                        use_simd_unary<D2, D1, UnaryOpT>());
+        }
+    } // backend
+} // GraphBLAS
+
+#endif // GB_SEQUENTIAL_DENSE_KERNELS_HPP
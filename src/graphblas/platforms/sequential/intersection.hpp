@@ -0,0 +1,328 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+/**
+ * Intersection of two sorted lists of distinct indices, the inner loop of
+ * the dot products and of the element-wise intersections.
+ *
+ * intersect_sorted() calls visit(k1, k2) for every pair of positions with
+ * list1[k1] == list2[k2], in increasing index order, until visit returns
+ * false.  When one list is at
+ * least GB_GALLOP_RATIO times longer than the other, each index of the
+ * short list is looked up in the long one by galloping (exponential, then
+ * binary) search: O(short * log(long / short)) instead of O(short + long).
+ * Otherwise the lists are merged; plain index arrays are merged a block of
+ * indices at a time with AVX2 (4 per step) or AVX-512 (8 per step) when
+ * the compiler targets them (e.g. -march=native).
+ */
+
+#ifndef GB_SEQUENTIAL_INTERSECTION_HPP
+#define GB_SEQUENTIAL_INTERSECTION_HPP
+
+#include <cstddef>
+#include <tuple>
+#include <algorithm>
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#include <graphblas/types.hpp>
+
+/// Length ratio above which the intersection gallops through the longer
+/// list instead of merging.
+#ifndef GB_GALLOP_RATIO
+#define GB_GALLOP_RATIO 16
+#endif
+
+//****************************************************************************
+
+namespace GraphBLAS
+{
+    namespace backend
+    {
+        /// The index of an element of a sorted list (an index array or a
+        /// row of (index, value) tuples).
+        struct IndexKey
+        {
+            IndexType operator()(IndexType idx) const { return idx; }
+
+            template <typename ScalarT>
+            IndexType operator()(std::tuple<IndexType, ScalarT> const &elt) const
+            {
+                return std::get<0>(elt);
+            }
+        };
+
+        //**********************************************************************
+        /// Look up each index of the short list in the long one, galloping
+        /// forward from the previous hit.  visit() gets the positions in
+        /// (list1, list2) order: swapped is true when short is list2.
+        template <typename ShortIt, typename LongIt, typename VisitT>
+        inline void intersect_gallop(ShortIt      short_it,
+                                     std::size_t  n_short,
+                                     LongIt       long_it,
+                                     std::size_t  n_long,
+                                     VisitT      &visit,
+                                     bool         swapped)
+        {
+            IndexKey key;
+            std::size_t lo(0);
+            for (std::size_t ks = 0; (ks < n_short) && (lo < n_long); ++ks)
+            {
+                IndexType target(key(short_it[ks]));
+
+                // Exponential search for a bound, then binary search
+                std::size_t bound(1);
+                while ((lo + bound < n_long) && (key(long_it[lo + bound]) < target))
+                {
+                    bound <<= 1;
+                }
+                std::size_t hi(std::min(lo + bound + 1, n_long));
+
+                while (lo < hi)
+                {
+                    std::size_t mid(lo + (hi - lo)/2);
+                    if (key(long_it[mid]) < target)
+                    {
+                        lo = mid + 1;
+                    }
+                    else
+                    {
+                        hi = mid;
+                    }
+                }
+
+                if ((lo < n_long) && (key(long_it[lo]) == target))
+                {
+                    if (!(swapped ? visit(lo, ks) : visit(ks, lo)))
+                    {
+                        return;
+                    }
+                    ++lo;
+                }
+            }
+        }
+
+        //**********************************************************************
+        /// Merge from positions (k1, k2) to the end of either list.
+        template <typename It1, typename It2, typename VisitT>
+        inline void intersect_merge_scalar(It1          it1,
+                                           std::size_t  k1,
+                                           std::size_t  n1,
+                                           It2          it2,
+                                           std::size_t  k2,
+                                           std::size_t  n2,
+                                           VisitT      &visit)
+        {
+            IndexKey key;
+            while ((k1 < n1) && (k2 < n2))
+            {
+                IndexType i1(key(it1[k1])), i2(key(it2[k2]));
+                if (i1 == i2)
+                {
+                    if (!visit(k1, k2))
+                    {
+                        return;
+                    }
+                    ++k1;
+                    ++k2;
+                }
+                else
+                {
+                    k1 += (i1 < i2);
+                    k2 += (i2 < i1);
+                }
+            }
+        }
+
+        template <typename It1, typename It2, typename VisitT>
+        inline void intersect_merge(It1          it1,
+                                    std::size_t  n1,
+                                    It2          it2,
+                                    std::size_t  n2,
+                                    VisitT      &visit)
+        {
+            intersect_merge_scalar(it1, 0, n1, it2, 0, n2, visit);
+        }
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+
+        /// Blocks of indices compared all-against-all: each block of list2
+        /// is rotated through every lane of the block of list1.
+        struct SimdIndexBlock
+        {
+#if defined(__AVX512F__)
+            static const std::size_t width = 8;
+            typedef __m512i type;
+
+            static type load(IndexType const *p)
+            {
+                return _mm512_loadu_si512(p);
+            }
+
+            static type rotation(std::size_t r)
+            {
+                return _mm512_set_epi64((r + 7) % 8, (r + 6) % 8,
+                                        (r + 5) % 8, (r + 4) % 8,
+                                        (r + 3) % 8, (r + 2) % 8,
+                                        (r + 1) % 8, r);
+            }
+
+            /// Bit k set when a[k] == b[(k + r) % width].
+            static unsigned match(type a, type b, type rot)
+            {
+                return _mm512_cmpeq_epi64_mask(a, _mm512_permutexvar_epi64(rot, b));
+            }
+#else
+            static const std::size_t width = 4;
+            typedef __m256i type;
+
+            static type load(IndexType const *p)
+            {
+                return _mm256_loadu_si256(reinterpret_cast<__m256i const *>(p));
+            }
+
+            // 64-bit lanes are rotated as pairs of 32-bit lanes
+            static type rotation(std::size_t r)
+            {
+                int l0((r % 4)*2), l1(((r + 1) % 4)*2);
+                int l2(((r + 2) % 4)*2), l3(((r + 3) % 4)*2);
+                return _mm256_set_epi32(l3 + 1, l3, l2 + 1, l2,
+                                        l1 + 1, l1, l0 + 1, l0);
+            }
+
+            static unsigned match(type a, type b, type rot)
+            {
+                __m256i cmp(_mm256_cmpeq_epi64(
+                                a, _mm256_permutevar8x32_epi32(b, rot)));
+                return _mm256_movemask_pd(_mm256_castsi256_pd(cmp));
+            }
+#endif
+        };
+
+        template <typename VisitT>
+        inline void intersect_merge(IndexType const *idx1,
+                                    std::size_t      n1,
+                                    IndexType const *idx2,
+                                    std::size_t      n2,
+                                    VisitT          &visit)
+        {
+            static_assert(sizeof(IndexType) == 8,
+                          "SIMD intersection assumes 64-bit indices");
+            std::size_t const width(SimdIndexBlock::width);
+
+            SimdIndexBlock::type rot[SimdIndexBlock::width];
+            for (std::size_t r = 0; r < width; ++r)
+            {
+                rot[r] = SimdIndexBlock::rotation(r);
+            }
+
+            std::size_t k1(0), k2(0);
+            while ((k1 + width <= n1) && (k2 + width <= n2))
+            {
+                SimdIndexBlock::type a(SimdIndexBlock::load(idx1 + k1));
+                SimdIndexBlock::type b(SimdIndexBlock::load(idx2 + k2));
+
+                // Indices are distinct, so each lane of a matches at most
+                // one lane of b.
+                std::size_t other[SimdIndexBlock::width];
+                unsigned any(0);
+                for (std::size_t r = 0; r < width; ++r)
+                {
+                    unsigned bits(SimdIndexBlock::match(a, b, rot[r]));
+                    any |= bits;
+                    for (std::size_t lane = 0; bits != 0; ++lane, bits >>= 1)
+                    {
+                        if (bits & 1U)
+                        {
+                            other[lane] = (lane + r) % width;
+                        }
+                    }
+                }
+                for (std::size_t lane = 0; any != 0; ++lane, any >>= 1)
+                {
+                    if ((any & 1U) && !visit(k1 + lane, k2 + other[lane]))
+                    {
+                        return;
+                    }
+                }
+
+                // Retire the block(s) ending with the smaller index
+                IndexType last1(idx1[k1 + width - 1]);
+                IndexType last2(idx2[k2 + width - 1]);
+                k1 += ((last1 <= last2) ? width : 0);
+                k2 += ((last2 <= last1) ? width : 0);
+            }
+
+            intersect_merge_scalar(idx1, k1, n1, idx2, k2, n2, visit);
+        }
+
+#endif
+
+        //**********************************************************************
+        /**
+         * @brief Call visit(k1, k2) for each position pair of equal indices
+         *        of two sorted lists of distinct indices, stopping early
+         *        when visit returns false.
+         *
+         * @param it1, it2  Random access to the lists (index arrays or rows
+         *                  of (index, value) tuples).
+         */
+        template <typename It1, typename It2, typename VisitT>
+        inline void intersect_sorted(It1          it1,
+                                     std::size_t  n1,
+                                     It2          it2,
+                                     std::size_t  n2,
+                                     VisitT       visit)
+        {
+            if ((n1 == 0) || (n2 == 0))
+            {
+                return;
+            }
+
+            if (n2 / n1 >= GB_GALLOP_RATIO)
+            {
+                intersect_gallop(it1, n1, it2, n2, visit, false);
+            }
+            else if (n1 / n2 >= GB_GALLOP_RATIO)
+            {
+                intersect_gallop(it2, n2, it1, n1, visit, true);
+            }
+            else
+            {
+                intersect_merge(it1, n1, it2, n2, visit);
+            }
+        }
+
+    } // namespace backend
+
+} // namespace GraphBLAS
+
+#endif // GB_SEQUENTIAL_INTERSECTION_HPP
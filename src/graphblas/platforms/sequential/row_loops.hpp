@@ -0,0 +1,252 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+/**
+ * Row loop drivers shared by the sparse kernels.
+ *
+ * Kernels describe the work for one output row (or one output entry) as a
+ * function object and hand it to compute_rows(), compute_rows_mapped() or
+ * compute_entries().  In the default build these are plain loops.  When
+ * GB_USE_OPENMP is defined (the openmp platform) the rows are computed by
+ * an OpenMP team:
+ *
+ *  - each thread works on its own copy of the function object, so any
+ *    scratch state captured by value (e.g., a sparse accumulator) is
+ *    private to the thread;
+ *  - results go to per-row buffers, which are committed to the output
+ *    matrix serially after each block of rows, so no locking is needed on
+ *    the shared output.
+ *
+ * Inputs read inside the row functions must be safe for concurrent const
+ * access; call assemble() on matrices with lazily maintained state (pending
+ * CSR rows, a column index) before the loop.
+ */
+
+#ifndef GB_SEQUENTIAL_ROW_LOOPS_HPP
+#define GB_SEQUENTIAL_ROW_LOOPS_HPP
+
+#pragma once
+
+#include <vector>
+#include <tuple>
+#include <algorithm>
+#include <utility>
+
+#if defined(GB_USE_OPENMP)
+#include <omp.h>
+#endif
+
+#include <graphblas/types.hpp>
+
+/// Number of output rows buffered per parallel block.
+#ifndef GB_OPENMP_ROWS_PER_BLOCK
+#define GB_OPENMP_ROWS_PER_BLOCK 16384
+#endif
+
+//****************************************************************************
+
+namespace GraphBLAS
+{
+    namespace backend
+    {
+        //********************************************************************
+        /**
+         * @brief Compute rows [0, num_rows) of T with row_fn(row_idx, row)
+         *        and store each of them (empty rows included) with setRow.
+         *
+         * @param row_fn  Called with a cleared row buffer to fill in
+         *                increasing column order.
+         */
+        template<typename MatrixT, typename RowFnT>
+        inline void compute_rows(MatrixT   &T,
+                                 IndexType  num_rows,
+                                 RowFnT     row_fn)
+        {
+            typedef std::vector<std::tuple<IndexType,
+                                           typename MatrixT::ScalarType> >
+                RowType;
+
+#if defined(GB_USE_OPENMP)
+            IndexType const block_size(
+                std::min<IndexType>(num_rows, GB_OPENMP_ROWS_PER_BLOCK));
+            std::vector<RowType> rows(block_size);
+
+            for (IndexType block_start = 0; block_start < num_rows;
+                 block_start += block_size)
+            {
+                IndexType block_end(
+                    std::min<IndexType>(num_rows, block_start + block_size));
+
+                #pragma omp parallel
+                {
+                    RowFnT local_fn(row_fn);
+
+                    #pragma omp for schedule(dynamic, 64)
+                    for (IndexType row_idx = block_start; row_idx < block_end;
+                         ++row_idx)
+                    {
+                        RowType &row(rows[row_idx - block_start]);
+                        row.clear();
+                        local_fn(row_idx, row);
+                    }
+                }
+
+                for (IndexType row_idx = block_start; row_idx < block_end;
+                     ++row_idx)
+                {
+                    T.setRow(row_idx, std::move(rows[row_idx - block_start]));
+                }
+            }
+#else
+            RowType row;
+            for (IndexType row_idx = 0; row_idx < num_rows; ++row_idx)
+            {
+                row.clear();
+                row_fn(row_idx, row);
+                T.setRow(row_idx, std::move(row));
+            }
+#endif
+        }
+
+        //********************************************************************
+        /**
+         * @brief Compute row k of the result with row_fn(k, row) for
+         *        k in [0, out_rows.size()) and store the non-empty ones in
+         *        row out_rows[k] of T (other rows of T are left unchanged).
+         */
+        template<typename MatrixT, typename RowFnT>
+        inline void compute_rows_mapped(MatrixT              &T,
+                                        IndexArrayType const &out_rows,
+                                        RowFnT                row_fn)
+        {
+            typedef std::vector<std::tuple<IndexType,
+                                           typename MatrixT::ScalarType> >
+                RowType;
+            IndexType num_rows(out_rows.size());
+
+#if defined(GB_USE_OPENMP)
+            IndexType const block_size(
+                std::min<IndexType>(num_rows, GB_OPENMP_ROWS_PER_BLOCK));
+            std::vector<RowType> rows(block_size);
+
+            for (IndexType block_start = 0; block_start < num_rows;
+                 block_start += block_size)
+            {
+                IndexType block_end(
+                    std::min<IndexType>(num_rows, block_start + block_size));
+
+                #pragma omp parallel
+                {
+                    RowFnT local_fn(row_fn);
+
+                    #pragma omp for schedule(dynamic, 64)
+                    for (IndexType ix = block_start; ix < block_end; ++ix)
+                    {
+                        RowType &row(rows[ix - block_start]);
+                        row.clear();
+                        local_fn(ix, row);
+                    }
+                }
+
+                for (IndexType ix = block_start; ix < block_end; ++ix)
+                {
+                    if (!rows[ix - block_start].empty())
+                    {
+                        T.setRow(out_rows[ix], std::move(rows[ix - block_start]));
+                    }
+                }
+            }
+#else
+            RowType row;
+            for (IndexType ix = 0; ix < num_rows; ++ix)
+            {
+                row.clear();
+                row_fn(ix, row);
+                if (!row.empty())
+                {
+                    T.setRow(out_rows[ix], std::move(row));
+                }
+            }
+#endif
+        }
+
+        //********************************************************************
+        /**
+         * @brief Append (idx, val) to t, in increasing idx order, for every
+         *        idx in [0, num_entries) for which entry_fn(idx, val) returns
+         *        true.
+         */
+        template<typename ScalarT, typename EntryFnT>
+        inline void compute_entries(
+            std::vector<std::tuple<IndexType, ScalarT> > &t,
+            IndexType                                     num_entries,
+            EntryFnT                                      entry_fn)
+        {
+#if defined(GB_USE_OPENMP)
+            // A static schedule hands each thread one contiguous chunk, in
+            // thread order, so concatenating the parts keeps t sorted.
+            std::vector<std::vector<std::tuple<IndexType, ScalarT> > >
+                parts(omp_get_max_threads());
+
+            #pragma omp parallel
+            {
+                EntryFnT local_fn(entry_fn);
+                auto &part(parts[omp_get_thread_num()]);
+
+                #pragma omp for schedule(static)
+                for (IndexType idx = 0; idx < num_entries; ++idx)
+                {
+                    ScalarT val;
+                    if (local_fn(idx, val))
+                    {
+                        part.push_back(std::make_tuple(idx, val));
+                    }
+                }
+            }
+
+            for (auto const &part : parts)
+            {
+                t.insert(t.end(), part.begin(), part.end());
+            }
+#else
+            for (IndexType idx = 0; idx < num_entries; ++idx)
+            {
+                ScalarT val;
+                if (entry_fn(idx, val))
+                {
+                    t.push_back(std::make_tuple(idx, val));
+                }
+            }
+#endif
+        }
+
+    } // backend
+} // GraphBLAS
+
+#endif // GB_SEQUENTIAL_ROW_LOOPS_HPP
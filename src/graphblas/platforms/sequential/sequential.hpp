@@ -42,7 +42,14 @@
 
 #include <graphblas/platforms/sequential/operations.hpp>
 
+#include <graphblas/platforms/sequential/Bitmap.hpp>
 #include <graphblas/platforms/sequential/BitmapSparseVector.hpp>
 #include <graphblas/platforms/sequential/LilSparseMatrix.hpp>
+#include <graphblas/platforms/sequential/CsrSparseMatrix.hpp>
+#include <graphblas/platforms/sequential/DcsrSparseMatrix.hpp>
+#include <graphblas/platforms/sequential/PatternSparseMatrix.hpp>
+#include <graphblas/platforms/sequential/SparseRow.hpp>
+#include <graphblas/platforms/sequential/ColumnIndex.hpp>
+#include <graphblas/platforms/sequential/row_loops.hpp>
 
 #endif // GB_SEQUENTIAL_HPP
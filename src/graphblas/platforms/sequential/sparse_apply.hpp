@@ -41,6 +41,7 @@
 #include <vector>
 #include <iterator>
 #include <iostream>
+#include <type_traits>
 #include <graphblas/types.hpp>
 #include <graphblas/exceptions.hpp>
 #include <graphblas/algebra.hpp>
@@ -54,6 +55,58 @@ namespace GraphBLAS
 {
     namespace backend
     {
+        //**********************************************************************
+        // op(value) for a unary op, op(value, i, j) for an index unary op.
+        template<typename OpT, typename ValueT>
+        inline typename OpT::result_type apply_op(OpT            &op,
+                                                  ValueT   const &val,
+                                                  IndexType,
+                                                  IndexType,
+                                                  std::false_type)
+        {
+            return op(val);
+        }
+
+        template<typename OpT, typename ValueT>
+        inline typename OpT::result_type apply_op(OpT            &op,
+                                                  ValueT   const &val,
+                                                  IndexType       i,
+                                                  IndexType       j,
+                                                  std::true_type)
+        {
+            return op(val, i, j);
+        }
+
+        template<typename OpT, typename ValueT>
+        inline typename OpT::result_type apply_op(OpT            &op,
+                                                  ValueT   const &val,
+                                                  IndexType       i,
+                                                  IndexType       j)
+        {
+            return apply_op(op, val, i, j, is_index_unary_op<OpT>());
+        }
+
+        //**********************************************************************
+        // Bitmap form: unary ops may take the dense runs; index unary ops
+        // need the position of every element.
+        template<typename TScalarT, typename UScalarT, typename OpT>
+        inline void apply_bitmap(BitmapSparseVector<TScalarT>       &t,
+                                 BitmapSparseVector<UScalarT> const &u,
+                                 OpT                                 op,
+                                 std::false_type)
+        {
+            t.apply(u, op);
+        }
+
+        template<typename TScalarT, typename UScalarT, typename OpT>
+        inline void apply_bitmap(BitmapSparseVector<TScalarT>       &t,
+                                 BitmapSparseVector<UScalarT> const &u,
+                                 OpT                                 op,
+                                 std::true_type)
+        {
+            t.apply_index(u, op);
+        }
+
         //**********************************************************************
         // Implementation of 4.3.8.1 Vector variant of Apply
         template<typename WScalarT,
@@ -73,42 +126,112 @@ namespace GraphBLAS
             // =================================================================
             // Apply the unary operator from A into T.
             // This is really the guts of what makes this special.
-            typedef typename UVectorT::ScalarType        UScalarType;
             typedef typename UnaryFunctionT::result_type TScalarType;
-            std::vector<std::tuple<IndexType,TScalarType> > t_contents;
+            typedef typename std::conditional<
+                std::is_same<AccumT, NoAccumulate>::value,
+                TScalarType,
+                typename AccumT::result_type>::type  ZScalarType;
 
-            if (u.nvals() > 0)
+            // A sparse form u: apply op along its list.
+            if (u.isSparseForm())
             {
-                auto u_contents(u.getContents());
-                auto row_iter = u_contents.begin();
-                while (row_iter != u_contents.end())
+                std::vector<std::tuple<IndexType,TScalarType> > t_contents;
+                t_contents.reserve(u.nvals());
+                for (auto const &u_elt : u.getContents())
                 {
-                    GraphBLAS::IndexType u_idx;
-                    UScalarType          u_val;
-                    std::tie(u_idx, u_val) = *row_iter;
-                    TScalarType t_val = static_cast<TScalarType>(op(u_val));
-                    t_contents.push_back(std::make_tuple(u_idx,t_val));
-                    ++row_iter;
+                    t_contents.push_back(std::make_tuple(
+                        std::get<0>(u_elt),
+                        static_cast<TScalarType>(
+                            apply_op(op, std::get<1>(u_elt),
+                                     std::get<0>(u_elt), 0))));
                 }
+                opt_accum_with_opt_mask_1D<ZScalarType>(w, mask, accum,
+                                                        t_contents,
+                                                        replace_flag);
+                return;
+            }
+
+            BitmapSparseVector<TScalarType> t(w.size());
+
+            if (u.nvals() > 0)
+            {
+                apply_bitmap(t, u, op, is_index_unary_op<UnaryFunctionT>());
             }
 
-            GRB_LOG_VERBOSE("t: " << t_contents);
+            GRB_LOG_VERBOSE("t: " << t);
 
             // =================================================================
-            // Accumulate into Z
-            typedef typename std::conditional<
-                std::is_same<AccumT, NoAccumulate>::value,
-                TScalarType,
-                typename AccumT::result_type>::type  ZScalarType;
+            // Accumulate into Z, then copy Z into the output considering mask
+            // and replace
+
+            opt_accum_with_opt_mask_1D<ZScalarType>(w, mask, accum, t,
+                                                    replace_flag);
+        }
+
+        //**********************************************************************
+        // Apply op to every stored value of A (generic row access).
+        template<typename TScalarT,
+                 typename UnaryFunctionT,
+                 typename AMatrixT>
+        inline void apply_rows(LilSparseMatrix<TScalarT>       &T,
+                               UnaryFunctionT                   op,
+                               AMatrixT                  const &A,
+                               std::false_type)
+        {
+            typedef typename AMatrixT::ScalarType                   AScalarType;
+            typedef std::vector<std::tuple<IndexType,AScalarType> > ARowType;
+            typedef std::vector<std::tuple<IndexType,TScalarT> >    TRowType;
+
+            A.assemble();
+            compute_rows(
+                T, A.nrows(),
+                [&A, op](IndexType row_idx, TRowType &t_row) mutable
+                {
+                    ARowType const a_row(A.getRow(row_idx));
+                    for (auto const &elt : a_row)
+                    {
+                        t_row.push_back(std::make_tuple(
+                            std::get<0>(elt),
+                            static_cast<TScalarT>(
+                                apply_op(op, std::get<1>(elt),
+                                         row_idx, std::get<0>(elt)))));
+                    }
+                });
+        }
 
-            std::vector<std::tuple<IndexType,ZScalarType> > z_contents;
-            ewise_or_opt_accum_1D(z_contents, w, t_contents, accum);
+        //**********************************************************************
+        // Apply op to every stored value of A, walking the CSR arrays
+        // directly (the structure of T is exactly the structure of A).
+        template<typename TScalarT,
+                 typename UnaryFunctionT,
+                 typename AMatrixT>
+        inline void apply_rows(LilSparseMatrix<TScalarT>       &T,
+                               UnaryFunctionT                   op,
+                               AMatrixT                  const &A,
+                               std::true_type)
+        {
+            typedef std::vector<std::tuple<IndexType,TScalarT> >    TRowType;
 
-            GRB_LOG_VERBOSE("z: " << z_contents);
+            auto const &row_ptr(A.get_row_ptr());
+            auto const &col_idx(A.get_col_idx());
+            auto const &A_vals(A.get_vals());
 
-            // =================================================================
-            // Copy Z into the final output considering mask and replace
-            write_with_opt_mask_1D(w, z_contents, mask, replace_flag);
+            compute_rows(
+                T, A.nrows(),
+                [&row_ptr, &col_idx, &A_vals, op](IndexType  row_idx,
+                                                  TRowType  &t_row) mutable
+                {
+                    for (IndexType ix = row_ptr[row_idx];
+                         ix < row_ptr[row_idx + 1]; ++ix)
+                    {
+                        t_row.push_back(
+                            std::make_tuple(col_idx[ix],
+                                            static_cast<TScalarT>(
+                                                apply_op(op, A_vals[ix],
+                                                         row_idx,
+                                                         col_idx[ix]))));
+                    }
+                });
         }
 
         //**********************************************************************
@@ -127,15 +250,7 @@ namespace GraphBLAS
             AMatrixT                                  const &A,
             bool                                             replace_flag = false)
         {
-            typedef typename AMatrixT::ScalarType                   AScalarType;
-            typedef std::vector<std::tuple<IndexType,AScalarType> > ARowType;
-
-            typedef CScalarT                                        CScalarType;
-            typedef std::vector<std::tuple<IndexType,CScalarType> > CRowType;
-
             typedef typename UnaryFunctionT::result_type            TScalarType;
-            typedef std::vector<std::tuple<IndexType,TScalarType> > TRowType;
-
 
             IndexType nrows(A.nrows());
             IndexType ncols(A.ncols());
@@ -144,50 +259,170 @@ namespace GraphBLAS
             // Apply the unary operator from A into T.
             // This is really the guts of what makes this special.
             LilSparseMatrix<TScalarType> T(nrows, ncols);
+            apply_rows(T, op, A, is_csr_matrix<AMatrixT>());
 
-            ARowType a_row;
-            TRowType t_row;
+            GRB_LOG_VERBOSE("T: " << T);
+
+            // =================================================================
+            // Accumulate T via C into Z, then copy Z into the output considering mask
+            // and replace
+            typedef typename std::conditional<
+                std::is_same<AccumT, NoAccumulate>::value,
+                TScalarType,
+                typename AccumT::result_type>::type  ZScalarType;
 
-            IndexType a_idx;
-            AScalarType a_val;
+            opt_accum_with_opt_mask<ZScalarType>(C, mask, accum, T,
+                                                 replace_flag);
+        }
 
-            for (IndexType row_idx = 0; row_idx < A.nrows(); ++row_idx)
+        //**********************************************************************
+        // Select on the vector variant: keep u(i) where op(u(i), i, 0)
+        template<typename WScalarT,
+                 typename MaskT,
+                 typename AccumT,
+                 typename IndexUnaryOpT,
+                 typename UVectorT,
+                 typename ...WTagsT>
+        inline void select(
+            GraphBLAS::backend::Vector<WScalarT, WTagsT...> &w,
+            MaskT                                     const &mask,
+            AccumT                                           accum,
+            IndexUnaryOpT                                    op,
+            UVectorT                                  const &u,
+            bool                                             replace_flag = false)
+        {
+            typedef typename UVectorT::ScalarType TScalarType;
+            typedef typename std::conditional<
+                std::is_same<AccumT, NoAccumulate>::value,
+                TScalarType,
+                typename AccumT::result_type>::type  ZScalarType;
+
+            if (u.isSparseForm())
             {
-                a_row = A.getRow(row_idx);
-                if (!a_row.empty())
+                std::vector<std::tuple<IndexType,TScalarType> > t_contents;
+                for (auto const &u_elt : u.getContents())
                 {
-                    t_row.clear();
-                    auto row_iter = a_row.begin();
-                    while (row_iter != a_row.end())
+                    if (op(std::get<1>(u_elt), std::get<0>(u_elt), 0))
                     {
-                        std::tie(a_idx, a_val) = *row_iter;
-                        TScalarType t_val = static_cast<TScalarType>(op(a_val));
-                        t_row.push_back(std::make_tuple(a_idx,t_val));
-                        ++row_iter;
+                        t_contents.push_back(u_elt);
                     }
-
-                    if (!t_row.empty())
-                        T.setRow(row_idx, t_row);
                 }
+                opt_accum_with_opt_mask_1D<ZScalarType>(w, mask, accum,
+                                                        t_contents,
+                                                        replace_flag);
+                return;
+            }
+
+            BitmapSparseVector<TScalarType> t(w.size());
+
+            if (u.nvals() > 0)
+            {
+                t.select(u, op);
             }
 
+            GRB_LOG_VERBOSE("t: " << t);
+
+            opt_accum_with_opt_mask_1D<ZScalarType>(w, mask, accum, t,
+                                                    replace_flag);
+        }
+
+        //**********************************************************************
+        // Keep A(i,j) where op(A(i,j), i, j) (generic row access).
+        template<typename TScalarT,
+                 typename IndexUnaryOpT,
+                 typename AMatrixT>
+        inline void select_rows(LilSparseMatrix<TScalarT>       &T,
+                                IndexUnaryOpT                    op,
+                                AMatrixT                  const &A,
+                                std::false_type)
+        {
+            typedef typename AMatrixT::ScalarType                   AScalarType;
+            typedef std::vector<std::tuple<IndexType,AScalarType> > ARowType;
+            typedef std::vector<std::tuple<IndexType,TScalarT> >    TRowType;
+
+            A.assemble();
+            compute_rows(
+                T, A.nrows(),
+                [&A, op](IndexType row_idx, TRowType &t_row) mutable
+                {
+                    ARowType const a_row(A.getRow(row_idx));
+                    for (auto const &elt : a_row)
+                    {
+                        if (op(std::get<1>(elt), row_idx, std::get<0>(elt)))
+                        {
+                            t_row.push_back(std::make_tuple(
+                                std::get<0>(elt),
+                                static_cast<TScalarT>(std::get<1>(elt))));
+                        }
+                    }
+                });
+        }
+
+        //**********************************************************************
+        // Keep A(i,j) where op(A(i,j), i, j), walking the CSR arrays.
+        template<typename TScalarT,
+                 typename IndexUnaryOpT,
+                 typename AMatrixT>
+        inline void select_rows(LilSparseMatrix<TScalarT>       &T,
+                                IndexUnaryOpT                    op,
+                                AMatrixT                  const &A,
+                                std::true_type)
+        {
+            typedef std::vector<std::tuple<IndexType,TScalarT> >    TRowType;
+
+            auto const &row_ptr(A.get_row_ptr());
+            auto const &col_idx(A.get_col_idx());
+            auto const &A_vals(A.get_vals());
+
+            compute_rows(
+                T, A.nrows(),
+                [&row_ptr, &col_idx, &A_vals, op](IndexType  row_idx,
+                                                  TRowType  &t_row) mutable
+                {
+                    for (IndexType ix = row_ptr[row_idx];
+                         ix < row_ptr[row_idx + 1]; ++ix)
+                    {
+                        if (op(A_vals[ix], row_idx, col_idx[ix]))
+                        {
+                            t_row.push_back(
+                                std::make_tuple(col_idx[ix],
+                                                static_cast<TScalarT>(
+                                                    A_vals[ix])));
+                        }
+                    }
+                });
+        }
+
+        //**********************************************************************
+        // Select on the matrix variant: keep A(i,j) where op(A(i,j), i, j)
+        template<typename CScalarT,
+                 typename MaskT,
+                 typename AccumT,
+                 typename IndexUnaryOpT,
+                 typename AMatrixT,
+                 typename ...CTagsT>
+        inline void select(
+            GraphBLAS::backend::Matrix<CScalarT, CTagsT...> &C,
+            MaskT                                     const &mask,
+            AccumT                                           accum,
+            IndexUnaryOpT                                    op,
+            AMatrixT                                  const &A,
+            bool                                             replace_flag = false)
+        {
+            typedef typename AMatrixT::ScalarType                   TScalarType;
+
+            LilSparseMatrix<TScalarType> T(A.nrows(), A.ncols());
+            select_rows(T, op, A, is_csr_matrix<AMatrixT>());
+
             GRB_LOG_VERBOSE("T: " << T);
 
-            // =================================================================
-            // Accumulate T via C into Z
             typedef typename std::conditional<
                 std::is_same<AccumT, NoAccumulate>::value,
                 TScalarType,
                 typename AccumT::result_type>::type  ZScalarType;
 
-            LilSparseMatrix<ZScalarType> Z(nrows, ncols);
-            ewise_or_opt_accum(Z, C, T, accum);
-
-            GRB_LOG_VERBOSE("Z: " << Z);
-
-            // =================================================================
-            // Copy Z into the final output considering mask and replace
-            write_with_opt_mask(C, Z, mask, replace_flag);
+            opt_accum_with_opt_mask<ZScalarType>(C, mask, accum, T,
+                                                 replace_flag);
         }
     }
 }
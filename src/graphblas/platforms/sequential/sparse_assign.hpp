@@ -44,6 +44,7 @@
 
 #include "sparse_helpers.hpp"
 #include "LilSparseMatrix.hpp"
+#include "CsrSparseMatrix.hpp"
 
 //******************************************************************************
 
@@ -179,23 +180,61 @@ namespace GraphBLAS
             compute_outin_mapping(col_Indices, oi_pairs);
 
             // Walk the rows
+            IndexArrayType out_rows;
             for (IndexType in_row_index = 0;
                  in_row_index < row_Indices.size();
                  ++in_row_index)
             {
-                IndexType out_row_index = row_Indices[in_row_index];
-                ARowType row(A.getRow(in_row_index));
-                auto row_it = row.begin();
+                out_rows.push_back(row_Indices[in_row_index]);
+            }
 
-                TRowType out_row;
+            compute_rows_mapped(
+                T, out_rows,
+                [&A, &oi_pairs](IndexType in_row_index, TRowType &out_row)
+                {
+                    ARowType row(A.getRow(in_row_index));
+                    vectorExpand(out_row, row, oi_pairs);
+                });
+        }
+
+        //********************************************************************
+        template<typename TScalarT,
+                 typename AScalarT,
+                 typename RowSequenceT,
+                 typename ColSequenceT>
+        void matrixExpand(LilSparseMatrix<TScalarT>          &T,
+                          CsrSparseMatrix<AScalarT>  const   &A,
+                          RowSequenceT               const   &row_Indices,
+                          ColSequenceT               const   &col_Indices)
+        {
+            // NOTE!! - Backend code. We expect that all dimension
+            // checks done elsewhere.
 
-                // Extract the values from the row
-                //std::cerr << "Expanding row " << in_row_index << " to " << out_row_index << std::endl;
-                vectorExpand(out_row, row, oi_pairs);
+            typedef std::vector<std::tuple<IndexType,AScalarT> > ARowType;
+            typedef std::vector<std::tuple<IndexType,TScalarT> > TRowType;
 
-                if (!out_row.empty())
-                    T.setRow(out_row_index, out_row);
+            T.clear();
+
+            // Build the mapping pairs once up front
+            std::vector<std::pair<IndexType, IndexType>> oi_pairs;
+            compute_outin_mapping(col_Indices, oi_pairs);
+
+            // Walk the rows
+            IndexArrayType out_rows;
+            for (IndexType in_row_index = 0;
+                 in_row_index < row_Indices.size();
+                 ++in_row_index)
+            {
+                out_rows.push_back(row_Indices[in_row_index]);
             }
+
+            compute_rows_mapped(
+                T, out_rows,
+                [&A, &oi_pairs](IndexType in_row_index, TRowType &out_row)
+                {
+                    ARowType row(A.getRow(in_row_index));
+                    vectorExpand(out_row, row, oi_pairs);
+                });
         }
 
         //********************************************************************
@@ -215,29 +254,28 @@ namespace GraphBLAS
             typedef std::vector<std::tuple<IndexType,TScalarT> > TRowType;
 
             T.clear();
+            A.assemble();
 
             // Build the mapping pairs once up front
             std::vector<std::pair<IndexType, IndexType>> oi_pairs;
             compute_outin_mapping(col_Indices, oi_pairs);
 
             // Walk the rows
+            IndexArrayType out_rows;
             for (IndexType in_row_index = 0;
                  in_row_index < row_Indices.size();
                  ++in_row_index)
             {
-                IndexType out_row_index = row_Indices[in_row_index];
-                auto row(A.getRow(in_row_index));
-                auto row_it = row.begin();
-
-                TRowType out_row;
-
-                // Extract the values from the row
-                //std::cerr << "Expanding row " << in_row_index << " to " << out_row_index << std::endl;
-                vectorExpand(out_row, row, oi_pairs);
-
-                if (!out_row.empty())
-                    T.setRow(out_row_index, out_row);
+                out_rows.push_back(row_Indices[in_row_index]);
             }
+
+            compute_rows_mapped(
+                T, out_rows,
+                [&A, &oi_pairs](IndexType in_row_index, TRowType &out_row)
+                {
+                    auto row(A.getRow(in_row_index));
+                    vectorExpand(out_row, row, oi_pairs);
+                });
         }
 
         //********************************************************************
@@ -77,24 +77,32 @@ namespace GraphBLAS
             // =================================================================
             // Do the basic ewise-and work: t = u .* v
             typedef typename BinaryOpT::result_type D3ScalarType;
-            std::vector<std::tuple<IndexType,D3ScalarType> > t_contents;
 
-            if ((u.nvals() > 0) && (v.nvals() > 0))
+            // Either operand in the sparse form: merge the lists.
+            if (u.isSparseForm() || v.isSparseForm())
             {
-                auto u_contents(u.getContents());
-                auto v_contents(v.getContents());
-
-                ewise_and(t_contents, u_contents, v_contents, op);
+                std::vector<std::tuple<IndexType,D3ScalarType> > t_contents;
+                if ((u.nvals() > 0) && (v.nvals() > 0))
+                {
+                    ewise_and(t_contents, u.getContents(), v.getContents(), op);
+                }
+                opt_accum_with_opt_mask_1D<WScalarT>(w, mask, accum,
+                                                     t_contents, replace_flag);
+                return;
             }
 
-            // =================================================================
-            // Accumulate into Z
-            std::vector<std::tuple<IndexType,WScalarT> > z_contents;
-            ewise_or_opt_accum_1D(z_contents, w, t_contents, accum);
+            BitmapSparseVector<D3ScalarType> t(w.size());
+
+            if ((u.nvals() > 0) && (v.nvals() > 0))
+            {
+                t.ewise_and(u, v, op);
+            }
 
             // =================================================================
-            // Copy Z into the final output considering mask and replace
-            write_with_opt_mask_1D(w, z_contents, mask, replace_flag);
+            // Accumulate into Z, then copy Z into the output considering mask
+            // and replace
+            opt_accum_with_opt_mask_1D<WScalarT>(w, mask, accum, t,
+                                                 replace_flag);
         }
 
         //**********************************************************************
@@ -121,8 +129,6 @@ namespace GraphBLAS
             typedef typename AMatrixT::ScalarType AScalarType;
             typedef typename BMatrixT::ScalarType BScalarType;
 
-            typedef std::vector<std::tuple<IndexType,AScalarType> > ARowType;
-            typedef std::vector<std::tuple<IndexType,BScalarType> > BRowType;
             typedef std::vector<std::tuple<IndexType,CScalarT> > CRowType;
 
             // =================================================================
@@ -134,43 +140,37 @@ namespace GraphBLAS
             if ((A.nvals() > 0) && (B.nvals() > 0))
             {
                 // create a row of result at a time
-                TRowType T_row;
-                for (IndexType row_idx = 0; row_idx < num_rows; ++row_idx)
-                {
-                    BRowType B_row(B.getRow(row_idx));
-
-                    if (!B_row.empty())
+                A.assemble();
+                B.assemble();
+                SparseRow<AScalarType> A_row;
+                SparseRow<BScalarType> B_row;
+                compute_rows(
+                    T, num_rows,
+                    [&A, &B, op, A_row, B_row](IndexType  row_idx,
+                                               TRowType  &T_row) mutable
                     {
-                        ARowType A_row(A.getRow(row_idx));
-                        if (!A_row.empty())
-                        {
-                            ewise_and(T_row, A_row, B_row, op);
+                        B.getRow(row_idx, B_row);
 
-                            if (!T_row.empty())
+                        if (!B_row.empty())
+                        {
+                            A.getRow(row_idx, A_row);
+                            if (!A_row.empty())
                             {
-                                T.setRow(row_idx, T_row);
-                                T_row.clear();
+                                ewise_and(T_row, A_row, B_row, op);
                             }
                         }
-                    }
-                }
+                    });
             }
 
 //            GRB_LOG_E(">>> T <<<");
 //            GRB_LOG_E(T);
 
             // =================================================================
-            // Accumulate into Z
-
-            LilSparseMatrix<CScalarT> Z(num_rows, num_cols);
-            ewise_or_opt_accum(Z, C, T, accum);
+            // Accumulate into Z, then copy Z into the output considering mask
+            // and replace
 
-//            GRB_LOG_E(">>> Z <<< ");
-//            GRB_LOG_E(Z);
-
-            // =================================================================
-            // Copy Z into the final output considering mask and replace
-            write_with_opt_mask(C, Z, Mask, replace_flag);
+            opt_accum_with_opt_mask<CScalarT>(C, Mask, accum, T,
+                                              replace_flag);
 
 //            GRB_LOG_E(">>> C <<< ");
 //            GRB_LOG_E(C);
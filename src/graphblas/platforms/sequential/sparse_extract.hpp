@@ -39,6 +39,7 @@
 #include <utility>
 #include <vector>
 #include <iterator>
+#include <algorithm>
 #include <type_traits>
 #include <iostream>
 
@@ -50,6 +51,7 @@
 
 #include "sparse_helpers.hpp"
 #include "LilSparseMatrix.hpp"
+#include "CsrSparseMatrix.hpp"
 
 //******************************************************************************
 
@@ -137,25 +139,59 @@ namespace GraphBLAS
 
             C.clear();
 
-            // Walk the rows
-            IndexType out_row_index = 0;
-
-            for (auto row_it = row_begin;
-                 row_it != row_end;
-                 ++row_it, ++out_row_index)
+            // Gather the rows to walk (the indices may repeat)
+            IndexArrayType in_rows;
+            for (auto row_it = row_begin; row_it != row_end; ++row_it)
             {
-                auto row(A.getRow(*row_it));
+                in_rows.push_back(*row_it);
+            }
 
-                IndexType tmp_idx;
-                AScalarT tmp_value;
-                CRowType out_row;
+            compute_rows(
+                C, in_rows.size(),
+                [&A, &in_rows, col_begin, col_end](IndexType  out_row_index,
+                                                   CRowType  &out_row)
+                {
+                    auto row(A.getRow(in_rows[out_row_index]));
+
+                    // Extract the values from the row
+                    vectorExtract(out_row, row, col_begin, col_end);
+                });
+        }
+
+        // *******************************************************************
+        template<typename CScalarT,
+                 typename AScalarT,
+                 typename RowIteratorT,
+                 typename ColIteratorT>
+        void matrixExtract(LilSparseMatrix<CScalarT>          &C,
+                           CsrSparseMatrix<AScalarT>  const   &A,
+                           RowIteratorT                        row_begin,
+                           RowIteratorT                        row_end,
+                           ColIteratorT                        col_begin,
+                           ColIteratorT                        col_end)
+        {
+            typedef std::vector<std::tuple<IndexType,AScalarT> > ARowType;
+            typedef std::vector<std::tuple<IndexType,CScalarT> > CRowType;
 
-                // Extract the values from the row
-                vectorExtract(out_row, row, col_begin, col_end);
+            C.clear();
 
-                if (!out_row.empty())
-                    C.setRow(out_row_index, out_row);
+            // Gather the rows to walk (the indices may repeat)
+            IndexArrayType in_rows;
+            for (auto row_it = row_begin; row_it != row_end; ++row_it)
+            {
+                in_rows.push_back(*row_it);
             }
+
+            compute_rows(
+                C, in_rows.size(),
+                [&A, &in_rows, col_begin, col_end](IndexType  out_row_index,
+                                                   CRowType  &out_row)
+                {
+                    ARowType row(A.getRow(in_rows[out_row_index]));
+
+                    // Extract the values from the row
+                    vectorExtract(out_row, row, col_begin, col_end);
+                });
         }
 
         // *******************************************************************
@@ -175,26 +211,25 @@ namespace GraphBLAS
             typedef std::vector<std::tuple<IndexType,CScalarT> > CRowType;
 
             C.clear();
+            A.assemble();
 
-            // Walk the rows
-            IndexType out_row_index = 0;
-
-            for (auto row_it = row_begin;
-                 row_it != row_end;
-                 ++row_it, ++out_row_index)
+            // Gather the rows to walk (the indices may repeat)
+            IndexArrayType in_rows;
+            for (auto row_it = row_begin; row_it != row_end; ++row_it)
             {
-                auto row(A.getRow(*row_it));
-
-                IndexType tmp_idx;
-                AScalarT tmp_value;
-                CRowType out_row;
+                in_rows.push_back(*row_it);
+            }
 
-                // Extract the values from the row
-                vectorExtract(out_row, row, col_begin, col_end);
+            compute_rows(
+                C, in_rows.size(),
+                [&A, &in_rows, col_begin, col_end](IndexType  out_row_index,
+                                                   CRowType  &out_row)
+                {
+                    auto row(A.getRow(in_rows[out_row_index]));
 
-                if (!out_row.empty())
-                    C.setRow(out_row_index, out_row);
-            }
+                    // Extract the values from the row
+                    vectorExtract(out_row, row, col_begin, col_end);
+                });
         }
 
         /**
@@ -270,6 +305,38 @@ namespace GraphBLAS
             }
         };
 
+        //********************************************************************
+        // Column lookups in CSR are a binary search of each requested row.
+        template <typename WScalarT, typename AScalarT, typename IteratorT>
+        void extractColumn(
+            std::vector< std::tuple<IndexType, WScalarT> >         &vec_dest,
+            CsrSparseMatrix<AScalarT>                       const  &A,
+            IteratorT                                               row_begin,
+            IteratorT                                               row_end,
+            IndexType                                               col_index)
+        {
+            auto const &row_ptr(A.get_row_ptr());
+            auto const &col_idx(A.get_col_idx());
+            auto const &A_vals(A.get_vals());
+
+            vec_dest.clear();
+
+            IndexType out_row_index = 0;
+            for (IteratorT it = row_begin; it != row_end; ++it, ++out_row_index)
+            {
+                auto row_first = col_idx.begin() + row_ptr[*it];
+                auto row_last  = col_idx.begin() + row_ptr[*it + 1];
+                auto col_it = std::lower_bound(row_first, row_last, col_index);
+                if ((col_it != row_last) && (*col_it == col_index))
+                {
+                    vec_dest.push_back(
+                        std::make_tuple(out_row_index,
+                                        static_cast<WScalarT>(
+                                            A_vals[col_it - col_idx.begin()])));
+                }
+            }
+        };
+
         //********************************************************************
         // Extract a row of a matrix using TransposeView
         template <typename WScalarT, typename AMatrixT, typename IteratorT>
@@ -354,20 +421,15 @@ namespace GraphBLAS
             GRB_LOG_VERBOSE("t: " << t);
 
             // =================================================================
-            // Accumulate into Z
+            // Accumulate into Z, then copy Z into the output considering mask
+            // and replace
             typedef typename std::conditional<
                 std::is_same<AccumT, NoAccumulate>::value,
                 UScalarType,
                 typename AccumT::result_type>::type  ZScalarType;
 
-            std::vector<std::tuple<IndexType, ZScalarType> > z;
-            ewise_or_opt_accum_1D(z, w, t, accum);
-
-            GRB_LOG_VERBOSE("z: " << z);
-
-            // =================================================================
-            // Copy Z into the final output considering mask and replace
-            write_with_opt_mask_1D(w, z, mask, replace_flag);
+            opt_accum_with_opt_mask_1D<ZScalarType>(w, mask, accum, t,
+                                                    replace_flag);
 
             GRB_LOG_VERBOSE("w (Result): " << w);
         };
@@ -411,20 +473,15 @@ namespace GraphBLAS
             GRB_LOG_VERBOSE("T: " << T);
 
             // =================================================================
-            // Accumulate into Z
+            // Accumulate into Z, then copy Z into the output considering mask
+            // and replace
             typedef typename std::conditional<
                 std::is_same<AccumT, NoAccumulate>::value,
                 AScalarType,
                 typename AccumT::result_type>::type  ZScalarType;
 
-            LilSparseMatrix<ZScalarType> Z(C.nrows(), C.ncols());
-            ewise_or_opt_accum(Z, C, T, accum);
-
-            GRB_LOG_VERBOSE("Z: " << Z);
-
-            // =================================================================
-            // Copy Z into the final output considering mask and replace
-            write_with_opt_mask(C, Z, Mask, replace_flag);
+            opt_accum_with_opt_mask<ZScalarType>(C, Mask, accum, T,
+                                                 replace_flag);
 
             GRB_LOG_VERBOSE("C (Result): " << C);
         };
@@ -468,20 +525,15 @@ namespace GraphBLAS
             GRB_LOG_VERBOSE("t: " << t);
 
             // =================================================================
-            // Accumulate into Z
+            // Accumulate into Z, then copy Z into the output considering mask
+            // and replace
             typedef typename std::conditional<
                 std::is_same<AccumT, NoAccumulate>::value,
                 AScalarType,
                 typename AccumT::result_type>::type  ZScalarType;
 
-            std::vector<std::tuple<IndexType, ZScalarType> > z;
-            ewise_or_opt_accum_1D(z, w, t, accum);
-
-            GRB_LOG_VERBOSE("z: " << z);
-
-            // =================================================================
-            // Copy Z into the final output considering mask and replace
-            write_with_opt_mask_1D(w, z, mask, replace_flag);
+            opt_accum_with_opt_mask_1D<ZScalarType>(w, mask, accum, t,
+                                                    replace_flag);
 
             GRB_LOG_VERBOSE("w (Result): " << w);
         }
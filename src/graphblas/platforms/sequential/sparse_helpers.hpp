@@ -43,9 +43,19 @@
 #include <iterator>
 #include <iostream>
 #include <string>
+#include <algorithm>
+#include <graphblas/detail/logging.h>
 #include <graphblas/algebra.hpp>
 #include <graphblas/indices.hpp>
 
+#include "Bitmap.hpp"
+#include "SparseRow.hpp"
+#include "intersection.hpp"
+#include "BitmapSparseVector.hpp"
+#include "ComplementView.hpp"
+#include "TransposeView.hpp"
+#include "row_loops.hpp"
+
 //****************************************************************************
 
 namespace GraphBLAS
@@ -83,30 +93,25 @@ namespace GraphBLAS
             typedef typename SrcMatrixT::ScalarType SrcScalarType;
             typedef typename DstMatrixT::ScalarType DstScalarType;
 
-            typedef std::vector<std::tuple<IndexType, SrcScalarType> > SrcRowType;
             typedef std::vector<std::tuple<IndexType, DstScalarType> > DstRowType;
 
             // Copying removes the contents of the other matrix so clear it first.
             dstMatrix.clear();
 
-            IndexType nrows(dstMatrix.nrows());
-            for (IndexType row_idx = 0; row_idx < nrows; ++row_idx)
-            {
-                SrcRowType srcRow = srcMatrix.getRow(row_idx);
-                DstRowType dstRow;
-
-                // We need to construct a new row with the appropriate cast!
-                for (auto it = srcRow.begin(); it != srcRow.end(); ++it)
+            compute_rows(
+                dstMatrix, dstMatrix.nrows(),
+                [&srcMatrix](IndexType row_idx, DstRowType &dstRow)
                 {
-                    IndexType idx;
-                    SrcScalarType srcVal;
-                    std::tie(idx, srcVal) = *it;
-                    dstRow.push_back(std::make_tuple(idx, static_cast<DstScalarType>(srcVal)));
-                }
-
-                if (!dstRow.empty())
-                    dstMatrix.setRow(row_idx, dstRow);
-            }
+                    // We need to construct a new row with the appropriate cast!
+                    auto const &srcRow(srcMatrix.getRow(row_idx));
+                    for (auto it = srcRow.begin(); it != srcRow.end(); ++it)
+                    {
+                        dstRow.push_back(
+                            std::make_tuple(std::get<0>(*it),
+                                            static_cast<DstScalarType>(
+                                                std::get<1>(*it))));
+                    }
+                });
         }
 
         // @todo: Make a sparse copy where they are the same type for efficiency
@@ -211,14 +216,95 @@ namespace GraphBLAS
             }
         }
 
+        //**********************************************************************
+        /**
+         * @brief Early exit for reductions and dot products.
+         *
+         * reached(val) is true when val is the terminal value of a monoid
+         * (or of a semiring's addition), so that adding further terms
+         * cannot change it (e.g., logical or at true).  For the Any monoid
+         * every value is final, so it is constant true; only test it after
+         * a value has been added.  For operators without a terminal value
+         * it is constant false.
+         */
+        template<typename OpT,
+                 bool = has_terminal_value<OpT>::value,
+                 bool = is_any_monoid<OpT>::value>
+        class TerminalTest
+        {
+        public:
+            TerminalTest(OpT const &) {}
+
+            template<typename ValueT>
+            bool reached(ValueT const &) const { return false; }
+        };
+
+        template<typename OpT>
+        class TerminalTest<OpT, true, false>
+        {
+        public:
+            TerminalTest(OpT const &op) : m_terminal(op.terminal()) {}
+
+            template<typename ValueT>
+            bool reached(ValueT const &val) const
+            {
+                return (val == m_terminal);
+            }
+
+        private:
+            typename OpT::result_type m_terminal;
+        };
+
+        template<typename OpT>
+        class TerminalTest<OpT, false, true>
+        {
+        public:
+            TerminalTest(OpT const &) {}
+
+            template<typename ValueT>
+            bool reached(ValueT const &) const { return true; }
+        };
+
+        //**********************************************************************
+        /**
+         * @brief op.mult(a, b) with the operands passed by reference.
+         *
+         * When the semiring multiplies with Pair the product is 1 and
+         * neither operand is loaded, so structure-only products do not read
+         * the value arrays of their inputs.
+         */
+        template<typename SemiringT, typename AValT, typename BValT>
+        inline typename SemiringT::result_type
+        semiring_mult(SemiringT const &op, AValT const &a, BValT const &b,
+                      std::false_type)
+        {
+            return op.mult(a, b);
+        }
+
+        template<typename SemiringT, typename AValT, typename BValT>
+        inline typename SemiringT::result_type
+        semiring_mult(SemiringT const &, AValT const &, BValT const &,
+                      std::true_type)
+        {
+            return static_cast<typename SemiringT::result_type>(1);
+        }
+
+        template<typename SemiringT, typename AValT, typename BValT>
+        inline typename SemiringT::result_type
+        semiring_mult(SemiringT const &op, AValT const &a, BValT const &b)
+        {
+            return semiring_mult(op, a, b, is_pair_op<SemiringT>());
+        }
+
         //**********************************************************************
 
         /// Perform the dot product of a row of a matrix with a sparse vector without
-        /// pulling the indices out of the vector first.
+        /// pulling the indices out of the vector first: each index of the row
+        /// probes u's bitmap, O(row length).
         template <typename D1, typename D2, typename D3, typename SemiringT>
         bool dot2(D3                                                      &ans,
                   std::vector<std::tuple<GraphBLAS::IndexType,D1> > const &A_row,
-                  std::vector<bool>                                 const &u_bitmap,
+                  Bitmap                                            const &u_bitmap,
                   std::vector<D2>                                   const &u_vals,
                   GraphBLAS::IndexType                                     u_nvals,
                   SemiringT                                                op)
@@ -226,49 +312,63 @@ namespace GraphBLAS
             bool value_set(false);
             ans = op.zero();
 
-            if ((u_nvals == 0) || A_row.empty())
+            if (u_nvals == 0)
             {
                 return value_set;
             }
 
-            // find first stored value in u
-            GraphBLAS::IndexType u_idx(0);
-            while (!u_bitmap[u_idx]) ++u_idx; // skip unstored elements
-
-            // pull first value out of the row
-            auto A_iter = A_row.begin();
-            D1 a_val;
-            GraphBLAS::IndexType a_idx;
-
-            // loop through both ordered sets to compute sparse dot prod
-            while ((A_iter != A_row.end()) && (u_idx < u_vals.size()))
+            TerminalTest<SemiringT> terminal(op);
+            for (auto const &a_elt : A_row)
             {
-                std::tie(a_idx, a_val) = *A_iter;
-                //std::cerr << "Examine u index = " << u_idx << "," << u_vals[u_idx]
-                //          << ", A col_idx = " << a_idx << "," << a_val << std::endl;
-
-                if (u_idx == a_idx)
+                IndexType a_idx(std::get<0>(a_elt));
+                if (u_bitmap[a_idx])
                 {
-                    //std::cerr << ans << " + "  << a_val << " * "  << u_vals[u_idx]
-                    //          << " = " << op.mult(a_val, u_vals[u_idx]) << std::endl;
-
-                    ans = op.add(ans, op.mult(a_val, u_vals[u_idx]));
+                    ans = op.add(ans, semiring_mult(op, std::get<1>(a_elt),
+                                                    u_vals[a_idx]));
                     value_set = true;
+                    if (terminal.reached(ans))
+                    {
+                        break;
+                    }
+                }
+            }
 
-                    //std::cerr << "Equal, mutliply_accum, ans = " << ans << std::endl;
+            return value_set;
+        }
 
-                    do { ++u_idx; } while ((u_idx < u_vals.size()) && !u_bitmap[u_idx]);
-                    ++A_iter;
-                }
-                else if (u_idx > a_idx)
-                {
-                    //std::cerr << "Advancing A_iter" << std::endl;
-                    ++A_iter;
-                }
-                else
+        //**********************************************************************
+        /// Dot product of a row held as index and value arrays with a sparse
+        /// vector: each index of the row probes u's bitmap, and a value of
+        /// the row is only loaded on a hit.
+        template <typename D1, typename D2, typename D3, typename SemiringT>
+        bool dot2(D3                         &ans,
+                  SparseRow<D1>        const &A_row,
+                  Bitmap               const &u_bitmap,
+                  std::vector<D2>      const &u_vals,
+                  GraphBLAS::IndexType        u_nvals,
+                  SemiringT                   op)
+        {
+            bool value_set(false);
+            ans = op.zero();
+
+            if (u_nvals == 0)
+            {
+                return value_set;
+            }
+
+            TerminalTest<SemiringT> terminal(op);
+            IndexType const *a_idx(A_row.indices().data());
+            for (std::size_t k = 0; k < A_row.size(); ++k)
+            {
+                if (u_bitmap[a_idx[k]])
                 {
-                    //std::cerr << "Advancing u_iter" << std::endl;
-                    do { ++u_idx; } while ((u_idx < u_vals.size()) && !u_bitmap[u_idx]);
+                    ans = op.add(ans, semiring_mult(op, A_row.values()[k],
+                                                    u_vals[a_idx[k]]));
+                    value_set = true;
+                    if (terminal.reached(ans))
+                    {
+                        break;
+                    }
                 }
             }
 
@@ -286,57 +386,53 @@ namespace GraphBLAS
             bool value_set(false);
             ans = op.zero();
 
-            if (vec2.empty() || vec1.empty())
-            {
-                return value_set;
-            }
-
-            auto v1_it = vec1.begin();
-            auto v2_it = vec2.begin();
-
-            // pull first value out of the row
-            D1 a_val;
-            D2 u_val;
-            GraphBLAS::IndexType a_idx, u_idx;
+            TerminalTest<SemiringT> terminal(op);
+            intersect_sorted(
+                vec1.begin(), vec1.size(), vec2.begin(), vec2.size(),
+                [&ans, &value_set, &vec1, &vec2, &op, &terminal](
+                    std::size_t k1, std::size_t k2)
+                {
+                    ans = op.add(ans, semiring_mult(op, std::get<1>(vec1[k1]),
+                                                    std::get<1>(vec2[k2])));
+                    value_set = true;
+                    return !terminal.reached(ans);
+                });
 
-            // loop through both ordered sets to compute sparse dot prod
-            while ((v1_it != vec1.end()) &&
-                   (v2_it != vec2.end()))
-            {
-                std::tie(a_idx, a_val) = *v1_it;
-                std::tie(u_idx, u_val) = *v2_it;
+            return value_set;
+        }
 
-                //std::cerr << "Examine u idx,val = " << u_idx << "," << u_val
-                //          << "; A col_idx,val = " << a_idx << "," << a_val << std::endl;
+        //************************************************************************
+        /// A dot product of two sparse vectors held as index and value
+        /// arrays.  The intersection only reads the index arrays; values are
+        /// loaded for matching positions.
+        template <typename D1, typename D2, typename D3, typename SemiringT>
+        bool dot(D3                   &ans,
+                 SparseRow<D1>  const &vec1,
+                 SparseRow<D2>  const &vec2,
+                 SemiringT             op)
+        {
+            bool value_set(false);
+            ans = op.zero();
 
-                if (u_idx == a_idx)
+            TerminalTest<SemiringT> terminal(op);
+            intersect_sorted(
+                vec1.indices().data(), vec1.size(),
+                vec2.indices().data(), vec2.size(),
+                [&ans, &value_set, &vec1, &vec2, &op, &terminal](
+                    std::size_t k1, std::size_t k2)
                 {
-                    //std::cerr << ans << " + " << a_val << " * " << u_val << " = ";
-                    ans = op.add(ans, op.mult(a_val, u_val));
+                    ans = op.add(ans, semiring_mult(op, vec1.values()[k1],
+                                                    vec2.values()[k2]));
                     value_set = true;
-                    //std::cerr << ans << std::endl;
-
-                    ++v2_it;
-                    ++v1_it;
-                }
-                else if (u_idx > a_idx)
-                {
-                    //std::cerr << "Advancing v1_it" << std::endl;
-                    ++v1_it;
-                }
-                else
-                {
-                    //std::cerr << "Advancing v2_it" << std::endl;
-                    ++v2_it;
-                }
-            }
+                    return !terminal.reached(ans);
+                });
 
             return value_set;
         }
 
         //************************************************************************
         /// A reduction of a sparse vector (vector<tuple(index,value)>) using a
-        /// binary op or a monoid.
+        /// binary op or a monoid; stops at the monoid's terminal value.
         template <typename D1, typename D3, typename BinaryOpT>
         bool reduction(
             D3                                                      &ans,
@@ -359,9 +455,11 @@ namespace GraphBLAS
             {
                 /// @note Since op is associative and commutative left to right
                 /// ordering is not strictly required.
+                TerminalTest<BinaryOpT> terminal(op);
                 tmp = op(std::get<1>(vec[0]), std::get<1>(vec[1]));
 
-                for (size_t idx = 2; idx < vec.size(); ++idx)
+                for (size_t idx = 2;
+                     (idx < vec.size()) && !terminal.reached(tmp); ++idx)
                 {
                     tmp = op(tmp, std::get<1>(vec[idx]));
                 }
@@ -435,12 +533,64 @@ namespace GraphBLAS
             }
         }
 
+        //**********************************************************************
+        /// Apply element-wise operation to union on sparse vectors held as
+        /// index and value arrays.
+        template <typename D1, typename D2, typename D3, typename BinaryOpT>
+        void ewise_or(std::vector<std::tuple<GraphBLAS::IndexType,D3> >       &ans,
+                      SparseRow<D1>                                     const &vec1,
+                      SparseRow<D2>                                     const &vec2,
+                      BinaryOpT                                                op)
+        {
+            ans.clear();
+            ans.reserve(vec1.size() + vec2.size());
+
+            IndexType const *idx1(vec1.indices().data());
+            IndexType const *idx2(vec2.indices().data());
+            std::size_t n1(vec1.size()), n2(vec2.size());
+            std::size_t k1(0), k2(0);
+
+            while ((k1 < n1) && (k2 < n2))
+            {
+                IndexType i1(idx1[k1]), i2(idx2[k2]);
+                if (i1 == i2)
+                {
+                    ans.push_back(std::make_tuple(
+                        i1, static_cast<D3>(op(vec1.value(k1), vec2.value(k2)))));
+                    ++k1;
+                    ++k2;
+                }
+                else if (i1 < i2)
+                {
+                    ans.push_back(std::make_tuple(
+                        i1, static_cast<D3>(vec1.value(k1))));
+                    ++k1;
+                }
+                else
+                {
+                    ans.push_back(std::make_tuple(
+                        i2, static_cast<D3>(vec2.value(k2))));
+                    ++k2;
+                }
+            }
+            for (; k1 < n1; ++k1)
+            {
+                ans.push_back(std::make_tuple(idx1[k1],
+                                              static_cast<D3>(vec1.value(k1))));
+            }
+            for (; k2 < n2; ++k2)
+            {
+                ans.push_back(std::make_tuple(idx2[k2],
+                                              static_cast<D3>(vec2.value(k2))));
+            }
+        }
+
         //********************************************************************
         // ALL SUPPORT
         // This is where we turns alls into the correct range
 
         template <typename SequenceT>
-        bool searchIndices(SequenceT seq, IndexType n)
+        bool searchIndices(SequenceT const &seq, IndexType n)
         {
             for (auto it : seq)
             {
@@ -621,13 +771,13 @@ namespace GraphBLAS
 
             typedef std::vector<std::tuple<IndexType,ZScalarType> > ZRowType;
 
-            ZRowType tmp_row;
-            IndexType nRows(Z.nrows());
-            for (IndexType row_idx = 0; row_idx < nRows; ++row_idx)
-            {
-                ewise_or(tmp_row, C.getRow(row_idx), T.getRow(row_idx), accum);
-                Z.setRow(row_idx, tmp_row);
-            }
+            compute_rows(
+                Z, Z.nrows(),
+                [&C, &T, accum](IndexType  row_idx,
+                                ZRowType  &z_row) mutable
+                {
+                    ewise_or(z_row, C.getRow(row_idx), T.getRow(row_idx), accum);
+                });
         }
 
         //**********************************************************************
@@ -649,25 +799,30 @@ namespace GraphBLAS
 
             typedef std::vector<std::tuple<IndexType,ZScalarType> > ZRowType;
 
-            ZRowType tmp_row;
-            IndexType nRows(Z.nrows());
-
-            for (IndexType row_idx = 0; row_idx < nRows; ++row_idx)
-            {
-                if (searchIndices(row_indices, row_idx))
-                {
-                    // Row Stenciled. merge C, T, using col stencil\n";
-                    ewise_or_stencil(tmp_row, C.getRow(row_idx), T.getRow(row_idx),
-                                     col_indices);
-                    Z.setRow(row_idx, tmp_row);
-                }
-                else
+            compute_rows(
+                Z, Z.nrows(),
+                [&C, &T, &row_indices, &col_indices](IndexType  row_idx,
+                                                     ZRowType  &z_row)
                 {
-                    // Row not stenciled.  Take row from C only
-                    // There should be nothing in T for this row
-                    Z.setRow(row_idx, C.getRow(row_idx));
-                }
-            }
+                    if (searchIndices(row_indices, row_idx))
+                    {
+                        // Row Stenciled. merge C, T, using col stencil
+                        ewise_or_stencil(z_row, C.getRow(row_idx),
+                                         T.getRow(row_idx), col_indices);
+                    }
+                    else
+                    {
+                        // Row not stenciled.  Take row from C only
+                        // There should be nothing in T for this row
+                        auto const &C_row(C.getRow(row_idx));
+                        for (auto const &elt : C_row)
+                        {
+                            z_row.push_back(std::make_tuple(
+                                std::get<0>(elt),
+                                static_cast<ZScalarType>(std::get<1>(elt))));
+                        }
+                    }
+                });
         }
 
         //**********************************************************************
@@ -684,13 +839,13 @@ namespace GraphBLAS
 
             typedef std::vector<std::tuple<IndexType,ZScalarType> > ZRowType;
 
-            ZRowType tmp_row;
-            IndexType nRows(Z.nrows());
-            for (IndexType row_idx = 0; row_idx < nRows; ++row_idx)
-            {
-                ewise_or(tmp_row, C.getRow(row_idx), T.getRow(row_idx), accum);
-                Z.setRow(row_idx, tmp_row);
-            }
+            compute_rows(
+                Z, Z.nrows(),
+                [&C, &T, accum](IndexType  row_idx,
+                                ZRowType  &z_row) mutable
+                {
+                    ewise_or(z_row, C.getRow(row_idx), T.getRow(row_idx), accum);
+                });
         }
 
         //**********************************************************************
@@ -777,40 +932,38 @@ namespace GraphBLAS
                        BinaryOpT                                                op)
         {
             ans.clear();
-            auto v1_it = vec1.begin();
-            auto v2_it = vec2.begin();
-
-            D1 v1_val;
-            D2 v2_val;
-            GraphBLAS::IndexType v1_idx, v2_idx;
-
-            // loop through both ordered sets to compute ewise_or
-            while ((v1_it != vec1.end()) && (v2_it != vec2.end()))
-            {
-                std::tie(v1_idx, v1_val) = *v1_it;
-                std::tie(v2_idx, v2_val) = *v2_it;
-
-                if (v2_idx == v1_idx)
+            intersect_sorted(
+                vec1.begin(), vec1.size(), vec2.begin(), vec2.size(),
+                [&ans, &vec1, &vec2, &op](std::size_t k1, std::size_t k2)
                 {
-                    //std::cerr << ans << " + " << v1_val << " * " << v2_val << " = ";
-                    ans.push_back(std::make_tuple(v1_idx,
-                                                  static_cast<D3>(op(v1_val, v2_val))));
-                    //std::cerr << ans << std::endl;
+                    ans.push_back(std::make_tuple(
+                        std::get<0>(vec1[k1]),
+                        static_cast<D3>(op(std::get<1>(vec1[k1]),
+                                           std::get<1>(vec2[k2])))));
+                    return true;
+                });
+        }
 
-                    ++v2_it;
-                    ++v1_it;
-                }
-                else if (v2_idx > v1_idx)
-                {
-                    //std::cerr << "Advancing v1_it" << std::endl;
-                    ++v1_it;
-                }
-                else
+        //************************************************************************
+        /// Apply element-wise operation to intersection of sparse vectors
+        /// held as index and value arrays.
+        template <typename D1, typename D2, typename D3, typename BinaryOpT>
+        void ewise_and(std::vector<std::tuple<GraphBLAS::IndexType,D3> >       &ans,
+                       SparseRow<D1>                                     const &vec1,
+                       SparseRow<D2>                                     const &vec2,
+                       BinaryOpT                                                op)
+        {
+            ans.clear();
+            intersect_sorted(
+                vec1.indices().data(), vec1.size(),
+                vec2.indices().data(), vec2.size(),
+                [&ans, &vec1, &vec2, &op](std::size_t k1, std::size_t k2)
                 {
-                    //std::cerr << "Advancing v2_it" << std::endl;
-                    ++v2_it;
-                }
-            }
+                    ans.push_back(std::make_tuple(
+                        vec1.index(k1),
+                        static_cast<D3>(op(vec1.value(k1), vec2.value(k2)))));
+                    return true;
+                });
         }
 
         //**********************************************************************
@@ -938,86 +1091,966 @@ namespace GraphBLAS
         } // apply_with_mask
 
         //**********************************************************************
-        // Matrix version
+        /// Append the columns of row row_idx of M that hold a true value.
+        template <typename MMatrixT>
+        inline void mask_row_true_columns(IndexArrayType       &cols,
+                                          MMatrixT       const &M,
+                                          IndexType             row_idx,
+                                          std::false_type)
+        {
+            auto const &mask_row(M.getRow(row_idx));
+            for (auto const &elt : mask_row)
+            {
+                if (static_cast<bool>(std::get<1>(elt)))
+                {
+                    cols.push_back(std::get<0>(elt));
+                }
+            }
+        }
 
-        template < typename CMatrixT,
-                   typename ZMatrixT,
-                   typename MMatrixT>
-        void write_with_opt_mask(CMatrixT           &C,
-                                 ZMatrixT   const   &Z,
-                                 MMatrixT   const   &mask,
-                                 bool               replace)
+        /// Pattern-only mask: every stored value is the iso value, so only
+        /// the stored indices are read.
+        template <typename MMatrixT>
+        inline void mask_row_true_columns(IndexArrayType       &cols,
+                                          MMatrixT       const &M,
+                                          IndexType             row_idx,
+                                          std::true_type)
         {
-            typedef typename CMatrixT::ScalarType CScalarType;
-            typedef typename ZMatrixT::ScalarType ZScalarType;
-            typedef typename MMatrixT::ScalarType MScalarType;
+            if (static_cast<bool>(M.isoValue()))
+            {
+                auto const &pattern(M.getPattern(row_idx));
+                cols.insert(cols.end(), pattern.begin(), pattern.end());
+            }
+        }
 
-            typedef std::vector<std::tuple<IndexType, CScalarType> > CRowType;
-            typedef std::vector<std::tuple<IndexType, ZScalarType> > ZRowType;
-            typedef std::vector<std::tuple<IndexType, MScalarType> > MRowType;
+        //**********************************************************************
+        /**
+         * @brief Per-row view of a matrix mask used by the multiply kernels
+         *        to skip columns the mask would discard anyway.
+         *
+         * load(row) marks the columns of that row holding a true mask value;
+         * allowed(col) is then O(1).  indices() lists the allowed columns.
+         */
+        template <typename MMatrixT>
+        class MaskRowFilter
+        {
+        public:
+            static const bool complemented = false;
+
+            MaskRowFilter(MMatrixT const &mask)
+                : m_mask(mask), m_flags(mask.ncols(), false)
+            {
+            }
 
-            CRowType tmp_row;
-            IndexType nRows(C.nrows());
-            for (IndexType row_idx = 0; row_idx < nRows; ++row_idx)
+            void load(IndexType row_idx)
             {
-                apply_with_mask(tmp_row, C.getRow(row_idx), Z.getRow(row_idx),
-                                mask.getRow(row_idx), replace);
+                for (auto idx : m_indices)
+                {
+                    m_flags[idx] = false;
+                }
+                m_indices.clear();
 
-                // Now, set the new one.  Yes, we can optimize this later
-                C.setRow(row_idx, tmp_row);
+                mask_row_true_columns(m_indices, m_mask, row_idx,
+                                      is_pattern_matrix<MMatrixT>());
+                for (auto idx : m_indices)
+                {
+                    m_flags[idx] = true;
+                }
             }
-        }
 
-        //**********************************************************************
-        // Matrix version specialized for no mask
+            bool allowed(IndexType col_idx) const { return m_flags[col_idx]; }
+            bool empty() const { return m_indices.empty(); }
+            IndexArrayType const &indices() const { return m_indices; }
 
-        template < typename CMatrixT,
-                   typename ZMatrixT >
-        void write_with_opt_mask(CMatrixT                   &C,
-                                 ZMatrixT           const   &Z,
-                                 backend::NoMask    const   &foo,
-                                 bool                       replace)
+        private:
+            MMatrixT const    &m_mask;
+            std::vector<bool>  m_flags;
+            IndexArrayType     m_indices;
+        };
+
+        /// Complemented mask: load(row) marks the blocked columns, taken
+        /// directly from the underlying matrix.
+        template <typename MatrixT>
+        class MaskRowFilter<MatrixComplementView<MatrixT> >
         {
-            sparse_copy(C, Z);
-        }
+        public:
+            static const bool complemented = true;
 
-        //**********************************************************************
-        // Vector version
+            MaskRowFilter(MatrixComplementView<MatrixT> const &mask)
+                : m_mask(mask.getMatrix()), m_flags(mask.ncols(), false)
+            {
+            }
 
-        template <typename WVectorT,
-                  typename ZScalarT,
-                  typename MaskT>
-        void write_with_opt_mask_1D(
-            WVectorT                                           &w,
-            std::vector<std::tuple<IndexType, ZScalarT>> const &z,
-            MaskT const                                        &mask,
-            bool                                                replace)
-        {
-            typedef typename WVectorT::ScalarType WScalarType;
-            std::vector<std::tuple<IndexType, WScalarType> > tmp_row;
+            void load(IndexType row_idx)
+            {
+                for (auto idx : m_blocked)
+                {
+                    m_flags[idx] = false;
+                }
+                m_blocked.clear();
 
-            apply_with_mask(tmp_row, w.getContents(), z,
-                            mask.getContents(), replace);
+                mask_row_true_columns(m_blocked, m_mask, row_idx,
+                                      is_pattern_matrix<MatrixT>());
+                for (auto idx : m_blocked)
+                {
+                    m_flags[idx] = true;
+                }
+            }
 
-            // Now, set the new one.  Yes, we can optimize this later
-            w.setContents(tmp_row);
-        }
+            bool allowed(IndexType col_idx) const { return !m_flags[col_idx]; }
+            bool empty() const { return m_blocked.size() == m_flags.size(); }
+
+            /// The allowed columns; O(ncols) for a complemented mask.
+            IndexArrayType const &indices() const
+            {
+                m_indices.clear();
+                for (IndexType idx = 0; idx < m_flags.size(); ++idx)
+                {
+                    if (!m_flags[idx])
+                    {
+                        m_indices.push_back(idx);
+                    }
+                }
+                return m_indices;
+            }
+
+        private:
+            MatrixT const          &m_mask;
+            std::vector<bool>       m_flags;
+            IndexArrayType          m_blocked;
+            mutable IndexArrayType  m_indices;
+        };
 
         //**********************************************************************
-        // Vector version specialized for no mask
+        /// O(1) test of a vector mask element; NoMask allows everything.
+        template <typename MaskT>
+        class VectorMaskFilter
+        {
+        public:
+            VectorMaskFilter(MaskT const &mask)
+                : m_bitmap(mask.get_bitmap()), m_vals(mask.get_vals())
+            {
+            }
 
-        template <typename WVectorT,
-                  typename ZScalarT>
-        void write_with_opt_mask_1D(
-            WVectorT                                           &w,
-            std::vector<std::tuple<IndexType, ZScalarT>> const &z,
-            backend::NoMask const                              &foo,
-            bool                                                replace)
+            bool allowed(IndexType idx) const
+            {
+                return (m_bitmap[idx] && static_cast<bool>(m_vals[idx]));
+            }
+
+        private:
+            Bitmap                                  const &m_bitmap;
+            std::vector<typename MaskT::ScalarType> const &m_vals;
+        };
+
+        template <typename VectorT>
+        class VectorMaskFilter<VectorComplementView<VectorT> >
         {
-            //sparse_copy(w, z);
+        public:
+            VectorMaskFilter(VectorComplementView<VectorT> const &mask)
+                : m_bitmap(mask.getVector().get_bitmap()),
+                  m_vals(mask.getVector().get_vals())
+            {
+            }
+
+            bool allowed(IndexType idx) const
+            {
+                return !(m_bitmap[idx] && static_cast<bool>(m_vals[idx]));
+            }
+
+        private:
+            Bitmap                                    const &m_bitmap;
+            std::vector<typename VectorT::ScalarType> const &m_vals;
+        };
+
+        template <>
+        class VectorMaskFilter<NoMask>
+        {
+        public:
+            VectorMaskFilter(NoMask const &) {}
+            bool allowed(IndexType) const { return true; }
+        };
+
+        //**********************************************************************
+        /**
+         * @brief Same result as apply_with_mask, but the mask is a filter
+         *        (MaskRowFilter or VectorMaskFilter) tested per index, so
+         *        the work is O(|c_vec| + |z_vec|) and a complemented mask
+         *        is never expanded.
+         */
+        template <typename CScalarT,
+                  typename ZScalarT,
+                  typename FilterT>
+        void apply_with_mask_filter(
+            std::vector<std::tuple<IndexType, CScalarT> >          &result,
+            std::vector<std::tuple<IndexType, CScalarT> > const    &c_vec,
+            std::vector<std::tuple<IndexType, ZScalarT> > const    &z_vec,
+            FilterT                                       const    &filter,
+            bool                                                    replace)
+        {
+            result.clear();
+
+            auto c_it = c_vec.begin();
+            auto z_it = z_vec.begin();
+
+            while ((c_it != c_vec.end()) || (z_it != z_vec.end()))
+            {
+                if ((z_it != z_vec.end()) &&
+                    ((c_it == c_vec.end()) ||
+                     (std::get<0>(*z_it) <= std::get<0>(*c_it))))
+                {
+                    IndexType idx(std::get<0>(*z_it));
+                    bool c_here((c_it != c_vec.end()) &&
+                                (std::get<0>(*c_it) == idx));
+
+                    if (filter.allowed(idx))
+                    {
+                        result.push_back(
+                            std::make_tuple(idx,
+                                            static_cast<CScalarT>(
+                                                std::get<1>(*z_it))));
+                    }
+                    else if (c_here && !replace)
+                    {
+                        result.push_back(*c_it);
+                    }
+
+                    ++z_it;
+                    if (c_here)
+                    {
+                        ++c_it;
+                    }
+                }
+                else
+                {
+                    // C only: kept when outside the mask (and not replace)
+                    if (!replace && !filter.allowed(std::get<0>(*c_it)))
+                    {
+                        result.push_back(*c_it);
+                    }
+                    ++c_it;
+                }
+            }
+        }
+
+        //**********************************************************************
+        // Matrix version
+
+        template < typename CMatrixT,
+                   typename ZMatrixT,
+                   typename MMatrixT>
+        void write_with_opt_mask(CMatrixT           &C,
+                                 ZMatrixT   const   &Z,
+                                 MMatrixT   const   &mask,
+                                 bool               replace)
+        {
+            typedef typename CMatrixT::ScalarType CScalarType;
+            typedef std::vector<std::tuple<IndexType, CScalarType> > CRowType;
+
+            mask.assemble();
+            MaskRowFilter<MMatrixT> filter(mask);
+            compute_rows(
+                C, C.nrows(),
+                [&C, &Z, filter, replace](IndexType    row_idx,
+                                          CRowType    &c_row) mutable
+                {
+                    filter.load(row_idx);
+                    apply_with_mask_filter(c_row, C.getRow(row_idx),
+                                           Z.getRow(row_idx), filter, replace);
+                });
+        }
+
+        //**********************************************************************
+        // Matrix version specialized for no mask
+
+        template < typename CMatrixT,
+                   typename ZMatrixT >
+        void write_with_opt_mask(CMatrixT                   &C,
+                                 ZMatrixT           const   &Z,
+                                 backend::NoMask    const   &foo,
+                                 bool                       replace)
+        {
+            sparse_copy(C, Z);
+        }
+
+        //**********************************************************************
+        // Vector version
+
+        template <typename WVectorT,
+                  typename ZScalarT,
+                  typename MaskT>
+        void write_with_opt_mask_1D(
+            WVectorT                                           &w,
+            std::vector<std::tuple<IndexType, ZScalarT>> const &z,
+            MaskT const                                        &mask,
+            bool                                                replace)
+        {
+            typedef typename WVectorT::ScalarType WScalarType;
+            std::vector<std::tuple<IndexType, WScalarType> > tmp_row;
+
+            apply_with_mask_filter(tmp_row, w.getContents(), z,
+                                   VectorMaskFilter<MaskT>(mask), replace);
+
+            // Now, set the new one.  Yes, we can optimize this later
+            w.setContents(tmp_row);
+        }
+
+        //**********************************************************************
+        // Vector version specialized for no mask
+
+        template <typename WVectorT,
+                  typename ZScalarT>
+        void write_with_opt_mask_1D(
+            WVectorT                                           &w,
+            std::vector<std::tuple<IndexType, ZScalarT>> const &z,
+            backend::NoMask const                              &foo,
+            bool                                                replace)
+        {
+            //sparse_copy(w, z);
             w.setContents(z);
         }
 
+        //**********************************************************************
+        // Fused accumulate and mask stages: C<M> (+)= T
+        //
+        // The general case forms Z = C (+) T and then writes Z into C through
+        // the mask.  The overloads below are picked at compile time and skip
+        // the intermediate copies: without a mask or accumulator T is moved
+        // into C; with only a mask T is written through it directly; with
+        // only an accumulator the rows of T are merged into C in place.  T
+        // (or t) is a temporary owned by the caller and is consumed.
+        //**********************************************************************
+
+        /// C = T for a LIL output of the same scalar type: take T's rows.
+        template <typename CMatrixT, typename TScalarT>
+        void move_rows(CMatrixT                    &C,
+                       LilSparseMatrix<TScalarT>   &T,
+                       std::false_type,
+                       std::true_type)
+        {
+            static_cast<LilSparseMatrix<TScalarT> &>(C).swap(T);
+        }
+
+        /// C = T for a LIL output of another scalar type: cast each value.
+        template <typename CMatrixT, typename TScalarT>
+        void move_rows(CMatrixT                    &C,
+                       LilSparseMatrix<TScalarT>   &T,
+                       std::false_type,
+                       std::false_type)
+        {
+            sparse_copy(C, T);
+        }
+
+        /// C = T for a CSR output: lay T out as CSR arrays in one pass.
+        template <typename CMatrixT, typename TScalarT, typename SameTypeT>
+        void move_rows(CMatrixT                    &C,
+                       LilSparseMatrix<TScalarT>   &T,
+                       std::true_type,
+                       SameTypeT)
+        {
+            typedef typename CMatrixT::ScalarType CScalarType;
+
+            std::vector<IndexType>   row_ptr(T.nrows() + 1, 0);
+            std::vector<IndexType>   col_idx;
+            std::vector<CScalarType> vals;
+            col_idx.reserve(T.nvals());
+            vals.reserve(T.nvals());
+
+            for (IndexType row_idx = 0; row_idx < T.nrows(); ++row_idx)
+            {
+                for (auto const &t_elt : T.getRow(row_idx))
+                {
+                    col_idx.push_back(std::get<0>(t_elt));
+                    vals.push_back(static_cast<CScalarType>(std::get<1>(t_elt)));
+                }
+                row_ptr[row_idx + 1] = col_idx.size();
+            }
+            T.clear();
+
+            CsrArray<IndexType> row_ptr_array, col_idx_array;
+            typename CMatrixT::ValuesArrayType vals_array;
+            row_ptr_array = std::move(row_ptr);
+            col_idx_array = std::move(col_idx);
+            vals_array = std::move(vals);
+            C.adopt_arrays(std::move(row_ptr_array), std::move(col_idx_array),
+                           std::move(vals_array));
+        }
+
+        //**********************************************************************
+        /// Z = C (+) T, then C<M> = Z.
+        template <typename ZScalarT,
+                  typename CMatrixT,
+                  typename MMatrixT,
+                  typename AccumT,
+                  typename TScalarT>
+        void accum_via_z(CMatrixT                  &C,
+                         MMatrixT          const   &M,
+                         AccumT            const   &accum,
+                         LilSparseMatrix<TScalarT> &T,
+                         bool                       replace)
+        {
+            LilSparseMatrix<ZScalarT> Z(C.nrows(), C.ncols());
+            ewise_or_opt_accum(Z, C, T, accum);
+
+            GRB_LOG_VERBOSE("Z: " << Z);
+
+            write_with_opt_mask(C, Z, M, replace);
+        }
+
+        /// General case: mask and accumulator.
+        template <typename ZScalarT,
+                  typename CMatrixT,
+                  typename MMatrixT,
+                  typename AccumT,
+                  typename TScalarT>
+        void opt_accum_with_opt_mask(CMatrixT                  &C,
+                                     MMatrixT          const   &M,
+                                     AccumT            const   &accum,
+                                     LilSparseMatrix<TScalarT> &T,
+                                     bool                       replace)
+        {
+            accum_via_z<ZScalarT>(C, M, accum, T, replace);
+        }
+
+        //**********************************************************************
+        /// No mask, no accumulator: C = T without intermediate copies.
+        template <typename ZScalarT,
+                  typename CMatrixT,
+                  typename TScalarT>
+        void opt_accum_with_opt_mask(CMatrixT                  &C,
+                                     backend::NoMask   const   &M,
+                                     NoAccumulate      const   &accum,
+                                     LilSparseMatrix<TScalarT> &T,
+                                     bool                       replace)
+        {
+            typedef typename CMatrixT::ScalarType CScalarType;
+            move_rows(C, T, is_csr_matrix<CMatrixT>(),
+                      std::integral_constant<
+                          bool,
+                          std::is_same<TScalarT, CScalarType>::value &&
+                          std::is_base_of<LilSparseMatrix<CScalarType>,
+                                          CMatrixT>::value>());
+        }
+
+        //**********************************************************************
+        /// Mask, no accumulator: Z is T, so write T through the mask.
+        template <typename ZScalarT,
+                  typename CMatrixT,
+                  typename MMatrixT,
+                  typename TScalarT>
+        void opt_accum_with_opt_mask(CMatrixT                  &C,
+                                     MMatrixT          const   &M,
+                                     NoAccumulate      const   &accum,
+                                     LilSparseMatrix<TScalarT> &T,
+                                     bool                       replace)
+        {
+            write_with_opt_mask(C, T, M, replace);
+        }
+
+        //**********************************************************************
+        /// Accumulator, no mask, Z of C's type: merge the non-empty rows of T
+        /// into C in place.  Other rows of C are not touched.
+        template <typename ZScalarT,
+                  typename CMatrixT,
+                  typename AccumT,
+                  typename TScalarT>
+        void accum_rows_in_place(CMatrixT                  &C,
+                                 AccumT            const   &accum,
+                                 LilSparseMatrix<TScalarT> &T,
+                                 std::true_type)
+        {
+            typedef typename CMatrixT::ScalarType CScalarType;
+            typedef std::vector<std::tuple<IndexType, CScalarType> > CRowType;
+
+            IndexArrayType rows;
+            for (IndexType row_idx = 0; row_idx < T.nrows(); ++row_idx)
+            {
+                if (!T.getRow(row_idx).empty())
+                {
+                    rows.push_back(row_idx);
+                }
+            }
+
+            C.assemble();
+            compute_rows_mapped(
+                C, rows,
+                [&C, &T, &rows, accum](IndexType  ix,
+                                       CRowType  &c_row) mutable
+                {
+                    ewise_or(c_row, C.getRow(rows[ix]), T.getRow(rows[ix]),
+                             accum);
+                });
+        }
+
+        /// Z of another type than C: values must pass through Z's type.
+        template <typename ZScalarT,
+                  typename CMatrixT,
+                  typename AccumT,
+                  typename TScalarT>
+        void accum_rows_in_place(CMatrixT                  &C,
+                                 AccumT            const   &accum,
+                                 LilSparseMatrix<TScalarT> &T,
+                                 std::false_type)
+        {
+            accum_via_z<ZScalarT>(C, backend::NoMask(), accum, T, false);
+        }
+
+        /// Accumulator, no mask.
+        template <typename ZScalarT,
+                  typename CMatrixT,
+                  typename AccumT,
+                  typename TScalarT>
+        void opt_accum_with_opt_mask(CMatrixT                  &C,
+                                     backend::NoMask   const   &M,
+                                     AccumT            const   &accum,
+                                     LilSparseMatrix<TScalarT> &T,
+                                     bool                       replace)
+        {
+            accum_rows_in_place<ZScalarT>(
+                C, accum, T,
+                std::is_same<ZScalarT, typename CMatrixT::ScalarType>());
+        }
+
+        //**********************************************************************
+        // Vector versions: w<mask> (+)= t
+
+        /// z = w (+) t, then w<mask> = z.
+        template <typename ZScalarT,
+                  typename WVectorT,
+                  typename MaskT,
+                  typename AccumT,
+                  typename TScalarT>
+        void accum_via_z_1D(
+            WVectorT                                         &w,
+            MaskT                                     const  &mask,
+            AccumT                                    const  &accum,
+            std::vector<std::tuple<IndexType, TScalarT> >    &t,
+            bool                                              replace)
+        {
+            std::vector<std::tuple<IndexType, ZScalarT> > z;
+            ewise_or_opt_accum_1D(z, w, t, accum);
+
+            GRB_LOG_VERBOSE("z: " << z);
+
+            write_with_opt_mask_1D(w, z, mask, replace);
+        }
+
+        /// General case: mask and accumulator.
+        template <typename ZScalarT,
+                  typename WVectorT,
+                  typename MaskT,
+                  typename AccumT,
+                  typename TScalarT>
+        void opt_accum_with_opt_mask_1D(
+            WVectorT                                         &w,
+            MaskT                                     const  &mask,
+            AccumT                                    const  &accum,
+            std::vector<std::tuple<IndexType, TScalarT> >    &t,
+            bool                                              replace)
+        {
+            accum_via_z_1D<ZScalarT>(w, mask, accum, t, replace);
+        }
+
+        /// No mask, no accumulator: w = t.
+        template <typename ZScalarT,
+                  typename WVectorT,
+                  typename TScalarT>
+        void opt_accum_with_opt_mask_1D(
+            WVectorT                                         &w,
+            backend::NoMask                           const  &mask,
+            NoAccumulate                              const  &accum,
+            std::vector<std::tuple<IndexType, TScalarT> >    &t,
+            bool                                              replace)
+        {
+            w.setContents(t);
+        }
+
+        /// Mask, no accumulator: write t through the mask.
+        template <typename ZScalarT,
+                  typename WVectorT,
+                  typename MaskT,
+                  typename TScalarT>
+        void opt_accum_with_opt_mask_1D(
+            WVectorT                                         &w,
+            MaskT                                     const  &mask,
+            NoAccumulate                              const  &accum,
+            std::vector<std::tuple<IndexType, TScalarT> >    &t,
+            bool                                              replace)
+        {
+            write_with_opt_mask_1D(w, t, mask, replace);
+        }
+
+        /// Accumulator, no mask: update the elements of w at t's indices.
+        template <typename ZScalarT,
+                  typename WVectorT,
+                  typename AccumT,
+                  typename TScalarT>
+        void accum_1D_in_place(
+            WVectorT                                         &w,
+            AccumT                                            accum,
+            std::vector<std::tuple<IndexType, TScalarT> >    &t,
+            std::true_type)
+        {
+            typedef typename WVectorT::ScalarType WScalarType;
+
+            // a sparse form w would insert one element at a time: merge
+            if (w.isSparseForm())
+            {
+                accum_via_z_1D<ZScalarT>(w, backend::NoMask(), accum, t, false);
+                return;
+            }
+
+            auto const &w_bitmap(w.get_bitmap());
+            auto const &w_vals(w.get_vals());
+            for (auto const &t_elt : t)
+            {
+                IndexType idx(std::get<0>(t_elt));
+                if (w_bitmap[idx])
+                {
+                    w.setElement(idx, static_cast<WScalarType>(
+                                     accum(w_vals[idx], std::get<1>(t_elt))));
+                }
+                else
+                {
+                    w.setElement(idx,
+                                 static_cast<WScalarType>(std::get<1>(t_elt)));
+                }
+            }
+        }
+
+        /// z of another type than w: values must pass through z's type.
+        template <typename ZScalarT,
+                  typename WVectorT,
+                  typename AccumT,
+                  typename TScalarT>
+        void accum_1D_in_place(
+            WVectorT                                         &w,
+            AccumT                                    const  &accum,
+            std::vector<std::tuple<IndexType, TScalarT> >    &t,
+            std::false_type)
+        {
+            accum_via_z_1D<ZScalarT>(w, backend::NoMask(), accum, t, false);
+        }
+
+        /// Accumulator, no mask.
+        template <typename ZScalarT,
+                  typename WVectorT,
+                  typename AccumT,
+                  typename TScalarT>
+        void opt_accum_with_opt_mask_1D(
+            WVectorT                                         &w,
+            backend::NoMask                           const  &mask,
+            AccumT                                    const  &accum,
+            std::vector<std::tuple<IndexType, TScalarT> >    &t,
+            bool                                              replace)
+        {
+            accum_1D_in_place<ZScalarT>(
+                w, accum, t,
+                std::is_same<ZScalarT, typename WVectorT::ScalarType>());
+        }
+
+        //**********************************************************************
+        // The same stages for a t built directly as a bitmap vector by the
+        // word-wise eWise and apply kernels.
+
+        /// General case: go through the list of stored elements.
+        template <typename ZScalarT,
+                  typename WVectorT,
+                  typename MaskT,
+                  typename AccumT,
+                  typename TScalarT>
+        void opt_accum_with_opt_mask_1D(
+            WVectorT                                         &w,
+            MaskT                                     const  &mask,
+            AccumT                                    const  &accum,
+            BitmapSparseVector<TScalarT>                     &t,
+            bool                                              replace)
+        {
+            auto t_contents(t.getContents());
+            opt_accum_with_opt_mask_1D<ZScalarT>(w, mask, accum, t_contents,
+                                                 replace);
+        }
+
+        template <typename WVectorT, typename TScalarT>
+        void move_vector_1D(WVectorT                     &w,
+                            BitmapSparseVector<TScalarT> &t,
+                            std::true_type)
+        {
+            static_cast<BitmapSparseVector<TScalarT> &>(w).swap(t);
+        }
+
+        template <typename WVectorT, typename TScalarT>
+        void move_vector_1D(WVectorT                     &w,
+                            BitmapSparseVector<TScalarT> &t,
+                            std::false_type)
+        {
+            w.setContents(t.getContents());
+        }
+
+        /// No mask, no accumulator: w = t, a swap when the types match.
+        template <typename ZScalarT,
+                  typename WVectorT,
+                  typename TScalarT>
+        void opt_accum_with_opt_mask_1D(
+            WVectorT                                         &w,
+            backend::NoMask                           const  &mask,
+            NoAccumulate                              const  &accum,
+            BitmapSparseVector<TScalarT>                     &t,
+            bool                                              replace)
+        {
+            move_vector_1D(
+                w, t,
+                std::is_same<TScalarT, typename WVectorT::ScalarType>());
+        }
+
+        /// Accumulator, no mask: merge t into w word by word.
+        template <typename ZScalarT,
+                  typename WVectorT,
+                  typename AccumT,
+                  typename TScalarT>
+        void opt_accum_with_opt_mask_1D(
+            WVectorT                                         &w,
+            backend::NoMask                           const  &mask,
+            AccumT                                    const  &accum,
+            BitmapSparseVector<TScalarT>                     &t,
+            bool                                              replace)
+        {
+            if (std::is_same<ZScalarT, typename WVectorT::ScalarType>::value)
+            {
+                w.ewise_or(w, t, accum);
+            }
+            else
+            {
+                auto t_contents(t.getContents());
+                accum_via_z_1D<ZScalarT>(w, mask, accum, t_contents, replace);
+            }
+        }
+
+        //**********************************************************************
+        /// True when getCol() costs O(column length).
+        template<typename MatrixT>
+        inline bool has_fast_columns(MatrixT const &B)
+        {
+            return B.hasColumnIndex();
+        }
+
+        template<typename MatrixT>
+        inline bool has_fast_columns(TransposeView<MatrixT> const &B)
+        {
+            return true;
+        }
+
+        /// True when getRow() is cheap; a TransposeView only has cheap
+        /// column access.
+        template<typename MatrixT>
+        inline bool has_fast_rows(MatrixT const &A) { return true; }
+
+        template<typename MatrixT>
+        inline bool has_fast_rows(TransposeView<MatrixT> const &A)
+        {
+            return false;
+        }
+
+        //********************************************************************
+        /**
+         * @brief Sparse accumulator (SPA) for row-wise (Gustavson/saxpy)
+         *        products.
+         *
+         * A dense value array and occupancy flags of length ncols plus the
+         * list of touched columns, so that resetting between rows costs only
+         * the number of entries produced by the previous row.
+         */
+        template<typename ScalarT>
+        class SparseAccumulator
+        {
+        public:
+            SparseAccumulator(IndexType num_cols)
+                : m_vals(num_cols), m_occupied(num_cols, false)
+            {
+                m_touched.reserve(num_cols);
+            }
+
+            /// vals[col] = vals[col] (+) val, or vals[col] = val if unset
+            template<typename AddOpT>
+            void accumulate(IndexType col, ScalarT const &val, AddOpT add)
+            {
+                if (m_occupied[col])
+                {
+                    m_vals[col] = add(m_vals[col], val);
+                }
+                else
+                {
+                    m_vals[col] = val;
+                    m_occupied[col] = true;
+                    m_touched.push_back(col);
+                }
+            }
+
+            /// Move the sorted contents into row and reset the accumulator.
+            void gather(std::vector<std::tuple<IndexType, ScalarT> > &row)
+            {
+                row.clear();
+                row.reserve(m_touched.size());
+
+                // Sorting only pays off when few columns were touched;
+                // otherwise sweep the dense flags.
+                if (m_touched.size() < m_occupied.size()/16)
+                {
+                    std::sort(m_touched.begin(), m_touched.end());
+                    for (auto col : m_touched)
+                    {
+                        row.push_back(std::make_tuple(col, m_vals[col]));
+                        m_occupied[col] = false;
+                    }
+                }
+                else
+                {
+                    for (IndexType col = 0; col < m_occupied.size(); ++col)
+                    {
+                        if (m_occupied[col])
+                        {
+                            row.push_back(std::make_tuple(col, m_vals[col]));
+                            m_occupied[col] = false;
+                        }
+                    }
+                }
+                m_touched.clear();
+            }
+
+            IndexType size() const { return m_occupied.size(); }
+
+        private:
+            std::vector<ScalarT>   m_vals;
+            std::vector<bool>      m_occupied;
+            std::vector<IndexType> m_touched;
+        };
+
+        //********************************************************************
+        /**
+         * @brief Open addressing accumulator for rows that touch few
+         *        columns compared to the row width.
+         *
+         * Same interface as SparseAccumulator, but the table only needs
+         * room for the row being computed: init(bound) sizes it for at most
+         * 'bound' distinct columns.  The storage is kept between rows.
+         */
+        template<typename ScalarT>
+        class HashAccumulator
+        {
+        public:
+            HashAccumulator() : m_mask(0), m_shift(64) {}
+
+            void init(IndexType bound)
+            {
+                unsigned int log_size(4);
+                while ((IndexType(1) << log_size) < 2*bound) ++log_size;
+
+                IndexType table_size(IndexType(1) << log_size);
+                if (m_keys.size() < table_size)
+                {
+                    m_keys.assign(table_size, empty_key());
+                    m_vals.resize(table_size);
+                }
+                m_mask = table_size - 1;
+                m_shift = 64 - log_size;
+            }
+
+            template<typename AddOpT>
+            void accumulate(IndexType col, ScalarT const &val, AddOpT add)
+            {
+                IndexType slot((col*0x9E3779B97F4A7C15ULL) >> m_shift);
+                while (true)
+                {
+                    if (m_keys[slot] == col)
+                    {
+                        m_vals[slot] = add(m_vals[slot], val);
+                        return;
+                    }
+                    if (m_keys[slot] == empty_key())
+                    {
+                        m_keys[slot] = col;
+                        m_vals[slot] = val;
+                        m_used.push_back(slot);
+                        return;
+                    }
+                    slot = (slot + 1) & m_mask;
+                }
+            }
+
+            /// Move the sorted contents into row and reset the table.
+            void gather(std::vector<std::tuple<IndexType, ScalarT> > &row)
+            {
+                std::sort(m_used.begin(), m_used.end(),
+                          [this](IndexType lhs, IndexType rhs)
+                          { return m_keys[lhs] < m_keys[rhs]; });
+
+                row.clear();
+                row.reserve(m_used.size());
+                for (auto slot : m_used)
+                {
+                    row.push_back(std::make_tuple(m_keys[slot], m_vals[slot]));
+                    m_keys[slot] = empty_key();
+                }
+                m_used.clear();
+            }
+
+        private:
+            static IndexType empty_key() { return ~IndexType(0); }
+
+            std::vector<IndexType> m_keys;
+            std::vector<ScalarT>   m_vals;
+            std::vector<IndexType> m_used;
+            IndexType              m_mask;
+            unsigned int           m_shift;
+        };
+
+        //********************************************************************
+        /**
+         * @brief Accumulator for rows with only a handful of products:
+         *        they are sorted by column and equal columns combined.
+         *
+         * The sort is stable, so values are added in the order they were
+         * accumulated, as with the other accumulators.
+         */
+        template<typename ScalarT>
+        class SortAccumulator
+        {
+        public:
+            void accumulate(IndexType col, ScalarT const &val)
+            {
+                m_products.push_back(std::make_pair(col, val));
+            }
+
+            template<typename AddOpT>
+            void gather(std::vector<std::tuple<IndexType, ScalarT> > &row,
+                        AddOpT                                          add)
+            {
+                std::stable_sort(
+                    m_products.begin(), m_products.end(),
+                    [](std::pair<IndexType, ScalarT> const &lhs,
+                       std::pair<IndexType, ScalarT> const &rhs)
+                    { return lhs.first < rhs.first; });
+
+                row.clear();
+                for (auto const &product : m_products)
+                {
+                    if (!row.empty() && (std::get<0>(row.back()) == product.first))
+                    {
+                        std::get<1>(row.back()) =
+                            add(std::get<1>(row.back()), product.second);
+                    }
+                    else
+                    {
+                        row.push_back(std::make_tuple(product.first,
+                                                      product.second));
+                    }
+                }
+                m_products.clear();
+            }
+
+        private:
+            std::vector<std::pair<IndexType, ScalarT> > m_products;
+        };
+
         //********************************************************************
         // Index-out-of-bounds is an execution error and a responsibility of
         // the backend.
@@ -42,6 +42,7 @@
 #include <iterator>
 #include <iostream>
 #include <chrono>
+#include <algorithm>
 
 #include <graphblas/detail/logging.h>
 #include <graphblas/types.hpp>
@@ -49,6 +50,7 @@
 
 #include "sparse_helpers.hpp"
 #include "LilSparseMatrix.hpp"
+#include "TransposeView.hpp"
 
 
 //****************************************************************************
@@ -57,6 +59,413 @@ namespace GraphBLAS
 {
     namespace backend
     {
+        //**********************************************************************
+        /**
+         * @brief Row access to an operand of mxm.
+         *
+         * Matrices are used in place.  A TransposeView only offers cheap
+         * column access, so its rows are materialized once in O(nvals).
+         */
+        template<typename MatrixT>
+        class MxmRowAccess
+        {
+        public:
+            MxmRowAccess(MatrixT const &mat) : m_mat(mat) {}
+            MatrixT const &rows() const { return m_mat; }
+
+        private:
+            MatrixT const &m_mat;
+        };
+
+        template<typename MatrixT>
+        class MxmRowAccess<TransposeView<MatrixT> >
+        {
+        public:
+            typedef typename MatrixT::ScalarType ScalarType;
+
+            MxmRowAccess(TransposeView<MatrixT> const &mat)
+                : m_mat(mat.nrows(), mat.ncols())
+            {
+                std::vector<std::vector<std::tuple<IndexType, ScalarType> > >
+                    data(mat.nrows());
+                for (IndexType col_idx = 0; col_idx < mat.ncols(); ++col_idx)
+                {
+                    for (auto const &elt : mat.getCol(col_idx))
+                    {
+                        data[std::get<0>(elt)].push_back(
+                            std::make_tuple(col_idx, std::get<1>(elt)));
+                    }
+                }
+
+                for (IndexType row_idx = 0; row_idx < mat.nrows(); ++row_idx)
+                {
+                    if (!data[row_idx].empty())
+                    {
+                        m_mat.setRow(row_idx, data[row_idx]);
+                    }
+                }
+            }
+
+            LilSparseMatrix<ScalarType> const &rows() const { return m_mat; }
+
+        private:
+            LilSparseMatrix<ScalarType> m_mat;
+        };
+
+        //**********************************************************************
+        /// Number of stored values in row row_idx (O(1) for CSR storage,
+        /// which must be assembled).
+        template<typename MatrixT>
+        inline IndexType mxm_row_nvals(MatrixT const &B, IndexType row_idx,
+                                       std::false_type)
+        {
+            return B.getRow(row_idx).size();
+        }
+
+        template<typename MatrixT>
+        inline IndexType mxm_row_nvals(MatrixT const &B, IndexType row_idx,
+                                       std::true_type)
+        {
+            auto const &row_ptr(B.get_row_ptr());
+            return row_ptr[row_idx + 1] - row_ptr[row_idx];
+        }
+
+        //**********************************************************************
+        /**
+         * @brief Symbolic phase of the Gustavson kernel: the number of
+         *        multiplies in each row of A*B.
+         *
+         * flops[i] is an upper bound on the number of entries in row i of
+         * the product; the numeric phase uses it to size its buffers and to
+         * pick the accumulator for the row.  Costs O(nvals(A)).
+         */
+        template<typename ARowsT, typename BRowsT>
+        inline void mxm_symbolic(std::vector<IndexType>       &flops,
+                                 ARowsT                 const &A_rows,
+                                 BRowsT                 const &B_rows)
+        {
+            B_rows.assemble();
+            flops.assign(A_rows.nrows(), 0);
+
+#if defined(GB_USE_OPENMP)
+            #pragma omp parallel for schedule(dynamic, 1024)
+#endif
+            for (int64_t row_idx = 0;
+                 row_idx < static_cast<int64_t>(flops.size()); ++row_idx)
+            {
+                IndexType row_flops(0);
+                for (auto const &a_elt : A_rows.getRow(row_idx))
+                {
+                    row_flops += mxm_row_nvals(B_rows, std::get<0>(a_elt),
+                                               is_csr_matrix<BRowsT>());
+                }
+                flops[row_idx] = row_flops;
+            }
+        }
+
+        //**********************************************************************
+        /// Row filter that lets every column through (no mask).
+        struct MxmAllColumns
+        {
+            bool allowed(IndexType) const { return true; }
+        };
+
+        //**********************************************************************
+        /**
+         * @brief Numeric phase of the Gustavson kernel: one row of A*B,
+         *        scattering A(i,k)*B(k,:) for every stored A(i,k).
+         *
+         * The accumulator is chosen per row from the symbolic bound on the
+         * row's entries:
+         *  - a single entry in the row of A: the scaled row of B is already
+         *    sorted, so no accumulator is needed;
+         *  - a few products: SortAccumulator;
+         *  - a bound well below the row width: HashAccumulator;
+         *  - otherwise the dense SparseAccumulator, allocated on first use.
+         *
+         * Captured by value in the row loop, so each thread has its own
+         * scratch space.
+         */
+        template<typename D3ScalarT>
+        class GustavsonRow
+        {
+        public:
+            typedef std::vector<std::tuple<IndexType, D3ScalarT> > TRowType;
+
+            /// Rows with at most this many products are sorted.
+            static const IndexType SORT_MAX_PRODUCTS = 32;
+
+            /// Hash rows whose bound is below num_cols/HASH_WIDTH_RATIO.
+            static const IndexType HASH_WIDTH_RATIO = 16;
+
+            GustavsonRow(IndexType num_cols)
+                : m_num_cols(num_cols), m_spa(0)
+            {
+            }
+
+            template<typename SemiringT,
+                     typename ARowT,
+                     typename BRowsT,
+                     typename FilterT>
+            void operator()(TRowType            &T_row,
+                            SemiringT            op,
+                            ARowT         const &A_row,
+                            BRowsT        const &B_rows,
+                            IndexType            bound,
+                            FilterT       const &filter)
+            {
+                auto add_op = [&op](D3ScalarT const &lhs, D3ScalarT const &rhs)
+                    { return op.add(lhs, rhs); };
+
+                if (A_row.size() == 1)
+                {
+                    T_row.reserve(bound);
+                    scatter(op, A_row, B_rows, filter,
+                            [&T_row](IndexType col_idx, D3ScalarT const &val)
+                            { T_row.push_back(std::make_tuple(col_idx, val)); });
+                }
+                else if (bound <= SORT_MAX_PRODUCTS)
+                {
+                    scatter(op, A_row, B_rows, filter,
+                            [this](IndexType col_idx, D3ScalarT const &val)
+                            { m_sort.accumulate(col_idx, val); });
+                    m_sort.gather(T_row, add_op);
+                }
+                else if (bound < m_num_cols/HASH_WIDTH_RATIO)
+                {
+                    m_hash.init(bound);
+                    scatter(op, A_row, B_rows, filter,
+                            [this, &add_op](IndexType col_idx,
+                                            D3ScalarT const &val)
+                            { m_hash.accumulate(col_idx, val, add_op); });
+                    m_hash.gather(T_row);
+                }
+                else
+                {
+                    if (m_spa.size() != m_num_cols)
+                    {
+                        m_spa = SparseAccumulator<D3ScalarT>(m_num_cols);
+                    }
+                    scatter(op, A_row, B_rows, filter,
+                            [this, &add_op](IndexType col_idx,
+                                            D3ScalarT const &val)
+                            { m_spa.accumulate(col_idx, val, add_op); });
+                    m_spa.gather(T_row);
+                }
+            }
+
+        private:
+            template<typename SemiringT,
+                     typename ARowT,
+                     typename BRowsT,
+                     typename FilterT,
+                     typename AccumFnT>
+            static void scatter(SemiringT           &op,
+                                ARowT         const &A_row,
+                                BRowsT        const &B_rows,
+                                FilterT       const &filter,
+                                AccumFnT             accum_fn)
+            {
+                for (auto const &a_elt : A_row)
+                {
+                    auto const &B_row(B_rows.getRow(std::get<0>(a_elt)));
+                    for (auto const &b_elt : B_row)
+                    {
+                        if (filter.allowed(std::get<0>(b_elt)))
+                        {
+                            accum_fn(std::get<0>(b_elt),
+                                     semiring_mult(op,
+                                                   std::get<1>(a_elt),
+                                                   std::get<1>(b_elt)));
+                        }
+                    }
+                }
+            }
+
+            IndexType                     m_num_cols;
+            SortAccumulator<D3ScalarT>    m_sort;
+            HashAccumulator<D3ScalarT>    m_hash;
+            SparseAccumulator<D3ScalarT>  m_spa;
+        };
+
+        //**********************************************************************
+        /// Gustavson (row-wise saxpy) product T = A*B; the cost is
+        /// proportional to the number of multiplies, not nrows*ncols.
+        template<typename D3ScalarT,
+                 typename SemiringT,
+                 typename AMatrixT,
+                 typename BMatrixT>
+        inline void mxm_gustavson(LilSparseMatrix<D3ScalarT> &T,
+                                  SemiringT                   op,
+                                  AMatrixT            const  &A,
+                                  BMatrixT            const  &B)
+        {
+            MxmRowAccess<AMatrixT> A_access(A);
+            MxmRowAccess<BMatrixT> B_access(B);
+            auto const &A_rows(A_access.rows());
+            auto const &B_rows(B_access.rows());
+
+            std::vector<IndexType> flops;
+            mxm_symbolic(flops, A_rows, B_rows);
+
+            typedef std::vector<std::tuple<IndexType, D3ScalarT> > TRowType;
+            IndexType num_cols(B.ncols());
+            GustavsonRow<D3ScalarT> kernel(num_cols);
+            MxmAllColumns all_columns;
+            compute_rows(
+                T, A.nrows(),
+                [&A_rows, &B_rows, &flops, num_cols, op, kernel, all_columns](
+                    IndexType  row_idx,
+                    TRowType  &T_row) mutable
+                {
+                    if (flops[row_idx] > 0)
+                    {
+                        kernel(T_row, op, A_rows.getRow(row_idx), B_rows,
+                               std::min(flops[row_idx], num_cols),
+                               all_columns);
+                    }
+                });
+        }
+
+        //**********************************************************************
+        /// Dot products of A_row with only the columns of B listed in cols;
+        /// B_col is the buffer each column is loaded into.
+        template<typename D3ScalarT,
+                 typename SemiringT,
+                 typename AScalarT,
+                 typename BMatrixT>
+        inline void masked_dot_row(
+            std::vector<std::tuple<IndexType, D3ScalarT> > &T_row,
+            SemiringT                                       op,
+            SparseRow<AScalarT>                      const &A_row,
+            BMatrixT                                 const &B,
+            IndexArrayType                           const &cols,
+            SparseRow<typename BMatrixT::ScalarType>       &B_col)
+        {
+            T_row.clear();
+            for (auto col_idx : cols)
+            {
+                B.getCol(col_idx, B_col);
+                D3ScalarT T_val;
+                if (dot(T_val, A_row, B_col, op))
+                {
+                    T_row.push_back(std::make_tuple(col_idx, T_val));
+                }
+            }
+        }
+
+        //**********************************************************************
+        /// T = A*B computed only where the mask M would keep the result.
+        ///
+        /// A plain mask with cheap column access to B uses masked dot
+        /// products when that is estimated to be cheaper than the
+        /// Gustavson flops; otherwise (and always for a complemented mask)
+        /// the Gustavson kernel skips the columns the mask discards.
+        template<typename D3ScalarT,
+                 typename SemiringT,
+                 typename AMatrixT,
+                 typename BMatrixT,
+                 typename MMatrixT>
+        inline void mxm_compute(LilSparseMatrix<D3ScalarT> &T,
+                                SemiringT                   op,
+                                AMatrixT            const  &A,
+                                BMatrixT            const  &B,
+                                MMatrixT            const  &M)
+        {
+            typedef MaskRowFilter<MMatrixT> FilterType;
+            FilterType filter(M);
+
+            MxmRowAccess<AMatrixT> A_access(A);
+            auto const &A_rows(A_access.rows());
+            typedef std::vector<std::tuple<IndexType, D3ScalarT> > TRowType;
+
+            bool use_dot(false);
+            if (!FilterType::complemented && has_fast_columns(B))
+            {
+                double avg_A_row(double(A.nvals())/double(A.nrows()));
+                double avg_B_row(double(B.nvals())/double(B.nrows()));
+                double avg_B_col(double(B.nvals())/double(B.ncols()));
+                double dot_cost(double(M.nvals())*(avg_A_row + avg_B_col));
+                double gustavson_cost(double(A.nvals())*avg_B_row +
+                                      double(B.nvals()));
+                use_dot = (dot_cost < gustavson_cost);
+            }
+
+            if (use_dot)
+            {
+                // Columns of B (and rows of M) are read concurrently.
+                B.assemble();
+                M.assemble();
+                SparseRow<typename AMatrixT::ScalarType> A_row;
+                SparseRow<typename BMatrixT::ScalarType> B_col;
+                compute_rows(
+                    T, A.nrows(),
+                    [&A_rows, &B, op, filter, A_row, B_col](
+                        IndexType  row_idx,
+                        TRowType  &T_row) mutable
+                    {
+                        A_rows.getRow(row_idx, A_row);
+                        if (!A_row.empty())
+                        {
+                            filter.load(row_idx);
+                            if (!filter.empty())
+                            {
+                                masked_dot_row(T_row, op, A_row, B,
+                                               filter.indices(), B_col);
+                            }
+                        }
+                    });
+                return;
+            }
+
+            MxmRowAccess<BMatrixT> B_access(B);
+            auto const &B_rows(B_access.rows());
+
+            std::vector<IndexType> flops;
+            mxm_symbolic(flops, A_rows, B_rows);
+
+            IndexType num_cols(B.ncols());
+            GustavsonRow<D3ScalarT> kernel(num_cols);
+            M.assemble();
+            compute_rows(
+                T, A.nrows(),
+                [&A_rows, &B_rows, &flops, num_cols, op, filter, kernel](
+                    IndexType  row_idx,
+                    TRowType  &T_row) mutable
+                {
+                    if (flops[row_idx] > 0)
+                    {
+                        filter.load(row_idx);
+                        if (!filter.empty())
+                        {
+                            // A plain mask also bounds the row's entries.
+                            IndexType bound(std::min(flops[row_idx], num_cols));
+                            if (!FilterType::complemented)
+                            {
+                                bound = std::min<IndexType>(
+                                    bound, filter.indices().size());
+                            }
+                            kernel(T_row, op, A_rows.getRow(row_idx), B_rows,
+                                   bound, filter);
+                        }
+                    }
+                });
+        }
+
+        /// Without a mask every entry of A*B is needed.
+        template<typename D3ScalarT,
+                 typename SemiringT,
+                 typename AMatrixT,
+                 typename BMatrixT>
+        inline void mxm_compute(LilSparseMatrix<D3ScalarT> &T,
+                                SemiringT                   op,
+                                AMatrixT            const  &A,
+                                BMatrixT            const  &B,
+                                NoMask              const  &M)
+        {
+            mxm_gustavson(T, op, A, B);
+        }
+
         //**********************************************************************
         /// Implementation of 4.3.1 mxm: Matrix-matrix multiply
         template<typename CMatrixT,
@@ -76,71 +485,30 @@ namespace GraphBLAS
             // Dimension checks happen in front end
             IndexType nrow_A(A.nrows());
             IndexType ncol_B(B.ncols());
-            //Frontend checks the dimensions, but use C explicitly
-            IndexType nrow_C(C.nrows());
-            IndexType ncol_C(C.ncols());
 
             typedef typename SemiringT::result_type D3ScalarType;
-            typedef typename AMatrixT::ScalarType AScalarType;
-            typedef typename BMatrixT::ScalarType BScalarType;
-            typedef typename CMatrixT::ScalarType CScalarType;
-            typedef std::vector<std::tuple<IndexType,CScalarType> > CColType;
-            typedef std::vector<std::tuple<IndexType,D3ScalarType> > TColType;
 
             // =================================================================
-            // Do the basic dot-product work with the semi-ring.
+            // Do the basic work with the semi-ring, one row of T at a time,
+            // skipping entries the mask would discard.
             LilSparseMatrix<D3ScalarType> T(nrow_A, ncol_B);
 
-            // Build this completely based on the semiring
             if ((A.nvals() > 0) && (B.nvals() > 0))
             {
-                // create a column of result at a time
-                TColType T_col;
-                for (IndexType col_idx = 0; col_idx < ncol_B; ++col_idx)
-                {
-                    typename BMatrixT::ColType B_col(B.getCol(col_idx));
-
-                    if (!B_col.empty())
-                    {
-                        for (IndexType row_idx = 0; row_idx < nrow_A; ++row_idx)
-                        {
-                            typename AMatrixT::RowType A_row(A.getRow(row_idx));
-                            if (!A_row.empty())
-                            {
-                                D3ScalarType T_val;
-                                if (dot(T_val, A_row, B_col, op))
-                                {
-                                    T_col.push_back(
-                                            std::make_tuple(row_idx, T_val));
-                                }
-                            }
-                        }
-                        if (!T_col.empty())
-                        {
-                            T.setCol(col_idx, T_col);
-                            T_col.clear();
-                        }
-                    }
-                }
+                mxm_compute(T, op, A, B, M);
             }
 
             GRB_LOG_VERBOSE("T: " << T);
 
             // =================================================================
-            // Accumulate into Z
+            // Accumulate into Z, then copy Z into the output considering mask
+            // and replace
             typedef typename std::conditional<
                 std::is_same<AccumT, NoAccumulate>::value,
                 D3ScalarType,
                 typename AccumT::result_type>::type ZScalarType;
-            LilSparseMatrix<ZScalarType> Z(nrow_C, ncol_C);
-
-            ewise_or_opt_accum(Z, C, T, accum);
 
-            GRB_LOG_VERBOSE("Z: " << Z);
-
-            // =================================================================
-            // Copy Z into the final output considering mask and replace
-            write_with_opt_mask(C, Z, M, replace_flag);
+            opt_accum_with_opt_mask<ZScalarType>(C, M, accum, T, replace_flag);
 
         } // mxm
     } // backend
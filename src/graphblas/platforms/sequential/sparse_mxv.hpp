@@ -41,6 +41,7 @@
 #include <vector>
 #include <iterator>
 #include <iostream>
+#include <type_traits>
 #include <graphblas/algebra.hpp>
 
 #include "sparse_helpers.hpp"
@@ -52,6 +53,204 @@ namespace GraphBLAS
 {
     namespace backend
     {
+        //********************************************************************
+        /// Dot product of every row of A allowed by the mask with u
+        /// (generic row access), probing u through its bitmap: O(row length)
+        /// per row.  A sparse form u is instead intersected through its list
+        /// (see intersect_sorted), which does not fill its O(size) bitmap
+        /// cache.  A row stops early once the sum reaches the terminal value
+        /// of the semiring's addition, if it has one.
+        template<typename D3ScalarT,
+                 typename SemiringT,
+                 typename AMatrixT,
+                 typename UVectorT,
+                 typename FilterT>
+        inline void mxv_dot_rows(
+            std::vector<std::tuple<IndexType, D3ScalarT> > &t,
+            SemiringT                                       op,
+            AMatrixT                                 const &A,
+            UVectorT                                 const &u,
+            FilterT                                  const &filter,
+            std::false_type)
+        {
+            typedef typename AMatrixT::ScalarType AScalarType;
+            typedef std::vector<std::tuple<IndexType,AScalarType> >  ARowType;
+
+            TerminalTest<SemiringT> terminal(op);
+            A.assemble();
+
+            if (u.isSparseForm())
+            {
+                auto const &u_idx(u.get_indices());
+                auto const &u_vals(u.get_list_vals());
+                SparseRow<AScalarType> A_row;
+                compute_entries(
+                    t, A.nrows(),
+                    [&A, &u_idx, &u_vals, &filter, op, terminal, A_row](
+                        IndexType  row_idx,
+                        D3ScalarT &t_val) mutable
+                    {
+                        if (!filter.allowed(row_idx))
+                        {
+                            return false;
+                        }
+
+                        A.getRow(row_idx, A_row);
+
+                        bool value_set(false);
+                        t_val = op.zero();
+                        intersect_sorted(
+                            A_row.indices().data(), A_row.size(),
+                            u_idx.data(), u_idx.size(),
+                            [&](std::size_t ka, std::size_t ku)
+                            {
+                                t_val = op.add(t_val,
+                                               semiring_mult(op,
+                                                             A_row.values()[ka],
+                                                             u_vals[ku]));
+                                value_set = true;
+                                return !terminal.reached(t_val);
+                            });
+                        return value_set;
+                    });
+                return;
+            }
+
+            auto const &u_bitmap(u.get_bitmap());
+            auto const &u_vals(u.get_vals());
+
+            compute_entries(
+                t, A.nrows(),
+                [&A, &u_bitmap, &u_vals, &filter, op, terminal](
+                    IndexType  row_idx,
+                    D3ScalarT &t_val) mutable
+                {
+                    if (!filter.allowed(row_idx))
+                    {
+                        return false;
+                    }
+
+                    ARowType const &A_row(A.getRow(row_idx));
+
+                    bool value_set(false);
+                    t_val = op.zero();
+                    for (auto const &a_elt : A_row)
+                    {
+                        IndexType u_idx(std::get<0>(a_elt));
+                        if (u_bitmap[u_idx])
+                        {
+                            t_val = op.add(t_val,
+                                           semiring_mult(op,
+                                                         std::get<1>(a_elt),
+                                                         u_vals[u_idx]));
+                            value_set = true;
+                            if (terminal.reached(t_val))
+                            {
+                                break;
+                            }
+                        }
+                    }
+                    return value_set;
+                });
+        }
+
+        //********************************************************************
+        /// Dot product of every row of A allowed by the mask with u,
+        /// walking the CSR arrays directly and probing u through its bitmap:
+        /// O(nvals(A)) overall.  A sparse form u is intersected through its
+        /// list instead.
+        template<typename D3ScalarT,
+                 typename SemiringT,
+                 typename AMatrixT,
+                 typename UVectorT,
+                 typename FilterT>
+        inline void mxv_dot_rows(
+            std::vector<std::tuple<IndexType, D3ScalarT> > &t,
+            SemiringT                                       op,
+            AMatrixT                                 const &A,
+            UVectorT                                 const &u,
+            FilterT                                  const &filter,
+            std::true_type)
+        {
+            auto const &row_ptr(A.get_row_ptr());
+            auto const &col_idx(A.get_col_idx());
+            auto const &A_vals(A.get_vals());
+
+            TerminalTest<SemiringT> terminal(op);
+
+            if (u.isSparseForm())
+            {
+                auto const &u_idx(u.get_indices());
+                auto const &u_vals(u.get_list_vals());
+                compute_entries(
+                    t, A.nrows(),
+                    [&row_ptr, &col_idx, &A_vals, &u_idx, &u_vals, &filter, op,
+                     terminal]
+                    (IndexType row_idx, D3ScalarT &t_val) mutable
+                    {
+                        if (!filter.allowed(row_idx))
+                        {
+                            return false;
+                        }
+
+                        IndexType row_start(row_ptr[row_idx]);
+                        bool value_set(false);
+                        t_val = op.zero();
+                        intersect_sorted(
+                            col_idx.data() + row_start,
+                            row_ptr[row_idx + 1] - row_start,
+                            u_idx.data(), u_idx.size(),
+                            [&](std::size_t ka, std::size_t ku)
+                            {
+                                t_val = op.add(t_val,
+                                               semiring_mult(op,
+                                                             A_vals[row_start + ka],
+                                                             u_vals[ku]));
+                                value_set = true;
+                                return !terminal.reached(t_val);
+                            });
+                        return value_set;
+                    });
+                return;
+            }
+
+            auto const &u_bitmap(u.get_bitmap());
+            auto const &u_vals(u.get_vals());
+
+            compute_entries(
+                t, A.nrows(),
+                [&row_ptr, &col_idx, &A_vals, &u_bitmap, &u_vals, &filter, op,
+                 terminal]
+                (IndexType row_idx, D3ScalarT &t_val) mutable
+                {
+                    if (!filter.allowed(row_idx))
+                    {
+                        return false;
+                    }
+
+                    bool value_set(false);
+                    t_val = op.zero();
+
+                    for (IndexType ix = row_ptr[row_idx];
+                         ix < row_ptr[row_idx + 1]; ++ix)
+                    {
+                        IndexType u_idx(col_idx[ix]);
+                        if (u_bitmap[u_idx])
+                        {
+                            t_val = op.add(t_val,
+                                           semiring_mult(op, A_vals[ix],
+                                                         u_vals[u_idx]));
+                            value_set = true;
+                            if (terminal.reached(t_val))
+                            {
+                                break;
+                            }
+                        }
+                    }
+                    return value_set;
+                });
+        }
+
         //********************************************************************
         /// Implementation of 4.3.3 mxv: Matrix-Vector variant
         template<typename WVectorT,
@@ -69,42 +268,26 @@ namespace GraphBLAS
                         bool             replace_flag = false)
         {
             // =================================================================
-            // Do the basic dot-product work with the semi-ring.
+            // Do the basic dot-product work with the semi-ring, only for the
+            // rows the mask would keep.
             typedef typename SemiringT::result_type D3ScalarType;
-            typedef typename AMatrixT::ScalarType AScalarType;
-            typedef std::vector<std::tuple<IndexType,AScalarType> >  ARowType;
 
             std::vector<std::tuple<IndexType, D3ScalarType> > t;
 
             if ((A.nvals() > 0) && (u.nvals() > 0))
             {
-                auto u_contents(u.getContents());
-                for (IndexType row_idx = 0; row_idx < w.size(); ++row_idx)
-                {
-                    ARowType const &A_row(A.getRow(row_idx));
-
-                    if (!A_row.empty())
-                    {
-                        D3ScalarType t_val;
-                        if (dot(t_val, A_row, u_contents, op))
-                        {
-                            t.push_back(std::make_tuple(row_idx, t_val));
-                        }
-                    }
-                }
+                VectorMaskFilter<MaskT> filter(mask);
+                mxv_dot_rows(t, op, A, u, filter, is_csr_matrix<AMatrixT>());
             }
 
             // =================================================================
-            // Accumulate into Z
+            // Accumulate into Z, then copy Z into the output considering mask
+            // and replace
             typedef typename std::conditional<std::is_same<AccumT, NoAccumulate>::value,
                                               D3ScalarType,
                                               typename AccumT::result_type>::type ZScalarType;
-            std::vector<std::tuple<IndexType, ZScalarType> > z;
-            ewise_or_opt_accum_1D(z, w, t, accum);
-
-            // =================================================================
-            // Copy Z into the final output, w, considering mask and replace
-            write_with_opt_mask_1D(w, z, mask, replace_flag);
+            opt_accum_with_opt_mask_1D<ZScalarType>(w, mask, accum, t,
+                                                    replace_flag);
         }
 
     } // backend
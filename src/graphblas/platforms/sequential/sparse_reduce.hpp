@@ -41,6 +41,7 @@
 #include <vector>
 #include <iterator>
 #include <iostream>
+#include <type_traits>
 #include <graphblas/algebra.hpp>
 
 #include "sparse_helpers.hpp"
@@ -51,6 +52,72 @@ namespace GraphBLAS
 {
     namespace backend
     {
+        //********************************************************************
+        /// Reduce every row of A with op (generic row access).
+        template<typename D3ScalarT,
+                 typename BinaryOpT,
+                 typename AMatrixT>
+        inline void reduce_rows(
+            std::vector<std::tuple<IndexType, D3ScalarT> > &t,
+            BinaryOpT                                       op,
+            AMatrixT                                 const &A,
+            std::false_type)
+        {
+            typedef typename AMatrixT::ScalarType AScalarType;
+            typedef std::vector<std::tuple<IndexType,AScalarType> >  ARowType;
+
+            A.assemble();
+            compute_entries(
+                t, A.nrows(),
+                [&A, op](IndexType row_idx, D3ScalarT &t_val) mutable
+                {
+                    /// @todo Can't be a reference because A might be transpose
+                    /// view.  Need to specialize on TransposeView and getCol()
+                    ARowType const A_row(A.getRow(row_idx));
+
+                    /// @todo There is something hinky with domains here.  How
+                    /// does one perform the reduction in A domain but produce
+                    /// partial results in D3(op)?
+                    return reduction(t_val, A_row, op);
+                });
+        }
+
+        //********************************************************************
+        /// Reduce every row of A with op, walking the CSR arrays directly.
+        template<typename D3ScalarT,
+                 typename BinaryOpT,
+                 typename AMatrixT>
+        inline void reduce_rows(
+            std::vector<std::tuple<IndexType, D3ScalarT> > &t,
+            BinaryOpT                                       op,
+            AMatrixT                                 const &A,
+            std::true_type)
+        {
+            auto const &row_ptr(A.get_row_ptr());
+            auto const &A_vals(A.get_vals());
+
+            TerminalTest<BinaryOpT> terminal(op);
+            compute_entries(
+                t, A.nrows(),
+                [&row_ptr, &A_vals, op, terminal](IndexType  row_idx,
+                                                  D3ScalarT &t_val) mutable
+                {
+                    IndexType ix(row_ptr[row_idx]);
+                    if (ix == row_ptr[row_idx + 1])
+                    {
+                        return false;
+                    }
+
+                    t_val = static_cast<D3ScalarT>(A_vals[ix]);
+                    for (++ix; (ix < row_ptr[row_idx + 1]) &&
+                               !terminal.reached(t_val); ++ix)
+                    {
+                        t_val = op(t_val, A_vals[ix]);
+                    }
+                    return true;
+                });
+        }
+
         //********************************************************************
         /// Implementation of 4.3.9.1 reduce: Standard Matrix to Vector variant
         template<typename WVectorT,
@@ -68,43 +135,24 @@ namespace GraphBLAS
             // =================================================================
             // Do the basic reduction work with the binary op
             typedef typename BinaryOpT::result_type D3ScalarType;
-            typedef typename AMatrixT::ScalarType AScalarType;
-            typedef std::vector<std::tuple<IndexType,AScalarType> >  ARowType;
 
             std::vector<std::tuple<IndexType, D3ScalarType> > t;
 
             if (A.nvals() > 0)
             {
-                for (IndexType row_idx = 0; row_idx < A.nrows(); ++row_idx)
-                {
-                    /// @todo Can't be a reference because A might be transpose
-                    /// view.  Need to specialize on TransposeView and getCol()
-                    ARowType const A_row(A.getRow(row_idx));
-
-                    /// @todo There is something hinky with domains here.  How
-                    /// does one perform the reduction in A domain but produce
-                    /// partial results in D3(op)?
-                    D3ScalarType t_val;
-                    if (reduction(t_val, A_row, op))
-                    {
-                        t.push_back(std::make_tuple(row_idx, t_val));
-                    }
-                }
+                reduce_rows(t, op, A, is_csr_matrix<AMatrixT>());
             }
 
             // =================================================================
-            // Accumulate into Z
+            // Accumulate into Z, then copy Z into the output considering mask
+            // and replace
             // Type generator for z: D3(accum), or D(w) if no accum.
             typedef typename std::conditional<
                 std::is_same<AccumT, NoAccumulate>::value,
                 D3ScalarType,
                 typename AccumT::result_type>::type  ZScalarType;
-            std::vector<std::tuple<IndexType, ZScalarType> > z;
-            ewise_or_opt_accum_1D(z, w, t, accum);
-
-            // =================================================================
-            // Copy Z into the final output, w, considering mask and replace
-            write_with_opt_mask_1D(w, z, mask, replace_flag);
+            opt_accum_with_opt_mask_1D<ZScalarType>(w, mask, accum, t,
+                                                    replace_flag);
         }
 
         //********************************************************************
@@ -134,7 +182,8 @@ namespace GraphBLAS
             }
 
             // =================================================================
-            // Accumulate into Z
+            // Accumulate into Z, then copy Z into the output considering mask
+            // and replace
             /// @todo Do we need a type generator for z: D(w) if no accum,
             /// or D3(accum). I think that D(z) := D(val) should be equivalent, but
             /// still need to work the proof.
@@ -145,6 +194,63 @@ namespace GraphBLAS
             val = z;
         }
 
+        //********************************************************************
+        /// Reduce all stored values of A into t (generic row access).
+        template<typename D3ScalarT,
+                 typename MonoidT,
+                 typename AMatrixT>
+        inline void reduce_all(D3ScalarT       &t,
+                               MonoidT          op,
+                               AMatrixT  const &A,
+                               std::false_type)
+        {
+            typedef typename AMatrixT::ScalarType AScalarType;
+            typedef std::vector<std::tuple<IndexType,AScalarType> >  ARowType;
+
+            TerminalTest<MonoidT> terminal(op);
+            for (IndexType row_idx = 0; row_idx < A.nrows(); ++row_idx)
+            {
+                /// @todo Can't be a reference because A might be transpose
+                /// view.  Need to specialize on TransposeView and getCol()
+                ARowType const A_row(A.getRow(row_idx));
+
+                /// @todo There is something hinky with domains here.  How
+                /// does one perform the reduction in A domain but produce
+                /// partial results in D3(op)?
+                D3ScalarT tmp;
+                if (reduction(tmp, A_row, op))
+                {
+                    t = op(t, tmp); // reduce each row
+                    if (terminal.reached(t))
+                    {
+                        break;
+                    }
+                }
+            }
+        }
+
+        //********************************************************************
+        /// Reduce all stored values of A into t with one pass over the CSR
+        /// value array.
+        template<typename D3ScalarT,
+                 typename MonoidT,
+                 typename AMatrixT>
+        inline void reduce_all(D3ScalarT       &t,
+                               MonoidT          op,
+                               AMatrixT  const &A,
+                               std::true_type)
+        {
+            TerminalTest<MonoidT> terminal(op);
+            for (auto const &a_val : A.get_vals())
+            {
+                t = op(t, static_cast<D3ScalarT>(a_val));
+                if (terminal.reached(t))
+                {
+                    break;
+                }
+            }
+        }
+
         //********************************************************************
         /// Implementation of 4.3.9.3 reduce: Matrix to scalar variant
         template<typename ValueT,
@@ -159,32 +265,17 @@ namespace GraphBLAS
             // =================================================================
             // Do the basic reduction work with the monoid
             typedef typename MonoidT::result_type D3ScalarType;
-            typedef typename AMatrixT::ScalarType AScalarType;
-            typedef std::vector<std::tuple<IndexType,AScalarType> >  ARowType;
 
             D3ScalarType t = op.identity();
 
             if (A.nvals() > 0)
             {
-                for (IndexType row_idx = 0; row_idx < A.nrows(); ++row_idx)
-                {
-                    /// @todo Can't be a reference because A might be transpose
-                    /// view.  Need to specialize on TransposeView and getCol()
-                    ARowType const A_row(A.getRow(row_idx));
-
-                    /// @todo There is something hinky with domains here.  How
-                    /// does one perform the reduction in A domain but produce
-                    /// partial results in D3(op)?
-                    D3ScalarType tmp;
-                    if (reduction(tmp, A_row, op))
-                    {
-                        t = op(t, tmp); // reduce each row
-                    }
-                }
+                reduce_all(t, op, A, is_csr_matrix<AMatrixT>());
             }
 
             // =================================================================
-            // Accumulate into Z
+            // Accumulate into Z, then copy Z into the output considering mask
+            // and replace
             /// @todo Do we need a type generator for z: D(w) if no accum,
             /// or D3(accum). I think that D(z) := D(val) should be equivalent, but
             /// still need to work the proof.
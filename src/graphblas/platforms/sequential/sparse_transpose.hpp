@@ -47,6 +47,7 @@
 
 #include "sparse_helpers.hpp"
 #include "LilSparseMatrix.hpp"
+#include "ColumnIndex.hpp"
 
 //******************************************************************************
 
@@ -79,40 +80,34 @@ namespace GraphBLAS
             // Apply the unary operator from A into T.
             // This is really the guts of what makes this special.
 
+            // Rows of T are the columns of A: bucket A by column once
+            // (O(nvals)), then copy the columns out row by row.
             /// @todo Do something different if A is TransposeView
+            ColumnIndex<AScalarType> A_cols;
+            A_cols.enable();
+            A_cols.update(A);
+
+            typedef std::vector<std::tuple<IndexType,AScalarType> > TRowType;
             LilSparseMatrix<AScalarType> T(ncols, nrows);
-            for (IndexType ridx = A.nrows(); ridx > 0; --ridx)
-            {
-                IndexType row_idx = ridx - 1;
-                auto a_row = A.getRow(row_idx);
-                for (auto elt = a_row.begin(); elt != a_row.end(); ++elt)
+            compute_rows(
+                T, ncols,
+                [&A_cols](IndexType row_idx, TRowType &t_row)
                 {
-                    T.setElement(std::get<0>(*elt), row_idx, std::get<1>(*elt));
-
-                    /// @todo Would be nice to push_back on each row directly
-                    //IndexType idx = std::get<0>(elt);
-                    //T.getRow(idx).push_back(
-                    //    std::make_tuple(row_idx, std::get<1>(elt)));
-                }
-            }
+                    t_row = A_cols.getCol(row_idx);
+                });
 
             GRB_LOG_VERBOSE("T: " << T);
 
             // =================================================================
-            // Accumulate T via C into Z
+            // Accumulate T via C into Z, then copy Z into the output considering mask
+            // and replace
             typedef typename std::conditional<
                 std::is_same<AccumT, NoAccumulate>::value,
                 AScalarType,
                 typename AccumT::result_type>::type  ZScalarType;
 
-            LilSparseMatrix<ZScalarType> Z(ncols, nrows);
-            ewise_or_opt_accum(Z, C, T, accum);
-
-            GRB_LOG_VERBOSE("Z: " << Z);
-
-            // =================================================================
-            // Copy Z into the final output considering mask and replace
-            write_with_opt_mask(C, Z, mask, replace_flag);
+            opt_accum_with_opt_mask<ZScalarType>(C, mask, accum, T,
+                                                 replace_flag);
         }
     }
 }
@@ -52,8 +52,148 @@ namespace GraphBLAS
 {
     namespace backend
     {
+        //********************************************************************
+        /// Push (saxpy) product t = u*A: scatter u(k)*A(k,:) into a sparse
+        /// accumulator for every stored u(k), skipping the columns the mask
+        /// discards.  Costs the total length of the rows of A selected by u.
+        template<typename D3ScalarT,
+                 typename SemiringT,
+                 typename UVectorT,
+                 typename AMatrixT,
+                 typename FilterT>
+        inline void vxm_push(
+            std::vector<std::tuple<IndexType, D3ScalarT> > &t,
+            SemiringT                                       op,
+            UVectorT                                 const &u,
+            AMatrixT                                 const &A,
+            FilterT                                  const &filter)
+        {
+            auto add_op = [&op](D3ScalarT const &lhs, D3ScalarT const &rhs)
+                { return op.add(lhs, rhs); };
+
+            SparseAccumulator<D3ScalarT> spa(A.ncols());
+            for (auto const &u_elt : u.getContents())
+            {
+                auto const &A_row(A.getRow(std::get<0>(u_elt)));
+                for (auto const &a_elt : A_row)
+                {
+                    if (filter.allowed(std::get<0>(a_elt)))
+                    {
+                        spa.accumulate(std::get<0>(a_elt),
+                                       semiring_mult(op,
+                                                     std::get<1>(u_elt),
+                                                     std::get<1>(a_elt)),
+                                       add_op);
+                    }
+                }
+            }
+            spa.gather(t);
+        }
+
+        //********************************************************************
+        /// Pull (dot) product t = u*A: for every column allowed by the mask,
+        /// scan A(:,j) and probe u through its bitmap.  Costs O(column
+        /// length) per column with a column index (ColumnIndexTag) or a
+        /// transposed A.  A sparse form u is intersected through its list
+        /// instead, without filling its O(size) bitmap cache.
+        template<typename D3ScalarT,
+                 typename SemiringT,
+                 typename UVectorT,
+                 typename AMatrixT,
+                 typename FilterT>
+        inline void vxm_pull(
+            std::vector<std::tuple<IndexType, D3ScalarT> > &t,
+            SemiringT                                       op,
+            UVectorT                                 const &u,
+            AMatrixT                                 const &A,
+            FilterT                                  const &filter)
+        {
+            typedef typename AMatrixT::ScalarType AScalarType;
+
+            SparseRow<AScalarType> A_col;
+            TerminalTest<SemiringT> terminal(op);
+            A.assemble();
+
+            if (u.isSparseForm())
+            {
+                auto const &u_idx(u.get_indices());
+                auto const &u_vals(u.get_list_vals());
+                compute_entries(
+                    t, A.ncols(),
+                    [&A, &u_idx, &u_vals, &filter, op, A_col, terminal](
+                        IndexType  col_idx,
+                        D3ScalarT &t_val) mutable
+                    {
+                        if (!filter.allowed(col_idx))
+                        {
+                            return false;
+                        }
+
+                        A.getCol(col_idx, A_col);
+
+                        bool value_set(false);
+                        t_val = op.zero();
+                        intersect_sorted(
+                            u_idx.data(), u_idx.size(),
+                            A_col.indices().data(), A_col.size(),
+                            [&](std::size_t ku, std::size_t ka)
+                            {
+                                t_val = op.add(t_val,
+                                               semiring_mult(op, u_vals[ku],
+                                                             A_col.values()[ka]));
+                                value_set = true;
+                                return !terminal.reached(t_val);
+                            });
+                        return value_set;
+                    });
+                return;
+            }
+
+            auto const &u_bitmap(u.get_bitmap());
+            auto const &u_vals(u.get_vals());
+
+            compute_entries(
+                t, A.ncols(),
+                [&A, &u_bitmap, &u_vals, &filter, op, A_col, terminal](
+                    IndexType  col_idx,
+                    D3ScalarT &t_val) mutable
+                {
+                    if (!filter.allowed(col_idx))
+                    {
+                        return false;
+                    }
+
+                    A.getCol(col_idx, A_col);
+                    IndexType const *a_idx(A_col.indices().data());
+
+                    bool value_set(false);
+                    t_val = op.zero();
+                    for (std::size_t k = 0; k < A_col.size(); ++k)
+                    {
+                        IndexType u_idx(a_idx[k]);
+                        if (u_bitmap[u_idx])
+                        {
+                            t_val = op.add(t_val,
+                                           semiring_mult(op, u_vals[u_idx],
+                                                         A_col.values()[k]));
+                            value_set = true;
+                            if (terminal.reached(t_val))
+                            {
+                                break;
+                            }
+                        }
+                    }
+                    return value_set;
+                });
+        }
+
         //********************************************************************
         /// Implementation of 4.3.2 vxm: Vector-Matrix multiply
+        ///
+        /// Pulls only when A has cheap column access and u is dense enough
+        /// that pushing (nvals(u) times the average row length multiplies)
+        /// would cost as much as scanning every column; otherwise pushes
+        /// from the stored entries of u.
         template<typename WVectorT,
                  typename MaskT,
                  typename AccumT,
@@ -69,43 +209,38 @@ namespace GraphBLAS
                         bool             replace_flag = false)
         {
             // =================================================================
-            // Do the basic dot-product work with the semi-ring.
+            // Do the basic work with the semi-ring, skipping the columns the
+            // mask would discard.
             typedef typename SemiringT::result_type D3ScalarType;
-            typedef typename AMatrixT::ScalarType AScalarType;
-            typedef std::vector<std::tuple<IndexType,AScalarType> > AColType;
 
             std::vector<std::tuple<IndexType, D3ScalarType> > t;
 
             if ((A.nvals() > 0) && (u.nvals() > 0))
             {
-                auto u_contents(u.getContents());
-                for (IndexType col_idx = 0; col_idx < w.size(); ++col_idx)
-                {
-                    AColType const &A_col(A.getCol(col_idx));
+                VectorMaskFilter<MaskT> filter(mask);
 
-                    if (!A_col.empty())
-                    {
-                        D3ScalarType t_val;
-                        if (dot(t_val, u_contents, A_col, op))
-                        {
-                            t.push_back(std::make_tuple(col_idx, t_val));
-                        }
-                    }
+                double push_cost(double(u.nvals())*double(A.nvals())/
+                                 double(A.nrows()));
+                if (has_fast_rows(A) &&
+                    (!has_fast_columns(A) || (push_cost < double(A.nvals()))))
+                {
+                    vxm_push(t, op, u, A, filter);
+                }
+                else
+                {
+                    vxm_pull(t, op, u, A, filter);
                 }
             }
 
             // =================================================================
-            // Accumulate into Z
+            // Accumulate into Z, then copy Z into the output considering mask
+            // and replace
             /// @todo Do we need a type generator for z: D(w) if no accum,
             /// or D3(accum). I think that output type should be equivalent, but
             /// still need to work the proof.
             typedef typename WVectorT::ScalarType WScalarType;
-            std::vector<std::tuple<IndexType, WScalarType> > z;
-            ewise_or_opt_accum_1D(z, w, t, accum);
-
-            // =================================================================
-            // Copy Z into the final output, w, considering mask and replace
-            write_with_opt_mask_1D(w, z, mask, replace_flag);
+            opt_accum_with_opt_mask_1D<WScalarType>(w, mask, accum, t,
+                                                    replace_flag);
         }
 
     } // backend
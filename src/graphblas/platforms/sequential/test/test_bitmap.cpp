@@ -0,0 +1,130 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+#include <iostream>
+
+#include <graphblas/graphblas.hpp>
+
+using namespace GraphBLAS;
+
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_MODULE bitmap_test_suite
+
+#include <boost/test/included/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(BOOST_TEST_MODULE)
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(bitmap_test_construction)
+{
+    backend::Bitmap b1(130);
+    BOOST_CHECK_EQUAL(b1.size(), 130);
+    BOOST_CHECK_EQUAL(b1.nwords(), 3);
+    BOOST_CHECK_EQUAL(b1.count(), 0);
+
+    // the bits past the size stay clear
+    backend::Bitmap b2(130, true);
+    BOOST_CHECK_EQUAL(b2.count(), 130);
+    BOOST_CHECK_EQUAL(b2.word(2), 3ULL);
+
+    b2.clear();
+    BOOST_CHECK_EQUAL(b2.size(), 130);
+    BOOST_CHECK_EQUAL(b2.count(), 0);
+    BOOST_CHECK(b1 == b2);
+
+    b2.set_word(2, ~0ULL);
+    BOOST_CHECK_EQUAL(b2.count(), 2);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(bitmap_test_set_reset)
+{
+    backend::Bitmap b(200);
+    IndexArrayType bits = {0, 1, 63, 64, 127, 150, 199};
+    for (auto idx : bits)
+    {
+        b.set(idx);
+    }
+    BOOST_CHECK_EQUAL(b.count(), bits.size());
+    for (IndexType idx = 0; idx < b.size(); ++idx)
+    {
+        bool expected(std::find(bits.begin(), bits.end(), idx) != bits.end());
+        BOOST_CHECK_EQUAL(b[idx], expected);
+    }
+
+    b.set(63);
+    BOOST_CHECK_EQUAL(b.count(), bits.size());
+    b.reset(63);
+    b.reset(62);
+    BOOST_CHECK(!b[63]);
+    BOOST_CHECK_EQUAL(b.count(), bits.size() - 1);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(bitmap_test_iteration)
+{
+    backend::Bitmap b(300);
+    IndexArrayType bits = {3, 64, 65, 128, 255, 256, 299};
+    for (auto idx : bits)
+    {
+        b.set(idx);
+    }
+
+    IndexArrayType visited;
+    b.for_each([&visited](IndexType idx) { visited.push_back(idx); });
+    BOOST_CHECK_EQUAL_COLLECTIONS(visited.begin(), visited.end(),
+                                  bits.begin(), bits.end());
+
+    IndexArrayType found;
+    for (IndexType idx = b.find_next(0); idx < b.size();
+         idx = b.find_next(idx + 1))
+    {
+        found.push_back(idx);
+    }
+    BOOST_CHECK_EQUAL_COLLECTIONS(found.begin(), found.end(),
+                                  bits.begin(), bits.end());
+
+    BOOST_CHECK_EQUAL(b.find_next(66), 128);
+    BOOST_CHECK_EQUAL(b.find_next(300), 300);
+    b.reset(299);
+    BOOST_CHECK_EQUAL(b.find_next(257), 300);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(bitmap_test_word_helpers)
+{
+    BOOST_CHECK_EQUAL(backend::popcount_word(0ULL), 0);
+    BOOST_CHECK_EQUAL(backend::popcount_word(~0ULL), 64);
+    BOOST_CHECK_EQUAL(backend::popcount_word(0x8000000000000101ULL), 3);
+    BOOST_CHECK_EQUAL(backend::ctz_word(1ULL), 0);
+    BOOST_CHECK_EQUAL(backend::ctz_word(0x8000000000000000ULL), 63);
+    BOOST_CHECK_EQUAL(backend::ctz_word(0x100ULL), 8);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
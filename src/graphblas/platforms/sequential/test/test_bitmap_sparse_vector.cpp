@@ -176,6 +176,414 @@ BOOST_AUTO_TEST_CASE(test_assignment)
     BOOST_CHECK_EQUAL(v1, v2);
 }
 
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_move_and_swap)
+{
+    std::vector<IndexType> indices = {0, 3, 4, 6, 7};
+    std::vector<double>    values  = {6 ,4, 7, 9, 4};
+
+    GraphBLAS::backend::BitmapSparseVector<double> ans(8, indices, values);
+    GraphBLAS::backend::BitmapSparseVector<double> v1(8, indices, values);
+
+    GraphBLAS::backend::BitmapSparseVector<double> v2(std::move(v1));
+    BOOST_CHECK_EQUAL(v2, ans);
+    BOOST_CHECK_EQUAL(v1.size(), 0);
+    BOOST_CHECK_EQUAL(v1.nvals(), 0);
+
+    GraphBLAS::backend::BitmapSparseVector<double> v3(3);
+    v3.setElement(1, 2.0);
+    v3 = std::move(v2);
+    BOOST_CHECK_EQUAL(v3, ans);
+    BOOST_CHECK_EQUAL(v2.size(), 0);
+    BOOST_CHECK_EQUAL(v2.nvals(), 0);
+
+    GraphBLAS::backend::BitmapSparseVector<double> v4(3);
+    v4.setElement(1, 2.0);
+    v3.swap(v4);
+    BOOST_CHECK_EQUAL(v4, ans);
+    BOOST_CHECK_EQUAL(v3.size(), 3);
+    BOOST_CHECK_EQUAL(v3.extractElement(1), 2.0);
+}
+
+//****************************************************************************
+namespace
+{
+    // 300 elements: words 0 and 1 full, word 2 half full, word 3 (the
+    // partial tail) sparse; every third element is left out of v.
+    template <typename ScalarT>
+    void build_word_operands(GraphBLAS::backend::BitmapSparseVector<ScalarT> &u,
+                             GraphBLAS::backend::BitmapSparseVector<ScalarT> &v)
+    {
+        for (IndexType idx = 0; idx < u.size(); ++idx)
+        {
+            if ((idx < 160) || ((idx < 256) && (idx % 2 == 0)) ||
+                (idx % 7 == 0))
+            {
+                u.setElement(idx, static_cast<ScalarT>(idx % 11) + 0.5);
+            }
+            if ((idx < 128) || (idx % 3 != 0))
+            {
+                v.setElement(idx, static_cast<ScalarT>(idx % 5) - 2.25);
+            }
+        }
+    }
+
+    template <typename ScalarT, typename BinaryOpT>
+    void check_ewise(GraphBLAS::backend::BitmapSparseVector<ScalarT> const &u,
+                     GraphBLAS::backend::BitmapSparseVector<ScalarT> const &v,
+                     BinaryOpT op)
+    {
+        GraphBLAS::backend::BitmapSparseVector<ScalarT> w_or(u.size());
+        GraphBLAS::backend::BitmapSparseVector<ScalarT> w_and(u.size());
+        w_or.ewise_or(u, v, op);
+        w_and.ewise_and(u, v, op);
+
+        IndexType or_nvals(0), and_nvals(0);
+        for (IndexType idx = 0; idx < u.size(); ++idx)
+        {
+            bool in_u(u.hasElement(idx)), in_v(v.hasElement(idx));
+            BOOST_CHECK_EQUAL(w_or.hasElement(idx), in_u || in_v);
+            BOOST_CHECK_EQUAL(w_and.hasElement(idx), in_u && in_v);
+            if (in_u && in_v)
+            {
+                ScalarT ans(op(u.extractElement(idx), v.extractElement(idx)));
+                BOOST_CHECK_EQUAL(w_or.extractElement(idx), ans);
+                BOOST_CHECK_EQUAL(w_and.extractElement(idx), ans);
+                ++and_nvals;
+            }
+            else if (in_u)
+            {
+                BOOST_CHECK_EQUAL(w_or.extractElement(idx),
+                                  u.extractElement(idx));
+            }
+            else if (in_v)
+            {
+                BOOST_CHECK_EQUAL(w_or.extractElement(idx),
+                                  v.extractElement(idx));
+            }
+            if (in_u || in_v) ++or_nvals;
+        }
+        BOOST_CHECK_EQUAL(w_or.nvals(), or_nvals);
+        BOOST_CHECK_EQUAL(w_and.nvals(), and_nvals);
+    }
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_ewise_by_words)
+{
+    GraphBLAS::backend::BitmapSparseVector<double> u(300), v(300);
+    build_word_operands(u, v);
+    check_ewise(u, v, GraphBLAS::Plus<double>());
+    check_ewise(u, v, GraphBLAS::Minus<double>());
+    check_ewise(u, v, GraphBLAS::Times<double>());
+    check_ewise(u, v, GraphBLAS::Div<double>());
+    check_ewise(u, v, GraphBLAS::Min<double>());
+    check_ewise(u, v, GraphBLAS::Max<double>());
+    check_ewise(u, v, GraphBLAS::Second<double>());
+
+    GraphBLAS::backend::BitmapSparseVector<float> uf(300), vf(300);
+    build_word_operands(uf, vf);
+    check_ewise(uf, vf, GraphBLAS::Plus<float>());
+    check_ewise(uf, vf, GraphBLAS::Max<float>());
+
+    // accumulate into an operand
+    GraphBLAS::backend::BitmapSparseVector<double> w(v);
+    w.ewise_or(w, u, GraphBLAS::Plus<double>());
+    GraphBLAS::backend::BitmapSparseVector<double> ans(300);
+    ans.ewise_or(v, u, GraphBLAS::Plus<double>());
+    BOOST_CHECK_EQUAL(w, ans);
+
+    GraphBLAS::backend::BitmapSparseVector<double> small(299);
+    BOOST_CHECK_THROW(w.ewise_and(u, small, GraphBLAS::Plus<double>()),
+                      DimensionException);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_apply_by_words)
+{
+    GraphBLAS::backend::BitmapSparseVector<double> u(300), v(300);
+    build_word_operands(u, v);
+
+    GraphBLAS::BinaryOp_Bind2nd<double, GraphBLAS::Times<double> > scale(0.5);
+    GraphBLAS::backend::BitmapSparseVector<double> w(300);
+    w.setElement(299, 4.0);  // not stored in u: must be dropped
+    w.apply(u, scale);
+    BOOST_CHECK_EQUAL(w.nvals(), u.nvals());
+
+    GraphBLAS::backend::BitmapSparseVector<double> copy(300);
+    copy.apply(u, GraphBLAS::Identity<double>());
+    BOOST_CHECK_EQUAL(copy, u);
+
+    GraphBLAS::backend::BitmapSparseVector<int> as_int(300);
+    as_int.apply(u, GraphBLAS::Identity<double, int>());
+    BOOST_CHECK_EQUAL(as_int.nvals(), u.nvals());
+
+    for (IndexType idx = 0; idx < u.size(); ++idx)
+    {
+        BOOST_CHECK_EQUAL(w.hasElement(idx), u.hasElement(idx));
+        if (u.hasElement(idx))
+        {
+            BOOST_CHECK_EQUAL(w.extractElement(idx),
+                              u.extractElement(idx) * 0.5);
+            BOOST_CHECK_EQUAL(as_int.extractElement(idx),
+                              static_cast<int>(u.extractElement(idx)));
+        }
+    }
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_form_switching)
+{
+    using GraphBLAS::backend::BitmapSparseVector;
+    IndexType const N(1000);  // sparse up to 31 stored, back below 15
+
+    BitmapSparseVector<double> v(N);
+    BOOST_CHECK_EQUAL(v.form(), GraphBLAS::backend::SPARSE_FORM);
+
+    for (IndexType idx = 0; idx < 31; ++idx)
+    {
+        v.setElement(N - 1 - 3*idx, static_cast<double>(idx));
+    }
+    BOOST_CHECK_EQUAL(v.form(), GraphBLAS::backend::SPARSE_FORM);
+    BOOST_CHECK_EQUAL(v.nvals(), 31);
+    BOOST_CHECK_EQUAL(v.extractElement(N - 4), 1.0);
+    BOOST_CHECK(!v.hasElement(N - 2));
+    BOOST_CHECK_THROW(v.extractElement(N - 2), NoValueException);
+
+    // the bitmap view of a sparse form vector follows later updates
+    auto const &bitmap(v.get_bitmap());
+    BOOST_CHECK_EQUAL(bitmap.count(), 31);
+    v.setElement(1, 5.0);
+    BOOST_CHECK_EQUAL(v.form(), GraphBLAS::backend::BITMAP_FORM);
+    BOOST_CHECK(v.get_bitmap()[1]);
+    BOOST_CHECK_EQUAL(v.get_vals()[N - 1], 0.0);
+    BOOST_CHECK_EQUAL(v.nvals(), 32);
+
+    // bulk writes move between the forms with hysteresis
+    std::vector<std::tuple<IndexType, double> > few, some, all;
+    for (IndexType idx = 0; idx < N; ++idx)
+    {
+        if (idx % 100 == 0) few.push_back(std::make_tuple(idx, 1.0));
+        if (idx % 50 == 0)  some.push_back(std::make_tuple(idx, 2.0));
+        all.push_back(std::make_tuple(idx, 3.0));
+    }
+    v.setContents(some);
+    BOOST_CHECK_EQUAL(v.form(), GraphBLAS::backend::BITMAP_FORM);
+    v.setContents(few);
+    BOOST_CHECK_EQUAL(v.form(), GraphBLAS::backend::SPARSE_FORM);
+    v.setContents(some);
+    BOOST_CHECK_EQUAL(v.form(), GraphBLAS::backend::SPARSE_FORM);
+    BOOST_CHECK(v.getContents() == some);
+    v.setContents(all);
+    BOOST_CHECK_EQUAL(v.form(), GraphBLAS::backend::DENSE_FORM);
+    BOOST_CHECK(v.getContents() == all);
+
+    // equality does not depend on the form
+    BitmapSparseVector<double> w(N), x(N);
+    w.setContents(some);
+    x.setContents(all);
+    x.setContents(some);
+    BOOST_CHECK_EQUAL(w.form(), GraphBLAS::backend::SPARSE_FORM);
+    BOOST_CHECK_EQUAL(x.form(), GraphBLAS::backend::BITMAP_FORM);
+    BOOST_CHECK_EQUAL(w, x);
+    x.setElement(1, 2.0);
+    BOOST_CHECK(w != x);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_form_build_and_pinning)
+{
+    IndexType const N(1000);
+    std::vector<IndexType> i = {900, 5, 900, 17, 5};
+    std::vector<double>    v = {1,   2, 3,   4,  5};
+
+    GraphBLAS::backend::BitmapSparseVector<double> u(N);
+    u.build(i.begin(), v.begin(), i.size(), GraphBLAS::Minus<double>());
+    BOOST_CHECK_EQUAL(u.form(), GraphBLAS::backend::SPARSE_FORM);
+    BOOST_CHECK_EQUAL(u.nvals(), 3);
+    BOOST_CHECK_EQUAL(u.extractElement(5), -3.0);
+    BOOST_CHECK_EQUAL(u.extractElement(900), -2.0);
+    std::vector<IndexType> bad_i = {5, N};
+    BOOST_CHECK_THROW(
+        u.build(bad_i.begin(), v.begin(), bad_i.size()),
+        IndexOutOfBoundsException);
+    BOOST_CHECK_EQUAL(u.nvals(), 3);
+
+    GraphBLAS::backend::BitmapSparseVector<double> ans(N);
+    ans.setFormPolicy(GraphBLAS::backend::FORM_PINNED_DENSE);
+    ans.build(i.begin(), v.begin(), i.size(), GraphBLAS::Minus<double>());
+    BOOST_CHECK_EQUAL(ans.form(), GraphBLAS::backend::BITMAP_FORM);
+    BOOST_CHECK_EQUAL(u, ans);
+
+    // the tags pin the form through any amount of fill
+    std::vector<double> dense(N, 1.0);
+    GraphBLAS::backend::Vector<double, GraphBLAS::SparseTag> s(dense);
+    BOOST_CHECK_EQUAL(s.form(), GraphBLAS::backend::SPARSE_FORM);
+    BOOST_CHECK_EQUAL(s.nvals(), N);
+
+    GraphBLAS::backend::Vector<double, GraphBLAS::DenseTag> d(N);
+    BOOST_CHECK_EQUAL(d.form(), GraphBLAS::backend::BITMAP_FORM);
+    d.setElement(3, 1.0);
+    d.clear();
+    BOOST_CHECK_EQUAL(d.form(), GraphBLAS::backend::BITMAP_FORM);
+
+    // swapping exchanges contents, not policies
+    GraphBLAS::backend::BitmapSparseVector<double> &s_base(s);
+    GraphBLAS::backend::BitmapSparseVector<double> &d_base(d);
+    s_base.swap(d_base);
+    BOOST_CHECK_EQUAL(s.form(), GraphBLAS::backend::SPARSE_FORM);
+    BOOST_CHECK_EQUAL(s.nvals(), 0);
+    BOOST_CHECK_EQUAL(d.form(), GraphBLAS::backend::DENSE_FORM);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_sparse_form_elementwise)
+{
+    using GraphBLAS::backend::BitmapSparseVector;
+    IndexType const N(1000);
+
+    BitmapSparseVector<double> u(N), v(N), w(N);
+    std::vector<std::tuple<IndexType, double> > u_list, v_list;
+    for (IndexType idx = 0; idx < 10; ++idx)
+    {
+        u_list.push_back(std::make_tuple(50*idx, 1.0 + idx));
+        v_list.push_back(std::make_tuple(100*idx, 10.0));
+    }
+    u.setContents(u_list);
+    v.setContents(v_list);
+
+    // sparse operands give a sparse result without leaving the lists
+    w.ewise_or(u, v, GraphBLAS::Plus<double>());
+    BOOST_CHECK_EQUAL(w.form(), GraphBLAS::backend::SPARSE_FORM);
+    BOOST_CHECK_EQUAL(w.nvals(), 15);
+    BOOST_CHECK_EQUAL(w.extractElement(0), 11.0);
+    BOOST_CHECK_EQUAL(w.extractElement(50), 2.0);
+    BOOST_CHECK_EQUAL(w.extractElement(900), 10.0);
+
+    w.ewise_and(u, v, GraphBLAS::Times<double>());
+    BOOST_CHECK_EQUAL(w.form(), GraphBLAS::backend::SPARSE_FORM);
+    BOOST_CHECK_EQUAL(w.nvals(), 5);
+    BOOST_CHECK_EQUAL(w.extractElement(400), 90.0);
+    BOOST_CHECK(!w.hasElement(50));
+
+    // one sparse operand is enough for the intersection, either side
+    BitmapSparseVector<double> d(N, 2.0);
+    w.ewise_and(d, u, GraphBLAS::Minus<double>());
+    BOOST_CHECK_EQUAL(w.form(), GraphBLAS::backend::SPARSE_FORM);
+    BOOST_CHECK_EQUAL(w.nvals(), 10);
+    BOOST_CHECK_EQUAL(w.extractElement(150), -2.0);
+    w.ewise_and(u, d, GraphBLAS::Minus<double>());
+    BOOST_CHECK_EQUAL(w.extractElement(150), 2.0);
+
+    w.apply(u, GraphBLAS::AdditiveInverse<double>());
+    BOOST_CHECK_EQUAL(w.form(), GraphBLAS::backend::SPARSE_FORM);
+    BOOST_CHECK_EQUAL(w.nvals(), 10);
+    BOOST_CHECK_EQUAL(w.extractElement(450), -10.0);
+
+    w.apply_index(u, GraphBLAS::RowIndex<double, double>(1.0));
+    BOOST_CHECK_EQUAL(w.form(), GraphBLAS::backend::SPARSE_FORM);
+    BOOST_CHECK_EQUAL(w.extractElement(450), 451.0);
+
+    w.select(u, GraphBLAS::TriU<double>(-200));  // keeps i <= 200
+    BOOST_CHECK_EQUAL(w.form(), GraphBLAS::backend::SPARSE_FORM);
+    BOOST_CHECK_EQUAL(w.nvals(), 5);
+    BOOST_CHECK_EQUAL(w.extractElement(200), 5.0);
+    BOOST_CHECK(!w.hasElement(250));
+
+    // the output may alias an operand, and a full enough result still
+    // moves to the bitmap form
+    u.ewise_or(u, v, GraphBLAS::Plus<double>());
+    BOOST_CHECK_EQUAL(u.nvals(), 15);
+    BOOST_CHECK_EQUAL(u.extractElement(200), 15.0);
+    w.setContents(u_list);
+    w.ewise_or(w, d, GraphBLAS::Plus<double>());
+    BOOST_CHECK_EQUAL(w.form(), GraphBLAS::backend::DENSE_FORM);
+    BOOST_CHECK_EQUAL(w.extractElement(50), 4.0);
+
+    // clear() returns to the sparse form (unless pinned)
+    w.clear();
+    BOOST_CHECK_EQUAL(w.nvals(), 0);
+    BOOST_CHECK_EQUAL(w.form(), GraphBLAS::backend::SPARSE_FORM);
+    w.setElement(7, 1.0);
+    BOOST_CHECK_EQUAL(w.extractElement(7), 1.0);
+    BOOST_CHECK_EQUAL(w.nvals(), 1);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_mxv_vxm_sparse_form_u)
+{
+    using GraphBLAS::backend::BitmapSparseVector;
+    IndexType const N(1000);
+
+    // A(i, j) = 1 + i for j in {i, i+1, 2i} (within bounds)
+    std::vector<IndexType> rows, cols;
+    std::vector<double>    vals;
+    for (IndexType i = 0; i < N; ++i)
+    {
+        IndexType js[] = {i, i + 1, 2*i};
+        for (IndexType j : js)
+        {
+            if ((j < N) && ((j != 2*i) || (i > 1)))
+            {
+                rows.push_back(i);
+                cols.push_back(j);
+                vals.push_back(1.0 + i);
+            }
+        }
+    }
+    GraphBLAS::backend::LilSparseMatrix<double> A_lil(N, N);
+    A_lil.build(rows.begin(), cols.begin(), vals.begin(), vals.size(),
+                GraphBLAS::Second<double>());
+    GraphBLAS::backend::CsrSparseMatrix<double> A_csr(N, N);
+    A_csr.build(rows.begin(), cols.begin(), vals.begin(), vals.size(),
+                GraphBLAS::Second<double>());
+
+    BitmapSparseVector<double> u(N), u_dense(N);
+    u_dense.setFormPolicy(GraphBLAS::backend::FORM_PINNED_DENSE);
+    std::vector<std::tuple<IndexType, double> > u_list;
+    for (IndexType idx = 3; idx < N; idx += 97)
+    {
+        u_list.push_back(std::make_tuple(idx, double(idx)));
+    }
+    u.setContents(u_list);
+    u_dense.setContents(u_list);
+    BOOST_CHECK_EQUAL(u.form(), GraphBLAS::backend::SPARSE_FORM);
+    BOOST_CHECK_EQUAL(u_dense.form(), GraphBLAS::backend::BITMAP_FORM);
+
+    BitmapSparseVector<double> w(N), ans(N);
+    GraphBLAS::backend::mxv(w, GraphBLAS::backend::NoMask(),
+                            GraphBLAS::NoAccumulate(),
+                            GraphBLAS::ArithmeticSemiring<double>(),
+                            A_lil, u);
+    GraphBLAS::backend::mxv(ans, GraphBLAS::backend::NoMask(),
+                            GraphBLAS::NoAccumulate(),
+                            GraphBLAS::ArithmeticSemiring<double>(),
+                            A_lil, u_dense);
+    BOOST_CHECK(w.nvals() > 0);
+    BOOST_CHECK_EQUAL(w, ans);
+    BOOST_CHECK_EQUAL(u.form(), GraphBLAS::backend::SPARSE_FORM);
+
+    w.clear();
+    GraphBLAS::backend::mxv(w, GraphBLAS::backend::NoMask(),
+                            GraphBLAS::NoAccumulate(),
+                            GraphBLAS::ArithmeticSemiring<double>(),
+                            A_csr, u);
+    BOOST_CHECK_EQUAL(w, ans);
+
+    w.clear();
+    ans.clear();
+    GraphBLAS::backend::vxm(w, GraphBLAS::backend::NoMask(),
+                            GraphBLAS::NoAccumulate(),
+                            GraphBLAS::ArithmeticSemiring<double>(),
+                            u, A_lil);
+    GraphBLAS::backend::vxm(ans, GraphBLAS::backend::NoMask(),
+                            GraphBLAS::NoAccumulate(),
+                            GraphBLAS::ArithmeticSemiring<double>(),
+                            u_dense, A_lil);
+    BOOST_CHECK(w.nvals() > 0);
+    BOOST_CHECK_EQUAL(w, ans);
+}
+
 //****************************************************************************
 BOOST_AUTO_TEST_CASE(test_mxv_sparse_nomask_noaccum)
 {
@@ -0,0 +1,364 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+#include <cstdio>
+#include <iostream>
+
+#include <graphblas/graphblas.hpp>
+
+using namespace GraphBLAS;
+
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_MODULE csr_sparse_matrix_test_suite
+
+#include <boost/test/included/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(BOOST_TEST_MODULE)
+
+namespace
+{
+    std::vector<std::vector<double>> mat = {{6, 0, 0, 4},
+                                            {7, 0, 0, 0},
+                                            {0, 0, 9, 4},
+                                            {2, 5, 0, 3},
+                                            {2, 0, 0, 1},
+                                            {0, 0, 0, 0},
+                                            {0, 1, 0, 2}};
+}
+
+//****************************************************************************
+// CSR basic constructor
+BOOST_AUTO_TEST_CASE(csr_test_construction_basic)
+{
+    IndexType M = 7;
+    IndexType N = 4;
+    backend::CsrSparseMatrix<double> m1(M, N);
+
+    BOOST_CHECK_EQUAL(m1.nrows(), M);
+    BOOST_CHECK_EQUAL(m1.ncols(), N);
+    BOOST_CHECK_EQUAL(m1.nvals(), 0);
+    BOOST_CHECK_EQUAL(m1.get_row_ptr().size(), M + 1);
+}
+
+//****************************************************************************
+// CSR constructor from dense matrix
+BOOST_AUTO_TEST_CASE(csr_test_construction_dense)
+{
+    backend::CsrSparseMatrix<double> m1(mat, 0);
+
+    BOOST_CHECK_EQUAL(m1.nrows(), mat.size());
+    BOOST_CHECK_EQUAL(m1.ncols(), mat[0].size());
+    BOOST_CHECK_EQUAL(m1.nvals(), 12);
+
+    std::vector<IndexType> row_ptr = {0, 2, 3, 5, 8, 10, 10, 12};
+    std::vector<IndexType> col_idx = {0, 3, 0, 2, 3, 0, 1, 3, 0, 3, 1, 3};
+    std::vector<double>    vals    = {6, 4, 7, 9, 4, 2, 5, 3, 2, 1, 1, 2};
+    BOOST_CHECK_EQUAL_COLLECTIONS(m1.get_row_ptr().begin(), m1.get_row_ptr().end(),
+                                  row_ptr.begin(), row_ptr.end());
+    BOOST_CHECK_EQUAL_COLLECTIONS(m1.get_col_idx().begin(), m1.get_col_idx().end(),
+                                  col_idx.begin(), col_idx.end());
+    BOOST_CHECK_EQUAL_COLLECTIONS(m1.get_vals().begin(), m1.get_vals().end(),
+                                  vals.begin(), vals.end());
+
+    for (IndexType i = 0; i < mat.size(); ++i)
+    {
+        for (IndexType j = 0; j < mat[i].size(); ++j)
+        {
+            BOOST_CHECK_EQUAL(m1.hasElement(i, j), (mat[i][j] != 0));
+            if (mat[i][j] != 0)
+            {
+                BOOST_CHECK_EQUAL(m1.extractElement(i, j), mat[i][j]);
+            }
+        }
+    }
+
+    BOOST_CHECK_THROW(m1.extractElement(0, 1), NoValueException);
+    BOOST_CHECK_THROW(m1.extractElement(7, 0), IndexOutOfBoundsException);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(csr_test_construction_copy)
+{
+    backend::CsrSparseMatrix<double> m1(mat, 0);
+    backend::CsrSparseMatrix<double> m2(m1);
+
+    BOOST_CHECK_EQUAL(m1, m2);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(csr_test_move_and_swap)
+{
+    backend::CsrSparseMatrix<double> ans(mat, 0);
+    backend::CsrSparseMatrix<double> m1(mat, 0);
+
+    backend::CsrSparseMatrix<double> m2(std::move(m1));
+    BOOST_CHECK_EQUAL(m2, ans);
+    BOOST_CHECK_EQUAL(m1.nrows(), 0);
+    BOOST_CHECK_EQUAL(m1.nvals(), 0);
+
+    backend::CsrSparseMatrix<double> m3(2, 3);
+    m3.setElement(1, 2, 5.0);
+    m3 = std::move(m2);
+    BOOST_CHECK_EQUAL(m3, ans);
+    BOOST_CHECK_EQUAL(m2.nrows(), 0);
+    BOOST_CHECK_EQUAL(m2.ncols(), 0);
+    BOOST_CHECK_EQUAL(m2.nvals(), 0);
+
+    // pending rows travel with the swap
+    backend::CsrSparseMatrix<double> m4(2, 3);
+    m4.setElement(1, 2, 5.0);
+    m3.swap(m4);
+    BOOST_CHECK_EQUAL(m4, ans);
+    BOOST_CHECK_EQUAL(m3.nrows(), 2);
+    BOOST_CHECK_EQUAL(m3.ncols(), 3);
+    BOOST_CHECK_EQUAL(m3.extractElement(1, 2), 5.0);
+
+    std::vector<std::tuple<IndexType, double>> row =
+        {std::make_tuple(0, 1.0), std::make_tuple(2, 3.0)};
+    m4.setRow(5, std::move(row));
+    BOOST_CHECK_EQUAL(m4.nvals(), 14);
+    BOOST_CHECK_EQUAL(m4.extractElement(5, 2), 3.0);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(csr_test_assign_to_implied_zero)
+{
+    std::vector<std::vector<double>> mat2(mat);
+    backend::CsrSparseMatrix<double> m1(mat2, 0);
+
+    mat2[0][1] = 8;
+    m1.setElement(0, 1, 8);
+    BOOST_CHECK_EQUAL(m1.extractElement(0, 1), mat2[0][1]);
+    BOOST_CHECK_EQUAL(m1.nvals(), 13);
+
+    backend::CsrSparseMatrix<double> m2(mat2, 0);
+    BOOST_CHECK_EQUAL(m1, m2);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(csr_test_assign_to_nonzero_element)
+{
+    std::vector<std::vector<double>> mat2(mat);
+    backend::CsrSparseMatrix<double> m1(mat2, 0);
+
+    mat2[0][0] = 8;
+    m1.setElement(0, 0, 8);
+    BOOST_CHECK_EQUAL(m1.extractElement(0, 0), mat2[0][0]);
+    BOOST_CHECK_EQUAL(m1.nvals(), 12);
+
+    m1.setElement(0, 0, 2, GraphBLAS::Plus<double>());
+    BOOST_CHECK_EQUAL(m1.extractElement(0, 0), 10);
+
+    mat2[0][0] = 10;
+    backend::CsrSparseMatrix<double> m2(mat2, 0);
+    BOOST_CHECK_EQUAL(m1, m2);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(csr_test_build_with_duplicates)
+{
+    std::vector<IndexType> rows = {3, 0, 2, 0, 3, 2, 0};
+    std::vector<IndexType> cols = {1, 3, 2, 0, 1, 0, 3};
+    std::vector<double>    vals = {1, 2, 3, 4, 5, 6, 7};
+
+    backend::CsrSparseMatrix<double> m1(4, 4);
+    m1.build(rows.begin(), cols.begin(), vals.begin(), rows.size(),
+             GraphBLAS::Plus<double>());
+
+    std::vector<std::vector<double>> ans = {{4, 0, 0, 9},
+                                            {0, 0, 0, 0},
+                                            {6, 0, 3, 0},
+                                            {0, 6, 0, 0}};
+    backend::CsrSparseMatrix<double> m2(ans, 0);
+    BOOST_CHECK_EQUAL(m1.nvals(), 5);
+    BOOST_CHECK_EQUAL(m1, m2);
+
+    // dup is applied in input order
+    backend::CsrSparseMatrix<double> m3(4, 4);
+    m3.build(rows.begin(), cols.begin(), vals.begin(), rows.size(),
+             GraphBLAS::Second<double>());
+    BOOST_CHECK_EQUAL(m3.extractElement(0, 3), 7);
+    BOOST_CHECK_EQUAL(m3.extractElement(3, 1), 5);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(csr_test_get_set_row)
+{
+    backend::CsrSparseMatrix<double> m1(mat, 0);
+
+    auto row = m1.getRow(3);
+    BOOST_CHECK_EQUAL(3UL, row.size());
+
+    // Rewrite every row in order, as the write stage of an operation does
+    backend::CsrSparseMatrix<double> m2(mat.size(), mat[0].size());
+    for (IndexType row_idx = 0; row_idx < m1.nrows(); ++row_idx)
+    {
+        m2.setRow(row_idx, m1.getRow(row_idx));
+    }
+    BOOST_CHECK_EQUAL(m1, m2);
+
+    row.clear();
+    m1.setRow(0, row);
+    BOOST_CHECK_EQUAL(10UL, m1.nvals());
+    BOOST_CHECK_EQUAL(0UL, m1.getRow(0).size());
+    BOOST_CHECK_EQUAL(m1.get_row_ptr()[1], 0);
+    BOOST_CHECK_EQUAL(m1.get_col_idx().size(), 10);
+
+    // Casting version
+    std::vector<std::tuple<IndexType, int>> int_row = {std::make_tuple(1, 3),
+                                                       std::make_tuple(2, 4)};
+    m1.setRow(5, int_row);
+    BOOST_CHECK_EQUAL(12UL, m1.nvals());
+    BOOST_CHECK_EQUAL(m1.extractElement(5, 2), 4.0);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(csr_test_get_set_col)
+{
+    backend::CsrSparseMatrix<double> m1(mat, 0);
+
+    BOOST_CHECK_EQUAL(4UL, m1.getCol(0).size());
+    BOOST_CHECK_EQUAL(2UL, m1.getCol(1).size());
+    BOOST_CHECK_EQUAL(1UL, m1.getCol(2).size());
+    BOOST_CHECK_EQUAL(5UL, m1.getCol(3).size());
+
+    std::vector<std::tuple<IndexType, double>> col = {std::make_tuple(1, 1.0),
+                                                      std::make_tuple(5, 2.0)};
+    m1.setCol(0, col);
+    BOOST_CHECK_EQUAL(10UL, m1.nvals());
+    BOOST_CHECK_EQUAL(m1.getCol(0).size(), 2UL);
+    BOOST_CHECK(!m1.hasElement(0, 0));
+    BOOST_CHECK_EQUAL(m1.extractElement(1, 0), 1.0);
+    BOOST_CHECK_EQUAL(m1.extractElement(5, 0), 2.0);
+
+    col.clear();
+    m1.setCol(3, col);
+    BOOST_CHECK_EQUAL(5UL, m1.nvals());
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(csr_test_column_index)
+{
+    backend::CsrSparseMatrix<double> m1(mat, 0);
+    backend::CsrSparseMatrix<double> m2(mat, 0);
+    m2.enableColumnIndex();
+
+    for (IndexType ci = 0; ci < 4; ++ci)
+    {
+        BOOST_CHECK(m1.getCol(ci) == m2.getCol(ci));
+        IndexArrayType r1, r2;
+        m1.getRowIndices(ci, r1);
+        m2.getRowIndices(ci, r2);
+        BOOST_CHECK_EQUAL_COLLECTIONS(r1.begin(), r1.end(), r2.begin(), r2.end());
+    }
+
+    // Pending (unassembled) modifications must be visible through the index
+    m2.setElement(5, 1, 8.0);
+    std::vector<std::tuple<IndexType, double>> row = {std::make_tuple(2, 3.0)};
+    m2.setRow(0, row);
+    BOOST_CHECK_EQUAL(m2.getCol(0).size(), 3UL);
+    BOOST_CHECK_EQUAL(m2.getCol(1).size(), 3UL);
+    BOOST_CHECK_EQUAL(m2.getCol(2).size(), 2UL);
+    BOOST_CHECK_EQUAL(m2.getCol(3).size(), 4UL);
+
+    std::vector<std::tuple<IndexType, double>> col;
+    m2.setCol(3, col);
+    BOOST_CHECK_EQUAL(m2.getCol(3).size(), 0UL);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(csr_test_extract_tuples)
+{
+    backend::CsrSparseMatrix<double> m1(mat, 0);
+    backend::LilSparseMatrix<double> lil(mat, 0);
+
+    IndexArrayType r1(12), c1(12), r2(12), c2(12);
+    std::vector<double> v1(12), v2(12);
+    m1.extractTuples(r1.begin(), c1.begin(), v1.begin());
+    lil.extractTuples(r2.begin(), c2.begin(), v2.begin());
+
+    BOOST_CHECK_EQUAL_COLLECTIONS(r1.begin(), r1.end(), r2.begin(), r2.end());
+    BOOST_CHECK_EQUAL_COLLECTIONS(c1.begin(), c1.end(), c2.begin(), c2.end());
+    BOOST_CHECK_EQUAL_COLLECTIONS(v1.begin(), v1.end(), v2.begin(), v2.end());
+}
+
+//****************************************************************************
+// Selecting CSR storage through the frontend
+BOOST_AUTO_TEST_CASE(csr_test_frontend_storage_tag)
+{
+    typedef GraphBLAS::Matrix<double, CsrStorageTag> CsrMatrixType;
+    typedef GraphBLAS::Matrix<double, DirectedMatrixTag, CsrStorageTag> CsrDirType;
+
+    BOOST_CHECK((std::is_base_of<backend::CsrSparseMatrix<double>,
+                                 CsrMatrixType::BackendType>::value));
+    BOOST_CHECK((std::is_base_of<backend::CsrSparseMatrix<double>,
+                                 CsrDirType::BackendType>::value));
+    BOOST_CHECK((std::is_base_of<backend::LilSparseMatrix<double>,
+                                 GraphBLAS::Matrix<double>::BackendType>::value));
+
+    CsrMatrixType m1(mat, 0);
+    BOOST_CHECK_EQUAL(m1.nvals(), 12);
+    BOOST_CHECK_EQUAL(m1.extractElement(2, 2), 9);
+}
+
+//****************************************************************************
+// Arrays adopted from a mapped file are used in place until modified
+BOOST_AUTO_TEST_CASE(csr_test_mapped_arrays)
+{
+    std::string path("test_csr_mapped_arrays.gbcsr");
+    backend::CsrSparseMatrix<double> m1(mat, 0);
+    backend::write_binary_csr(path, m1);
+
+    backend::CsrSparseMatrix<double> m2(m1.nrows(), m1.ncols());
+    {
+        backend::BinaryCsrFile file(path);
+        file.load(m2);
+    }
+    std::remove(path.c_str());   // the mapping outlives the directory entry
+
+    BOOST_CHECK(m2.is_view());
+    BOOST_CHECK(!m1.is_view());
+    BOOST_CHECK_EQUAL(m1, m2);
+
+    backend::CsrSparseMatrix<double> m3(m2);
+    BOOST_CHECK(m3.is_view());
+    BOOST_CHECK_EQUAL(m2.get_col_idx().data(), m3.get_col_idx().data());
+
+    m2.setElement(5, 1, 8.0);
+    BOOST_CHECK(!m2.is_view());
+    BOOST_CHECK_EQUAL(m2.extractElement(5, 1), 8.0);
+    BOOST_CHECK_EQUAL(m3, m1);
+    BOOST_CHECK(m3.is_view());
+
+    m3.clear();
+    BOOST_CHECK(!m3.is_view());
+    BOOST_CHECK_EQUAL(m3.nvals(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
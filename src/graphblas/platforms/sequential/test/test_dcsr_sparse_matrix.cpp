@@ -0,0 +1,336 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+#include <iostream>
+
+#include <graphblas/graphblas.hpp>
+
+using namespace GraphBLAS;
+
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_MODULE dcsr_sparse_matrix_test_suite
+
+#include <boost/test/included/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(BOOST_TEST_MODULE)
+
+namespace
+{
+    std::vector<std::vector<double>> mat = {{6, 0, 0, 4},
+                                            {7, 0, 0, 0},
+                                            {0, 0, 9, 4},
+                                            {2, 5, 0, 3},
+                                            {2, 0, 0, 1},
+                                            {0, 0, 0, 0},
+                                            {0, 1, 0, 2}};
+
+    // A row space far too large for one entry per row
+    IndexType const HUGE_DIM = (IndexType(1) << 40);
+}
+
+//****************************************************************************
+// DCSR basic constructor: nothing is allocated per row
+BOOST_AUTO_TEST_CASE(dcsr_test_construction_basic)
+{
+    backend::DcsrSparseMatrix<double> m1(HUGE_DIM, HUGE_DIM);
+
+    BOOST_CHECK_EQUAL(m1.nrows(), HUGE_DIM);
+    BOOST_CHECK_EQUAL(m1.ncols(), HUGE_DIM);
+    BOOST_CHECK_EQUAL(m1.nvals(), 0);
+    BOOST_CHECK_EQUAL(m1.num_stored_rows(), 0);
+    BOOST_CHECK_EQUAL(m1.get_row_ptr().size(), 1);
+    BOOST_CHECK(m1.getRow(HUGE_DIM - 1).empty());
+}
+
+//****************************************************************************
+// DCSR constructor from dense matrix
+BOOST_AUTO_TEST_CASE(dcsr_test_construction_dense)
+{
+    backend::DcsrSparseMatrix<double> m1(mat, 0);
+
+    BOOST_CHECK_EQUAL(m1.nrows(), mat.size());
+    BOOST_CHECK_EQUAL(m1.ncols(), mat[0].size());
+    BOOST_CHECK_EQUAL(m1.nvals(), 12);
+    BOOST_CHECK_EQUAL(m1.num_stored_rows(), 6);
+
+    std::vector<IndexType> row_ids = {0, 1, 2, 3, 4, 6};
+    std::vector<IndexType> row_ptr = {0, 2, 3, 5, 8, 10, 12};
+    std::vector<IndexType> col_idx = {0, 3, 0, 2, 3, 0, 1, 3, 0, 3, 1, 3};
+    std::vector<double>    vals    = {6, 4, 7, 9, 4, 2, 5, 3, 2, 1, 1, 2};
+    BOOST_CHECK_EQUAL_COLLECTIONS(m1.get_row_ids().begin(), m1.get_row_ids().end(),
+                                  row_ids.begin(), row_ids.end());
+    BOOST_CHECK_EQUAL_COLLECTIONS(m1.get_row_ptr().begin(), m1.get_row_ptr().end(),
+                                  row_ptr.begin(), row_ptr.end());
+    BOOST_CHECK_EQUAL_COLLECTIONS(m1.get_col_idx().begin(), m1.get_col_idx().end(),
+                                  col_idx.begin(), col_idx.end());
+    BOOST_CHECK_EQUAL_COLLECTIONS(m1.get_vals().begin(), m1.get_vals().end(),
+                                  vals.begin(), vals.end());
+
+    for (IndexType i = 0; i < mat.size(); ++i)
+    {
+        for (IndexType j = 0; j < mat[i].size(); ++j)
+        {
+            BOOST_CHECK_EQUAL(m1.hasElement(i, j), (mat[i][j] != 0));
+            if (mat[i][j] != 0)
+            {
+                BOOST_CHECK_EQUAL(m1.extractElement(i, j), mat[i][j]);
+            }
+        }
+    }
+
+    BOOST_CHECK_THROW(m1.extractElement(0, 1), NoValueException);
+    BOOST_CHECK_THROW(m1.extractElement(5, 0), NoValueException);
+    BOOST_CHECK_THROW(m1.extractElement(7, 0), IndexOutOfBoundsException);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(dcsr_test_move_and_swap)
+{
+    backend::DcsrSparseMatrix<double> ans(mat, 0);
+    backend::DcsrSparseMatrix<double> m1(mat, 0);
+
+    backend::DcsrSparseMatrix<double> m2(std::move(m1));
+    BOOST_CHECK_EQUAL(m2, ans);
+    BOOST_CHECK_EQUAL(m1.nrows(), 0);
+    BOOST_CHECK_EQUAL(m1.nvals(), 0);
+
+    backend::DcsrSparseMatrix<double> m3(2, 3);
+    m3.setElement(1, 2, 5.0);
+    m3 = std::move(m2);
+    BOOST_CHECK_EQUAL(m3, ans);
+    BOOST_CHECK_EQUAL(m2.nrows(), 0);
+    BOOST_CHECK_EQUAL(m2.ncols(), 0);
+    BOOST_CHECK_EQUAL(m2.nvals(), 0);
+
+    // pending rows travel with the swap
+    backend::DcsrSparseMatrix<double> m4(2, 3);
+    m4.setElement(1, 2, 5.0);
+    m3.swap(m4);
+    BOOST_CHECK_EQUAL(m4, ans);
+    BOOST_CHECK_EQUAL(m3.nrows(), 2);
+    BOOST_CHECK_EQUAL(m3.extractElement(1, 2), 5.0);
+    BOOST_CHECK_EQUAL(m3.num_stored_rows(), 1);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(dcsr_test_build_with_duplicates)
+{
+    std::vector<IndexType> rows = {3, 0, 2, 0, 3, 2, 0};
+    std::vector<IndexType> cols = {1, 3, 2, 0, 1, 0, 3};
+    std::vector<double>    vals = {1, 2, 3, 4, 5, 6, 7};
+
+    backend::DcsrSparseMatrix<double> m1(4, 4);
+    m1.build(rows.begin(), cols.begin(), vals.begin(), rows.size(),
+             GraphBLAS::Plus<double>());
+
+    std::vector<std::vector<double>> ans = {{4, 0, 0, 9},
+                                            {0, 0, 0, 0},
+                                            {6, 0, 3, 0},
+                                            {0, 6, 0, 0}};
+    backend::DcsrSparseMatrix<double> m2(ans, 0);
+    BOOST_CHECK_EQUAL(m1.nvals(), 5);
+    BOOST_CHECK_EQUAL(m1.num_stored_rows(), 3);
+    BOOST_CHECK_EQUAL(m1, m2);
+
+    // dup is applied in input order
+    backend::DcsrSparseMatrix<double> m3(4, 4);
+    m3.build(rows.begin(), cols.begin(), vals.begin(), rows.size(),
+             GraphBLAS::Second<double>());
+    BOOST_CHECK_EQUAL(m3.extractElement(0, 3), 7);
+    BOOST_CHECK_EQUAL(m3.extractElement(3, 1), 5);
+
+    // existing values come before the new ones
+    m3.build(rows.begin(), cols.begin(), vals.begin(), 1,
+             GraphBLAS::Plus<double>());
+    BOOST_CHECK_EQUAL(m3.extractElement(3, 1), 6);
+    BOOST_CHECK_EQUAL(m3.nvals(), 5);
+}
+
+//****************************************************************************
+// 64-bit entity IDs used directly as row and column indices
+BOOST_AUTO_TEST_CASE(dcsr_test_huge_index_space)
+{
+    std::vector<IndexType> rows = {HUGE_DIM - 1, 42, 1UL << 35, 42};
+    std::vector<IndexType> cols = {7, HUGE_DIM - 2, 1UL << 33, 3};
+    std::vector<double>    vals = {1, 2, 3, 4};
+
+    backend::DcsrSparseMatrix<double> m1(HUGE_DIM, HUGE_DIM);
+    m1.build(rows.begin(), cols.begin(), vals.begin(), rows.size(),
+             GraphBLAS::Second<double>());
+
+    BOOST_CHECK_EQUAL(m1.nvals(), 4);
+    BOOST_CHECK_EQUAL(m1.num_stored_rows(), 3);
+    BOOST_CHECK_EQUAL(m1.extractElement(HUGE_DIM - 1, 7), 1);
+    BOOST_CHECK_EQUAL(m1.extractElement(42, HUGE_DIM - 2), 2);
+    BOOST_CHECK_EQUAL(m1.getRow(42).size(), 2UL);
+    BOOST_CHECK(!m1.hasElement(43, 3));
+
+    m1.setElement(HUGE_DIM / 2, 0, 5.0);
+    std::vector<std::tuple<IndexType, double>> empty;
+    m1.setRow(42, empty);
+    BOOST_CHECK_EQUAL(m1.nvals(), 3);
+
+    IndexArrayType r(3), c(3);
+    std::vector<double> v(3);
+    m1.extractTuples(r.begin(), c.begin(), v.begin());
+    IndexArrayType r_ans = {1UL << 35, HUGE_DIM / 2, HUGE_DIM - 1};
+    std::vector<double> v_ans = {3, 5, 1};
+    BOOST_CHECK_EQUAL_COLLECTIONS(r.begin(), r.end(), r_ans.begin(), r_ans.end());
+    BOOST_CHECK_EQUAL_COLLECTIONS(v.begin(), v.end(), v_ans.begin(), v_ans.end());
+    BOOST_CHECK_EQUAL(m1.num_stored_rows(), 3);
+
+    BOOST_CHECK_EQUAL(m1.getCol(7).size(), 1UL);
+    IndexArrayType col_rows;
+    m1.getRowIndices(0, col_rows);
+    BOOST_CHECK_EQUAL(col_rows.size(), 1UL);
+    BOOST_CHECK_EQUAL(col_rows[0], HUGE_DIM / 2);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(dcsr_test_get_set_row)
+{
+    backend::DcsrSparseMatrix<double> m1(mat, 0);
+
+    auto row = m1.getRow(3);
+    BOOST_CHECK_EQUAL(3UL, row.size());
+
+    // Rewrite every row in order, as the write stage of an operation does
+    backend::DcsrSparseMatrix<double> m2(mat.size(), mat[0].size());
+    for (IndexType row_idx = 0; row_idx < m1.nrows(); ++row_idx)
+    {
+        m2.setRow(row_idx, m1.getRow(row_idx));
+    }
+    BOOST_CHECK_EQUAL(m1, m2);
+
+    row.clear();
+    m1.setRow(0, row);
+    BOOST_CHECK_EQUAL(10UL, m1.nvals());
+    BOOST_CHECK_EQUAL(0UL, m1.getRow(0).size());
+    BOOST_CHECK_EQUAL(m1.get_row_ids()[0], 1);
+    BOOST_CHECK_EQUAL(m1.get_col_idx().size(), 10);
+
+    // Casting version
+    std::vector<std::tuple<IndexType, int>> int_row = {std::make_tuple(1, 3),
+                                                       std::make_tuple(2, 4)};
+    m1.setRow(5, int_row);
+    BOOST_CHECK_EQUAL(12UL, m1.nvals());
+    BOOST_CHECK_EQUAL(m1.extractElement(5, 2), 4.0);
+    BOOST_CHECK_EQUAL(m1.num_stored_rows(), 6);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(dcsr_test_get_set_col)
+{
+    backend::DcsrSparseMatrix<double> m1(mat, 0);
+
+    BOOST_CHECK_EQUAL(4UL, m1.getCol(0).size());
+    BOOST_CHECK_EQUAL(2UL, m1.getCol(1).size());
+    BOOST_CHECK_EQUAL(1UL, m1.getCol(2).size());
+    BOOST_CHECK_EQUAL(5UL, m1.getCol(3).size());
+
+    std::vector<std::tuple<IndexType, double>> col = {std::make_tuple(1, 1.0),
+                                                      std::make_tuple(5, 2.0)};
+    m1.setCol(0, col);
+    BOOST_CHECK_EQUAL(10UL, m1.nvals());
+    BOOST_CHECK_EQUAL(m1.getCol(0).size(), 2UL);
+    BOOST_CHECK(!m1.hasElement(0, 0));
+    BOOST_CHECK_EQUAL(m1.extractElement(1, 0), 1.0);
+    BOOST_CHECK_EQUAL(m1.extractElement(5, 0), 2.0);
+
+    col.clear();
+    m1.setCol(3, col);
+    BOOST_CHECK_EQUAL(5UL, m1.nvals());
+    BOOST_CHECK_EQUAL(m1.num_stored_rows(), 5);
+
+    backend::DcsrSparseMatrix<double> m2(mat, 0);
+    m2.enableColumnIndex();
+    m2.setElement(5, 1, 8.0);
+    BOOST_CHECK_EQUAL(m2.getCol(1).size(), 3UL);
+}
+
+//****************************************************************************
+// Conversions to and from CSR
+BOOST_AUTO_TEST_CASE(dcsr_test_csr_conversion)
+{
+    backend::CsrSparseMatrix<double> csr(mat, 0);
+    backend::DcsrSparseMatrix<double> m1(csr);
+    backend::DcsrSparseMatrix<double> ans(mat, 0);
+    BOOST_CHECK_EQUAL(m1, ans);
+
+    m1.setElement(5, 3, 8.0);
+    backend::CsrSparseMatrix<double> csr2(m1.to_csr());
+    BOOST_CHECK_EQUAL(csr2.nrows(), mat.size());
+    BOOST_CHECK_EQUAL(csr2.get_row_ptr().size(), mat.size() + 1);
+    BOOST_CHECK_EQUAL(csr2.nvals(), 13);
+    BOOST_CHECK_EQUAL(csr2.extractElement(5, 3), 8.0);
+
+    csr.setElement(5, 3, 8.0);
+    BOOST_CHECK_EQUAL(csr, csr2);
+
+    backend::DcsrSparseMatrix<bool> bool_dcsr(4, 4);
+    bool_dcsr.setElement(2, 1, true);
+    auto bool_csr(bool_dcsr.to_csr());
+    BOOST_CHECK_EQUAL(bool_csr.nvals(), 1);
+    BOOST_CHECK(bool_csr.extractElement(2, 1));
+}
+
+//****************************************************************************
+// Selecting hypersparse storage through the frontend; operations work on
+// it through the generic row interface.
+BOOST_AUTO_TEST_CASE(dcsr_test_frontend_storage_tag)
+{
+    typedef GraphBLAS::Matrix<double, HypersparseStorageTag> HyperMatrixType;
+
+    BOOST_CHECK((std::is_base_of<backend::DcsrSparseMatrix<double>,
+                                 HyperMatrixType::BackendType>::value));
+
+    HyperMatrixType A(mat, 0);
+    GraphBLAS::Matrix<double> lA(mat, 0);
+    BOOST_CHECK_EQUAL(A.nvals(), 12);
+    BOOST_CHECK_EQUAL(A.extractElement(2, 2), 9);
+
+    HyperMatrixType C(mat.size(), mat.size());
+    GraphBLAS::Matrix<double> lC(mat.size(), mat.size());
+    GraphBLAS::mxm(C, GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
+                   GraphBLAS::ArithmeticSemiring<double>(),
+                   A, GraphBLAS::transpose(A));
+    GraphBLAS::mxm(lC, GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
+                   GraphBLAS::ArithmeticSemiring<double>(),
+                   lA, GraphBLAS::transpose(lA));
+
+    IndexArrayType r1(C.nvals()), c1(C.nvals()), r2(lC.nvals()), c2(lC.nvals());
+    std::vector<double> v1(C.nvals()), v2(lC.nvals());
+    C.extractTuples(r1, c1, v1);
+    lC.extractTuples(r2, c2, v2);
+    BOOST_CHECK_EQUAL_COLLECTIONS(r1.begin(), r1.end(), r2.begin(), r2.end());
+    BOOST_CHECK_EQUAL_COLLECTIONS(c1.begin(), c1.end(), c2.begin(), c2.end());
+    BOOST_CHECK_EQUAL_COLLECTIONS(v1.begin(), v1.end(), v2.begin(), v2.end());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
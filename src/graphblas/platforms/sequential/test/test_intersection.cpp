@@ -0,0 +1,187 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+#include <random>
+#include <set>
+#include <graphblas/graphblas.hpp>
+
+using namespace GraphBLAS;
+
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_MODULE intersection_test_suite
+
+#include <boost/test/included/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(BOOST_TEST_MODULE)
+
+namespace
+{
+    IndexArrayType random_indices(std::mt19937 &gen, IndexType n,
+                                  IndexType range)
+    {
+        std::uniform_int_distribution<IndexType> dist(0, range - 1);
+        std::set<IndexType> indices;
+        while (indices.size() < n)
+        {
+            indices.insert(dist(gen));
+        }
+        return IndexArrayType(indices.begin(), indices.end());
+    }
+
+    // Every pair of positions visited must hold equal indices, and the
+    // visited indices must be the intersection in increasing order.
+    void check_intersection(IndexArrayType const &a, IndexArrayType const &b)
+    {
+        IndexArrayType expected;
+        std::set_intersection(a.begin(), a.end(), b.begin(), b.end(),
+                              std::back_inserter(expected));
+
+        IndexArrayType result;
+        bool pairs_ok(true);
+        backend::intersect_sorted(
+            a.data(), a.size(), b.data(), b.size(),
+            [&](std::size_t k1, std::size_t k2)
+            {
+                pairs_ok = pairs_ok && (a[k1] == b[k2]);
+                result.push_back(a[k1]);
+                return true;
+            });
+        BOOST_CHECK(pairs_ok);
+        BOOST_CHECK(result == expected);
+
+        // The same through rows of tuples
+        std::vector<std::tuple<IndexType, int> > ta, tb;
+        for (auto idx : a) ta.push_back(std::make_tuple(idx, 1));
+        for (auto idx : b) tb.push_back(std::make_tuple(idx, 1));
+        result.clear();
+        backend::intersect_sorted(
+            ta.begin(), ta.size(), tb.begin(), tb.size(),
+            [&](std::size_t k1, std::size_t k2)
+            {
+                result.push_back(std::get<0>(ta[k1]));
+                return true;
+            });
+        BOOST_CHECK(result == expected);
+    }
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(intersection_test_edge_cases)
+{
+    IndexArrayType empty, one = {3}, many = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    check_intersection(empty, many);
+    check_intersection(many, empty);
+    check_intersection(one, many);
+    check_intersection(many, one);
+    check_intersection(many, many);
+
+    IndexArrayType evens, odds;
+    for (IndexType ix = 0; ix < 100; ++ix)
+    {
+        ((ix % 2 == 0) ? evens : odds).push_back(ix);
+    }
+    check_intersection(evens, odds);
+    check_intersection(evens, many);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(intersection_test_balanced)
+{
+    std::mt19937 gen(42);
+    for (IndexType n = 1; n < 70; n += 3)
+    {
+        check_intersection(random_indices(gen, n, 3*n),
+                           random_indices(gen, n + n/2, 3*n));
+    }
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(intersection_test_skewed)
+{
+    std::mt19937 gen(7);
+    for (IndexType n = 1; n < 10; ++n)
+    {
+        IndexArrayType small(random_indices(gen, n, 2000));
+        IndexArrayType large(random_indices(gen, 1000, 2000));
+        check_intersection(small, large);
+        check_intersection(large, small);
+    }
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(intersection_test_stop)
+{
+    IndexArrayType a = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+    IndexArrayType b = {2, 4, 6, 8, 10, 12};
+    IndexArrayType big;
+    for (IndexType ix = 0; ix < 1000; ++ix)
+    {
+        big.push_back(ix);
+    }
+
+    for (auto const *other : {&b, &big})
+    {
+        IndexArrayType result;
+        backend::intersect_sorted(
+            a.data(), a.size(), other->data(), other->size(),
+            [&](std::size_t k1, std::size_t k2)
+            {
+                result.push_back(a[k1]);
+                return (result.size() < 2);
+            });
+        BOOST_CHECK_EQUAL(result.size(), 2);
+    }
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(intersection_test_dot)
+{
+    std::vector<std::tuple<IndexType, double> > u, v;
+    for (IndexType ix = 0; ix < 500; ++ix)
+    {
+        u.push_back(std::make_tuple(ix, 1.0));
+    }
+    v.push_back(std::make_tuple(17, 2.0));
+    v.push_back(std::make_tuple(499, 3.0));
+    v.push_back(std::make_tuple(600, 4.0));
+
+    double ans;
+    BOOST_CHECK(backend::dot(ans, u, v, ArithmeticSemiring<double>()));
+    BOOST_CHECK_EQUAL(ans, 5.0);
+    BOOST_CHECK(backend::dot(ans, v, u, ArithmeticSemiring<double>()));
+    BOOST_CHECK_EQUAL(ans, 5.0);
+
+    backend::SparseRow<double> su, sv;
+    su.assign(u);
+    sv.assign(v);
+    BOOST_CHECK(backend::dot(ans, su, sv, ArithmeticSemiring<double>()));
+    BOOST_CHECK_EQUAL(ans, 5.0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -254,6 +254,128 @@ BOOST_AUTO_TEST_CASE(lil_test_get_set_col)
     }
 }
 
+//****************************************************************************
+// LIL move construction, move assignment and swap
+BOOST_AUTO_TEST_CASE(lil_test_move_and_swap)
+{
+    std::vector<std::vector<double>> mat = {{6, 0, 0, 4},
+                                            {7, 0, 0, 0},
+                                            {0, 0, 9, 4},
+                                            {2, 5, 0, 3},
+                                            {2, 0, 0, 1},
+                                            {0, 0, 0, 0},
+                                            {0, 1, 0, 2}};
+
+    backend::LilSparseMatrix<double> ans(mat, 0);
+    backend::LilSparseMatrix<double> m1(mat, 0);
+
+    backend::LilSparseMatrix<double> m2(std::move(m1));
+    BOOST_CHECK_EQUAL(m2, ans);
+    BOOST_CHECK_EQUAL(m1.nrows(), 0);
+    BOOST_CHECK_EQUAL(m1.nvals(), 0);
+
+    backend::LilSparseMatrix<double> m3(2, 3);
+    m3.setElement(1, 2, 5.0);
+    m3 = std::move(m2);
+    BOOST_CHECK_EQUAL(m3, ans);
+    BOOST_CHECK_EQUAL(m2.nrows(), 0);
+    BOOST_CHECK_EQUAL(m2.ncols(), 0);
+    BOOST_CHECK_EQUAL(m2.nvals(), 0);
+
+    backend::LilSparseMatrix<double> m4(2, 3);
+    m4.setElement(1, 2, 5.0);
+    m4.enableColumnIndex();
+    m3.swap(m4);
+    BOOST_CHECK_EQUAL(m4, ans);
+    BOOST_CHECK_EQUAL(m3.nrows(), 2);
+    BOOST_CHECK_EQUAL(m3.ncols(), 3);
+    BOOST_CHECK_EQUAL(m3.extractElement(1, 2), 5.0);
+    BOOST_CHECK_EQUAL(m3.getCol(2).size(), 1UL);
+
+    std::vector<std::tuple<IndexType, double>> row =
+        {std::make_tuple(0, 1.0), std::make_tuple(2, 3.0)};
+    m4.setRow(5, std::move(row));
+    BOOST_CHECK_EQUAL(m4.nvals(), 14);
+    BOOST_CHECK_EQUAL(m4.extractElement(5, 2), 3.0);
+}
+
+//****************************************************************************
+// cached column index must agree with the row scan and track modifications
+BOOST_AUTO_TEST_CASE(lil_test_column_index)
+{
+    std::vector<std::vector<double>> mat = {{6, 0, 0, 4},
+                                            {7, 0, 0, 0},
+                                            {0, 0, 9, 4},
+                                            {2, 5, 0, 3},
+                                            {2, 0, 0, 1},
+                                            {0, 0, 0, 0},
+                                            {0, 1, 0, 2}};
+
+    backend::LilSparseMatrix<double> m1(mat, 0);
+    backend::LilSparseMatrix<double> m2(mat, 0);
+    m2.enableColumnIndex();
+    BOOST_CHECK(!m1.hasColumnIndex());
+    BOOST_CHECK(m2.hasColumnIndex());
+
+    for (IndexType ci = 0; ci < 4; ++ci)
+    {
+        BOOST_CHECK(m1.getCol(ci) == m2.getCol(ci));
+        IndexArrayType r1, r2;
+        m1.getRowIndices(ci, r1);
+        m2.getRowIndices(ci, r2);
+        BOOST_CHECK_EQUAL_COLLECTIONS(r1.begin(), r1.end(), r2.begin(), r2.end());
+    }
+
+    m2.setElement(5, 1, 8.0);
+    BOOST_CHECK_EQUAL(m2.getCol(1).size(), 3UL);
+
+    std::vector<std::tuple<IndexType, double>> row = {std::make_tuple(2, 3.0)};
+    m2.setRow(0, row);
+    BOOST_CHECK_EQUAL(m2.getCol(0).size(), 3UL);
+    BOOST_CHECK_EQUAL(m2.getCol(2).size(), 2UL);
+    BOOST_CHECK_EQUAL(m2.getCol(3).size(), 4UL);
+
+    m2.clear();
+    BOOST_CHECK_EQUAL(m2.getCol(3).size(), 0UL);
+}
+
+//****************************************************************************
+// sorted bulk build must match per-tuple setElement with the same dup,
+// including duplicates, unsorted input and existing stored values
+BOOST_AUTO_TEST_CASE(lil_test_build_matches_set_element)
+{
+    IndexType const NR = 9, NC = 13;
+    IndexArrayType i, j;
+    std::vector<double> v;
+    for (IndexType ix = 0; ix < 200; ++ix)
+    {
+        i.push_back((ix*7 + 3) % NR);
+        j.push_back((ix*ix + 5*ix) % NC);
+        v.push_back(double(ix % 11) - 4.0);
+    }
+
+    backend::LilSparseMatrix<double> built(NR, NC), reference(NR, NC);
+    built.setElement(2, 4, 100.0);
+    built.setElement(5, 0, -3.0);
+    reference.setElement(2, 4, 100.0);
+    reference.setElement(5, 0, -3.0);
+
+    // Minus is not commutative, so the order of the merges is checked too
+    built.build(i.begin(), j.begin(), v.begin(), i.size(), Minus<double>());
+    for (IndexType ix = 0; ix < i.size(); ++ix)
+    {
+        reference.setElement(i[ix], j[ix], v[ix], Minus<double>());
+    }
+
+    BOOST_CHECK_EQUAL(built.nvals(), reference.nvals());
+    BOOST_CHECK(built == reference);
+
+    BOOST_CHECK_THROW(
+        built.build(IndexArrayType({NR}).begin(), IndexArrayType({0}).begin(),
+                    std::vector<double>({1.0}).begin(), 1, Second<double>()),
+        IndexOutOfBoundsException);
+}
+
 //****************************************************************************
 // test set/get_col
 BOOST_AUTO_TEST_CASE(lil_test_get_set_row)
@@ -0,0 +1,268 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+#include <iostream>
+
+#include <graphblas/graphblas.hpp>
+
+using namespace GraphBLAS;
+
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_MODULE pattern_sparse_matrix_test_suite
+
+#include <boost/test/included/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(BOOST_TEST_MODULE)
+
+namespace
+{
+    std::vector<std::vector<double>> mat = {{6, 0, 0, 4},
+                                            {7, 0, 0, 0},
+                                            {0, 0, 9, 4},
+                                            {2, 5, 0, 3},
+                                            {2, 0, 0, 1},
+                                            {0, 0, 0, 0},
+                                            {0, 1, 0, 2}};
+
+    // The pattern of mat, holding the default iso value
+    std::vector<std::vector<double>> pat = {{1, 0, 0, 1},
+                                            {1, 0, 0, 0},
+                                            {0, 0, 1, 1},
+                                            {1, 1, 0, 1},
+                                            {1, 0, 0, 1},
+                                            {0, 0, 0, 0},
+                                            {0, 1, 0, 1}};
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(pattern_test_construction)
+{
+    backend::PatternSparseMatrix<double> m1(7, 4);
+    BOOST_CHECK_EQUAL(m1.nrows(), 7);
+    BOOST_CHECK_EQUAL(m1.ncols(), 4);
+    BOOST_CHECK_EQUAL(m1.nvals(), 0);
+    BOOST_CHECK_EQUAL(m1.isoValue(), 1.0);
+
+    BOOST_CHECK_THROW((backend::PatternSparseMatrix<double>(mat, 0)),
+                      InvalidValueException);
+    BOOST_CHECK_THROW((backend::PatternSparseMatrix<double>(pat)),
+                      InvalidValueException);
+
+    backend::PatternSparseMatrix<double> m2(pat, 0);
+    BOOST_CHECK_EQUAL(m2.nvals(), 12);
+    for (IndexType i = 0; i < mat.size(); ++i)
+    {
+        for (IndexType j = 0; j < mat[i].size(); ++j)
+        {
+            BOOST_CHECK_EQUAL(m2.hasElement(i, j), (mat[i][j] != 0));
+            if (mat[i][j] != 0)
+            {
+                BOOST_CHECK_EQUAL(m2.extractElement(i, j), 1.0);
+            }
+        }
+    }
+    BOOST_CHECK_THROW(m2.extractElement(0, 1), NoValueException);
+    BOOST_CHECK_THROW(m2.extractElement(7, 0), IndexOutOfBoundsException);
+
+    IndexArrayType pattern = {0, 1, 3};
+    BOOST_CHECK_EQUAL_COLLECTIONS(m2.getPattern(3).begin(), m2.getPattern(3).end(),
+                                  pattern.begin(), pattern.end());
+
+    // every stored value changes at once
+    m2.setIsoValue(2.5);
+    BOOST_CHECK_EQUAL(m2.extractElement(3, 1), 2.5);
+    BOOST_CHECK_EQUAL(std::get<1>(m2.getRow(2)[1]), 2.5);
+}
+
+//****************************************************************************
+// Only the iso value can be written; anything else is rejected unchanged
+BOOST_AUTO_TEST_CASE(pattern_test_set_and_build)
+{
+    backend::PatternSparseMatrix<double> m1(pat, 0);
+
+    m1.setElement(0, 1, 1);
+    m1.setElement(0, 0, 1, GraphBLAS::Second<double>());
+    BOOST_CHECK_EQUAL(m1.nvals(), 13);
+    BOOST_CHECK_EQUAL(m1.extractElement(0, 1), 1.0);
+    BOOST_CHECK_EQUAL(m1.extractElement(0, 0), 1.0);
+
+    BOOST_CHECK_THROW(m1.setElement(0, 2, 8), InvalidValueException);
+    BOOST_CHECK_THROW(m1.setElement(0, 0, 1, GraphBLAS::Plus<double>()),
+                      InvalidValueException);
+    BOOST_CHECK_EQUAL(m1.nvals(), 13);
+    BOOST_CHECK(!m1.hasElement(0, 2));
+
+    std::vector<IndexType> rows = {3, 0, 2, 0, 3, 2, 0};
+    std::vector<IndexType> cols = {1, 3, 2, 0, 1, 0, 3};
+    std::vector<double>    vals(rows.size(), 1);
+    backend::PatternSparseMatrix<double> m2(4, 4);
+    BOOST_CHECK_THROW(m2.build(rows.begin(), cols.begin(), vals.begin(),
+                               rows.size(), GraphBLAS::Plus<double>()),
+                      InvalidValueException);
+    BOOST_CHECK_EQUAL(m2.nvals(), 0);
+    m2.build(rows.begin(), cols.begin(), vals.begin(), rows.size(),
+             GraphBLAS::Second<double>());
+
+    std::vector<std::vector<double>> ans = {{1, 0, 0, 1},
+                                            {0, 0, 0, 0},
+                                            {1, 0, 1, 0},
+                                            {0, 1, 0, 0}};
+    backend::PatternSparseMatrix<double> m3(ans, 0);
+    BOOST_CHECK_EQUAL(m2.nvals(), 5);
+    BOOST_CHECK_EQUAL(m2, m3);
+
+    // existing elements are kept
+    std::vector<IndexType> more_rows = {1, 2};
+    std::vector<IndexType> more_cols = {1, 2};
+    m2.build(more_rows.begin(), more_cols.begin(), vals.begin(), 2,
+             GraphBLAS::LogicalOr<double>());
+    BOOST_CHECK_EQUAL(m2.nvals(), 6);
+
+    std::vector<double> bad_vals = {1, 3};
+    BOOST_CHECK_THROW(m2.build(rows.begin(), cols.begin(), bad_vals.begin(),
+                               2, GraphBLAS::Second<double>()),
+                      InvalidValueException);
+    BOOST_CHECK_EQUAL(m2.nvals(), 6);
+    BOOST_CHECK(m2.hasElement(1, 1));
+
+    std::vector<IndexType> bad_rows = {1, 4};
+    BOOST_CHECK_THROW(m2.build(bad_rows.begin(), more_cols.begin(),
+                               vals.begin(), 2, GraphBLAS::Plus<double>()),
+                      IndexOutOfBoundsException);
+    BOOST_CHECK_EQUAL(m2.nvals(), 6);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(pattern_test_rows_and_cols)
+{
+    backend::PatternSparseMatrix<double> m1(pat, 0);
+
+    std::vector<std::tuple<IndexType, int>> int_row = {std::make_tuple(1, 3),
+                                                       std::make_tuple(2, 1)};
+    BOOST_CHECK_THROW(m1.setRow(5, int_row), InvalidValueException);
+    BOOST_CHECK_EQUAL(m1.nvals(), 12);
+    std::get<1>(int_row[0]) = 1;
+    m1.setRow(5, int_row);
+    BOOST_CHECK_EQUAL(m1.nvals(), 14);
+    BOOST_CHECK_EQUAL(m1.getRow(5).size(), 2UL);
+    m1.setRow(0, std::vector<std::tuple<IndexType, double>>());
+    BOOST_CHECK_EQUAL(m1.nvals(), 12);
+
+    BOOST_CHECK_EQUAL(m1.getCol(3).size(), 4UL);
+    std::vector<std::tuple<IndexType, double>> col = {std::make_tuple(1, 1.0),
+                                                      std::make_tuple(5, 2.0)};
+    BOOST_CHECK_THROW(m1.setCol(0, col), InvalidValueException);
+    std::get<1>(col[1]) = 1.0;
+    m1.setCol(0, col);
+    BOOST_CHECK_EQUAL(m1.nvals(), 11);
+    IndexArrayType col_rows;
+    m1.getRowIndices(0, col_rows);
+    IndexArrayType col_ans = {1, 5};
+    BOOST_CHECK_EQUAL_COLLECTIONS(col_rows.begin(), col_rows.end(),
+                                  col_ans.begin(), col_ans.end());
+
+    backend::PatternSparseMatrix<double> m2(std::move(m1));
+    BOOST_CHECK_EQUAL(m2.nvals(), 11);
+    BOOST_CHECK_EQUAL(m1.nvals(), 0);
+
+    backend::PatternSparseMatrix<double> m3(2, 2);
+    m3 = std::move(m2);
+    BOOST_CHECK_EQUAL(m3.nvals(), 11);
+    BOOST_CHECK_EQUAL(m2.nrows(), 0);
+    m2 = std::move(m3);
+
+    IndexArrayType r(11), c(11);
+    std::vector<double> v(11);
+    m2.extractTuples(r.begin(), c.begin(), v.begin());
+    BOOST_CHECK_EQUAL(r[0], 1);
+    BOOST_CHECK_EQUAL(c[0], 0);
+    BOOST_CHECK(std::all_of(v.begin(), v.end(),
+                            [](double val) { return val == 1.0; }));
+}
+
+//****************************************************************************
+// A pattern mask gives the same results as a boolean mask holding only
+// true values, for both plain and complemented masks.
+BOOST_AUTO_TEST_CASE(pattern_test_frontend_mask)
+{
+    typedef GraphBLAS::Matrix<bool, PatternStorageTag> PatternMatrixType;
+    BOOST_CHECK((std::is_base_of<backend::PatternSparseMatrix<bool>,
+                                 PatternMatrixType::BackendType>::value));
+    BOOST_CHECK((backend::is_pattern_matrix<
+                 PatternMatrixType::BackendType>::value));
+    BOOST_CHECK((!backend::is_pattern_matrix<
+                 GraphBLAS::Matrix<bool>::BackendType>::value));
+
+    std::vector<std::vector<bool>> mask_dense = {{1, 0, 0, 1, 0, 0, 0},
+                                                 {0, 1, 0, 0, 0, 0, 1},
+                                                 {0, 0, 0, 0, 0, 0, 0},
+                                                 {1, 1, 1, 1, 1, 1, 1},
+                                                 {0, 0, 1, 0, 0, 1, 0},
+                                                 {0, 0, 0, 0, 0, 0, 0},
+                                                 {0, 1, 0, 1, 0, 1, 0}};
+    PatternMatrixType M(mask_dense, false);
+    GraphBLAS::Matrix<bool> lM(mask_dense, false);
+    BOOST_CHECK_EQUAL(M.nvals(), lM.nvals());
+
+    GraphBLAS::Matrix<double> A(mat, 0);
+    GraphBLAS::Matrix<double> C1(7, 7), C2(7, 7);
+    GraphBLAS::mxm(C1, M, GraphBLAS::NoAccumulate(),
+                   GraphBLAS::ArithmeticSemiring<double>(),
+                   A, GraphBLAS::transpose(A));
+    GraphBLAS::mxm(C2, lM, GraphBLAS::NoAccumulate(),
+                   GraphBLAS::ArithmeticSemiring<double>(),
+                   A, GraphBLAS::transpose(A));
+    BOOST_CHECK_EQUAL(C1, C2);
+
+    GraphBLAS::mxm(C1, GraphBLAS::complement(M), GraphBLAS::NoAccumulate(),
+                   GraphBLAS::ArithmeticSemiring<double>(),
+                   A, GraphBLAS::transpose(A), true);
+    GraphBLAS::mxm(C2, GraphBLAS::complement(lM), GraphBLAS::NoAccumulate(),
+                   GraphBLAS::ArithmeticSemiring<double>(),
+                   A, GraphBLAS::transpose(A), true);
+    BOOST_CHECK_EQUAL(C1, C2);
+
+    // Every value written is true, so the result holds the pattern of A
+    PatternMatrixType P(7, 4);
+    GraphBLAS::apply(P, GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
+                     GraphBLAS::Identity<double, bool>(), A);
+    BOOST_CHECK_EQUAL(P.nvals(), 12);
+    BOOST_CHECK_EQUAL(P.extractElement(2, 2), true);
+
+    // A stored false cannot be represented
+    GraphBLAS::Matrix<bool> F(7, 4);
+    F.setElement(1, 1, false);
+    BOOST_CHECK_THROW(
+        GraphBLAS::apply(P, GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
+                         GraphBLAS::Identity<bool>(), F),
+        InvalidValueException);
+    BOOST_CHECK_THROW(P.setElement(0, 1, false), InvalidValueException);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,168 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+#include <graphblas/graphblas.hpp>
+
+using namespace GraphBLAS;
+
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_MODULE sparse_row_test_suite
+
+#include <boost/test/included/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(BOOST_TEST_MODULE)
+
+namespace
+{
+    std::vector<std::vector<double>> mat = {{6, 0, 0, 4},
+                                            {7, 0, 0, 0},
+                                            {0, 0, 9, 4},
+                                            {2, 5, 0, 3},
+                                            {2, 0, 0, 1},
+                                            {0, 0, 0, 0},
+                                            {0, 1, 0, 2}};
+
+    template <typename ScalarT>
+    std::vector<std::tuple<IndexType, ScalarT> >
+    as_tuples(backend::SparseRow<ScalarT> const &row)
+    {
+        std::vector<std::tuple<IndexType, ScalarT> > tuples;
+        for (std::size_t k = 0; k < row.size(); ++k)
+        {
+            tuples.push_back(std::make_tuple(row.index(k), row.value(k)));
+        }
+        return tuples;
+    }
+
+    template <typename MatrixT>
+    void check_rows_and_cols(MatrixT const &m)
+    {
+        backend::SparseRow<double> buf;
+        for (IndexType i = 0; i < m.nrows(); ++i)
+        {
+            m.getRow(i, buf);
+            BOOST_CHECK(as_tuples(buf) == m.getRow(i));
+        }
+        for (IndexType j = 0; j < m.ncols(); ++j)
+        {
+            m.getCol(j, buf);
+            BOOST_CHECK(as_tuples(buf) == m.getCol(j));
+        }
+    }
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(sparse_row_test_construction)
+{
+    backend::SparseRow<double> row;
+    BOOST_CHECK(row.empty());
+
+    row.push_back(1, 3.0);
+    row.push_back(4, 5.0);
+    BOOST_CHECK_EQUAL(row.size(), 2);
+    BOOST_CHECK_EQUAL(row.index(1), 4);
+    BOOST_CHECK_EQUAL(row.value(1), 5.0);
+
+    std::vector<std::tuple<IndexType, int> > tuples =
+        {std::make_tuple(0, 2), std::make_tuple(2, 7), std::make_tuple(3, 1)};
+    row.assign(tuples);
+    BOOST_CHECK_EQUAL(row.size(), 3);
+    BOOST_CHECK_EQUAL(row.index(2), 3);
+    BOOST_CHECK_EQUAL(row.value(1), 7.0);
+
+    row.clear();
+    BOOST_CHECK(row.empty());
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(sparse_row_test_storage_access)
+{
+    backend::LilSparseMatrix<double> lil(mat, 0);
+    check_rows_and_cols(lil);
+
+    backend::CsrSparseMatrix<double> csr(mat, 0);
+    check_rows_and_cols(csr);
+    csr.setElement(5, 2, 8.0);   // a pending row
+    check_rows_and_cols(csr);
+
+    backend::DcsrSparseMatrix<double> dcsr(mat, 0);
+    check_rows_and_cols(dcsr);
+
+    // Pattern storage only accepts its iso value (1)
+    std::vector<std::vector<double>> pat(mat);
+    for (auto &row : pat)
+    {
+        for (auto &val : row)
+        {
+            if (val != 0) val = 1;
+        }
+    }
+    backend::PatternSparseMatrix<double> pattern(pat, 0);
+    check_rows_and_cols(pattern);
+
+    lil.enableColumnIndex();
+    check_rows_and_cols(lil);
+
+    backend::TransposeView<backend::LilSparseMatrix<double> > lil_t(lil);
+    check_rows_and_cols(lil_t);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(sparse_row_test_helpers)
+{
+    backend::LilSparseMatrix<double> m(mat, 0);
+    backend::SparseRow<double> r0, r3;
+    m.getRow(0, r0);
+    m.getRow(3, r3);
+
+    double ans(0), ref(0);
+    BOOST_CHECK(backend::dot(ans, r0, r3,
+                             ArithmeticSemiring<double>()));
+    BOOST_CHECK(backend::dot(ref, m.getRow(0), m.getRow(3),
+                             ArithmeticSemiring<double>()));
+    BOOST_CHECK_EQUAL(ans, ref);
+    BOOST_CHECK_EQUAL(ans, 24.0);
+
+    backend::SparseRow<double> r5;
+    m.getRow(5, r5);
+    BOOST_CHECK(!backend::dot(ans, r0, r5, ArithmeticSemiring<double>()));
+
+    std::vector<std::tuple<IndexType, double> > res, res_ref;
+    backend::ewise_or(res, r0, r3, Plus<double>());
+    backend::ewise_or(res_ref, m.getRow(0), m.getRow(3), Plus<double>());
+    BOOST_CHECK(res == res_ref);
+    BOOST_CHECK_EQUAL(res.size(), 3);
+
+    backend::ewise_and(res, r0, r3, Times<double>());
+    backend::ewise_and(res_ref, m.getRow(0), m.getRow(3), Times<double>());
+    BOOST_CHECK(res == res_ref);
+    BOOST_CHECK_EQUAL(res.size(), 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
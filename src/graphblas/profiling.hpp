@@ -0,0 +1,459 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+#ifndef GB_PROFILING_HPP
+#define GB_PROFILING_HPP
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <typeinfo>
+#include <vector>
+
+#if defined(__GNUG__)
+#include <cxxabi.h>
+#endif
+
+#include <graphblas/Matrix.hpp>
+#include <graphblas/ComplementView.hpp>
+
+//****************************************************************************
+// Per-operation profiling.
+//
+// Compile with GRAPHBLAS_PROFILING defined to 1 to have every frontend
+// operation (operations.hpp) record its wall time, input and output nvals,
+// mask kind, operator type and an estimated flop count.  Records go to a
+// ring buffer owned by the calling thread (the oldest records are
+// overwritten), and can be dumped as a summary table or as Chrome trace
+// JSON (load it in chrome://tracing or Perfetto):
+//
+//     GraphBLAS::profiling::clear();
+//     algorithms::page_rank(graph, rank);
+//     GraphBLAS::profiling::print_summary(std::cout);
+//     std::ofstream trace("page_rank.json");
+//     GraphBLAS::profiling::write_chrome_trace(trace);
+//
+// Without GRAPHBLAS_PROFILING the hooks compile to nothing (the arguments
+// are not evaluated) and the dump functions report no records.
+//****************************************************************************
+namespace GraphBLAS
+{
+    namespace profiling
+    {
+        //********************************************************************
+        /// One frontend operation call.
+        struct Record
+        {
+            char const   *op;           // e.g. "mxm"
+            char const   *type_name;    // typeid name of the semiring/op
+            char const   *mask;         // "none", "mask" or "complement"
+            uint64_t      nvals_in;     // sum over the inputs
+            uint64_t      nvals_out;
+            uint64_t      flops;        // estimate (see operations.hpp)
+            double        start_us;     // since the first record
+            double        duration_us;
+            unsigned int  thread;       // profiling thread id
+        };
+
+        namespace detail
+        {
+            typedef std::chrono::steady_clock Clock;
+
+            inline Clock::time_point epoch()
+            {
+                static Clock::time_point const start(Clock::now());
+                return start;
+            }
+
+            inline double micros_since_epoch(Clock::time_point t)
+            {
+                return std::chrono::duration<double, std::micro>(
+                    t - epoch()).count();
+            }
+
+            /// The records of one thread; overwrites the oldest when full.
+            class RingBuffer
+            {
+            public:
+                RingBuffer(unsigned int thread, std::size_t capacity)
+                    : m_thread(thread), m_records(capacity), m_next(0),
+                      m_size(0)
+                {}
+
+                unsigned int thread() const { return m_thread; }
+
+                void push(Record const &rec)
+                {
+                    if (m_records.empty()) return;
+                    m_records[m_next] = rec;
+                    m_next = (m_next + 1) % m_records.size();
+                    m_size = std::min(m_size + 1, m_records.size());
+                }
+
+                /// Append the records, oldest first.
+                void copy_to(std::vector<Record> &out) const
+                {
+                    std::size_t first =
+                        (m_next + m_records.size() - m_size) % std::max<std::size_t>(1, m_records.size());
+                    for (std::size_t ix = 0; ix < m_size; ++ix)
+                    {
+                        out.push_back(m_records[(first + ix) % m_records.size()]);
+                    }
+                }
+
+                void reset(std::size_t capacity)
+                {
+                    m_records.assign(capacity, Record());
+                    m_next = 0;
+                    m_size = 0;
+                }
+
+            private:
+                unsigned int         m_thread;
+                std::vector<Record>  m_records;
+                std::size_t          m_next;
+                std::size_t          m_size;
+            };
+
+            /// All threads' buffers (they outlive their threads).
+            struct Registry
+            {
+                Registry() : capacity(1 << 16) {}
+
+                std::mutex                                  mutex;
+                std::vector<std::shared_ptr<RingBuffer> >   buffers;
+                std::size_t                                 capacity;
+            };
+
+            inline Registry &registry()
+            {
+                static Registry reg;
+                return reg;
+            }
+
+            inline RingBuffer &thread_buffer()
+            {
+                thread_local std::shared_ptr<RingBuffer> buffer;
+                if (!buffer)
+                {
+                    Registry &reg(registry());
+                    std::lock_guard<std::mutex> lock(reg.mutex);
+                    buffer = std::make_shared<RingBuffer>(
+                        static_cast<unsigned int>(reg.buffers.size()),
+                        reg.capacity);
+                    reg.buffers.push_back(buffer);
+                }
+                return *buffer;
+            }
+
+            inline std::string demangle(char const *name)
+            {
+                if (name == nullptr) return "";
+                std::string result(name);
+#if defined(__GNUG__)
+                int status = 0;
+                char *readable = abi::__cxa_demangle(name, nullptr, nullptr,
+                                                     &status);
+                if ((status == 0) && (readable != nullptr))
+                {
+                    result = readable;
+                }
+                std::free(readable);
+#endif
+                // Drop the namespace noise: GraphBLAS::Plus<double> -> Plus<double>
+                std::string const ns("GraphBLAS::");
+                for (std::size_t pos = result.find(ns);
+                     pos != std::string::npos;
+                     pos = result.find(ns, pos))
+                {
+                    result.erase(pos, ns.size());
+                }
+                return result;
+            }
+
+            inline std::string json_escape(std::string const &str)
+            {
+                std::string out;
+                for (char c : str)
+                {
+                    if ((c == '"') || (c == '\\')) out.push_back('\\');
+                    out.push_back(c);
+                }
+                return out;
+            }
+        } // namespace detail
+
+        //********************************************************************
+        /// Number of records kept per thread; also clears all records.
+        inline void set_buffer_capacity(std::size_t capacity)
+        {
+            detail::Registry &reg(detail::registry());
+            std::lock_guard<std::mutex> lock(reg.mutex);
+            reg.capacity = capacity;
+            for (auto &buffer : reg.buffers)
+            {
+                buffer->reset(capacity);
+            }
+        }
+
+        /// Discard all records.
+        inline void clear()
+        {
+            detail::Registry &reg(detail::registry());
+            std::lock_guard<std::mutex> lock(reg.mutex);
+            for (auto &buffer : reg.buffers)
+            {
+                buffer->reset(reg.capacity);
+            }
+        }
+
+        /**
+         * @brief The records of all threads ordered by start time.
+         *
+         * @note Take this (or a dump) while no operations are running.
+         */
+        inline std::vector<Record> records()
+        {
+            std::vector<Record> recs;
+            detail::Registry &reg(detail::registry());
+            {
+                std::lock_guard<std::mutex> lock(reg.mutex);
+                for (auto const &buffer : reg.buffers)
+                {
+                    buffer->copy_to(recs);
+                }
+            }
+            std::stable_sort(recs.begin(), recs.end(),
+                             [](Record const &a, Record const &b)
+                             { return a.start_us < b.start_us; });
+            return recs;
+        }
+
+        //********************************************************************
+        /**
+         * @brief One line per (operation, operator type, mask kind) with the
+         *        call count, total and mean time, share of the profiled
+         *        time, total nvals in and out and estimated GFLOP/s; the
+         *        most expensive first.
+         */
+        inline void print_summary(std::ostream &os)
+        {
+            struct Totals
+            {
+                Totals() : calls(0), time_us(0), nvals_in(0), nvals_out(0),
+                           flops(0) {}
+                uint64_t calls;
+                double   time_us;
+                uint64_t nvals_in, nvals_out, flops;
+            };
+
+            typedef std::tuple<std::string, std::string, std::string> KeyType;
+            std::map<KeyType, Totals> totals;
+            double total_us = 0;
+            for (Record const &rec : records())
+            {
+                Totals &t(totals[KeyType(rec.op,
+                                         detail::demangle(rec.type_name),
+                                         rec.mask)]);
+                ++t.calls;
+                t.time_us   += rec.duration_us;
+                t.nvals_in  += rec.nvals_in;
+                t.nvals_out += rec.nvals_out;
+                t.flops     += rec.flops;
+                total_us    += rec.duration_us;
+            }
+
+            std::vector<std::pair<KeyType, Totals> > rows(totals.begin(),
+                                                          totals.end());
+            std::sort(rows.begin(), rows.end(),
+                      [](std::pair<KeyType, Totals> const &a,
+                         std::pair<KeyType, Totals> const &b)
+                      { return a.second.time_us > b.second.time_us; });
+
+            std::ios::fmtflags flags(os.flags());
+            os << std::left  << std::setw(12) << "op"
+               << std::setw(48) << "type"
+               << std::setw(11) << "mask"
+               << std::right << std::setw(8)  << "calls"
+               << std::setw(12) << "total ms"
+               << std::setw(11) << "mean ms"
+               << std::setw(7)  << "%"
+               << std::setw(14) << "nvals in"
+               << std::setw(14) << "nvals out"
+               << std::setw(10) << "GFLOP/s" << "\n";
+            os << std::fixed;
+            for (auto const &row : rows)
+            {
+                Totals const &t(row.second);
+                std::string type(std::get<1>(row.first));
+                if (type.size() > 46) type = type.substr(0, 43) + "...";
+                os << std::left  << std::setw(12) << std::get<0>(row.first)
+                   << std::setw(48) << type
+                   << std::setw(11) << std::get<2>(row.first)
+                   << std::right << std::setw(8) << t.calls
+                   << std::setprecision(3)
+                   << std::setw(12) << t.time_us/1000.0
+                   << std::setw(11) << t.time_us/1000.0/t.calls
+                   << std::setprecision(1)
+                   << std::setw(7)
+                   << ((total_us > 0) ? 100.0*t.time_us/total_us : 0.0)
+                   << std::setw(14) << t.nvals_in
+                   << std::setw(14) << t.nvals_out
+                   << std::setprecision(3)
+                   << std::setw(10)
+                   << ((t.time_us > 0) ? t.flops/(t.time_us*1000.0) : 0.0)
+                   << "\n";
+            }
+            os.flags(flags);
+        }
+
+        /// Chrome trace event format: one complete ("X") event per call.
+        inline void write_chrome_trace(std::ostream &os)
+        {
+            std::ios::fmtflags flags(os.flags());
+            os << std::fixed << std::setprecision(3);
+            os << "{\"traceEvents\": [";
+            bool first = true;
+            for (Record const &rec : records())
+            {
+                os << (first ? "\n" : ",\n")
+                   << "  {\"name\": \"" << rec.op << "\", \"cat\": \"graphblas\""
+                   << ", \"ph\": \"X\", \"pid\": 1, \"tid\": " << rec.thread
+                   << ", \"ts\": " << rec.start_us
+                   << ", \"dur\": " << rec.duration_us
+                   << ", \"args\": {\"type\": \""
+                   << detail::json_escape(detail::demangle(rec.type_name))
+                   << "\", \"mask\": \"" << rec.mask
+                   << "\", \"nvals_in\": " << rec.nvals_in
+                   << ", \"nvals_out\": " << rec.nvals_out
+                   << ", \"flops\": " << rec.flops << "}}";
+                first = false;
+            }
+            os << "\n], \"displayTimeUnit\": \"ms\"}\n";
+            os.flags(flags);
+        }
+
+        //********************************************************************
+        // Hook helpers used by operations.hpp
+        //********************************************************************
+
+        inline char const *mask_kind(NoMask const &) { return "none"; }
+
+        template<typename MatrixT>
+        inline char const *mask_kind(MatrixComplementView<MatrixT> const &)
+        {
+            return "complement";
+        }
+
+        template<typename VectorT>
+        inline char const *mask_kind(VectorComplementView<VectorT> const &)
+        {
+            return "complement";
+        }
+
+        template<typename MaskT>
+        inline char const *mask_kind(MaskT const &) { return "mask"; }
+
+        /// nvals of a matrix or vector as a double (for flop estimates).
+        template<typename T>
+        inline double density(T const &x, IndexType n)
+        {
+            return (n == 0) ? 0.0 : static_cast<double>(x.nvals())/n;
+        }
+
+        /// Times one operation call; record() at the end of the call.
+        /// Calls that throw leave no record.
+        class Scope
+        {
+        public:
+            Scope(char const *op,
+                  char const *type_name,
+                  char const *mask,
+                  uint64_t    nvals_in,
+                  double      flops)
+                : m_start((detail::epoch(), detail::Clock::now()))
+            {
+                m_rec.op        = op;
+                m_rec.type_name = type_name;
+                m_rec.mask      = mask;
+                m_rec.nvals_in  = nvals_in;
+                m_rec.nvals_out = 0;
+                m_rec.flops     = static_cast<uint64_t>(flops);
+            }
+
+            void record(uint64_t nvals_out)
+            {
+                detail::Clock::time_point stop(detail::Clock::now());
+                detail::RingBuffer &buffer(detail::thread_buffer());
+                m_rec.nvals_out   = nvals_out;
+                m_rec.start_us    = detail::micros_since_epoch(m_start);
+                m_rec.duration_us = std::chrono::duration<double, std::micro>(
+                    stop - m_start).count();
+                m_rec.thread      = buffer.thread();
+                buffer.push(m_rec);
+            }
+
+        private:
+            detail::Clock::time_point  m_start;
+            Record                     m_rec;
+        };
+    } // namespace profiling
+} // namespace GraphBLAS
+
+//****************************************************************************
+// GRB_PROFILE_BEGIN(opname, op, mask, nvals_in, flops) starts timing the
+// enclosing operation; GRB_PROFILE_END(nvals_out) records it.
+//****************************************************************************
+#if GRAPHBLAS_PROFILING
+
+    #define GRB_PROFILE_BEGIN(opname, op, mask, nvals_in, flops)        \
+        GraphBLAS::profiling::Scope grb_profile_scope(                  \
+            opname, typeid(op).name(),                                  \
+            GraphBLAS::profiling::mask_kind(mask), nvals_in, flops)
+    #define GRB_PROFILE_END(nvals_out) grb_profile_scope.record(nvals_out)
+
+#else
+
+    #define GRB_PROFILE_BEGIN(opname, op, mask, nvals_in, flops)
+    #define GRB_PROFILE_END(nvals_out)
+
+#endif
+
+#endif // GB_PROFILING_HPP
@@ -2107,4 +2107,74 @@ BOOST_AUTO_TEST_CASE(min_select1st_test)
     BOOST_CHECK_EQUAL(GraphBLAS::MinSelect1stSemiring<bool>().mult(false, true), false);
 }
 
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(monoid_terminal_test)
+{
+    BOOST_CHECK(!GraphBLAS::PlusMonoid<uint32_t>::has_terminal);
+    BOOST_CHECK(!GraphBLAS::MinMonoid<double>::has_terminal);
+    BOOST_CHECK(!GraphBLAS::MaxMonoid<float>::has_terminal);
+    BOOST_CHECK(!GraphBLAS::TimesMonoid<double>::has_terminal);
+
+    BOOST_CHECK(GraphBLAS::LogicalOrMonoid<bool>::has_terminal);
+    BOOST_CHECK_EQUAL(GraphBLAS::LogicalOrMonoid<bool>().terminal(), true);
+    BOOST_CHECK(GraphBLAS::LogicalAndMonoid<bool>::has_terminal);
+    BOOST_CHECK_EQUAL(GraphBLAS::LogicalAndMonoid<bool>().identity(), true);
+    BOOST_CHECK_EQUAL(GraphBLAS::LogicalAndMonoid<bool>().terminal(), false);
+    BOOST_CHECK_EQUAL(GraphBLAS::LogicalAndMonoid<bool>()(true, false), false);
+
+    BOOST_CHECK(GraphBLAS::MinMonoid<uint32_t>::has_terminal);
+    BOOST_CHECK_EQUAL(GraphBLAS::MinMonoid<uint32_t>().terminal(), 0U);
+    BOOST_CHECK_EQUAL(GraphBLAS::MinMonoid<int8_t>().terminal(),
+                      std::numeric_limits<int8_t>::lowest());
+    BOOST_CHECK_EQUAL(GraphBLAS::MaxMonoid<uint16_t>().terminal(),
+                      std::numeric_limits<uint16_t>::max());
+    BOOST_CHECK_EQUAL(GraphBLAS::TimesMonoid<int32_t>().terminal(), 0);
+
+    BOOST_CHECK(GraphBLAS::LogicalSemiring<bool>::has_terminal);
+    BOOST_CHECK_EQUAL(GraphBLAS::LogicalSemiring<bool>().terminal(), true);
+    BOOST_CHECK(!GraphBLAS::ArithmeticSemiring<double>::has_terminal);
+    BOOST_CHECK(GraphBLAS::MinSelect1stSemiring<uint64_t>::has_terminal);
+
+    BOOST_CHECK(GraphBLAS::has_terminal_value<
+                    GraphBLAS::LogicalOrMonoid<bool> >::value);
+    BOOST_CHECK(!GraphBLAS::has_terminal_value<GraphBLAS::Plus<double> >::value);
+    BOOST_CHECK(GraphBLAS::add_monoid(GraphBLAS::LogicalSemiring<bool>())
+                .has_terminal);
+}
+
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(any_monoid_pair_op_test)
+{
+    BOOST_CHECK_EQUAL(GraphBLAS::Pair<double>()(-3.5, 0.0), 1.0);
+    BOOST_CHECK_EQUAL((GraphBLAS::Pair<double, bool, uint32_t>()(0.0, false)),
+                      1U);
+
+    GraphBLAS::AnyMonoid<uint32_t> any;
+    BOOST_CHECK_EQUAL(any(any.identity(), 7U), 7U);
+
+    BOOST_CHECK(GraphBLAS::is_any_monoid<GraphBLAS::AnyMonoid<int> >::value);
+    BOOST_CHECK(!GraphBLAS::is_any_monoid<GraphBLAS::MinMonoid<int> >::value);
+    BOOST_CHECK(
+        GraphBLAS::is_any_monoid<GraphBLAS::AnyPairSemiring<int> >::value);
+    BOOST_CHECK(
+        !GraphBLAS::is_any_monoid<GraphBLAS::PlusPairSemiring<int> >::value);
+    BOOST_CHECK(GraphBLAS::is_any_monoid<
+                    GraphBLAS::AdditiveMonoidFromSemiring<
+                        GraphBLAS::AnySelect1stSemiring<int> > >::value);
+
+    BOOST_CHECK(GraphBLAS::is_pair_op<GraphBLAS::Pair<float> >::value);
+    BOOST_CHECK(!GraphBLAS::is_pair_op<GraphBLAS::First<float> >::value);
+    BOOST_CHECK(GraphBLAS::is_pair_op<GraphBLAS::PlusPairSemiring<int> >::value);
+    BOOST_CHECK(
+        !GraphBLAS::is_pair_op<GraphBLAS::AnySelect2ndSemiring<int> >::value);
+    BOOST_CHECK(GraphBLAS::is_pair_op<
+                    GraphBLAS::MultiplicativeOpFromSemiring<
+                        GraphBLAS::AnyPairSemiring<int> > >::value);
+
+    GraphBLAS::PlusPairSemiring<double, double, uint32_t> plus_pair;
+    BOOST_CHECK_EQUAL(plus_pair.add(plus_pair.mult(2.5, 0.0),
+                                    plus_pair.mult(-1.0, 4.0)), 2U);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -137,6 +137,34 @@ BOOST_AUTO_TEST_CASE(sparse_apply_matrix_nomask_noaccum)
     BOOST_CHECK_EQUAL(mC, answer);
 }
 
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(sparse_apply_matrix_csr_storage)
+{
+    std::vector<std::vector<double>> matA = {{8, 1, 6},
+                                             {3, 5, 7},
+                                             {4, 9, 0}};
+    GraphBLAS::Matrix<double, GraphBLAS::CsrStorageTag> mA(matA, 0);
+
+    std::vector<std::vector<double>> matC = {{1, 2, 3},
+                                             {4, 6, 6},
+                                             {7, 8, 0}};
+    GraphBLAS::Matrix<double, GraphBLAS::CsrStorageTag> mC(matC, 0);
+
+    std::vector<std::vector<double>> matAnswer = {{-7, 1, -3},
+                                                  { 1, 1, -1},
+                                                  { 3, -1, 0}};
+
+    GraphBLAS::Matrix<double, GraphBLAS::CsrStorageTag> answer(matAnswer, 0);
+
+    GraphBLAS::apply(mC,
+                     GraphBLAS::NoMask(),
+                     GraphBLAS::Plus<double>(),
+                     GraphBLAS::AdditiveInverse<double>(),
+                     mA);
+
+    BOOST_CHECK_EQUAL(mC, answer);
+}
+
 //****************************************************************************
 BOOST_AUTO_TEST_CASE(sparse_apply_matrix_mask_merge_noaccum)
 {
@@ -806,4 +834,143 @@ BOOST_AUTO_TEST_CASE(apply_stdvec_test_plus_accum)
 }
 
 
+
+//****************************************************************************
+// Index unary ops and select
+//****************************************************************************
+
+BOOST_AUTO_TEST_CASE(apply_index_unary_vector)
+{
+    std::vector<double> vecA = {8, 0, 6, 0, 5};
+    std::vector<double> vecAnswer = {1, 0, 3, 0, 5};
+
+    {
+        GraphBLAS::Vector<double, GraphBLAS::SparseTag> vA(vecA, 0);
+        GraphBLAS::Vector<double, GraphBLAS::SparseTag> answer(vecAnswer, 0);
+        GraphBLAS::Vector<double, GraphBLAS::SparseTag> w(5);
+        GraphBLAS::apply(w, GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
+                         GraphBLAS::RowIndex<double, double>(1), vA);
+        BOOST_CHECK_EQUAL(w, answer);
+    }
+    {
+        GraphBLAS::Vector<double, GraphBLAS::DenseTag> vA(vecA, 0);
+        GraphBLAS::Vector<double, GraphBLAS::DenseTag> answer(vecAnswer, 0);
+        GraphBLAS::Vector<double, GraphBLAS::DenseTag> w(5);
+        GraphBLAS::apply(w, GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
+                         GraphBLAS::RowIndex<double, double>(1), vA);
+        BOOST_CHECK_EQUAL(w, answer);
+
+        // In place, as the parent-list BFS does
+        GraphBLAS::apply(vA, GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
+                         GraphBLAS::RowIndex<double, double>(1), vA, true);
+        BOOST_CHECK_EQUAL(vA, answer);
+    }
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(apply_index_unary_matrix)
+{
+    std::vector<std::vector<double>> matA = {{8, 1, 0},
+                                             {0, 5, 7},
+                                             {4, 0, 0}};
+    std::vector<std::vector<double>> matRows = {{1, 1, 0},
+                                                {0, 2, 2},
+                                                {3, 0, 0}};
+    std::vector<std::vector<double>> matCols = {{1, 2, 0},
+                                                {0, 2, 3},
+                                                {1, 0, 0}};
+
+    GraphBLAS::Matrix<double> mA(matA, 0);
+    GraphBLAS::Matrix<double> rows_answer(matRows, 0);
+    GraphBLAS::Matrix<double> C(3, 3);
+    GraphBLAS::apply(C, GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
+                     GraphBLAS::RowIndex<double, double>(1), mA);
+    BOOST_CHECK_EQUAL(C, rows_answer);
+
+    GraphBLAS::Matrix<double, GraphBLAS::CsrStorageTag> mA_csr(matA, 0);
+    GraphBLAS::Matrix<double, GraphBLAS::CsrStorageTag> cols_answer(matCols, 0);
+    GraphBLAS::Matrix<double, GraphBLAS::CsrStorageTag> C_csr(3, 3);
+    GraphBLAS::apply(C_csr, GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
+                     GraphBLAS::ColIndex<double, double>(1), mA_csr);
+    BOOST_CHECK_EQUAL(C_csr, cols_answer);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(select_vector)
+{
+    std::vector<double> vecA = {8, 0, 6, 0, 5, 2};
+    std::vector<double> vecAnswer = {8, 0, 6, 0, 0, 0};
+
+    // A vector is a column: TriL(-3) keeps i >= 3, TriU(-3) keeps i <= 3
+    {
+        GraphBLAS::Vector<double, GraphBLAS::SparseTag> vA(vecA, 0);
+        GraphBLAS::Vector<double, GraphBLAS::SparseTag> answer(vecAnswer, 0);
+        GraphBLAS::Vector<double, GraphBLAS::SparseTag> w(6);
+        GraphBLAS::select(w, GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
+                          GraphBLAS::TriU<double>(-3), vA);
+        BOOST_CHECK_EQUAL(w, answer);
+    }
+    {
+        GraphBLAS::Vector<double, GraphBLAS::DenseTag> vA(vecA, 0);
+        GraphBLAS::Vector<double, GraphBLAS::DenseTag> answer(vecAnswer, 0);
+        GraphBLAS::Vector<double, GraphBLAS::DenseTag> w(6);
+        GraphBLAS::select(w, GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
+                          GraphBLAS::TriU<double>(-3), vA);
+        BOOST_CHECK_EQUAL(w, answer);
+    }
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(select_matrix)
+{
+    std::vector<std::vector<double>> matA = {{8, 1, 6},
+                                             {3, 5, 7},
+                                             {4, 9, 0}};
+    std::vector<std::vector<double>> matTriL = {{0, 0, 0},
+                                                {3, 0, 0},
+                                                {4, 9, 0}};
+    std::vector<std::vector<double>> matOffDiag = {{0, 1, 6},
+                                                   {3, 0, 7},
+                                                   {4, 9, 0}};
+
+    GraphBLAS::Matrix<double> mA(matA, 0);
+    GraphBLAS::Matrix<double> tril_answer(matTriL, 0);
+    GraphBLAS::Matrix<double> C(3, 3);
+    GraphBLAS::select(C, GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
+                      GraphBLAS::TriL<double>(-1), mA);
+    BOOST_CHECK_EQUAL(C, tril_answer);
+
+    // Strictly upper part of A is the strictly lower part of A'
+    GraphBLAS::Matrix<double> C_t(3, 3);
+    GraphBLAS::select(C_t, GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
+                      GraphBLAS::TriU<double>(1), GraphBLAS::transpose(mA));
+    GraphBLAS::Matrix<double> triu_t(3, 3);
+    GraphBLAS::transpose(triu_t, GraphBLAS::NoMask(),
+                         GraphBLAS::NoAccumulate(), tril_answer);
+    BOOST_CHECK_EQUAL(C_t, triu_t);
+
+    GraphBLAS::Matrix<double, GraphBLAS::CsrStorageTag> mA_csr(matA, 0);
+    GraphBLAS::Matrix<double, GraphBLAS::CsrStorageTag> offdiag_answer(
+        matOffDiag, 0);
+    GraphBLAS::Matrix<double, GraphBLAS::CsrStorageTag> C_csr(3, 3);
+    GraphBLAS::select(C_csr, GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
+                      GraphBLAS::OffDiag<double>(), mA_csr);
+    BOOST_CHECK_EQUAL(C_csr, offdiag_answer);
+
+    // Diag keeps the diagonal; with a complemented mask and replace
+    std::vector<std::vector<bool>> matMask = {{true, false, false},
+                                              {false, false, false},
+                                              {false, false, true}};
+    GraphBLAS::Matrix<bool> mask(matMask, false);
+    std::vector<std::vector<double>> matDiag = {{0, 0, 0},
+                                                {0, 5, 0},
+                                                {0, 0, 0}};
+    GraphBLAS::Matrix<double> diag_answer(matDiag, 0);
+    GraphBLAS::Matrix<double> D(matA, 0);
+    GraphBLAS::select(D, GraphBLAS::complement(mask),
+                      GraphBLAS::NoAccumulate(),
+                      GraphBLAS::Diag<double>(), mA, true);
+    BOOST_CHECK_EQUAL(D, diag_answer);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
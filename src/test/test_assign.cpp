@@ -453,6 +453,36 @@ BOOST_AUTO_TEST_CASE(sparse_assign_matrix_base)
     BOOST_CHECK_EQUAL(result, answer);
 }
 
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(sparse_assign_matrix_csr_storage)
+{
+    std::vector<std::vector<double>> matA = {{1, 6},
+                                             {9, 2}};
+    GraphBLAS::Matrix<double, GraphBLAS::CsrStorageTag> mA(matA, 0);
+
+    std::vector<std::vector<double>> matC = {{3, 0, 0},
+                                             {0, 4, 0},
+                                             {0, 0, 5}};
+    GraphBLAS::Matrix<double, GraphBLAS::CsrStorageTag> result(matC, 0);
+
+    std::vector<std::vector<double>> matAnswer = {{3, 0, 0},
+                                                  {9, 4, 2},
+                                                  {1, 0, 6}};
+    GraphBLAS::Matrix<double, GraphBLAS::CsrStorageTag> answer(matAnswer, 0);
+
+    GraphBLAS::IndexArrayType row_indices = {2, 1};
+    GraphBLAS::IndexArrayType col_indices = {0, 2};
+
+    GraphBLAS::assign(result,
+                      GraphBLAS::NoMask(),
+                      GraphBLAS::NoAccumulate(),
+                      mA,
+                      row_indices,
+                      col_indices);
+
+    BOOST_CHECK_EQUAL(result, answer);
+}
+
 //****************************************************************************
 BOOST_AUTO_TEST_CASE(sparse_assign_matrix_mask)
 {
@@ -673,4 +673,113 @@ BOOST_AUTO_TEST_CASE(bfs_level_masked_v2_test_one_root_integer)
     }
 }
 
+//****************************************************************************
+// Forced push-only, pull-only and switching traversals must all match the
+// existing parent and level BFS results.
+BOOST_AUTO_TEST_CASE(bfs_direction_optimizing_test_one_root)
+{
+    typedef double T;
+    typedef GraphBLAS::Matrix<T, GraphBLAS::DirectedMatrixTag> GrBMatrix;
+
+    GraphBLAS::IndexType const NUM_NODES(9);
+    GraphBLAS::IndexType const START_INDEX(5);
+
+    GraphBLAS::IndexArrayType i = {0, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3,
+                                   4, 4, 4, 5, 6, 6, 6, 8, 8};
+    GraphBLAS::IndexArrayType j = {3, 3, 6, 4, 5, 6, 8, 0, 1, 4, 6,
+                                   2, 3, 8, 2, 1, 2, 3, 2, 4};
+    std::vector<T> v(i.size(), 1);
+
+    GrBMatrix G_tn(NUM_NODES, NUM_NODES);
+    G_tn.build(i, j, v);
+
+    GraphBLAS::Vector<T> root(NUM_NODES);
+    root.setElement(START_INDEX, 1);
+
+    GraphBLAS::Vector<T> parents_answer(NUM_NODES);
+    algorithms::bfs(G_tn, root, parents_answer);
+    GraphBLAS::Vector<T> levels_answer(NUM_NODES);
+    algorithms::bfs_level_masked(G_tn, root, levels_answer);
+
+    // {alpha, beta}: push only, pull only, and the default switching
+    std::vector<std::pair<double, double> > params =
+        {{1.0e-9, 1.0e9}, {1.0e9, 1.0e9}, {14.0, 24.0}};
+    for (auto const &ab : params)
+    {
+        GraphBLAS::Vector<T> parent_list(NUM_NODES);
+        algorithms::bfs_direction_optimizing(G_tn, root, parent_list,
+                                             ab.first, ab.second);
+        BOOST_CHECK_EQUAL(parent_list, parents_answer);
+
+        GraphBLAS::Vector<T> levels(NUM_NODES);
+        algorithms::bfs_level_direction_optimizing(G_tn, root, levels,
+                                                   ab.first, ab.second);
+        BOOST_CHECK_EQUAL(levels, levels_answer);
+    }
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(bfs_direction_optimizing_test_larger_graph)
+{
+    typedef unsigned int T;
+    typedef GraphBLAS::Matrix<T> GrBMatrix;
+
+    // A low-diameter graph: a ring plus a few hub vertices
+    GraphBLAS::IndexType const NUM_NODES(500);
+    GraphBLAS::IndexArrayType i, j;
+    for (GraphBLAS::IndexType ix = 0; ix < NUM_NODES; ++ix)
+    {
+        i.push_back(ix); j.push_back((ix + 1) % NUM_NODES);
+        i.push_back(ix); j.push_back((ix*37 + 11) % NUM_NODES);
+        if (ix % 7 == 0)
+        {
+            i.push_back(3); j.push_back(ix);
+            i.push_back(ix); j.push_back(250);
+        }
+    }
+    std::vector<T> v(i.size(), 1);
+
+    GrBMatrix graph(NUM_NODES, NUM_NODES);
+    graph.build(i, j, v);
+    GrBMatrix graph_t(NUM_NODES, NUM_NODES);
+    GraphBLAS::transpose(graph_t, GraphBLAS::NoMask(),
+                         GraphBLAS::NoAccumulate(), graph);
+
+    for (GraphBLAS::IndexType src : {0UL, 3UL, 499UL})
+    {
+        GraphBLAS::Vector<T> root(NUM_NODES);
+        root.setElement(src, 1);
+
+        GraphBLAS::Vector<T> parents_answer(NUM_NODES);
+        algorithms::bfs(graph, root, parents_answer);
+        GraphBLAS::Vector<T> parent_list(NUM_NODES);
+        algorithms::bfs_direction_optimizing(graph, graph_t, root,
+                                             parent_list);
+        BOOST_CHECK_EQUAL(parent_list, parents_answer);
+
+        GraphBLAS::Vector<T> levels_answer(NUM_NODES);
+        algorithms::bfs_level_masked(graph, root, levels_answer);
+        GraphBLAS::Vector<T> levels(NUM_NODES);
+        algorithms::bfs_level_direction_optimizing(graph, graph_t, root,
+                                                   levels);
+        BOOST_CHECK_EQUAL(levels, levels_answer);
+
+        // First-found parents: same vertices reached, each parent is an
+        // in-neighbor one level closer to the root
+        GraphBLAS::Vector<T> any_parents(NUM_NODES);
+        algorithms::bfs_direction_optimizing(graph, graph_t, root,
+                                             any_parents, 1.0e9, 1.0e9,
+                                             false);
+        BOOST_CHECK_EQUAL(any_parents.nvals(), parents_answer.nvals());
+        for (GraphBLAS::IndexType ix = 0; ix < NUM_NODES; ++ix)
+        {
+            if (!any_parents.hasElement(ix) || ix == src) continue;
+            T p = any_parents.extractElement(ix);
+            BOOST_CHECK(graph.hasElement(p, ix));
+            BOOST_CHECK_EQUAL(levels_answer.extractElement(p) + 1,
+                              levels_answer.extractElement(ix));
+        }
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
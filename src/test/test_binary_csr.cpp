@@ -0,0 +1,273 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#include <graphblas/graphblas.hpp>
+
+using namespace GraphBLAS;
+
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_MODULE binary_csr_test_suite
+
+#include <boost/test/included/unit_test.hpp>
+
+namespace
+{
+    std::vector<std::vector<double>> mat = {{6, 0, 0, 4},
+                                            {7, 0, 0, 0},
+                                            {0, 0, 9, 4},
+                                            {2, 5, 0, 3},
+                                            {2, 0, 0, 1},
+                                            {0, 0, 0, 0},
+                                            {0, 1, 0, 2}};
+
+    // Removes the file when the test case is done with it.
+    struct TempFile
+    {
+        TempFile(std::string const &name) : path(name) {}
+        ~TempFile() { std::remove(path.c_str()); }
+        std::string path;
+    };
+
+    template <typename MatrixT>
+    void get_tuples(MatrixT const                               &A,
+                    IndexArrayType                              &i,
+                    IndexArrayType                              &j,
+                    std::vector<typename MatrixT::ScalarType>   &v)
+    {
+        i.resize(A.nvals());
+        j.resize(A.nvals());
+        v.resize(A.nvals());
+        A.extractTuples(i, j, v);
+    }
+
+    template <typename MatrixT, typename OtherMatrixT>
+    void check_same(MatrixT const &A, OtherMatrixT const &B)
+    {
+        BOOST_CHECK_EQUAL(A.nrows(), B.nrows());
+        BOOST_CHECK_EQUAL(A.ncols(), B.ncols());
+        BOOST_CHECK_EQUAL(A.nvals(), B.nvals());
+
+        IndexArrayType ia, ja, ib, jb;
+        std::vector<typename MatrixT::ScalarType> va, vb;
+        get_tuples(A, ia, ja, va);
+        get_tuples(B, ib, jb, vb);
+        BOOST_CHECK_EQUAL_COLLECTIONS(ia.begin(), ia.end(), ib.begin(), ib.end());
+        BOOST_CHECK_EQUAL_COLLECTIONS(ja.begin(), ja.end(), jb.begin(), jb.end());
+        BOOST_CHECK_EQUAL_COLLECTIONS(va.begin(), va.end(), vb.begin(), vb.end());
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(BOOST_TEST_MODULE)
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(binary_csr_test_round_trip)
+{
+    TempFile tmp("test_binary_csr_round_trip.gbcsr");
+    Matrix<double> A(mat, 0);
+    write_binary_csr(tmp.path, A);
+
+    auto B = read_binary_csr<Matrix<double, CsrStorageTag> >(tmp.path);
+    check_same(A, B);
+
+    auto C = read_binary_csr<Matrix<double> >(tmp.path);
+    check_same(A, C);
+
+    // Written from CSR storage: same file contents
+    TempFile tmp2("test_binary_csr_round_trip2.gbcsr");
+    write_binary_csr(tmp2.path, B);
+    auto D = read_binary_csr<Matrix<double> >(tmp2.path);
+    check_same(A, D);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(binary_csr_test_modify_after_load)
+{
+    TempFile tmp("test_binary_csr_modify.gbcsr");
+    Matrix<double> A(mat, 0);
+    write_binary_csr(tmp.path, A);
+
+    typedef Matrix<double, CsrStorageTag> CsrMatrixType;
+    CsrMatrixType B = read_binary_csr<CsrMatrixType>(tmp.path);
+    CsrMatrixType copy(B);
+
+    B.setElement(5, 2, 42.0);
+    B.setElement(0, 0, 1.5);
+    BOOST_CHECK_EQUAL(B.nvals(), A.nvals() + 1);
+    BOOST_CHECK_EQUAL(B.extractElement(5, 2), 42.0);
+    BOOST_CHECK_EQUAL(B.extractElement(0, 0), 1.5);
+
+    // Neither the copy nor the file saw the change
+    check_same(A, copy);
+    check_same(A, read_binary_csr<CsrMatrixType>(tmp.path));
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(binary_csr_test_masked_mxm_on_loaded)
+{
+    TempFile tmp("test_binary_csr_mxm.gbcsr");
+    Matrix<double> A(mat, 0);
+    write_binary_csr(tmp.path, A);
+
+    auto B = read_binary_csr<Matrix<double, CsrStorageTag> >(tmp.path);
+
+    Matrix<double> expected(A.nrows(), A.nrows());
+    mxm(expected, NoMask(), NoAccumulate(), ArithmeticSemiring<double>(),
+        A, transpose(A));
+
+    Matrix<double> result(A.nrows(), A.nrows());
+    mxm(result, NoMask(), NoAccumulate(), ArithmeticSemiring<double>(),
+        B, transpose(B));
+    BOOST_CHECK_EQUAL(result, expected);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(binary_csr_test_bool_and_empty_rows)
+{
+    TempFile tmp("test_binary_csr_bool.gbcsr");
+    Matrix<bool> A(1000, 500);
+    A.setElement(0, 499, true);
+    A.setElement(999, 0, true);
+    A.setElement(500, 250, false);
+    write_binary_csr(tmp.path, A);
+
+    auto B = read_binary_csr<Matrix<bool, CsrStorageTag> >(tmp.path);
+    check_same(A, B);
+    BOOST_CHECK_EQUAL(B.extractElement(500, 250), false);
+
+    auto C = read_binary_csr<Matrix<bool> >(tmp.path);
+    check_same(A, C);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(binary_csr_test_bad_files)
+{
+    TempFile tmp("test_binary_csr_bad.gbcsr");
+    Matrix<double> A(mat, 0);
+    write_binary_csr(tmp.path, A);
+
+    // Wrong value type
+    BOOST_CHECK_THROW((read_binary_csr<Matrix<float> >(tmp.path)),
+                      IOException);
+    BOOST_CHECK_THROW((read_binary_csr<Matrix<int64_t> >(tmp.path)),
+                      IOException);
+
+    // Missing file
+    BOOST_CHECK_THROW((read_binary_csr<Matrix<double> >("no_such_file.gbcsr")),
+                      IOException);
+
+    // Not a binary CSR file
+    TempFile text("test_binary_csr_bad.txt");
+    {
+        std::ofstream ofs(text.path);
+        ofs << "%%MatrixMarket matrix coordinate real general\n"
+            << "3 3 1\n1 1 1.0\n"
+            << std::string(100, ' ') << "\n";
+    }
+    BOOST_CHECK_THROW((read_binary_csr<Matrix<double> >(text.path)),
+                      IOException);
+
+    // Truncated
+    TempFile cut("test_binary_csr_cut.gbcsr");
+    {
+        std::ifstream ifs(tmp.path, std::ios::binary);
+        std::string bytes((std::istreambuf_iterator<char>(ifs)),
+                          std::istreambuf_iterator<char>());
+        std::ofstream ofs(cut.path, std::ios::binary);
+        ofs.write(bytes.data(), bytes.size() - 8);
+    }
+    BOOST_CHECK_THROW((read_binary_csr<Matrix<double> >(cut.path)),
+                      IOException);
+}
+
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(binary_csr_test_bad_header_and_columns)
+{
+    TempFile tmp("test_binary_csr_patch.gbcsr");
+    Matrix<double> A(mat, 0);
+    write_binary_csr(tmp.path, A);
+
+    std::string bytes;
+    {
+        std::ifstream ifs(tmp.path, std::ios::binary);
+        bytes.assign((std::istreambuf_iterator<char>(ifs)),
+                     std::istreambuf_iterator<char>());
+    }
+
+    // A row count whose array sizes wrap around 64 bits
+    TempFile huge("test_binary_csr_huge.gbcsr");
+    {
+        std::string patched(bytes);
+        uint64_t num_rows = (uint64_t(1) << 61) - 1;
+        uint64_t num_vals = 0;
+        std::memcpy(&patched[16], &num_rows, sizeof(num_rows));
+        std::memcpy(&patched[32], &num_vals, sizeof(num_vals));
+        std::ofstream ofs(huge.path, std::ios::binary);
+        ofs.write(patched.data(), 72);
+    }
+    BOOST_CHECK_THROW((read_binary_csr<Matrix<double> >(huge.path)),
+                      IOException);
+
+    // An out of range column index is found unless the file is trusted,
+    // and always when copying
+    TempFile bad_col("test_binary_csr_bad_col.gbcsr");
+    {
+        std::string patched(bytes);
+        uint64_t col = 1000;
+        uint64_t col_idx_off = 64 + 64*((8*(mat.size() + 1) + 63)/64);
+        std::memcpy(&patched[col_idx_off], &col, sizeof(col));
+        std::ofstream ofs(bad_col.path, std::ios::binary);
+        ofs.write(patched.data(), patched.size());
+    }
+    BOOST_CHECK_THROW(
+        (read_binary_csr<Matrix<double, CsrStorageTag> >(bad_col.path)),
+        IOException);
+    BOOST_CHECK_NO_THROW(
+        (read_binary_csr<Matrix<double, CsrStorageTag> >(bad_col.path, true)));
+    BOOST_CHECK_THROW((read_binary_csr<Matrix<double> >(bad_col.path)),
+                      IOException);
+    BOOST_CHECK_THROW((read_binary_csr<Matrix<double> >(bad_col.path, true)),
+                      IOException);
+
+    try
+    {
+        read_binary_csr<Matrix<double> >(huge.path);
+    }
+    catch (std::exception const &e)
+    {
+        BOOST_CHECK_EQUAL(std::string(e.what()).find("IOException: "), 0U);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
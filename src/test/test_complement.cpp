@@ -230,6 +230,58 @@ BOOST_AUTO_TEST_CASE(test_transpose_complement_nonsquare)
 }
 #endif
 
+//****************************************************************************
+// Writes through a complemented mask (which the kernels test per index
+// rather than expanding) must match the dense definition, including stored
+// false values in the mask.
+BOOST_AUTO_TEST_CASE(test_complement_mask_write_vs_dense)
+{
+    IndexType const N = 12;
+    std::vector<double> c_dense = {1, 0, 2, 0, 3, 0, 4, 0, 5, 0, 6, 0};
+    std::vector<double> u_dense = {0, 7, 7, 0, 0, 7, 7, 7, 0, 0, 7, 7};
+    std::vector<bool>   m_bits  = {1, 1, 0, 0, 1, 0, 1, 0, 0, 1, 1, 0};
+    std::vector<bool>   m_vals  = {1, 0, 0, 0, 1, 0, 1, 0, 0, 1, 0, 0};
+
+    Vector<double> u(u_dense, 0.);
+    Vector<bool> mask(N);
+    Matrix<double> uA(N, N), cA(N, N);
+    Matrix<bool> mA(N, N);
+    for (IndexType ix = 0; ix < N; ++ix)
+    {
+        if (m_bits[ix])
+        {
+            mask.setElement(ix, m_vals[ix]);
+            mA.setElement(ix, (ix*5) % N, m_vals[ix]);
+        }
+        if (u_dense[ix] != 0) uA.setElement(ix, (ix*5) % N, u_dense[ix]);
+        if (c_dense[ix] != 0) cA.setElement(ix, (ix*5) % N, c_dense[ix]);
+    }
+
+    for (bool replace : {false, true})
+    {
+        std::vector<double> ans(N, 0);
+        for (IndexType ix = 0; ix < N; ++ix)
+        {
+            bool allowed = !(m_bits[ix] && m_vals[ix]);
+            ans[ix] = allowed ? u_dense[ix] : (replace ? 0 : c_dense[ix]);
+        }
+
+        Vector<double> w(c_dense, 0.);
+        apply(w, complement(mask), NoAccumulate(), Identity<double>(), u,
+              replace);
+        BOOST_CHECK_EQUAL(w, Vector<double>(ans, 0.));
+
+        Matrix<double> C(cA), answer(N, N);
+        for (IndexType ix = 0; ix < N; ++ix)
+        {
+            if (ans[ix] != 0) answer.setElement(ix, (ix*5) % N, ans[ix]);
+        }
+        apply(C, complement(mA), NoAccumulate(), Identity<double>(), uA,
+              replace);
+        BOOST_CHECK_EQUAL(C, answer);
+    }
+}
+
 /// @todo Need many more tests involving vector masks
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -314,6 +314,35 @@ BOOST_AUTO_TEST_CASE(extract_stdmat_test_nomask_noaccum_notrans)
     }
 }
 
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(extract_stdmat_test_csr_storage)
+{
+    std::vector<std::vector<double>> matA = {{8, 1, 6, 0},
+                                             {0, 5, 7, 9},
+                                             {4, 0, 2, 0}};
+    Matrix<double, CsrStorageTag> A(matA, 0);
+
+    IndexArrayType arrayI({2,0,2});
+    IndexArrayType arrayJ({3,0,1,0});
+
+    Matrix<double, CsrStorageTag> C(3,4);
+    extract(C, NoMask(), NoAccumulate(), A, arrayI, arrayJ);
+
+    std::vector<std::vector<double>> ansMat ={{0, 4, 0, 4},
+                                              {0, 8, 1, 8},
+                                              {0, 4, 0, 4}};
+    Matrix<double, CsrStorageTag> answer(ansMat, 0.);
+    BOOST_CHECK_EQUAL(C, answer);
+
+    // column variant
+    std::vector<double> vecAnswer = {2, 6};
+    Vector<double> col_answer(vecAnswer, 0);
+    Vector<double> result(2);
+    IndexArrayType row_indices = {2, 0};
+    extract(result, NoMask(), NoAccumulate(), A, row_indices, (IndexType)2);
+    BOOST_CHECK_EQUAL(result, col_answer);
+}
+
 //****************************************************************************
 BOOST_AUTO_TEST_CASE(extract_stdmat_test_nomask_noaccum_trans)
 {
@@ -0,0 +1,157 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+#include <iostream>
+
+#include <graphblas/graphblas.hpp>
+
+using namespace GraphBLAS;
+
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_MODULE graph_generators_test_suite
+
+#include <boost/test/included/unit_test.hpp>
+
+namespace
+{
+    // True if every stored (i, j) has a stored (j, i).
+    template <typename MatrixT>
+    bool is_symmetric(MatrixT const &A)
+    {
+        IndexArrayType i(A.nvals()), j(A.nvals());
+        std::vector<typename MatrixT::ScalarType> v(A.nvals());
+        A.extractTuples(i, j, v);
+        for (IndexType ix = 0; ix < i.size(); ++ix)
+        {
+            if (!A.hasElement(j[ix], i[ix])) return false;
+        }
+        return true;
+    }
+
+    template <typename MatrixT>
+    bool has_self_loop(MatrixT const &A)
+    {
+        for (IndexType ix = 0; ix < A.nrows(); ++ix)
+        {
+            if (A.hasElement(ix, ix)) return true;
+        }
+        return false;
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(BOOST_TEST_MODULE)
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(rmat_test_reproducible)
+{
+    auto A = rmat<Matrix<bool> >(10, 8, 42);
+    auto B = rmat<Matrix<bool> >(10, 8, 42);
+    auto C = rmat<Matrix<bool> >(10, 8, 43);
+
+    BOOST_CHECK_EQUAL(A.nrows(), 1024);
+    BOOST_CHECK_EQUAL(A.ncols(), 1024);
+    BOOST_CHECK(A.nvals() > 0);
+    BOOST_CHECK(A.nvals() <= 8*1024);
+    BOOST_CHECK_EQUAL(A, B);
+    BOOST_CHECK(A != C);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(rmat_test_skewed_degrees)
+{
+    // Without relabelling, vertex 0 collects the most edges (a is the
+    // largest quadrant probability); a uniform graph of the same size has
+    // a far smaller maximum degree.
+    auto A = rmat<Matrix<IndexType> >(12, 16, 7, false, false);
+    auto U = uniform_random_graph<Matrix<IndexType> >(4096, 16*4096, 7);
+
+    Vector<IndexType> deg_a(4096), deg_u(4096);
+    reduce(deg_a, NoMask(), NoAccumulate(), PlusMonoid<IndexType>(), A);
+    reduce(deg_u, NoMask(), NoAccumulate(), PlusMonoid<IndexType>(), U);
+
+    IndexType max_a(0), max_u(0);
+    reduce(max_a, NoAccumulate(), MaxMonoid<IndexType>(), deg_a);
+    reduce(max_u, NoAccumulate(), MaxMonoid<IndexType>(), deg_u);
+
+    BOOST_CHECK_EQUAL(deg_a.extractElement(0), max_a);
+    BOOST_CHECK(max_a > 10*max_u);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(rmat_test_symmetric_no_loops)
+{
+    auto A = rmat<Matrix<double> >(8, 16, 3, true, true, false, 2.5);
+
+    BOOST_CHECK(is_symmetric(A));
+    BOOST_CHECK(!has_self_loop(A));
+
+    double max_val(0);
+    reduce(max_val, NoAccumulate(), MaxMonoid<double>(), A);
+    BOOST_CHECK_EQUAL(max_val, 2.5);
+
+    BOOST_CHECK_THROW((rmat<Matrix<bool> >(8, 16, 1, false, true, true,
+                                           true, 0.6, 0.3, 0.3)),
+                      InvalidValueException);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(uniform_random_graph_test)
+{
+    auto A = uniform_random_graph<Matrix<int> >(500, 2000, 11, true);
+    auto B = uniform_random_graph<Matrix<int> >(500, 2000, 11, true);
+
+    BOOST_CHECK_EQUAL(A, B);
+    BOOST_CHECK(is_symmetric(A));
+    BOOST_CHECK(!has_self_loop(A));
+    BOOST_CHECK(A.nvals() <= 2*2000);
+    BOOST_CHECK(A.nvals() > 2*2000*9/10);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(grid_test)
+{
+    IndexType const NX = 7, NY = 5, NZ = 3;
+
+    auto G2 = grid_2d<Matrix<bool> >(NX, NY);
+    BOOST_CHECK_EQUAL(G2.nrows(), NX*NY);
+    BOOST_CHECK_EQUAL(G2.nvals(), 2*((NX - 1)*NY + NX*(NY - 1)));
+    BOOST_CHECK(is_symmetric(G2));
+    BOOST_CHECK(G2.hasElement(0, 1));
+    BOOST_CHECK(G2.hasElement(0, NX));
+    BOOST_CHECK(!G2.hasElement(NX - 1, NX));   // no wrap around
+
+    auto G3 = grid_3d<Matrix<bool> >(NX, NY, NZ);
+    BOOST_CHECK_EQUAL(G3.nrows(), NX*NY*NZ);
+    BOOST_CHECK_EQUAL(G3.nvals(), 2*((NX - 1)*NY*NZ + NX*(NY - 1)*NZ +
+                                     NX*NY*(NZ - 1)));
+    BOOST_CHECK(is_symmetric(G3));
+    BOOST_CHECK(G3.hasElement(0, NX*NY));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -28,6 +28,7 @@
  */
 
 #include <iostream>
+#include <set>
 
 #include <graphblas/graphblas.hpp>
 #include <algorithms/k_truss.hpp>
@@ -72,6 +73,43 @@ BOOST_AUTO_TEST_CASE(k_truss_test_basic)
     // TODO test for correct contents
 }
 
+//****************************************************************************
+// The adjacency A<!Diag> = E'*E is masked by a pattern-stored diagonal; check
+// that the surviving edges are exactly the ones on triangles.
+BOOST_AUTO_TEST_CASE(k_truss_test_contents)
+{
+    typedef int32_t T;
+    IndexType num_nodes = 5;
+    IndexType num_edges = 6;
+    IndexArrayType edge_num = {0, 1, 2, 3, 4, 5,  0, 1, 2, 3, 4, 5};
+    IndexArrayType node_num = {0, 1, 0, 2, 0, 1,  1, 2, 3, 3, 2, 4};
+    std::vector<T> val(edge_num.size(), 1);
+
+    Matrix<T> E(num_edges, num_nodes);
+    E.build(edge_num.begin(), node_num.begin(), val.begin(), val.size());
+
+    auto Eout3 = k_truss(E, 3);
+    BOOST_REQUIRE_EQUAL(Eout3.nrows(), 5);
+    BOOST_CHECK_EQUAL(Eout3.nvals(), 10);
+
+    std::set<std::pair<IndexType, IndexType> > edges;
+    for (IndexType e = 0; e < Eout3.nrows(); ++e)
+    {
+        std::vector<IndexType> ends;
+        for (IndexType v = 0; v < num_nodes; ++v)
+        {
+            if (Eout3.hasElement(e, v)) ends.push_back(v);
+        }
+        BOOST_REQUIRE_EQUAL(ends.size(), 2U);
+        edges.insert(std::make_pair(ends[0], ends[1]));
+    }
+
+    // Edge (1, 4) is on no triangle
+    std::set<std::pair<IndexType, IndexType> > answer =
+        {{0, 1}, {1, 2}, {0, 3}, {2, 3}, {0, 2}};
+    BOOST_CHECK(edges == answer);
+}
+
 //****************************************************************************
 BOOST_AUTO_TEST_CASE(k_truss_test2)
 {
@@ -102,4 +102,49 @@ BOOST_AUTO_TEST_CASE(matrix_build_test_iterators)
     }
 }
 
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(matrix_move_and_swap_test)
+{
+    IndexArrayType i = {0, 0, 0, 1, 1, 1, 2, 2};
+    IndexArrayType j = {1, 2, 3, 0, 2, 3, 0, 1};
+    std::vector<double>       v = {1, 2, 3, 4, 6, 7, 8, 9};
+
+    Matrix<double, DirectedMatrixTag> ans(3, 4);
+    ans.build(i, j, v);
+
+    Matrix<double, DirectedMatrixTag> m1(ans);
+    Matrix<double, DirectedMatrixTag> m2(std::move(m1));
+    BOOST_CHECK_EQUAL(m2, ans);
+    BOOST_CHECK_EQUAL(m1.nvals(), 0);
+
+    // move assignment takes the shape of the source
+    Matrix<double, DirectedMatrixTag> m3(2, 2);
+    m3 = std::move(m2);
+    BOOST_CHECK_EQUAL(m3, ans);
+    BOOST_CHECK_EQUAL(m2.nrows(), 0);
+    BOOST_CHECK_EQUAL(m2.nvals(), 0);
+
+    Matrix<double, DirectedMatrixTag> m4(2, 2);
+    m4.setElement(1, 1, 5.0);
+    swap(m3, m4);
+    BOOST_CHECK_EQUAL(m4, ans);
+    BOOST_CHECK_EQUAL(m3.nrows(), 2);
+    BOOST_CHECK_EQUAL(m3.extractElement(1, 1), 5.0);
+
+    Vector<double> w1(std::vector<double>{1, 0, 3}, 0.0);
+    Vector<double> w2(std::move(w1));
+    BOOST_CHECK_EQUAL(w2.nvals(), 2);
+    BOOST_CHECK_EQUAL(w1.nvals(), 0);
+
+    Vector<double> w3(5);
+    w3 = std::move(w2);
+    BOOST_CHECK_EQUAL(w3.size(), 3);
+    BOOST_CHECK_EQUAL(w3.extractElement(2), 3.0);
+
+    Vector<double> w4(4);
+    w3.swap(w4);
+    BOOST_CHECK_EQUAL(w3.size(), 4);
+    BOOST_CHECK_EQUAL(w4.nvals(), 2);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,234 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#include <graphblas/graphblas.hpp>
+
+using namespace GraphBLAS;
+
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_MODULE matrix_io_test_suite
+
+#include <boost/test/included/unit_test.hpp>
+
+namespace
+{
+    // Writes 'text' to a file that is removed when the test case is done.
+    struct TempFile
+    {
+        TempFile(std::string const &name, std::string const &text = "")
+            : path(name)
+        {
+            std::ofstream ofs(path, std::ios::binary);
+            ofs << text;
+        }
+        ~TempFile() { std::remove(path.c_str()); }
+
+        std::string contents() const
+        {
+            std::ifstream ifs(path, std::ios::binary);
+            std::stringstream ss;
+            ss << ifs.rdbuf();
+            return ss.str();
+        }
+
+        std::string path;
+    };
+
+    std::vector<std::vector<double>> mat = {{6, 0, 0, 4},
+                                            {7, 0, 0, 0},
+                                            {0, 0, 9, 4},
+                                            {2, 5, 0, 3},
+                                            {2, 0, 0, 1},
+                                            {0, 0, 0, 0},
+                                            {0, 1, 0, 2}};
+}
+
+BOOST_AUTO_TEST_SUITE(BOOST_TEST_MODULE)
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(matrix_io_test_read_matrix_market)
+{
+    TempFile tmp("test_matrix_io_mm.mtx",
+                 "%%MatrixMarket matrix coordinate real general\n"
+                 "% a comment\n"
+                 "%\n"
+                 "7 4 12\n"
+                 "1 1 6\n1 4 4.0\n2 1 7e0\n3 3 9\n3 4 4\n4 1 2\n"
+                 "4 2 5\n4 4 3\n5 1 2\n5 4 1\n7 2 1\n7 4 0.2e1\n");
+    auto A = read_matrix_market<Matrix<double> >(tmp.path);
+    BOOST_CHECK_EQUAL(A, Matrix<double>(mat, 0));
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(matrix_io_test_read_matrix_market_symmetric)
+{
+    TempFile sym("test_matrix_io_sym.mtx",
+                 "%%MatrixMarket matrix coordinate integer symmetric\n"
+                 "3 3 3\n"
+                 "1 1 5\n3 1 -2\r\n3 2 7\n");
+    std::vector<std::vector<int>> sym_dense = {{5, 0, -2},
+                                               {0, 0, 7},
+                                               {-2, 7, 0}};
+    auto A = read_matrix_market<Matrix<int> >(sym.path);
+    BOOST_CHECK_EQUAL(A, Matrix<int>(sym_dense, 0));
+
+    TempFile skew("test_matrix_io_skew.mtx",
+                  "%%MatrixMarket matrix coordinate real skew-symmetric\n"
+                  "3 3 2\n"
+                  "2 1 1.5\n3 2 -4\n");
+    std::vector<std::vector<double>> skew_dense = {{0, -1.5, 0},
+                                                   {1.5, 0, 4},
+                                                   {0, -4, 0}};
+    auto B = read_matrix_market<Matrix<double> >(skew.path);
+    BOOST_CHECK_EQUAL(B, Matrix<double>(skew_dense, 0));
+
+    TempFile pattern("test_matrix_io_pattern.mtx",
+                     "%%MatrixMarket matrix coordinate pattern general\n"
+                     "2 3 2\n"
+                     "1 3\n2 1\n");
+    auto C = read_matrix_market<Matrix<bool> >(pattern.path);
+    BOOST_CHECK_EQUAL(C.nvals(), 2);
+    BOOST_CHECK_EQUAL(C.extractElement(0, 2), true);
+    BOOST_CHECK_EQUAL(C.extractElement(1, 0), true);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(matrix_io_test_matrix_market_round_trip)
+{
+    TempFile tmp("test_matrix_io_round_trip.mtx");
+
+    Matrix<double> A(mat, 0);
+    A.setElement(5, 3, 0.1);
+    A.setElement(5, 0, -1.0/3.0);
+    A.setElement(5, 1, 6.02214076e23);
+    write_matrix_market(tmp.path, A);
+    BOOST_CHECK_EQUAL(read_matrix_market<Matrix<double> >(tmp.path), A);
+
+    // Lower triangle only, mirrored on the way back in
+    auto G = rmat<Matrix<int64_t> >(8, 4, 7, true);
+    write_matrix_market(tmp.path, G, true);
+    BOOST_CHECK(tmp.contents().find("symmetric") != std::string::npos);
+    BOOST_CHECK_EQUAL(read_matrix_market<Matrix<int64_t> >(tmp.path), G);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(matrix_io_test_edge_list)
+{
+    TempFile tsv("test_matrix_io_edges.tsv",
+                 "# src\tdst\n"
+                 "0\t1\n"
+                 "0\t2\n"
+                 "\n"
+                 "3\t1\n");
+    auto A = read_edge_list<Matrix<int> >(tsv.path);
+    BOOST_CHECK_EQUAL(A.nrows(), 4);
+    BOOST_CHECK_EQUAL(A.nvals(), 3);
+    BOOST_CHECK_EQUAL(A.extractElement(3, 1), 1);
+
+    auto S = read_edge_list<Matrix<int> >(tsv.path, 10, true);
+    BOOST_CHECK_EQUAL(S.nrows(), 10);
+    BOOST_CHECK_EQUAL(S.nvals(), 6);
+    BOOST_CHECK_EQUAL(S.extractElement(1, 3), 1);
+
+    TempFile csv("test_matrix_io_edges.csv",
+                 "1,2,0.5\n"
+                 "2, 3, 1.5\n"
+                 "1,2,2.5\n");
+    auto W = read_edge_list<Matrix<double> >(csv.path, 0, false, true,
+                                             Plus<double>());
+    BOOST_CHECK_EQUAL(W.nrows(), 3);
+    BOOST_CHECK_EQUAL(W.nvals(), 2);
+    BOOST_CHECK_EQUAL(W.extractElement(0, 1), 3.0);
+    BOOST_CHECK_EQUAL(W.extractElement(1, 2), 1.5);
+
+    // Round trip
+    TempFile out("test_matrix_io_out.tsv");
+    Matrix<double> M(mat, 0);
+    write_edge_list(out.path, M);
+    auto M2 = read_edge_list<Matrix<double> >(out.path, M.nrows());
+    BOOST_CHECK_EQUAL(M2.nvals(), M.nvals());
+    BOOST_CHECK_EQUAL(M2.extractElement(6, 3), 2.0);
+
+    write_edge_list(out.path, M, ',', false, true);
+    std::string text(out.contents());
+    BOOST_CHECK_EQUAL(text.substr(0, text.find('\n')), "1,1");
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(matrix_io_test_large_edge_list)
+{
+    // Big enough to be parsed in several chunks
+    auto G = uniform_random_graph<Matrix<uint32_t> >(5000, 200000, 3);
+    TempFile out("test_matrix_io_large.tsv");
+    write_edge_list(out.path, G);
+    BOOST_CHECK_EQUAL(read_edge_list<Matrix<uint32_t> >(out.path, 5000), G);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(matrix_io_test_bad_files)
+{
+    BOOST_CHECK_THROW((read_matrix_market<Matrix<double> >("no_such_file.mtx")),
+                      IOException);
+
+    TempFile array("test_matrix_io_array.mtx",
+                   "%%MatrixMarket matrix array real general\n2 2\n1\n2\n3\n4\n");
+    BOOST_CHECK_THROW((read_matrix_market<Matrix<double> >(array.path)),
+                      IOException);
+
+    TempFile range("test_matrix_io_range.mtx",
+                   "%%MatrixMarket matrix coordinate real general\n"
+                   "2 2 2\n1 1 1.0\n3 1 1.0\n");
+    BOOST_CHECK_THROW((read_matrix_market<Matrix<double> >(range.path)),
+                      IOException);
+
+    TempFile count("test_matrix_io_count.mtx",
+                   "%%MatrixMarket matrix coordinate real general\n"
+                   "2 2 3\n1 1 1.0\n2 1 1.0\n");
+    BOOST_CHECK_THROW((read_matrix_market<Matrix<double> >(count.path)),
+                      IOException);
+
+    TempFile missing("test_matrix_io_missing.mtx",
+                     "%%MatrixMarket matrix coordinate real general\n"
+                     "2 2 1\n1 1\n");
+    BOOST_CHECK_THROW((read_matrix_market<Matrix<double> >(missing.path)),
+                      IOException);
+
+    TempFile bad("test_matrix_io_bad.tsv", "0 1\n1 x\n");
+    BOOST_CHECK_THROW((read_edge_list<Matrix<double> >(bad.path)),
+                      IOException);
+    BOOST_CHECK_THROW((read_edge_list<Matrix<double> >(bad.path, 0, false, true)),
+                      IOException);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -557,6 +557,122 @@ BOOST_AUTO_TEST_CASE(test_mxm_reg_sparse)
     }
 }
 
+//****************************************************************************
+// Larger, non-square product checked against a dense reference, for both
+// storage engines and a transposed B.
+BOOST_AUTO_TEST_CASE(test_mxm_min_plus_vs_dense_reference)
+{
+    GraphBLAS::IndexType const M = 23, K = 31, N = 17;
+    int const NIL(-1);
+
+    std::vector<std::vector<int> > A(M, std::vector<int>(K, NIL));
+    std::vector<std::vector<int> > B(K, std::vector<int>(N, NIL));
+    std::vector<std::vector<int> > Bt(N, std::vector<int>(K, NIL));
+    for (GraphBLAS::IndexType i = 0; i < M; ++i)
+        for (GraphBLAS::IndexType k = 0; k < K; ++k)
+            if ((i*7 + k*3) % 5 == 0) A[i][k] = (i + 2*k) % 11;
+    for (GraphBLAS::IndexType k = 0; k < K; ++k)
+        for (GraphBLAS::IndexType j = 0; j < N; ++j)
+            if ((k*5 + j) % 4 == 1) B[k][j] = Bt[j][k] = (3*k + j) % 13;
+
+    std::vector<std::vector<int> > ans(M, std::vector<int>(N, NIL));
+    for (GraphBLAS::IndexType i = 0; i < M; ++i)
+        for (GraphBLAS::IndexType j = 0; j < N; ++j)
+            for (GraphBLAS::IndexType k = 0; k < K; ++k)
+                if ((A[i][k] != NIL) && (B[k][j] != NIL))
+                {
+                    int val = A[i][k] + B[k][j];
+                    if ((ans[i][j] == NIL) || (val < ans[i][j])) ans[i][j] = val;
+                }
+
+    GraphBLAS::Matrix<int> answer(ans, NIL);
+    BOOST_CHECK(answer.nvals() > 0);
+
+    GraphBLAS::Matrix<int> mA(A, NIL), mB(B, NIL), mBt(Bt, NIL);
+    GraphBLAS::Matrix<int> result(M, N);
+    GraphBLAS::mxm(result,
+                   GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
+                   GraphBLAS::MinPlusSemiring<int>(), mA, mB);
+    BOOST_CHECK_EQUAL(result, answer);
+
+    GraphBLAS::Matrix<int> result_t(M, N);
+    GraphBLAS::mxm(result_t,
+                   GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
+                   GraphBLAS::MinPlusSemiring<int>(), mA, transpose(mBt));
+    BOOST_CHECK_EQUAL(result_t, answer);
+
+    GraphBLAS::Matrix<int, GraphBLAS::CsrStorageTag> cA(A, NIL), cB(B, NIL);
+    GraphBLAS::Matrix<int, GraphBLAS::CsrStorageTag> cresult(M, N);
+    GraphBLAS::Matrix<int, GraphBLAS::CsrStorageTag> canswer(ans, NIL);
+    GraphBLAS::mxm(cresult,
+                   GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
+                   GraphBLAS::MinPlusSemiring<int>(), cA, cB);
+    BOOST_CHECK_EQUAL(cresult, canswer);
+}
+
+//****************************************************************************
+// Masked products (computed only inside the mask) must match the unmasked
+// product restricted to the mask, for plain and complemented masks and for
+// both the masked dot and masked Gustavson kernels.
+BOOST_AUTO_TEST_CASE(test_mxm_masked_vs_unmasked)
+{
+    GraphBLAS::IndexType const M = 19, K = 27, N = 21;
+
+    std::vector<std::vector<double> > A(M, std::vector<double>(K, 0));
+    std::vector<std::vector<double> > Bt(N, std::vector<double>(K, 0));
+    std::vector<std::vector<double> > B(K, std::vector<double>(N, 0));
+    std::vector<std::vector<bool> > mask(M, std::vector<bool>(N, false));
+    for (GraphBLAS::IndexType i = 0; i < M; ++i)
+        for (GraphBLAS::IndexType k = 0; k < K; ++k)
+            if ((i*3 + k*2) % 4 == 0) A[i][k] = double(i + k + 1);
+    for (GraphBLAS::IndexType k = 0; k < K; ++k)
+        for (GraphBLAS::IndexType j = 0; j < N; ++j)
+            if ((k + j*5) % 3 == 0) B[k][j] = Bt[j][k] = double(k*j % 7 + 1);
+    for (GraphBLAS::IndexType i = 0; i < M; ++i)
+        for (GraphBLAS::IndexType j = 0; j < N; ++j)
+            mask[i][j] = ((i + 2*j) % 7 == 1);
+
+    GraphBLAS::Matrix<double> mA(A, 0.), mB(B, 0.), mBt(Bt, 0.);
+    GraphBLAS::Matrix<double, GraphBLAS::ColumnIndexTag> mBi(B, 0.);
+    GraphBLAS::Matrix<bool> mM(mask, false);
+
+    GraphBLAS::Matrix<double> full(M, N);
+    GraphBLAS::mxm(full, GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
+                   GraphBLAS::ArithmeticSemiring<double>(), mA, mB);
+
+    std::vector<std::vector<double> > in(M, std::vector<double>(N, 0));
+    std::vector<std::vector<double> > out(M, std::vector<double>(N, 0));
+    for (GraphBLAS::IndexType i = 0; i < M; ++i)
+        for (GraphBLAS::IndexType j = 0; j < N; ++j)
+            if (full.hasElement(i, j))
+                (mask[i][j] ? in : out)[i][j] = full.extractElement(i, j);
+    GraphBLAS::Matrix<double> ans_in(in, 0.), ans_out(out, 0.);
+    BOOST_CHECK(ans_in.nvals() > 0);
+    BOOST_CHECK(ans_out.nvals() > 0);
+
+    GraphBLAS::Matrix<double> result(M, N);
+    GraphBLAS::mxm(result, mM, GraphBLAS::NoAccumulate(),
+                   GraphBLAS::ArithmeticSemiring<double>(), mA, mB, true);
+    BOOST_CHECK_EQUAL(result, ans_in);
+
+    GraphBLAS::Matrix<double> result_t(M, N);
+    GraphBLAS::mxm(result_t, mM, GraphBLAS::NoAccumulate(),
+                   GraphBLAS::ArithmeticSemiring<double>(), mA,
+                   transpose(mBt), true);
+    BOOST_CHECK_EQUAL(result_t, ans_in);
+
+    GraphBLAS::Matrix<double> result_i(M, N);
+    GraphBLAS::mxm(result_i, mM, GraphBLAS::NoAccumulate(),
+                   GraphBLAS::ArithmeticSemiring<double>(), mA, mBi, true);
+    BOOST_CHECK_EQUAL(result_i, ans_in);
+
+    GraphBLAS::Matrix<double> result_c(M, N);
+    GraphBLAS::mxm(result_c, GraphBLAS::complement(mM),
+                   GraphBLAS::NoAccumulate(),
+                   GraphBLAS::ArithmeticSemiring<double>(), mA, mB, true);
+    BOOST_CHECK_EQUAL(result_c, ans_out);
+}
+
 //****************************************************************************
 BOOST_AUTO_TEST_CASE(test_mxm_stored_zero_result)
 {
@@ -1938,4 +2054,125 @@ BOOST_AUTO_TEST_CASE(test_a_equals_c_transpose3)
     BOOST_CHECK_EQUAL(result, answer);
 }
 
+//****************************************************************************
+// Rows of A sized so that the Gustavson kernel uses each of its row
+// accumulators (single row, sorted, hashed and dense).
+namespace
+{
+    void build_accumulator_operands(
+        GraphBLAS::Matrix<int, DirectedMatrixTag> &mA,
+        GraphBLAS::Matrix<int, DirectedMatrixTag> &mB,
+        std::vector<std::vector<int> >            &dense_answer)
+    {
+        GraphBLAS::IndexType const K(mB.nrows()), N(mB.ncols());
+        std::vector<std::vector<int> > dB(K, std::vector<int>(N, 0));
+        IndexArrayType i_B, j_B;
+        std::vector<int> v_B;
+        for (GraphBLAS::IndexType k = 0; k < K; ++k)
+            for (GraphBLAS::IndexType j = 0; j < N; ++j)
+                if ((k*37 + j*11) % 250 == 0)
+                {
+                    dB[k][j] = int(k + j % 7 + 1);
+                    i_B.push_back(k); j_B.push_back(j);
+                    v_B.push_back(dB[k][j]);
+                }
+        mB.build(i_B, j_B, v_B);
+
+        // row 0: one entry; row 1: a few products; row 2: 10 entries;
+        // row 3: every row of B; row 4: empty
+        std::vector<GraphBLAS::IndexType> row_len = {1, 2, 10, K, 0};
+        std::vector<std::vector<int> > dA(row_len.size(),
+                                          std::vector<int>(K, 0));
+        IndexArrayType i_A, j_A;
+        std::vector<int> v_A;
+        for (GraphBLAS::IndexType i = 0; i < row_len.size(); ++i)
+            for (GraphBLAS::IndexType k = 0; k < row_len[i]; ++k)
+            {
+                dA[i][(k*3 + i) % K] = int(i + k + 2);
+                i_A.push_back(i); j_A.push_back((k*3 + i) % K);
+                v_A.push_back(dA[i][(k*3 + i) % K]);
+            }
+        mA.build(i_A, j_A, v_A);
+
+        dense_answer.assign(row_len.size(), std::vector<int>(N, 0));
+        for (GraphBLAS::IndexType i = 0; i < row_len.size(); ++i)
+            for (GraphBLAS::IndexType k = 0; k < K; ++k)
+                for (GraphBLAS::IndexType j = 0; j < N; ++j)
+                    dense_answer[i][j] += dA[i][k]*dB[k][j];
+    }
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_mxm_row_accumulators)
+{
+    GraphBLAS::Matrix<int, DirectedMatrixTag> mA(5, 50), mB(50, 2000);
+    std::vector<std::vector<int> > dense_answer;
+    build_accumulator_operands(mA, mB, dense_answer);
+
+    GraphBLAS::Matrix<int, DirectedMatrixTag> answer(dense_answer, 0);
+    GraphBLAS::Matrix<int, DirectedMatrixTag> result(5, 2000);
+    mxm(result,
+        GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
+        GraphBLAS::ArithmeticSemiring<int>(), mA, mB);
+    BOOST_CHECK_EQUAL(result, answer);
+
+    // Same product through the transposed-operand paths
+    GraphBLAS::Matrix<int, DirectedMatrixTag> mAT(50, 5), mBT(2000, 50);
+    GraphBLAS::transpose(mAT, GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
+                         mA);
+    GraphBLAS::transpose(mBT, GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
+                         mB);
+    GraphBLAS::Matrix<int, DirectedMatrixTag> result2(5, 2000);
+    mxm(result2,
+        GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
+        GraphBLAS::ArithmeticSemiring<int>(),
+        transpose(mAT), transpose(mBT));
+    BOOST_CHECK_EQUAL(result2, answer);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_mxm_row_accumulators_masked)
+{
+    GraphBLAS::Matrix<int, DirectedMatrixTag> mA(5, 50), mB(50, 2000);
+    std::vector<std::vector<int> > dense_answer;
+    build_accumulator_operands(mA, mB, dense_answer);
+
+    // Mask: every third column
+    std::vector<std::vector<bool> > dense_mask(5,
+                                               std::vector<bool>(2000, false));
+    IndexArrayType i_M, j_M;
+    std::vector<bool> v_M;
+    for (GraphBLAS::IndexType i = 0; i < 5; ++i)
+        for (GraphBLAS::IndexType j = 0; j < 2000; j += 3)
+        {
+            dense_mask[i][j] = true;
+            i_M.push_back(i); j_M.push_back(j); v_M.push_back(true);
+        }
+    GraphBLAS::Matrix<bool, DirectedMatrixTag> M(5, 2000);
+    M.build(i_M, j_M, v_M);
+
+    std::vector<std::vector<int> > dense_masked(dense_answer);
+    std::vector<std::vector<int> > dense_comp(dense_answer);
+    for (GraphBLAS::IndexType i = 0; i < 5; ++i)
+        for (GraphBLAS::IndexType j = 0; j < 2000; ++j)
+        {
+            if (dense_mask[i][j]) dense_comp[i][j] = 0;
+            else                  dense_masked[i][j] = 0;
+        }
+
+    GraphBLAS::Matrix<int, DirectedMatrixTag> result(5, 2000);
+    mxm(result, M, GraphBLAS::NoAccumulate(),
+        GraphBLAS::ArithmeticSemiring<int>(), mA, mB, true);
+    BOOST_CHECK_EQUAL(result,
+                      (GraphBLAS::Matrix<int, DirectedMatrixTag>(dense_masked,
+                                                                 0)));
+
+    GraphBLAS::Matrix<int, DirectedMatrixTag> result2(5, 2000);
+    mxm(result2, GraphBLAS::complement(M), GraphBLAS::NoAccumulate(),
+        GraphBLAS::ArithmeticSemiring<int>(), mA, mB, true);
+    BOOST_CHECK_EQUAL(result2,
+                      (GraphBLAS::Matrix<int, DirectedMatrixTag>(dense_comp,
+                                                                 0)));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
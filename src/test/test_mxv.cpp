@@ -194,6 +194,45 @@ BOOST_AUTO_TEST_CASE(test_a_transpose)
     BOOST_CHECK_EQUAL(result4, ansB);
 }
 
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_mxv_csr_storage)
+{
+    GraphBLAS::Matrix<double, GraphBLAS::CsrStorageTag> mA(m3x3_dense, 0.);
+    GraphBLAS::Matrix<double, GraphBLAS::CsrStorageTag> mB(m3x4_dense, 0.);
+    GraphBLAS::Vector<double> u3(u3_dense, 0.);
+    GraphBLAS::Vector<double> u4(u4_dense, 0.);
+    GraphBLAS::Vector<double> result(3);
+    GraphBLAS::Vector<double> ansA(ans3_dense, 0.);
+    GraphBLAS::Vector<double> ansB(ans4_dense, 0.);
+
+    GraphBLAS::mxv(result,
+                   GraphBLAS::NoMask(),
+                   GraphBLAS::NoAccumulate(),
+                   GraphBLAS::ArithmeticSemiring<double>(),
+                   mA,
+                   u3);
+    BOOST_CHECK_EQUAL(result, ansA);
+
+    GraphBLAS::mxv(result,
+                   GraphBLAS::NoMask(),
+                   GraphBLAS::NoAccumulate(),
+                   GraphBLAS::ArithmeticSemiring<double>(),
+                   mB,
+                   u4);
+    BOOST_CHECK_EQUAL(result, ansB);
+
+    std::vector<double> ansBT_dense = {11, 7, 1, 2};
+    GraphBLAS::Vector<double> ansBT(ansBT_dense, 0.);
+    GraphBLAS::Vector<double> result4(4);
+    GraphBLAS::mxv(result4,
+                   GraphBLAS::NoMask(),
+                   GraphBLAS::NoAccumulate(),
+                   GraphBLAS::ArithmeticSemiring<double>(),
+                   transpose(mB),
+                   u3);
+    BOOST_CHECK_EQUAL(result4, ansBT);
+}
+
 //****************************************************************************
 // Tests using a mask with REPLACE
 //****************************************************************************
@@ -774,4 +813,46 @@ BOOST_AUTO_TEST_CASE(mxv_reg)
 }
 
 
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(mxv_any_pair_semirings)
+{
+    std::vector<std::vector<double>> A_dense = {{8, 1, 6, 0},
+                                                {3, 0, 7, 0},
+                                                {0, 0, 0, 0},
+                                                {0, 9, 2, 5}};
+    GraphBLAS::Matrix<double> A(A_dense, 0.);
+
+    std::vector<double> u_dense = {-1, 0, 2, 4};
+    GraphBLAS::Vector<double> u(u_dense, 0.);
+
+    // Number of stored A(i,k) whose u(k) is stored
+    std::vector<uint32_t> count_dense = {2, 2, 0, 2};
+    GraphBLAS::Vector<uint32_t> count_ans(count_dense, 0U);
+    GraphBLAS::Vector<uint32_t> count(4);
+    GraphBLAS::mxv(count, GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
+                   GraphBLAS::PlusPairSemiring<double, double, uint32_t>(),
+                   A, u);
+    BOOST_CHECK_EQUAL(count, count_ans);
+
+    std::vector<uint32_t> reach_dense = {1, 1, 0, 1};
+    GraphBLAS::Vector<uint32_t> reach_ans(reach_dense, 0U);
+    GraphBLAS::Vector<uint32_t> reach(4);
+    GraphBLAS::mxv(reach, GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
+                   GraphBLAS::AnyPairSemiring<double, double, uint32_t>(),
+                   A, u);
+    BOOST_CHECK_EQUAL(reach, reach_ans);
+
+    // Any of the matching values of u is a valid answer
+    GraphBLAS::Vector<double> any(4);
+    GraphBLAS::mxv(any, GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
+                   GraphBLAS::AnySelect2ndSemiring<double>(),
+                   A, u);
+    BOOST_CHECK_EQUAL(any.nvals(), 3);
+    BOOST_CHECK(!any.hasElement(2));
+    double val(any.extractElement(0));
+    BOOST_CHECK((val == -1.) || (val == 2.));
+    val = any.extractElement(3);
+    BOOST_CHECK((val == 2.) || (val == 4.));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,147 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+#include <iostream>
+
+#include <graphblas/graphblas.hpp>
+
+using namespace GraphBLAS;
+
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_MODULE output_stages_test_suite
+
+#include <boost/test/included/unit_test.hpp>
+
+// The accumulate and mask stages take shortcuts when the mask or the
+// accumulator is absent; every case is checked against the general path
+// (a mask that allows everything).
+
+namespace
+{
+    std::vector<std::vector<double>> A_dense = {{8, 0, 1.5, 0},
+                                                {0, 0, 0,   0},
+                                                {4, 2, 0,   0},
+                                                {0, 0, 0,   3}};
+
+    std::vector<std::vector<double>> C_dense = {{1, 0, 0, 2.5},
+                                                {0, 7, 0, 0},
+                                                {0, 0, 0, 0},
+                                                {5, 0, 0, 0.5}};
+
+    std::vector<std::vector<bool>> all_true(4, std::vector<bool>(4, true));
+}
+
+BOOST_AUTO_TEST_SUITE(BOOST_TEST_MODULE)
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(no_mask_no_accum_replaces_output)
+{
+    Matrix<double> A(A_dense, 0);
+    Matrix<double> answer(4, 4);
+    mxm(answer, NoMask(), NoAccumulate(), ArithmeticSemiring<double>(), A, A);
+
+    Matrix<double> C(C_dense, 0);
+    mxm(C, NoMask(), NoAccumulate(), ArithmeticSemiring<double>(), A, A);
+    BOOST_CHECK_EQUAL(C, answer);
+
+    Matrix<double, CsrStorageTag> cC(C_dense, 0);
+    mxm(cC, NoMask(), NoAccumulate(), ArithmeticSemiring<double>(), A, A);
+    BOOST_CHECK_EQUAL(cC.nvals(), answer.nvals());
+    BOOST_CHECK_EQUAL(cC.extractElement(2, 2), answer.extractElement(2, 2));
+
+    // The output is a different type than the result of the operation
+    Matrix<int> iC(4, 4), ianswer(4, 4);
+    Matrix<bool> M(all_true);
+    apply(iC, NoMask(), NoAccumulate(), Identity<double>(), A);
+    apply(ianswer, M, NoAccumulate(), Identity<double>(), A);
+    BOOST_CHECK_EQUAL(iC, ianswer);
+    BOOST_CHECK_EQUAL(iC.extractElement(0, 2), 1);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(accum_no_mask_merges_in_place)
+{
+    Matrix<double> A(A_dense, 0);
+    Matrix<bool> M(all_true);
+
+    Matrix<double> C(C_dense, 0), answer(C_dense, 0);
+    eWiseAdd(C, NoMask(), Plus<double>(), Plus<double>(), A, A);
+    eWiseAdd(answer, M, Plus<double>(), Plus<double>(), A, A);
+    BOOST_CHECK_EQUAL(C, answer);
+
+    // Row 1 of C has no counterpart in A and is left as is
+    BOOST_CHECK_EQUAL(C.extractElement(1, 1), 7.0);
+    BOOST_CHECK_EQUAL(C.extractElement(0, 0), 17.0);
+
+    Matrix<double, CsrStorageTag> cC(C_dense, 0);
+    eWiseAdd(cC, NoMask(), Plus<double>(), Plus<double>(), A, A);
+    BOOST_CHECK_EQUAL(cC.nvals(), answer.nvals());
+    BOOST_CHECK_EQUAL(cC.extractElement(1, 1), 7.0);
+    BOOST_CHECK_EQUAL(cC.extractElement(3, 3), 6.5);
+
+    // The accumulator's domain (int) differs from C's: values of both C and
+    // T pass through it, as in the general path
+    Matrix<double> C2(C_dense, 0), answer2(C_dense, 0);
+    apply(C2, NoMask(), Plus<int>(), Identity<double>(), A);
+    apply(answer2, M, Plus<int>(), Identity<double>(), A);
+    BOOST_CHECK_EQUAL(C2, answer2);
+    BOOST_CHECK_EQUAL(C2.extractElement(0, 3), 2.0);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(vector_output_stages)
+{
+    std::vector<double> u_dense = {1.5, 0, 3, 0, 2};
+    std::vector<double> w_dense = {0, 4, 1, 0, 0.5};
+    std::vector<bool> all_true_vec(5, true);
+
+    Vector<double> u(u_dense, 0);
+    Vector<bool> m(all_true_vec);
+
+    Vector<double> w(w_dense, 0), answer(w_dense, 0);
+    apply(w, NoMask(), NoAccumulate(), AdditiveInverse<double>(), u);
+    apply(answer, m, NoAccumulate(), AdditiveInverse<double>(), u);
+    BOOST_CHECK_EQUAL(w, answer);
+    BOOST_CHECK_EQUAL(w.nvals(), 3);
+
+    Vector<double> w2(w_dense, 0), answer2(w_dense, 0);
+    eWiseAdd(w2, NoMask(), Plus<double>(), Plus<double>(), u, u);
+    eWiseAdd(answer2, m, Plus<double>(), Plus<double>(), u, u);
+    BOOST_CHECK_EQUAL(w2, answer2);
+    BOOST_CHECK_EQUAL(w2.extractElement(1), 4.0);
+    BOOST_CHECK_EQUAL(w2.extractElement(2), 7.0);
+
+    Vector<double> w3(w_dense, 0), answer3(w_dense, 0);
+    apply(w3, NoMask(), Plus<int>(), Identity<double>(), u);
+    apply(answer3, m, Plus<int>(), Identity<double>(), u);
+    BOOST_CHECK_EQUAL(w3, answer3);
+    BOOST_CHECK_EQUAL(w3.extractElement(4), 2.0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,149 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+#define GRAPHBLAS_PROFILING 1
+
+#include <graphblas/graphblas.hpp>
+
+using namespace GraphBLAS;
+
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_MODULE profiling_test_suite
+
+#include <boost/test/included/unit_test.hpp>
+
+namespace
+{
+    std::vector<std::vector<double>> mat = {{6, 0, 0, 4},
+                                            {7, 0, 0, 0},
+                                            {0, 0, 9, 4},
+                                            {2, 5, 0, 3}};
+}
+
+BOOST_AUTO_TEST_SUITE(BOOST_TEST_MODULE)
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(profiling_test_records)
+{
+    profiling::clear();
+
+    Matrix<double> A(mat, 0), C(4, 4);
+    Vector<double> u(std::vector<double>{1, 0, 1, 0}, 0), w(4);
+
+    mxm(C, NoMask(), NoAccumulate(), ArithmeticSemiring<double>(), A, A);
+    mxv(w, complement(u), NoAccumulate(), ArithmeticSemiring<double>(), A, u);
+    double sum = 0;
+    reduce(sum, NoAccumulate(), PlusMonoid<double>(), C);
+
+    auto recs = profiling::records();
+    BOOST_REQUIRE_EQUAL(recs.size(), 3);
+
+    BOOST_CHECK_EQUAL(std::string(recs[0].op), "mxm");
+    BOOST_CHECK_EQUAL(std::string(recs[0].mask), "none");
+    BOOST_CHECK_EQUAL(recs[0].nvals_in, 2*A.nvals());
+    BOOST_CHECK_EQUAL(recs[0].nvals_out, C.nvals());
+    BOOST_CHECK(recs[0].flops > 0);
+    BOOST_CHECK(recs[0].duration_us >= 0.0);
+
+    BOOST_CHECK_EQUAL(std::string(recs[1].op), "mxv");
+    BOOST_CHECK_EQUAL(std::string(recs[1].mask), "complement");
+    BOOST_CHECK_EQUAL(recs[1].nvals_out, w.nvals());
+    BOOST_CHECK(recs[1].start_us >= recs[0].start_us);
+
+    BOOST_CHECK_EQUAL(std::string(recs[2].op), "reduce");
+    BOOST_CHECK_EQUAL(recs[2].nvals_in, C.nvals());
+
+    profiling::clear();
+    BOOST_CHECK(profiling::records().empty());
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(profiling_test_summary_and_trace)
+{
+    profiling::clear();
+
+    Matrix<double> A(mat, 0), C(4, 4);
+    for (int ix = 0; ix < 3; ++ix)
+    {
+        mxm(C, NoMask(), NoAccumulate(), ArithmeticSemiring<double>(), A, A);
+    }
+    eWiseAdd(C, A, NoAccumulate(), Plus<double>(), C, A);
+
+    std::ostringstream summary;
+    profiling::print_summary(summary);
+    std::string text(summary.str());
+    BOOST_CHECK(text.find("ArithmeticSemiring<double") != std::string::npos);
+    BOOST_CHECK(text.find("eWiseAdd") != std::string::npos);
+    BOOST_CHECK(text.find("Plus<double") != std::string::npos);
+    // header + one line per (op, type, mask)
+    BOOST_CHECK_EQUAL(std::count(text.begin(), text.end(), '\n'), 3);
+
+    std::ostringstream trace;
+    profiling::write_chrome_trace(trace);
+    std::string json(trace.str());
+    BOOST_CHECK_EQUAL(json.find("{\"traceEvents\": ["), 0);
+    BOOST_CHECK_EQUAL(std::count(json.begin(), json.end(), '{'),
+                      1 + 2*4);
+    BOOST_CHECK(json.find("\"ph\": \"X\"") != std::string::npos);
+    BOOST_CHECK(json.find("\"mask\": \"mask\"") != std::string::npos);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(profiling_test_ring_buffer_and_threads)
+{
+    profiling::set_buffer_capacity(4);
+
+    Matrix<double> A(mat, 0);
+    Vector<double> w(4);
+    for (int ix = 0; ix < 10; ++ix)
+    {
+        reduce(w, NoMask(), NoAccumulate(), Plus<double>(), A);
+    }
+    BOOST_CHECK_EQUAL(profiling::records().size(), 4);
+
+    std::thread worker([&]() {
+            Matrix<double> B(mat, 0);
+            Matrix<double> C(4, 4);
+            transpose(C, NoMask(), NoAccumulate(), B);
+        });
+    worker.join();
+
+    auto recs = profiling::records();
+    BOOST_REQUIRE_EQUAL(recs.size(), 5);
+    BOOST_CHECK_EQUAL(std::string(recs.back().op), "transpose");
+    BOOST_CHECK(recs.back().thread != recs.front().thread);
+
+    profiling::set_buffer_capacity(1 << 16);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
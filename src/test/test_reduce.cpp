@@ -1171,4 +1171,90 @@ BOOST_AUTO_TEST_CASE(test_reduce_matscalar_accum_empty)
     BOOST_CHECK_EQUAL(val, 22.0);
 }
 
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_reduce_csr_storage)
+{
+    std::vector<std::vector<double> > m6x4_dense = {{5, 0, 1, 0},
+                                                    {6, 7, 0, 0},
+                                                    {6, 7, 0, 0},
+                                                    {0, 5, 0, 0},
+                                                    {6, 7, 0, 0},
+                                                    {0, 0, 0, 0}};
+    std::vector<double> ans6x4_dense = {6, 13, 13, 5, 13, 0};
+
+    Matrix<double, CsrStorageTag> mB(m6x4_dense, 0.);
+    Vector<double> result6(6);
+    Vector<double> ansB(ans6x4_dense, 0.);
+
+    reduce(result6,
+           NoMask(),
+           NoAccumulate(),
+           Plus<double>(), mB);
+    BOOST_CHECK_EQUAL(result6, ansB);
+
+    std::vector<double> ansBT_dense = {23, 26, 1, 0};
+    Vector<double> ansBT(ansBT_dense, 0.);
+    Vector<double> result4(4);
+    reduce(result4,
+           NoMask(),
+           NoAccumulate(),
+           Plus<double>(), transpose(mB));
+    BOOST_CHECK_EQUAL(result4, ansBT);
+
+    double val = 22;
+    reduce(val,
+           Plus<double>(),
+           PlusMonoid<double>(), mB);
+    BOOST_CHECK_EQUAL(val, 72.0);
+
+    Matrix<double, CsrStorageTag> empty6x4(6, 4);
+    val = 22;
+    reduce(val,
+           NoAccumulate(),
+           PlusMonoid<double>(), empty6x4);
+    BOOST_CHECK_EQUAL(val, PlusMonoid<double>().identity());
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_reduce_terminal_monoids)
+{
+    std::vector<std::vector<uint32_t> > m4x4_dense = {{5, 0, 1, 0},
+                                                      {6, 7, 3, 0},
+                                                      {0, 0, 0, 2},
+                                                      {9, 5, 0, 8}};
+
+    // Stored zeros reach MinMonoid's terminal value
+    Matrix<uint32_t> mA(m4x4_dense, 99);
+    Matrix<uint32_t, CsrStorageTag> mA_csr(m4x4_dense, 99);
+
+    uint32_t val = 22;
+    reduce(val, NoAccumulate(), MinMonoid<uint32_t>(), mA);
+    BOOST_CHECK_EQUAL(val, 0U);
+    val = 22;
+    reduce(val, NoAccumulate(), MinMonoid<uint32_t>(), mA_csr);
+    BOOST_CHECK_EQUAL(val, 0U);
+
+    std::vector<uint32_t> ans_min = {0, 0, 0, 0};
+    Vector<uint32_t> ansMin(ans_min, 99);
+    Vector<uint32_t> result(4);
+    reduce(result, NoMask(), NoAccumulate(), MinMonoid<uint32_t>(), mA);
+    BOOST_CHECK_EQUAL(result, ansMin);
+    reduce(result, NoMask(), NoAccumulate(), MinMonoid<uint32_t>(), mA_csr);
+    BOOST_CHECK_EQUAL(result, ansMin);
+
+    std::vector<std::vector<bool> > b_dense = {{false, true, false},
+                                               {false, false, false},
+                                               {true, true, true}};
+    Matrix<bool> mB(b_dense);
+    Vector<bool> any(3);
+    reduce(any, NoMask(), NoAccumulate(), LogicalOrMonoid<bool>(), mB);
+    std::vector<bool> ans_any = {true, false, true};
+    BOOST_CHECK_EQUAL(any, Vector<bool>(ans_any));
+
+    Vector<bool> all(3);
+    reduce(all, NoMask(), NoAccumulate(), LogicalAndMonoid<bool>(), mB);
+    std::vector<bool> ans_all = {false, false, true};
+    BOOST_CHECK_EQUAL(all, Vector<bool>(ans_all));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
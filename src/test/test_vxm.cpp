@@ -114,6 +114,42 @@ BOOST_AUTO_TEST_CASE(test_vxm_reg)
     BOOST_CHECK_EQUAL(result, ansB);
 }
 
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_vxm_column_index)
+{
+    GraphBLAS::Matrix<double, GraphBLAS::ColumnIndexTag> mA(m3x3_dense, 0.);
+    GraphBLAS::Matrix<double, GraphBLAS::CsrStorageTag,
+                      GraphBLAS::ColumnIndexTag> mB(m4x3_dense, 0.);
+    GraphBLAS::Vector<double> u3(u3_dense, 0.);
+    GraphBLAS::Vector<double> u4(u4_dense, 0.);
+    GraphBLAS::Vector<double> result(3);
+    GraphBLAS::Vector<double> ansA(ans3_dense, 0.);
+    GraphBLAS::Vector<double> ansB(ans4_dense, 0.);
+
+    GraphBLAS::vxm(result,
+                   GraphBLAS::NoMask(),
+                   GraphBLAS::NoAccumulate(),
+                   GraphBLAS::ArithmeticSemiring<double>(), u3, mA);
+    BOOST_CHECK_EQUAL(result, ansA);
+
+    GraphBLAS::vxm(result,
+                   GraphBLAS::NoMask(),
+                   GraphBLAS::NoAccumulate(),
+                   GraphBLAS::ArithmeticSemiring<double>(), u4, mB);
+    BOOST_CHECK_EQUAL(result, ansB);
+
+    // index must be rebuilt after a modification
+    mA.setElement(2, 0, 1.);
+    u3.setElement(2, 1.);
+    std::vector<double> ans = {14, 6, 16};
+    GraphBLAS::Vector<double> ansC(ans, 0.);
+    GraphBLAS::vxm(result,
+                   GraphBLAS::NoMask(),
+                   GraphBLAS::NoAccumulate(),
+                   GraphBLAS::ArithmeticSemiring<double>(), u3, mA);
+    BOOST_CHECK_EQUAL(result, ansC);
+}
+
 //****************************************************************************
 BOOST_AUTO_TEST_CASE(test_vxm_stored_zero_result)
 {
@@ -655,4 +691,66 @@ BOOST_AUTO_TEST_CASE(test_vxm_scmp_masked_a_transpose)
 }
 
 
+//****************************************************************************
+// A sparse u is pushed along the rows of A, a dense u pulls every column
+// when A has a column index; both, with and without a (complemented) mask,
+// must match a dense reference.
+BOOST_AUTO_TEST_CASE(test_vxm_push_and_pull_vs_dense_reference)
+{
+    GraphBLAS::IndexType const M = 40, N = 30;
+    std::vector<std::vector<double> > A(M, std::vector<double>(N, 0));
+    for (GraphBLAS::IndexType i = 0; i < M; ++i)
+        for (GraphBLAS::IndexType j = 0; j < N; ++j)
+            if ((i*5 + j*3) % 7 == 2) A[i][j] = double((i + j) % 5 + 1);
+    GraphBLAS::Matrix<double> mA(A, 0.);
+    GraphBLAS::Matrix<double, GraphBLAS::ColumnIndexTag> mAi(A, 0.);
+
+    std::vector<double> mask_dense(N, 0);
+    for (GraphBLAS::IndexType j = 0; j < N; j += 3) mask_dense[j] = 1;
+    GraphBLAS::Vector<double> mask(mask_dense, 0.);
+
+    for (GraphBLAS::IndexType stride : {17UL, 1UL})
+    {
+        std::vector<double> u_dense(M, 0);
+        for (GraphBLAS::IndexType i = 0; i < M; i += stride)
+            u_dense[i] = double(i % 3 + 1);
+        GraphBLAS::Vector<double> u(u_dense, 0.);
+
+        std::vector<double> ans(N, 0), ans_masked(N, 0), ans_comp(N, 0);
+        for (GraphBLAS::IndexType j = 0; j < N; ++j)
+        {
+            for (GraphBLAS::IndexType i = 0; i < M; ++i)
+                ans[j] += u_dense[i]*A[i][j];
+            (mask_dense[j] ? ans_masked : ans_comp)[j] = ans[j];
+        }
+
+        GraphBLAS::Vector<double> result(N);
+        GraphBLAS::vxm(result, GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
+                       GraphBLAS::ArithmeticSemiring<double>(), u, mA);
+        BOOST_CHECK_EQUAL(result, GraphBLAS::Vector<double>(ans, 0.));
+
+        GraphBLAS::Vector<double> result_m(N);
+        GraphBLAS::vxm(result_m, mask, GraphBLAS::NoAccumulate(),
+                       GraphBLAS::ArithmeticSemiring<double>(), u, mA);
+        BOOST_CHECK_EQUAL(result_m, GraphBLAS::Vector<double>(ans_masked, 0.));
+
+        GraphBLAS::Vector<double> result_c(N);
+        GraphBLAS::vxm(result_c, GraphBLAS::complement(mask),
+                       GraphBLAS::NoAccumulate(),
+                       GraphBLAS::ArithmeticSemiring<double>(), u, mA);
+        BOOST_CHECK_EQUAL(result_c, GraphBLAS::Vector<double>(ans_comp, 0.));
+
+        GraphBLAS::Vector<double> result_i(N);
+        GraphBLAS::vxm(result_i, GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
+                       GraphBLAS::ArithmeticSemiring<double>(), u, mAi);
+        BOOST_CHECK_EQUAL(result_i, GraphBLAS::Vector<double>(ans, 0.));
+
+        GraphBLAS::Vector<double> result_ic(N);
+        GraphBLAS::vxm(result_ic, GraphBLAS::complement(mask),
+                       GraphBLAS::NoAccumulate(),
+                       GraphBLAS::ArithmeticSemiring<double>(), u, mAi);
+        BOOST_CHECK_EQUAL(result_ic, GraphBLAS::Vector<double>(ans_comp, 0.));
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()